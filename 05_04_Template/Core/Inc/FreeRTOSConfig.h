@@ -53,6 +53,7 @@
   extern uint32_t SystemCoreClock;
   void xPortSysTickHandler(void);
 #endif
+#define configUSE_TICKLESS_IDLE                  0
 #define configENABLE_FPU                         0
 #define configENABLE_MPU                         0
 
@@ -117,6 +118,23 @@ to all Cortex-M ports, and do not rely on any particular library functions. */
 See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
 #define configMAX_SYSCALL_INTERRUPT_PRIORITY 	( configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - configPRIO_BITS) )
 
+/* Definitions for tickless idle mode */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void PreSleepProcessing(uint32_t ulExpectedIdleTime);
+void PostSleepProcessing(uint32_t ulExpectedIdleTime);
+#endif
+
+/* The configPRE_SLEEP_PROCESSING() and configPOST_SLEEP_PROCESSING() macros
+allow the application writer to add additional code before and after the MCU is
+placed into the low power state respectively.  The HAL time base runs from TIM11
+rather than the SysTick, so these hooks mask its interrupt across the sleep and
+then add the milliseconds TIM11 counted while it was masked.  Tickless idle is
+off until this has been checked on the board. */
+#if configUSE_TICKLESS_IDLE == 1
+#define configPRE_SLEEP_PROCESSING                        PreSleepProcessing
+#define configPOST_SLEEP_PROCESSING                       PostSleepProcessing
+#endif /* configUSE_TICKLESS_IDLE == 1 */
+
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
 /* USER CODE BEGIN 1 */
@@ -135,6 +153,82 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Set to 1 to detect stack overflows with an MPU region that guards the end of
+   the running task's stack, rather than checking the stack on every context
+   switch.  Off until it has been run on the board: aligning the guard costs up
+   to 56 bytes of each task's stack. */
+#define configUSE_MPU_STACK_GUARD                0
+/* Lets osMailAlloc() wait for a free block rather than fail at once. */
+#define configUSE_COUNTING_SEMAPHORES            1
+#if defined(LATENCY_BENCH)
+/* The wake latency benchmark (latency_bench.h) reports over USART2, measures
+   the event group path through the timer task, and must not be disturbed by
+   tickless idle reprogramming the SysTick. */
+#define configUSE_TIMERS                         1
+#define configTIMER_TASK_PRIORITY                ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                 4
+#define configTIMER_TASK_STACK_DEPTH             configMINIMAL_STACK_SIZE
+#define INCLUDE_xTimerPendFunctionCall           1
+#undef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE                  0
+#elif defined(PRINTF_BENCH)
+/* The printf benchmark (printf_bench.h) reports over USART2 and measures the
+   stack its probe tasks use. */
+#define INCLUDE_uxTaskGetStackHighWaterMark      1
+#elif defined(POOL_BENCH)
+/* The memory pool benchmark (pool_bench.h) reports over USART2. */
+#elif defined(MAIL_BENCH)
+/* The mail pipeline benchmark (mail_bench.h) reports over USART2 and paces
+   its producer with vTaskDelayUntil(). */
+#undef INCLUDE_vTaskDelayUntil
+#define INCLUDE_vTaskDelayUntil                  1
+#endif /* LATENCY_BENCH, PRINTF_BENCH, POOL_BENCH, MAIL_BENCH */
+/* Record scheduler and queue events and stream them out of USART2, see
+   trace_recorder.h.  Off unless configUSE_TRACE_RECORDER=1 is defined on the
+   compiler command line, as USART2 is the ST-Link virtual COM port that
+   HeapTelemetry_Dump() and the benchmarks write to, and nothing else can use
+   it while the recorder is streaming. */
+#ifndef configUSE_TRACE_RECORDER
+#define configUSE_TRACE_RECORDER                 0
+#endif
+#if (configUSE_TRACE_RECORDER == 1)
+  #if defined(LATENCY_BENCH) || defined(PRINTF_BENCH) || defined(POOL_BENCH) || defined(MAIL_BENCH)
+    #error The benchmarks report over USART2, which the trace recorder uses.
+  #endif
+  #include "trace_recorder.h"
+#endif
+/* Set to 1 to unblock vTaskDelayMicroseconds() and
+   xTaskNotifyWaitMicroseconds() from a compare interrupt of the 1 MHz TIM5
+   count rather than the tick, see microsecond_timer.h.  Off until it has been
+   run on the board.  Can be set on the compiler command line, for example to
+   build the latency benchmark with it. */
+#ifndef configUSE_MICROSECOND_DELAYS
+#define configUSE_MICROSECOND_DELAYS             0
+#endif
+#if (configUSE_MICROSECOND_DELAYS == 1)
+  #include "microsecond_timer.h"
+  #define configMICROSECOND_TIMER_COUNT()            MicrosecondTimer_Count()
+  #define configMICROSECOND_TIMER_SET_ALARM(ulCount) MicrosecondTimer_SetAlarm(ulCount)
+#endif
+/* Build newlib's malloc() family and its locks on heap_4, and give heap_4 all
+   the RAM between .bss and the MSP stack rather than configTOTAL_HEAP_SIZE
+   bytes of .bss, see newlib_heap.h. */
+#define configUSE_NEWLIB_HEAP                    1
+#if (configUSE_NEWLIB_HEAP == 1)
+  #include "newlib_heap.h"
+  #define configUSE_NEWLIB_REENTRANT               1
+  #define configUSE_APPLICATION_HEAP_REGION        1
+  #define configHEAP_REGION_START()                NEWLIB_HEAP_START
+  #define configHEAP_REGION_END()                  NEWLIB_HEAP_END
+  /* heap_4 does not use configTOTAL_HEAP_SIZE then, but code that reports
+     the size of the heap still can. */
+  #undef configTOTAL_HEAP_SIZE
+  #define configTOTAL_HEAP_SIZE                    ((size_t)(NEWLIB_HEAP_END - NEWLIB_HEAP_START))
+#endif
+/* Set to 1 to keep free block and allocation time histograms and a record of
+   failed allocations in heap_4, and dump them with HeapTelemetry_Dump(), see
+   heap_telemetry.h.  The dump shares USART2 with the trace recorder. */
+#define configUSE_HEAP_TELEMETRY                 0
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,56 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : heap_telemetry.h
+  * @brief          : Binary dump of the heap_4 telemetry over a UART.
+  ******************************************************************************
+  * @attention
+  *
+  * Built into the template when configUSE_HEAP_TELEMETRY is 1.  The kernel
+  * keeps the telemetry as the heap is used (see vPortGetHeapTelemetry() in
+  * portable.h); HeapTelemetry_Dump() sends a snapshot of it as one frame:
+  *
+  *   'H' 'T' version  length (2 bytes)  payload  checksum (2 bytes)
+  *
+  * The length and checksum are little endian, and the checksum is the
+  * Fletcher-16 sum of the payload.  The payload is a sequence of unsigned
+  * LEB128 numbers, so counters that are still small take one byte each.  A
+  * frame is normally well under 200 bytes.
+  *
+  * Utilities/heap_telemetry_decode.py finds the frames in a captured byte
+  * stream and prints them as histograms and a list of failed allocations,
+  * whose call sites can be resolved with arm-none-eabi-addr2line.
+  *
+  * The dump blocks in HAL_UART_Transmit(), so it is meant for a diagnostic
+  * command or for the point where an allocation has failed.  It must not be
+  * sent to USART2 while the trace recorder (configUSE_TRACE_RECORDER) is
+  * streaming on it.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HEAP_TELEMETRY_H
+#define __HEAP_TELEMETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define HEAP_TELEMETRY_MAGIC_0          0x48U   /* 'H' */
+#define HEAP_TELEMETRY_MAGIC_1          0x54U   /* 'T' */
+#define HEAP_TELEMETRY_VERSION          1U
+
+/* Exported functions prototypes ---------------------------------------------*/
+HAL_StatusTypeDef HeapTelemetry_Dump(UART_HandleTypeDef *huart);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HEAP_TELEMETRY_H */
@@ -0,0 +1,119 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : latency_bench.h
+  * @brief          : Interrupt to task wake latency benchmark.
+  ******************************************************************************
+  * @attention
+  *
+  * Built into the template when LATENCY_BENCH is defined on the compiler
+  * command line (Project > Properties > C/C++ Build > Settings > MCU GCC
+  * Compiler > Preprocessor, preferably in a build configuration of its own).
+  *
+  * A software pended interrupt wakes a task through each of the kernel's wake
+  * primitives in turn: direct to task notification, binary semaphore, queue,
+  * event group and stream buffer.  The time from pending the interrupt to the
+  * first instruction of the woken task is measured LATENCY_BENCH_SAMPLES times
+  * per primitive and reported as min/avg/p99/max plus a log2 histogram.
+  *
+  * The interrupt is pended from inside LATENCY_BENCH_LOAD_TASKS busy tasks, at
+  * a random point of their work, so that the samples include the cost of the
+  * critical sections those tasks enter.  With no load tasks the interrupt is
+  * pended from the task that collects the results.
+  *
+  * With configUSE_MICROSECOND_DELAYS set to 1, the control task then sleeps
+  * LATENCY_BENCH_SAMPLES times in vTaskDelayMicroseconds() for a random 20 to
+  * 2019 us, with the load tasks still running, and reports how many
+  * microseconds of the TIM5 count after its wake time it ran again.
+  *
+  * Last, the control task and a task of the same priority yield to each other
+  * LATENCY_BENCH_SWITCH_ROUNDS times, and the cycles per context switch are
+  * reported.  Running it built with configGENERATE_RUN_TIME_CYCLE_STATS set to
+  * 1 and then to 0 gives the cost of the per task cycle accounting.
+  *
+  * Timestamps come from the DWT cycle counter.  Where it does not count, as
+  * under QEMU, they are built from the SysTick counter and the tick count
+  * instead, which has the same resolution.  The report header names the one
+  * in use.
+  *
+  * Results go to USART2 at 115200 baud, or with LATENCY_BENCH_QEMU also
+  * defined, to the debugger console through semihosting.  The QEMU build
+  * differs from the board build where QEMU's netduinoplus2 (an STM32F405)
+  * does not model the STM32F411:
+  *
+  *   - the RCC is left alone and SystemCoreClock is set to
+  *     LATENCY_BENCH_QEMU_CORE_CLOCK, the clock QEMU runs the core at;
+  *   - TIM11 is not started, and HAL_GetTick() reads the kernel tick count
+  *     (stm32f4xx_hal_timebase_tim.c);
+  *   - the microsecond delay run is skipped, as the TIM5 compare interrupt
+  *     never fires.
+  *
+  * It exits QEMU through semihosting when the run is complete.  Build it and
+  * run it from the project directory with arm-none-eabi-gcc and
+  * qemu-system-arm on the PATH:
+  *
+  *   make -f latency_bench_qemu.mk run
+  *
+  * which runs Utilities/run_latency_bench_qemu.sh on the ELF.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __LATENCY_BENCH_H
+#define __LATENCY_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Wake-ups measured per primitive. */
+#ifndef LATENCY_BENCH_SAMPLES
+#define LATENCY_BENCH_SAMPLES            1000U
+#endif
+
+/* Round trips between the two yielding tasks of the context switch run. */
+#ifndef LATENCY_BENCH_SWITCH_ROUNDS
+#define LATENCY_BENCH_SWITCH_ROUNDS      10000U
+#endif
+
+/* Background tasks running below the measured tasks. */
+#ifndef LATENCY_BENCH_LOAD_TASKS
+#define LATENCY_BENCH_LOAD_TASKS         2U
+#endif
+
+/* Each load task enters a critical section once every
+   LATENCY_BENCH_CRITICAL_PERIOD iterations of its work loop, and spins for
+   LATENCY_BENCH_CRITICAL_LENGTH iterations inside it.  Set the period to 0
+   to measure without critical sections. */
+#ifndef LATENCY_BENCH_CRITICAL_PERIOD
+#define LATENCY_BENCH_CRITICAL_PERIOD    64U
+#endif
+#ifndef LATENCY_BENCH_CRITICAL_LENGTH
+#define LATENCY_BENCH_CRITICAL_LENGTH    32U
+#endif
+
+/* Core clock of QEMU's netduinoplus2 machine. */
+#ifndef LATENCY_BENCH_QEMU_CORE_CLOCK
+#define LATENCY_BENCH_QEMU_CORE_CLOCK    168000000U
+#endif
+
+/* Interrupt used as the wake source.  It is only ever pended by software. */
+#ifndef LATENCY_BENCH_IRQn
+#define LATENCY_BENCH_IRQn               EXTI0_IRQn
+#endif
+
+/* Exported functions prototypes ---------------------------------------------*/
+void LatencyBench_Init(void);
+void LatencyBench_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LATENCY_BENCH_H */
@@ -0,0 +1,70 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : lite_printf.h
+  * @brief          : Small printf() family for tasks, with no heap and no
+  *                   shared state.
+  ******************************************************************************
+  * @attention
+  *
+  * newlib's printf() keeps its state in the _REENT structure of the calling
+  * task, may allocate a stdout buffer or big number storage from the heap,
+  * and needs more stack than the small task stacks of the examples have.  The
+  * formatter here keeps all of its state on the stack of the caller, a few
+  * hundred bytes of it, so any number of tasks can use it at once.
+  *
+  * Supported conversions: %d %i %u %x %X %c %s %p %f %F and %%, with the
+  * flags - 0 + space #, a width and a precision (either may be *), and the
+  * length modifiers hh h l ll z and t.  %f prints fixed point with at most
+  * LITE_PRINTF_MAX_PRECISION decimals, and prints "ovf" for magnitudes of
+  * 2^64 and above.  It rounds half away from zero, so the last decimal of a
+  * value on or very near a tie can differ from newlib's.
+  *
+  * Output goes to a sink in chunks of up to LITE_PRINTF_CHUNK_SIZE bytes, so
+  * a formatted line reaches the sink in more than one call if it is longer
+  * than that.  Output from several tasks printing at once can then
+  * interleave unless the sink serialises them.
+  *
+  * See Core/Src/printf_bench.c for a comparison with newlib-nano.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __LITE_PRINTF_H
+#define __LITE_PRINTF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stddef.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Bytes gathered on the stack between calls of the sink. */
+#ifndef LITE_PRINTF_CHUNK_SIZE
+#define LITE_PRINTF_CHUNK_SIZE          32U
+#endif
+
+/* Most decimals %f prints. */
+#define LITE_PRINTF_MAX_PRECISION       9U
+
+/* Exported types ------------------------------------------------------------*/
+/* Receives the formatted output, xLength bytes at a time.  The bytes are not
+   null terminated. */
+typedef void (*LitePrintf_Sink)(void *pvContext, const char *pcData, size_t xLength);
+
+/* Exported functions prototypes ---------------------------------------------*/
+int LitePrintf_Format(LitePrintf_Sink pfnSink, void *pvContext, const char *pcFormat, va_list xArgs);
+int LitePrintf_Snprintf(char *pcBuffer, size_t xSize, const char *pcFormat, ...) __attribute__((format(printf, 3, 4)));
+int LitePrintf_Vsnprintf(char *pcBuffer, size_t xSize, const char *pcFormat, va_list xArgs);
+int LitePrintf_Printf(const char *pcFormat, ...) __attribute__((format(printf, 1, 2)));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LITE_PRINTF_H */
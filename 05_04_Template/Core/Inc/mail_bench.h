@@ -0,0 +1,81 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : mail_bench.h
+  * @brief          : Bursty producer and consumer pipeline through a CMSIS
+  *                   mail queue.
+  ******************************************************************************
+  * @attention
+  *
+  * Built into the template when MAIL_BENCH is defined on the compiler command
+  * line, in the same way as LATENCY_BENCH (see latency_bench.h).
+  *
+  * A producer task puts MAIL_BENCH_BURST mails back to back every
+  * MAIL_BENCH_PERIOD_MS milliseconds into a mail queue of MAIL_BENCH_BLOCKS
+  * blocks.  A consumer task at the same priority spends MAIL_BENCH_WORK_LOOPS
+  * loop iterations on each mail before freeing it.  The defaults keep the
+  * consumer busy for a little over half of each period, so the pipeline can
+  * keep up with the producer only if the producer uses no more than the rest.
+  *
+  * The run is made twice:
+  *  - "blocking": the producer waits in osMailAlloc(queue, osWaitForever)
+  *    while the pool is empty, and osMailFree() wakes it;
+  *  - "retry": the producer calls osMailAlloc(queue, 0) until it returns a
+  *    block, as it had to while osMailAlloc() ignored its timeout, and takes
+  *    every other time slice from the consumer while the pool is empty.
+  *
+  * For each it reports the mails per second delivered against the rate the
+  * producer offers, the longest time from the start of a burst until its last
+  * mail was consumed, the failed allocations and any mail received out of
+  * order.
+  *
+  * Results go to USART2 at 115200 baud, written with LitePrintf_Format().
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __MAIL_BENCH_H
+#define __MAIL_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Blocks in the pool of the mail queue. */
+#ifndef MAIL_BENCH_BLOCKS
+#define MAIL_BENCH_BLOCKS               8U
+#endif
+
+/* Mails per burst, and the period of the bursts. */
+#ifndef MAIL_BENCH_BURST
+#define MAIL_BENCH_BURST                32U
+#endif
+
+#ifndef MAIL_BENCH_PERIOD_MS
+#define MAIL_BENCH_PERIOD_MS            10U
+#endif
+
+/* Bursts per run. */
+#ifndef MAIL_BENCH_BURSTS
+#define MAIL_BENCH_BURSTS               200U
+#endif
+
+/* Work of the consumer per mail, in iterations of a loop of a few cycles. */
+#ifndef MAIL_BENCH_WORK_LOOPS
+#define MAIL_BENCH_WORK_LOOPS           4000U
+#endif
+
+/* Exported functions prototypes ---------------------------------------------*/
+void MailBench_Init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAIL_BENCH_H */
@@ -0,0 +1,46 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : microsecond_timer.h
+  * @brief          : TIM5 alarm behind the kernel's microsecond delays.
+  ******************************************************************************
+  * @attention
+  *
+  * Included from FreeRTOSConfig.h when configUSE_MICROSECOND_DELAYS is 1.
+  * TIM5 is a 32-bit timer counting at 1 MHz.  Its count is the kernel's
+  * microsecond time, and its compare channel 1 raises the interrupt that
+  * unblocks tasks waiting in vTaskDelayMicroseconds() or
+  * xTaskNotifyWaitMicroseconds(), independently of the tick.  TIM5 must not
+  * be used for anything else.
+  *
+  * The interrupt runs at configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, the
+  * highest priority allowed to use the FreeRTOS API, so a task is woken within
+  * a few microseconds of its wake time unless the kernel is in a critical
+  * section at that moment.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __MICROSECOND_TIMER_H
+#define __MICROSECOND_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported functions prototypes ---------------------------------------------*/
+void MicrosecondTimer_Init(void);
+uint32_t MicrosecondTimer_Count(void);
+void MicrosecondTimer_SetAlarm(uint32_t ulCount);
+void MicrosecondTimer_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MICROSECOND_TIMER_H */
@@ -0,0 +1,60 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : newlib_heap.h
+  * @brief          : One heap for newlib's malloc() and the FreeRTOS kernel.
+  ******************************************************************************
+  * @attention
+  *
+  * Included from FreeRTOSConfig.h when configUSE_NEWLIB_HEAP is 1.  heap_4 then
+  * manages all the RAM between the end of .bss and the MSP stack, the region
+  * _sbrk() used to hand to newlib, instead of a fixed ucHeap array in .bss:
+  *
+  * ############################################################################
+  * #  .data  #  .bss  #         heap_4 heap         #        MSP stack        #
+  * #         #        #                             # _Min_Stack_Size bytes   #
+  * ############################################################################
+  * ^-- RAM start      ^-- _end           NEWLIB_HEAP_END --^  _estack, RAM end --^
+  *
+  * newlib_heap.c maps malloc(), free(), realloc() and calloc() and their
+  * reentrant _r forms onto pvPortMalloc() and friends, and implements the
+  * __malloc_lock() and __env_lock() hooks by suspending the scheduler, so
+  * allocations made by printf() and the like are safe from any task.  _sbrk()
+  * always fails, as the RAM it would give out belongs to heap_4.  With
+  * configUSE_NEWLIB_REENTRANT each task has its own struct _reent, so errno and
+  * the stdio state are per task.
+  *
+  * The C library must not be used from interrupts, and memalign(), mallinfo()
+  * and malloc_usable_size() are not supported.  The linker script still
+  * checks that _Min_Heap_Size bytes are left for the heap.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __NEWLIB_HEAP_H
+#define __NEWLIB_HEAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Symbols defined in the linker script. */
+extern uint8_t _end;
+extern uint8_t _estack;
+extern uint32_t _Min_Stack_Size;
+
+/* The first byte of the heap, and the byte after its last. */
+#define NEWLIB_HEAP_START               (&_end)
+#define NEWLIB_HEAP_END                 (&_estack - (uint32_t)&_Min_Stack_Size)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NEWLIB_HEAP_H */
@@ -0,0 +1,62 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : pool_bench.h
+  * @brief          : osPoolAlloc()/osPoolFree() against the marker scan they
+  *                   replaced.
+  ******************************************************************************
+  * @attention
+  *
+  * Built into the template when POOL_BENCH is defined on the compiler command
+  * line, in the same way as LATENCY_BENCH (see latency_bench.h).
+  *
+  * The earlier osPoolAlloc() masked interrupts and scanned a byte of markers
+  * per block from the block it last allocated, so its cost, and the time
+  * interrupts stayed masked, grew with the size of the pool.  The benchmark
+  * keeps a copy of it and runs both against pools of 8 to
+  * POOL_BENCH_MAX_BLOCKS blocks.  For each size it reports, from the DWT
+  * cycle counter with the scheduler suspended:
+  *  - the average and largest cost of an allocation while filling an empty
+  *    pool;
+  *  - the largest cost of an allocation that takes the only free block, when
+  *    that block is the one the marker scan reaches last, over
+  *    POOL_BENCH_ROUNDS allocations;
+  *  - the average cost of a free;
+  *  - the high water mark osPoolGetHighWaterMark() returns afterwards.
+  *
+  * Results go to USART2 at 115200 baud, written with LitePrintf_Format().
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __POOL_BENCH_H
+#define __POOL_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Blocks in the largest pool.  The sizes double from 8 up to this. */
+#ifndef POOL_BENCH_MAX_BLOCKS
+#define POOL_BENCH_MAX_BLOCKS           512U
+#endif
+
+/* Timed single free block allocations per pool. */
+#ifndef POOL_BENCH_ROUNDS
+#define POOL_BENCH_ROUNDS               256U
+#endif
+
+/* Exported functions prototypes ---------------------------------------------*/
+void PoolBench_Init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __POOL_BENCH_H */
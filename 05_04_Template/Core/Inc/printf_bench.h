@@ -0,0 +1,61 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : printf_bench.h
+  * @brief          : newlib-nano snprintf() against LitePrintf_Snprintf().
+  ******************************************************************************
+  * @attention
+  *
+  * Built into the template when PRINTF_BENCH is defined on the compiler
+  * command line, in the same way as LATENCY_BENCH (see latency_bench.h).
+  *
+  * Each formatter formats the same set of typical log lines.  For each line
+  * the benchmark reports:
+  *  - the cycles per call, min and average over PRINTF_BENCH_CALLS calls made
+  *    with the scheduler suspended, from the DWT cycle counter;
+  *  - the stack the first call needs, from the high water mark of a task that
+  *    makes only that call, less that of a task that makes none;
+  *  - the heap allocations that first call makes.
+  *
+  * newlib-nano only formats floating point if the application links with
+  * "-u _printf_float" (Project > Properties > C/C++ Build > Settings > MCU
+  * Settings > Use float with printf from newlib-nano).  Without it the
+  * float lines measure newlib skipping the conversion.
+  *
+  * Results go to USART2 at 115200 baud, written with LitePrintf_Format().
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __PRINTF_BENCH_H
+#define __PRINTF_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Timed calls per formatter and line. */
+#ifndef PRINTF_BENCH_CALLS
+#define PRINTF_BENCH_CALLS              100U
+#endif
+
+/* Stack of the task each first call is made from, in words.  It must hold
+   the deepest formatter with room to spare. */
+#ifndef PRINTF_BENCH_PROBE_STACK_DEPTH
+#define PRINTF_BENCH_PROBE_STACK_DEPTH  ((uint16_t) 1024)
+#endif
+
+/* Exported functions prototypes ---------------------------------------------*/
+void PrintfBench_Init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PRINTF_BENCH_H */
@@ -53,8 +53,11 @@ void BusFault_Handler(void);
 void UsageFault_Handler(void);
 void DebugMon_Handler(void);
 void SysTick_Handler(void);
+void TIM1_TRG_COM_TIM11_IRQHandler(void);
 /* USER CODE BEGIN EFP */
-
+void DMA1_Stream6_IRQHandler(void);
+void EXTI0_IRQHandler(void);
+void TIM5_IRQHandler(void);
 /* USER CODE END EFP */
 
 #ifdef __cplusplus
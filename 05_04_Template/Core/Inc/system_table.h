@@ -0,0 +1,99 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : system_table.h
+  * @brief          : Declarative description of the kernel objects created at
+  *                   boot.
+  ******************************************************************************
+  * @attention
+  *
+  * Every task, queue, semaphore, mutex, event group and stream buffer listed
+  * below is given statically allocated storage by system_table.c, and is
+  * created by a single call to SystemTable_Init() before the scheduler is
+  * started.  Nothing is taken from the FreeRTOS heap, so configTOTAL_HEAP_SIZE
+  * only needs to cover objects created at run time.
+  *
+  * main() starts the scheduler right after SystemTable_Init(), so every task
+  * listed here, defaultTask included, runs from boot.
+  *
+  * Each list is an X-macro: add one X(...) line per object.  The first
+  * argument names the object, and its handle is declared below as
+  * <name>Handle.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SYSTEM_TABLE_H
+#define __SYSTEM_TABLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Tasks: X(name, function, stack depth in words, priority, parameter) */
+#define SYSTEM_TABLE_TASKS(X) \
+  X(defaultTask, StartDefaultTask, 128, tskIDLE_PRIORITY + 3, NULL)
+
+/* Queues: X(name, length, item size in bytes) */
+#define SYSTEM_TABLE_QUEUES(X)
+
+/* Binary semaphores: X(name) */
+#define SYSTEM_TABLE_BINARY_SEMAPHORES(X)
+
+/* Counting semaphores: X(name, maximum count, initial count) */
+#define SYSTEM_TABLE_COUNTING_SEMAPHORES(X)
+
+/* Mutexes: X(name) */
+#define SYSTEM_TABLE_MUTEXES(X)
+
+/* Event groups: X(name) */
+#define SYSTEM_TABLE_EVENT_GROUPS(X)
+
+/* Stream buffers: X(name, size in bytes, trigger level in bytes) */
+#define SYSTEM_TABLE_STREAM_BUFFERS(X)
+
+/* Exported variables --------------------------------------------------------*/
+#define SYSTEM_TABLE_DECLARE_TASK(name, function, depth, priority, parameter) \
+  extern TaskHandle_t name##Handle;
+#define SYSTEM_TABLE_DECLARE_QUEUE(name, length, size) \
+  extern QueueHandle_t name##Handle;
+#define SYSTEM_TABLE_DECLARE_SEMAPHORE(name) \
+  extern SemaphoreHandle_t name##Handle;
+#define SYSTEM_TABLE_DECLARE_COUNTING_SEMAPHORE(name, max, initial) \
+  extern SemaphoreHandle_t name##Handle;
+#define SYSTEM_TABLE_DECLARE_EVENT_GROUP(name) \
+  extern EventGroupHandle_t name##Handle;
+#define SYSTEM_TABLE_DECLARE_STREAM_BUFFER(name, size, trigger) \
+  extern StreamBufferHandle_t name##Handle;
+
+SYSTEM_TABLE_TASKS(SYSTEM_TABLE_DECLARE_TASK)
+SYSTEM_TABLE_QUEUES(SYSTEM_TABLE_DECLARE_QUEUE)
+SYSTEM_TABLE_BINARY_SEMAPHORES(SYSTEM_TABLE_DECLARE_SEMAPHORE)
+SYSTEM_TABLE_COUNTING_SEMAPHORES(SYSTEM_TABLE_DECLARE_COUNTING_SEMAPHORE)
+SYSTEM_TABLE_MUTEXES(SYSTEM_TABLE_DECLARE_SEMAPHORE)
+SYSTEM_TABLE_EVENT_GROUPS(SYSTEM_TABLE_DECLARE_EVENT_GROUP)
+SYSTEM_TABLE_STREAM_BUFFERS(SYSTEM_TABLE_DECLARE_STREAM_BUFFER)
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* Functions implementing the tasks listed in SYSTEM_TABLE_TASKS. */
+void StartDefaultTask(void const * argument);
+
+void SystemTable_Init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SYSTEM_TABLE_H */
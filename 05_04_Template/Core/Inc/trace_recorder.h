@@ -0,0 +1,176 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : trace_recorder.h
+  * @brief          : Binary recorder for the FreeRTOS trace macros.
+  ******************************************************************************
+  * @attention
+  *
+  * Included from FreeRTOSConfig.h when configUSE_TRACE_RECORDER is defined to
+  * 1 on the compiler command line (Project > Properties > C/C++ Build >
+  * Settings > MCU GCC Compiler > Preprocessor), so the trace macros below
+  * replace the empty defaults in FreeRTOS.h.  Each macro
+  * writes one 8 byte event into a RAM ring buffer, and the buffer is streamed
+  * out of USART2 (PA2) by DMA1 Stream 6 in the background.  While the recorder
+  * is enabled USART2 must not be used for anything else.
+  *
+  * Utilities/trace_to_json.py converts the captured byte stream into a Chrome
+  * trace JSON file that can be opened in Perfetto (ui.perfetto.dev) or in
+  * chrome://tracing.
+  *
+  * At 115200 baud the link carries about 1400 events per second.  Events that
+  * do not fit in the buffer are dropped and counted rather than blocking the
+  * kernel, so raise the baud rate in MX_USART2_UART_Init() if the decoder
+  * reports drops.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TRACE_RECORDER_H
+#define __TRACE_RECORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* One recorded event.  ucEvent is written last and is cleared again once the
+   event has been sent, so a non-zero ucEvent marks a complete record. */
+typedef struct
+{
+  uint32_t ulTimestamp;       /* DWT cycle counter when the event occurred. */
+  uint16_t usObject;          /* Task or queue the event refers to, see TRACE_OBJECT_ID(). */
+  uint8_t ucArg;              /* Event specific argument, saturated at 255. */
+  volatile uint8_t ucEvent;   /* One of the TRACE_EVT_ values. */
+} TraceEvent_t;
+
+/* Exported constants --------------------------------------------------------*/
+/* Number of events the ring buffer holds.  Must be a power of two. */
+#ifndef TRACE_RECORDER_BUFFER_EVENTS
+#define TRACE_RECORDER_BUFFER_EVENTS    512U
+#endif
+
+/* A TRACE_EVT_HEADER event is written every TRACE_RECORDER_SYNC_TICKS ticks so
+   the decoder can find the record boundaries in a stream it joined part way
+   through, and so gaps never hide a wrap of the 32-bit cycle counter. */
+#ifndef TRACE_RECORDER_SYNC_TICKS
+#define TRACE_RECORDER_SYNC_TICKS       1024U
+#endif
+
+#define TRACE_RECORDER_MAGIC            0x5254U   /* "TR" */
+#define TRACE_RECORDER_VERSION          1U
+
+/* Objects are identified by their word offset into SRAM, which fits the
+   128 KB of the STM32F411 in 16 bits.  TRACE_OBJECT_NONE stands for NULL. */
+#define TRACE_RECORDER_RAM_BASE         0x20000000UL
+#define TRACE_OBJECT_NONE               0xFFFFU
+
+/* Event identifiers.  Keep in step with Utilities/trace_to_json.py. */
+#define TRACE_EVT_NONE                  0U
+#define TRACE_EVT_HEADER                1U   /* usObject: magic, ucArg: version */
+#define TRACE_EVT_DROPPED               2U   /* ucArg: events lost since the last report */
+#define TRACE_EVT_NAME                  3U   /* ulTimestamp: 4 name characters, ucArg: offset */
+#define TRACE_EVT_TASK_CREATE           4U   /* ucArg: priority */
+#define TRACE_EVT_TASK_DELETE           5U
+#define TRACE_EVT_TASK_SWITCHED_IN      6U   /* ucArg: priority */
+#define TRACE_EVT_TASK_READY            7U
+#define TRACE_EVT_TASK_DELAY            8U
+#define TRACE_EVT_TASK_SUSPEND          9U
+#define TRACE_EVT_TASK_RESUME           10U
+#define TRACE_EVT_TASK_PRIORITY_SET     11U  /* ucArg: new priority */
+#define TRACE_EVT_TASK_PRIORITY_INHERIT 12U  /* ucArg: inherited priority */
+#define TRACE_EVT_TASK_NOTIFY           13U
+#define TRACE_EVT_TASK_NOTIFY_FROM_ISR  14U
+#define TRACE_EVT_TASK_NOTIFY_WAIT      15U
+#define TRACE_EVT_QUEUE_CREATE          16U  /* ucArg: length */
+#define TRACE_EVT_MUTEX_CREATE          17U
+#define TRACE_EVT_QUEUE_SEND            18U  /* ucArg: items waiting before the send */
+#define TRACE_EVT_QUEUE_SEND_FROM_ISR   19U
+#define TRACE_EVT_QUEUE_SEND_FAILED     20U
+#define TRACE_EVT_QUEUE_RECEIVE         21U  /* ucArg: items waiting before the receive */
+#define TRACE_EVT_QUEUE_RECEIVE_FROM_ISR 22U
+#define TRACE_EVT_QUEUE_RECEIVE_FAILED  23U
+#define TRACE_EVT_QUEUE_BLOCK_SEND      24U
+#define TRACE_EVT_QUEUE_BLOCK_RECEIVE   25U
+
+/* Exported functions prototypes ---------------------------------------------*/
+void TraceRecorder_Init(void);
+void TraceRecorder_Event(uint8_t ucEvent, const void *pvObject, uint32_t ulArg);
+void TraceRecorder_Name(const void *pvObject, const char *pcName);
+void TraceRecorder_Tick(uint32_t ulTickCount);
+void TraceRecorder_IRQHandler(void);
+
+/* Kernel trace macros -------------------------------------------------------*/
+/* The macros are expanded inside tasks.c and queue.c, where pxCurrentTCB and
+   the TCB_t and Queue_t members are visible. */
+#define traceTASK_SWITCHED_IN() \
+  TraceRecorder_Event(TRACE_EVT_TASK_SWITCHED_IN, pxCurrentTCB, pxCurrentTCB->uxPriority)
+#define traceTASK_CREATE(pxNewTCB)                                                    \
+  do {                                                                                \
+    TraceRecorder_Event(TRACE_EVT_TASK_CREATE, (pxNewTCB), (pxNewTCB)->uxPriority);   \
+    TraceRecorder_Name((pxNewTCB), (pxNewTCB)->pcTaskName);                           \
+  } while (0)
+#define traceTASK_DELETE(pxTaskToDelete) \
+  TraceRecorder_Event(TRACE_EVT_TASK_DELETE, (pxTaskToDelete), 0U)
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) \
+  TraceRecorder_Event(TRACE_EVT_TASK_READY, (pxTCB), 0U)
+#define traceTASK_DELAY() \
+  TraceRecorder_Event(TRACE_EVT_TASK_DELAY, pxCurrentTCB, 0U)
+#define traceTASK_DELAY_UNTIL(xTimeToWake) \
+  TraceRecorder_Event(TRACE_EVT_TASK_DELAY, pxCurrentTCB, 0U)
+#define traceTASK_SUSPEND(pxTaskToSuspend) \
+  TraceRecorder_Event(TRACE_EVT_TASK_SUSPEND, (pxTaskToSuspend), 0U)
+#define traceTASK_RESUME(pxTaskToResume) \
+  TraceRecorder_Event(TRACE_EVT_TASK_RESUME, (pxTaskToResume), 0U)
+#define traceTASK_RESUME_FROM_ISR(pxTaskToResume) \
+  TraceRecorder_Event(TRACE_EVT_TASK_RESUME, (pxTaskToResume), 0U)
+#define traceTASK_PRIORITY_SET(pxTask, uxNewPriority) \
+  TraceRecorder_Event(TRACE_EVT_TASK_PRIORITY_SET, (pxTask), (uxNewPriority))
+#define traceTASK_PRIORITY_INHERIT(pxTCBOfMutexHolder, uxInheritedPriority) \
+  TraceRecorder_Event(TRACE_EVT_TASK_PRIORITY_INHERIT, (pxTCBOfMutexHolder), (uxInheritedPriority))
+#define traceTASK_NOTIFY() \
+  TraceRecorder_Event(TRACE_EVT_TASK_NOTIFY, pxTCB, 0U)
+#define traceTASK_NOTIFY_FROM_ISR() \
+  TraceRecorder_Event(TRACE_EVT_TASK_NOTIFY_FROM_ISR, pxTCB, 0U)
+#define traceTASK_NOTIFY_GIVE_FROM_ISR() \
+  TraceRecorder_Event(TRACE_EVT_TASK_NOTIFY_FROM_ISR, pxTCB, 0U)
+#define traceTASK_NOTIFY_TAKE_BLOCK() \
+  TraceRecorder_Event(TRACE_EVT_TASK_NOTIFY_WAIT, pxCurrentTCB, 0U)
+#define traceTASK_NOTIFY_WAIT_BLOCK() \
+  TraceRecorder_Event(TRACE_EVT_TASK_NOTIFY_WAIT, pxCurrentTCB, 0U)
+#define traceTASK_INCREMENT_TICK(xTickCount) \
+  TraceRecorder_Tick((uint32_t) (xTickCount))
+
+#define traceQUEUE_CREATE(pxNewQueue) \
+  TraceRecorder_Event(TRACE_EVT_QUEUE_CREATE, (pxNewQueue), (pxNewQueue)->uxLength)
+#define traceCREATE_MUTEX(pxNewQueue) \
+  TraceRecorder_Event(TRACE_EVT_MUTEX_CREATE, (pxNewQueue), 0U)
+#define traceQUEUE_REGISTRY_ADD(xQueue, pcQueueName) \
+  TraceRecorder_Name((xQueue), (pcQueueName))
+#define traceQUEUE_SEND(pxQueue) \
+  TraceRecorder_Event(TRACE_EVT_QUEUE_SEND, (pxQueue), (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+  TraceRecorder_Event(TRACE_EVT_QUEUE_SEND_FROM_ISR, (pxQueue), (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND_FAILED(pxQueue) \
+  TraceRecorder_Event(TRACE_EVT_QUEUE_SEND_FAILED, (pxQueue), (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE(pxQueue) \
+  TraceRecorder_Event(TRACE_EVT_QUEUE_RECEIVE, (pxQueue), (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+  TraceRecorder_Event(TRACE_EVT_QUEUE_RECEIVE_FROM_ISR, (pxQueue), (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) \
+  TraceRecorder_Event(TRACE_EVT_QUEUE_RECEIVE_FAILED, (pxQueue), (pxQueue)->uxMessagesWaiting)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+  TraceRecorder_Event(TRACE_EVT_QUEUE_BLOCK_SEND, (pxQueue), (pxQueue)->uxMessagesWaiting)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+  TraceRecorder_Event(TRACE_EVT_QUEUE_BLOCK_RECEIVE, (pxQueue), (pxQueue)->uxMessagesWaiting)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TRACE_RECORDER_H */
@@ -68,6 +68,108 @@ void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackTy
 }
 /* USER CODE END GET_IDLE_TASK_MEMORY */
 
+#if (configUSE_TIMERS == 1)
+/* GetTimerTaskMemory prototype (linked to static allocation support) */
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
+
+/* USER CODE BEGIN GET_TIMER_TASK_MEMORY */
+static StaticTask_t xTimerTaskTCBBuffer;
+static StackType_t xTimerStack[configTIMER_TASK_STACK_DEPTH];
+
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+{
+  *ppxTimerTaskTCBBuffer = &xTimerTaskTCBBuffer;
+  *ppxTimerTaskStackBuffer = &xTimerStack[0];
+  *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+  /* place for user code */
+}
+/* USER CODE END GET_TIMER_TASK_MEMORY */
+#endif /* configUSE_TIMERS */
+
+/* USER CODE BEGIN PREPOSTSLEEP */
+extern TIM_HandleTypeDef htim11;
+
+/* TIM11 count, and whether an update was still to be counted, when the sleep
+   started. */
+static uint32_t ulSleepStartCount;
+static uint32_t ulSleepStartPending;
+
+/**
+  * @brief  Read the TIM11 count and its update flag as a consistent pair.
+  * @note   Interrupts are masked, so a set flag is an update that uwTick does
+  *         not yet include.  If the flag changes between the two reads of it
+  *         the count has just wrapped, and both are read again.
+  */
+static void prvReadTimeBase(uint32_t *pulCount, uint32_t *pulPending)
+{
+  uint32_t ulPending;
+
+  do
+  {
+    ulPending = (__HAL_TIM_GET_FLAG(&htim11, TIM_FLAG_UPDATE) != RESET) ? 1U : 0U;
+    *pulCount = __HAL_TIM_GET_COUNTER(&htim11);
+    *pulPending = (__HAL_TIM_GET_FLAG(&htim11, TIM_FLAG_UPDATE) != RESET) ? 1U : 0U;
+  } while (*pulPending != ulPending);
+}
+
+void PreSleepProcessing(uint32_t ulExpectedIdleTime)
+{
+  /* TIM11 provides the HAL time base and would wake the core every
+     millisecond.  Mask its update interrupt for the duration of the sleep but
+     leave it counting, so PostSleepProcessing() can tell how many
+     milliseconds went by. */
+  HAL_SuspendTick();
+  prvReadTimeBase(&ulSleepStartCount, &ulSleepStartPending);
+}
+
+void PostSleepProcessing(uint32_t ulExpectedIdleTime)
+{
+  uint32_t ulCount;
+  uint32_t ulPending;
+  uint32_t ulPeriod = __HAL_TIM_GET_AUTORELOAD(&htim11) + 1U;
+  uint32_t ulSlept;
+  uint32_t ulUpdates;
+
+  /* The port restarted the SysTick from 0 with the sleep's reload value just
+     before PreSleepProcessing().  With interrupts masked, a pending SysTick
+     means it has counted down once already and reloaded. */
+  ulSlept = SysTick->LOAD - SysTick->VAL;
+  if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0U)
+  {
+    ulSlept += SysTick->LOAD + 1U;
+  }
+  ulSlept /= SystemCoreClock / 1000000U;
+
+  /* TIM11 counts at 1 MHz, so the count gives the part period exactly and the
+     SysTick, which is a few cycles out, only has to pick the number of whole
+     periods. */
+  prvReadTimeBase(&ulCount, &ulPending);
+  ulUpdates = ((ulSleepStartCount + ulSlept + ulPeriod + (ulPeriod / 2U) - ulCount) / ulPeriod) - 1U;
+  ulUpdates += ulSleepStartPending;
+
+  /* The update that latched, if any, is counted by the TIM11 interrupt as
+     soon as it is unmasked. */
+  if (ulUpdates > ulPending)
+  {
+    uwTick += (ulUpdates - ulPending) * (uint32_t) uwTickFreq;
+  }
+  HAL_ResumeTick();
+}
+/* USER CODE END PREPOSTSLEEP */
+
+/* USER CODE BEGIN 4 */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+  /* Called from MemManage_Handler() when a task writes into the MPU guard at
+     the end of its stack.  The task cannot continue, so halt here with xTask
+     and pcTaskName identifying it to the debugger. */
+  (void) xTask;
+  (void) pcTaskName;
+  taskDISABLE_INTERRUPTS();
+  for (;;);
+}
+/* USER CODE END 4 */
+
 /* Private application code --------------------------------------------------*/
 /* USER CODE BEGIN Application */
 
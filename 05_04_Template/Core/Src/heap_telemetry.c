@@ -0,0 +1,159 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : heap_telemetry.c
+  * @brief          : Binary dump of the heap_4 telemetry over a UART.
+  ******************************************************************************
+  * @attention
+  *
+  * Payload layout, every field an unsigned LEB128 number.  Keep in step with
+  * Utilities/heap_telemetry_decode.py.
+  *
+  *   configTOTAL_HEAP_SIZE, SystemCoreClock, tick count,
+  *   heapTELEMETRY_BUCKETS, heapTELEMETRY_BUCKET_SHIFT,
+  *   free block histogram, malloc cycle histogram, free cycle histogram,
+  *   max malloc cycles, max free cycles,
+  *   free bytes, largest free block, fragmentation, worst fragmentation,
+  *   failures, number of failure records that follow,
+  *   per record: caller, wanted size, free bytes, largest free block, tick
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "heap_telemetry.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_HEAP_TELEMETRY == 1)
+
+/* Private define ------------------------------------------------------------*/
+#define HEAP_TELEMETRY_HEADER_SIZE      5U    /* magic, version, length */
+#define HEAP_TELEMETRY_CHECKSUM_SIZE    2U
+
+/* Number of fields in the payload, each at most 5 bytes long as a LEB128
+   encoded 32-bit value. */
+#define HEAP_TELEMETRY_FIELDS           (16U + (3U * heapTELEMETRY_BUCKETS) + (5U * heapTELEMETRY_FAILURE_RECORDS))
+#define HEAP_TELEMETRY_FRAME_SIZE       (HEAP_TELEMETRY_HEADER_SIZE + (5U * HEAP_TELEMETRY_FIELDS) + \
+                                         HEAP_TELEMETRY_CHECKSUM_SIZE)
+
+#define HEAP_TELEMETRY_TIMEOUT_MS       1000U
+
+/* Private variables ---------------------------------------------------------*/
+/* The frame is built here rather than on the stack of the caller, which may
+   be a task with little stack left after an allocation failed. */
+static uint8_t ucHeapTelemetryFrame[HEAP_TELEMETRY_FRAME_SIZE];
+static HeapTelemetry_t xHeapTelemetry;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t prvPutNumber(uint32_t ulOffset, uint32_t ulValue);
+static uint32_t prvPutHistogram(uint32_t ulOffset, const uint32_t *pulBuckets);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Send a snapshot of the heap telemetry as one frame.
+  * @note   Not reentrant, as the frame is built in a static buffer.  Call from
+  *         a task, not from an interrupt.
+  * @param  huart: Initialised UART to send the frame on.
+  * @retval Status of the transmission.
+  */
+HAL_StatusTypeDef HeapTelemetry_Dump(UART_HandleTypeDef *huart)
+{
+  uint32_t ulOffset = HEAP_TELEMETRY_HEADER_SIZE;
+  uint32_t ulRecords;
+  uint32_t ulLength;
+  uint32_t ulSum1 = 0U;
+  uint32_t ulSum2 = 0U;
+  uint32_t i;
+
+  vPortGetHeapTelemetry(&xHeapTelemetry);
+
+  ulOffset = prvPutNumber(ulOffset, (uint32_t) configTOTAL_HEAP_SIZE);
+  ulOffset = prvPutNumber(ulOffset, SystemCoreClock);
+  ulOffset = prvPutNumber(ulOffset, (uint32_t) xTaskGetTickCount());
+  ulOffset = prvPutNumber(ulOffset, heapTELEMETRY_BUCKETS);
+  ulOffset = prvPutNumber(ulOffset, heapTELEMETRY_BUCKET_SHIFT);
+  ulOffset = prvPutHistogram(ulOffset, xHeapTelemetry.ulFreeBlocks);
+  ulOffset = prvPutHistogram(ulOffset, xHeapTelemetry.ulMallocCycles);
+  ulOffset = prvPutHistogram(ulOffset, xHeapTelemetry.ulFreeCycles);
+  ulOffset = prvPutNumber(ulOffset, xHeapTelemetry.ulMaxMallocCycles);
+  ulOffset = prvPutNumber(ulOffset, xHeapTelemetry.ulMaxFreeCycles);
+  ulOffset = prvPutNumber(ulOffset, (uint32_t) xHeapTelemetry.xFreeBytes);
+  ulOffset = prvPutNumber(ulOffset, (uint32_t) xHeapTelemetry.xLargestFreeBlock);
+  ulOffset = prvPutNumber(ulOffset, xHeapTelemetry.ulFragmentation);
+  ulOffset = prvPutNumber(ulOffset, xHeapTelemetry.ulWorstFragmentation);
+  ulOffset = prvPutNumber(ulOffset, xHeapTelemetry.ulFailures);
+
+  ulRecords = (xHeapTelemetry.ulFailures < heapTELEMETRY_FAILURE_RECORDS) ?
+              xHeapTelemetry.ulFailures : heapTELEMETRY_FAILURE_RECORDS;
+  ulOffset = prvPutNumber(ulOffset, ulRecords);
+
+  for (i = 0U; i < ulRecords; i++)
+  {
+    ulOffset = prvPutNumber(ulOffset, (uint32_t) xHeapTelemetry.xFailures[i].pvCaller);
+    ulOffset = prvPutNumber(ulOffset, (uint32_t) xHeapTelemetry.xFailures[i].xWantedSize);
+    ulOffset = prvPutNumber(ulOffset, (uint32_t) xHeapTelemetry.xFailures[i].xFreeBytes);
+    ulOffset = prvPutNumber(ulOffset, (uint32_t) xHeapTelemetry.xFailures[i].xLargestFreeBlock);
+    ulOffset = prvPutNumber(ulOffset, (uint32_t) xHeapTelemetry.xFailures[i].xTickCount);
+  }
+
+  ulLength = ulOffset - HEAP_TELEMETRY_HEADER_SIZE;
+  ucHeapTelemetryFrame[0] = HEAP_TELEMETRY_MAGIC_0;
+  ucHeapTelemetryFrame[1] = HEAP_TELEMETRY_MAGIC_1;
+  ucHeapTelemetryFrame[2] = HEAP_TELEMETRY_VERSION;
+  ucHeapTelemetryFrame[3] = (uint8_t) ulLength;
+  ucHeapTelemetryFrame[4] = (uint8_t) (ulLength >> 8);
+
+  /* Fletcher-16 over the payload, so the decoder can tell a frame from
+     unrelated output that happens to contain the magic. */
+  for (i = HEAP_TELEMETRY_HEADER_SIZE; i < ulOffset; i++)
+  {
+    ulSum1 = (ulSum1 + ucHeapTelemetryFrame[i]) % 255U;
+    ulSum2 = (ulSum2 + ulSum1) % 255U;
+  }
+  ucHeapTelemetryFrame[ulOffset++] = (uint8_t) ulSum1;
+  ucHeapTelemetryFrame[ulOffset++] = (uint8_t) ulSum2;
+
+  return HAL_UART_Transmit(huart, ucHeapTelemetryFrame, (uint16_t) ulOffset, HEAP_TELEMETRY_TIMEOUT_MS);
+}
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Append ulValue to the frame as an unsigned LEB128 number.
+  * @param  ulOffset: Where in the frame to write.
+  * @param  ulValue: Value to write.
+  * @retval Offset just past the number.
+  */
+static uint32_t prvPutNumber(uint32_t ulOffset, uint32_t ulValue)
+{
+  while (ulValue >= 0x80U)
+  {
+    ucHeapTelemetryFrame[ulOffset++] = (uint8_t) (ulValue | 0x80U);
+    ulValue >>= 7;
+  }
+  ucHeapTelemetryFrame[ulOffset++] = (uint8_t) ulValue;
+
+  return ulOffset;
+}
+
+/**
+  * @brief  Append the heapTELEMETRY_BUCKETS counts of a histogram.
+  * @param  ulOffset: Where in the frame to write.
+  * @param  pulBuckets: Counts to write.
+  * @retval Offset just past the histogram.
+  */
+static uint32_t prvPutHistogram(uint32_t ulOffset, const uint32_t *pulBuckets)
+{
+  uint32_t i;
+
+  for (i = 0U; i < heapTELEMETRY_BUCKETS; i++)
+  {
+    ulOffset = prvPutNumber(ulOffset, pulBuckets[i]);
+  }
+
+  return ulOffset;
+}
+
+#endif /* configUSE_HEAP_TELEMETRY */
@@ -0,0 +1,678 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : latency_bench.c
+  * @brief          : Interrupt to task wake latency benchmark.
+  ******************************************************************************
+  * @attention
+  *
+  * One waiter task per primitive blocks on its primitive at a priority above
+  * everything else in the benchmark.  For each sample the control task arms
+  * the load tasks and waits; the load task that reaches the randomly chosen
+  * point timestamps and pends LATENCY_BENCH_IRQn, the interrupt gives the
+  * primitive and requests a context switch, and the woken waiter timestamps
+  * again and hands the difference back to the control task.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "latency_bench.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+
+#if defined(LATENCY_BENCH)
+
+#if (configUSE_TIMERS != 1) || (INCLUDE_xTimerPendFunctionCall != 1)
+#error The event group measurement needs configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall set to 1.
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  BENCH_NOTIFY = 0,
+  BENCH_SEMAPHORE,
+  BENCH_QUEUE,
+  BENCH_EVENT_GROUP,
+  BENCH_STREAM_BUFFER,
+  BENCH_PRIMITIVES
+} BenchPrimitive_t;
+
+/* Private define ------------------------------------------------------------*/
+/* The timer task, which runs the deferred half of xEventGroupSetBitsFromISR(),
+   sits above the waiters so the event group path is not penalised twice. */
+#define BENCH_WAITER_PRIORITY      (configMAX_PRIORITIES - 2)
+#define BENCH_CONTROL_PRIORITY     (configMAX_PRIORITIES - 3)
+#define BENCH_LOAD_PRIORITY        (tskIDLE_PRIORITY + 1)
+#define BENCH_STACK_DEPTH          ((uint16_t) 256)
+#define BENCH_EVENT_BIT            ((EventBits_t) 0x01)
+#define BENCH_ARM_RANGE            1024U
+#define BENCH_SAMPLE_TIMEOUT       pdMS_TO_TICKS(1000)
+#define BENCH_HISTOGRAM_BUCKETS    32U
+#define BENCH_HISTOGRAM_WIDTH      40U
+#define BENCH_DELAY_MIN_US         20U
+#define BENCH_DELAY_RANGE_US       2000U
+
+#if defined(LATENCY_BENCH_QEMU)
+#define BENCH_SEMIHOSTING_WRITE0   0x04U
+#define BENCH_SEMIHOSTING_EXIT     0x18U
+#define BENCH_SEMIHOSTING_EXIT_OK  0x20026U   /* ADP_Stopped_ApplicationExit */
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+extern UART_HandleTypeDef huart2;
+
+static const char * const pcBenchNames[BENCH_PRIMITIVES] =
+{
+  "task notification",
+  "binary semaphore",
+  "queue",
+  "event group",
+  "stream buffer"
+};
+
+static TaskHandle_t xBenchControlTask;
+static TaskHandle_t xBenchYieldTask;
+static TaskHandle_t xBenchWaiters[BENCH_PRIMITIVES];
+static SemaphoreHandle_t xBenchSemaphore;
+static QueueHandle_t xBenchQueue;
+static EventGroupHandle_t xBenchEvents;
+static StreamBufferHandle_t xBenchStream;
+
+static volatile BenchPrimitive_t eBenchPrimitive;
+static volatile uint32_t ulBenchCountdown;   /* Load iterations left before pending, 0 when disarmed. */
+static volatile uint32_t ulBenchStart;
+static volatile uint32_t ulBenchLatency;
+static uint32_t ulBenchUseCycleCounter;
+static uint32_t ulBenchRandom = 0x2545F491U;
+static uint32_t ulBenchSamples[LATENCY_BENCH_SAMPLES];
+static char cBenchLine[96];
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvBenchControlTask(void *pvParameters);
+static void prvBenchWaiterTask(void *pvParameters);
+static void prvBenchYieldTask(void *pvParameters);
+static void prvBenchArm(void);
+static uint32_t prvBenchRandom(void);
+#if (configUSE_MICROSECOND_DELAYS == 1) && !defined(LATENCY_BENCH_QEMU)
+static void prvBenchMicrosecondDelays(void);
+#endif
+static void prvBenchSwitches(void);
+static void prvBenchPend(void);
+#if (LATENCY_BENCH_LOAD_TASKS > 0)
+static void prvBenchLoadTask(void *pvParameters);
+static void prvBenchPoll(void);
+#endif
+static uint32_t prvBenchNow(void);
+static void prvBenchSort(uint32_t ulCount);
+static void prvBenchReport(BenchPrimitive_t ePrimitive, uint32_t ulCount);
+static void prvBenchPrintf(const char *pcFormat, ...);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Create the benchmark tasks and objects.
+  * @note   Call before the scheduler is started.
+  * @retval None
+  */
+void LatencyBench_Init(void)
+{
+  uint32_t ulBefore;
+  uint32_t i;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  ulBefore = DWT->CYCCNT;
+  for (i = 0U; i < 16U; i++)
+  {
+    __NOP();
+  }
+  ulBenchUseCycleCounter = (DWT->CYCCNT != ulBefore) ? 1U : 0U;
+
+  xBenchSemaphore = xSemaphoreCreateBinary();
+  xBenchQueue = xQueueCreate(1U, sizeof(uint32_t));
+  xBenchEvents = xEventGroupCreate();
+  xBenchStream = xStreamBufferCreate(2U * sizeof(uint32_t), sizeof(uint32_t));
+  configASSERT(xBenchSemaphore);
+  configASSERT(xBenchQueue);
+  configASSERT(xBenchEvents);
+  configASSERT(xBenchStream);
+
+  for (i = 0U; i < (uint32_t) BENCH_PRIMITIVES; i++)
+  {
+    if (xTaskCreate(prvBenchWaiterTask, "BenchWait", BENCH_STACK_DEPTH / 2U, (void *) i,
+                    BENCH_WAITER_PRIORITY, &xBenchWaiters[i]) != pdPASS)
+    {
+      Error_Handler();
+    }
+  }
+
+#if (LATENCY_BENCH_LOAD_TASKS > 0)
+  for (i = 0U; i < LATENCY_BENCH_LOAD_TASKS; i++)
+  {
+    if (xTaskCreate(prvBenchLoadTask, "BenchLoad", BENCH_STACK_DEPTH / 2U, NULL,
+                    BENCH_LOAD_PRIORITY, NULL) != pdPASS)
+    {
+      Error_Handler();
+    }
+  }
+#endif
+
+  if (xTaskCreate(prvBenchControlTask, "BenchCtrl", BENCH_STACK_DEPTH, NULL,
+                  BENCH_CONTROL_PRIORITY, &xBenchControlTask) != pdPASS)
+  {
+    Error_Handler();
+  }
+
+  if (xTaskCreate(prvBenchYieldTask, "BenchYield", BENCH_STACK_DEPTH / 2U, NULL,
+                  BENCH_CONTROL_PRIORITY, &xBenchYieldTask) != pdPASS)
+  {
+    Error_Handler();
+  }
+
+  /* The interrupt calls FreeRTOS API functions, so it must not be above
+     configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY. */
+  HAL_NVIC_SetPriority(LATENCY_BENCH_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 0U);
+  HAL_NVIC_EnableIRQ(LATENCY_BENCH_IRQn);
+}
+
+/**
+  * @brief  LATENCY_BENCH_IRQn handler: wake the waiter of the primitive under
+  *         test.
+  * @retval None
+  */
+void LatencyBench_IRQHandler(void)
+{
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  uint32_t ulStart = ulBenchStart;
+
+  switch (eBenchPrimitive)
+  {
+    case BENCH_NOTIFY:
+      vTaskNotifyGiveFromISR(xBenchWaiters[BENCH_NOTIFY], &xHigherPriorityTaskWoken);
+      break;
+
+    case BENCH_SEMAPHORE:
+      (void) xSemaphoreGiveFromISR(xBenchSemaphore, &xHigherPriorityTaskWoken);
+      break;
+
+    case BENCH_QUEUE:
+      (void) xQueueSendFromISR(xBenchQueue, &ulStart, &xHigherPriorityTaskWoken);
+      break;
+
+    case BENCH_EVENT_GROUP:
+      (void) xEventGroupSetBitsFromISR(xBenchEvents, BENCH_EVENT_BIT, &xHigherPriorityTaskWoken);
+      break;
+
+    case BENCH_STREAM_BUFFER:
+      (void) xStreamBufferSendFromISR(xBenchStream, &ulStart, sizeof(ulStart), &xHigherPriorityTaskWoken);
+      break;
+
+    default:
+      break;
+  }
+
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void prvBenchControlTask(void *pvParameters)
+{
+  BenchPrimitive_t ePrimitive;
+  uint32_t ulCount;
+
+  (void) pvParameters;
+
+  prvBenchPrintf("\r\nwake latency: %lu samples, %lu load tasks, core clock %lu Hz, %s\r\n",
+                 (unsigned long) LATENCY_BENCH_SAMPLES, (unsigned long) LATENCY_BENCH_LOAD_TASKS,
+                 (unsigned long) SystemCoreClock,
+                 (ulBenchUseCycleCounter != 0U) ? "DWT cycle counter" : "SysTick counter");
+
+  for (ePrimitive = BENCH_NOTIFY; ePrimitive < BENCH_PRIMITIVES; ePrimitive++)
+  {
+    eBenchPrimitive = ePrimitive;
+
+    for (ulCount = 0U; ulCount < LATENCY_BENCH_SAMPLES; ulCount++)
+    {
+      prvBenchArm();
+      if (ulTaskNotifyTake(pdTRUE, BENCH_SAMPLE_TIMEOUT) == 0U)
+      {
+        prvBenchPrintf("%s: no wake-up, giving up\r\n", pcBenchNames[ePrimitive]);
+        ulBenchCountdown = 0U;
+        break;
+      }
+      ulBenchSamples[ulCount] = ulBenchLatency;
+    }
+
+    prvBenchReport(ePrimitive, ulCount);
+  }
+
+#if (configUSE_MICROSECOND_DELAYS == 1)
+#if defined(LATENCY_BENCH_QEMU)
+  /* QEMU counts TIM5 but never raises its compare interrupt, so every delay
+     would run on to the tick backstop. */
+  prvBenchPrintf("\r\nmicrosecond delays: skipped, no TIM5 compare interrupt under QEMU\r\n");
+#else
+  prvBenchMicrosecondDelays();
+#endif
+#endif
+
+  prvBenchSwitches();
+
+  prvBenchPrintf("done\r\n");
+
+#if defined(LATENCY_BENCH_QEMU)
+  {
+    register uint32_t r0 __asm("r0") = BENCH_SEMIHOSTING_EXIT;
+    register uint32_t r1 __asm("r1") = BENCH_SEMIHOSTING_EXIT_OK;
+    __asm volatile ("bkpt 0xAB" : "+r" (r0) : "r" (r1) : "memory");
+  }
+#endif
+
+  vTaskSuspend(NULL);
+}
+
+static void prvBenchWaiterTask(void *pvParameters)
+{
+  const BenchPrimitive_t ePrimitive = (BenchPrimitive_t) (uint32_t) pvParameters;
+  uint32_t ulValue;
+  uint32_t ulEnd = 0U;
+
+  for (;;)
+  {
+    /* Each case takes its timestamp as soon as the blocking call returns. */
+    switch (ePrimitive)
+    {
+      case BENCH_NOTIFY:
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        ulEnd = prvBenchNow();
+        break;
+
+      case BENCH_SEMAPHORE:
+        (void) xSemaphoreTake(xBenchSemaphore, portMAX_DELAY);
+        ulEnd = prvBenchNow();
+        break;
+
+      case BENCH_QUEUE:
+        (void) xQueueReceive(xBenchQueue, &ulValue, portMAX_DELAY);
+        ulEnd = prvBenchNow();
+        break;
+
+      case BENCH_EVENT_GROUP:
+        (void) xEventGroupWaitBits(xBenchEvents, BENCH_EVENT_BIT, pdTRUE, pdFALSE, portMAX_DELAY);
+        ulEnd = prvBenchNow();
+        break;
+
+      case BENCH_STREAM_BUFFER:
+        (void) xStreamBufferReceive(xBenchStream, &ulValue, sizeof(ulValue), portMAX_DELAY);
+        ulEnd = prvBenchNow();
+        break;
+
+      default:
+        vTaskSuspend(NULL);
+        break;
+    }
+
+    ulBenchLatency = ulEnd - ulBenchStart;
+    xTaskNotifyGive(xBenchControlTask);
+  }
+}
+
+/**
+  * @brief  Yields back to the control task, which shares its priority, once
+  *         for every yield of the control task's context switch run.
+  */
+static void prvBenchYieldTask(void *pvParameters)
+{
+  uint32_t i;
+
+  (void) pvParameters;
+
+  for (;;)
+  {
+    (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    for (i = 0U; i < LATENCY_BENCH_SWITCH_ROUNDS; i++)
+    {
+      taskYIELD();
+    }
+  }
+}
+
+#if (LATENCY_BENCH_LOAD_TASKS > 0)
+static void prvBenchLoadTask(void *pvParameters)
+{
+  volatile uint32_t ulWork[16];
+  uint32_t ulIteration = 0U;
+  uint32_t i;
+
+  (void) pvParameters;
+
+  for (;;)
+  {
+    for (i = 0U; i < 16U; i++)
+    {
+      ulWork[i] += i ^ ulIteration;
+    }
+    prvBenchPoll();
+    ulIteration++;
+
+#if (LATENCY_BENCH_CRITICAL_PERIOD > 0)
+    if ((ulIteration % LATENCY_BENCH_CRITICAL_PERIOD) == 0U)
+    {
+      /* An interrupt pended in here is held off until the critical section
+         ends, as a peripheral interrupt would be. */
+      taskENTER_CRITICAL();
+      for (i = 0U; i < LATENCY_BENCH_CRITICAL_LENGTH; i++)
+      {
+        ulWork[i & 15U]++;
+        prvBenchPoll();
+      }
+      taskEXIT_CRITICAL();
+    }
+#endif
+  }
+}
+
+#endif /* LATENCY_BENCH_LOAD_TASKS */
+
+/**
+  * @brief  Arrange for the next interrupt to be pended.
+  */
+static void prvBenchArm(void)
+{
+#if (LATENCY_BENCH_LOAD_TASKS > 0)
+  ulBenchCountdown = 1U + (prvBenchRandom() % BENCH_ARM_RANGE);
+#else
+  prvBenchPend();
+#endif
+}
+
+static uint32_t prvBenchRandom(void)
+{
+  /* xorshift32 */
+  ulBenchRandom ^= ulBenchRandom << 13;
+  ulBenchRandom ^= ulBenchRandom >> 17;
+  ulBenchRandom ^= ulBenchRandom << 5;
+
+  return ulBenchRandom;
+}
+
+#if (configUSE_MICROSECOND_DELAYS == 1) && !defined(LATENCY_BENCH_QEMU)
+/**
+  * @brief  Measure how late vTaskDelayMicroseconds() wakes the control task,
+  *         against the TIM5 count its wake time was set from.
+  * @note   The load tasks keep running, so a wake can be held off by one of
+  *         their critical sections.
+  */
+static void prvBenchMicrosecondDelays(void)
+{
+  uint64_t ullSum = 0U;
+  uint32_t ulDelay;
+  uint32_t ulWake;
+  uint32_t ulEarly = 0U;
+  uint32_t ulCount;
+
+  for (ulCount = 0U; ulCount < LATENCY_BENCH_SAMPLES; ulCount++)
+  {
+    ulDelay = BENCH_DELAY_MIN_US + (prvBenchRandom() % BENCH_DELAY_RANGE_US);
+    ulWake = MicrosecondTimer_Count() + ulDelay;
+    vTaskDelayMicroseconds(ulDelay);
+    ulBenchSamples[ulCount] = MicrosecondTimer_Count() - ulWake;
+
+    if ((int32_t) ulBenchSamples[ulCount] < 0)
+    {
+      ulEarly++;
+      ulBenchSamples[ulCount] = 0U;
+    }
+    ullSum += ulBenchSamples[ulCount];
+  }
+
+  prvBenchSort(ulCount);
+
+  prvBenchPrintf("\r\nmicrosecond delay of %lu to %lu us (%lu samples)\r\n",
+                 (unsigned long) BENCH_DELAY_MIN_US,
+                 (unsigned long) (BENCH_DELAY_MIN_US + BENCH_DELAY_RANGE_US - 1U), (unsigned long) ulCount);
+  prvBenchPrintf("  us late: min %lu avg %lu p99 %lu max %lu, %lu early\r\n",
+                 (unsigned long) ulBenchSamples[0], (unsigned long) (ullSum / ulCount),
+                 (unsigned long) ulBenchSamples[(ulCount * 99U) / 100U],
+                 (unsigned long) ulBenchSamples[ulCount - 1U], (unsigned long) ulEarly);
+}
+
+#endif /* configUSE_MICROSECOND_DELAYS && !LATENCY_BENCH_QEMU */
+
+/**
+  * @brief  Measure the cost of a context switch: the control task and the
+  *         yield task, both above the load tasks, yield to each other
+  *         LATENCY_BENCH_SWITCH_ROUNDS times, two switches a round.
+  * @note   The figure includes the taskYIELD() calls and the ticks that fall
+  *         in the run.  Subtract the figure of a build with
+  *         configGENERATE_RUN_TIME_CYCLE_STATS set to 0 from that of a build
+  *         with it set to 1 to get what the cycle accounting adds per switch.
+  */
+static void prvBenchSwitches(void)
+{
+  uint32_t ulStart;
+  uint32_t ulCycles;
+  uint32_t i;
+
+  /* The yield task becomes ready without preempting, and runs at the first
+     yield below. */
+  xTaskNotifyGive(xBenchYieldTask);
+
+  ulStart = prvBenchNow();
+  for (i = 0U; i < LATENCY_BENCH_SWITCH_ROUNDS; i++)
+  {
+    taskYIELD();
+  }
+  ulCycles = prvBenchNow() - ulStart;
+
+  prvBenchPrintf("\r\ncontext switch (%lu switches, run time cycle stats %lu)\r\n",
+                 (unsigned long) (2U * LATENCY_BENCH_SWITCH_ROUNDS),
+                 (unsigned long) configGENERATE_RUN_TIME_CYCLE_STATS);
+  prvBenchPrintf("  cycles per switch: %lu\r\n",
+                 (unsigned long) (ulCycles / (2U * LATENCY_BENCH_SWITCH_ROUNDS)));
+}
+
+#if (LATENCY_BENCH_LOAD_TASKS > 0)
+/**
+  * @brief  Called by the load tasks on every step of their work; the caller
+  *         that takes the countdown to zero pends the interrupt.
+  */
+static void prvBenchPoll(void)
+{
+  uint32_t ulCount = ulBenchCountdown;
+
+  while (ulCount != 0U)
+  {
+    if (__atomic_compare_exchange_n(&ulBenchCountdown, &ulCount, ulCount - 1U, pdFALSE,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED) != 0)
+    {
+      if (ulCount == 1U)
+      {
+        prvBenchPend();
+      }
+      break;
+    }
+  }
+}
+
+#endif /* LATENCY_BENCH_LOAD_TASKS */
+
+static void prvBenchPend(void)
+{
+  ulBenchStart = prvBenchNow();
+  NVIC_SetPendingIRQ(LATENCY_BENCH_IRQn);
+}
+
+/**
+  * @brief  Current time in core clock cycles.
+  * @note   Without a DWT cycle counter the time is rebuilt from the SysTick,
+  *         which the port clocks from the core clock and reloads every tick.
+  */
+static uint32_t prvBenchNow(void)
+{
+  uint32_t ulReload;
+  uint32_t ulCount;
+  uint32_t ulTicks;
+  UBaseType_t uxSavedInterruptStatus;
+
+  if (ulBenchUseCycleCounter != 0U)
+  {
+    return DWT->CYCCNT;
+  }
+
+  ulReload = SysTick->LOAD + 1U;
+  uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+  ulCount = SysTick->VAL;
+  ulTicks = (uint32_t) xTaskGetTickCountFromISR();
+  if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0U)
+  {
+    /* The counter has reloaded but the tick has not been counted yet. */
+    ulCount = SysTick->VAL;
+    ulTicks++;
+  }
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+  return (ulTicks * ulReload) + (ulReload - 1U - ulCount);
+}
+
+/**
+  * @brief  Sort the first ulCount samples into ascending order.
+  * @note   Insertion sort, which is quick enough for the sample counts used
+  *         here and needs no heap.
+  */
+static void prvBenchSort(uint32_t ulCount)
+{
+  uint32_t ulValue;
+  uint32_t i;
+  uint32_t j;
+
+  for (i = 1U; i < ulCount; i++)
+  {
+    ulValue = ulBenchSamples[i];
+    for (j = i; (j > 0U) && (ulBenchSamples[j - 1U] > ulValue); j--)
+    {
+      ulBenchSamples[j] = ulBenchSamples[j - 1U];
+    }
+    ulBenchSamples[j] = ulValue;
+  }
+}
+
+static void prvBenchReport(BenchPrimitive_t ePrimitive, uint32_t ulCount)
+{
+  uint32_t ulHistogram[BENCH_HISTOGRAM_BUCKETS] = { 0U };
+  uint32_t ulCyclesPerMicrosecond = SystemCoreClock / 1000000U;
+  uint64_t ullSum = 0U;
+  uint32_t ulPeak = 0U;
+  uint32_t ulValue;
+  uint32_t ulBucket;
+  uint32_t ulBar;
+  uint32_t i;
+  uint32_t j;
+  uint32_t ulMin, ulAvg, ulP99, ulMax;
+
+  if (ulCount == 0U)
+  {
+    return;
+  }
+
+  prvBenchSort(ulCount);
+
+  for (i = 0U; i < ulCount; i++)
+  {
+    ullSum += ulBenchSamples[i];
+    ulValue = ulBenchSamples[i];
+    for (ulBucket = 0U; (ulValue >>= 1U) != 0U; ulBucket++)
+    {
+    }
+    ulHistogram[ulBucket]++;
+    if (ulHistogram[ulBucket] > ulPeak)
+    {
+      ulPeak = ulHistogram[ulBucket];
+    }
+  }
+
+  ulMin = ulBenchSamples[0];
+  ulAvg = (uint32_t) (ullSum / ulCount);
+  ulP99 = ulBenchSamples[((ulCount * 99U) / 100U < ulCount) ? (ulCount * 99U) / 100U : ulCount - 1U];
+  ulMax = ulBenchSamples[ulCount - 1U];
+
+  if (ulCyclesPerMicrosecond == 0U)
+  {
+    ulCyclesPerMicrosecond = 1U;
+  }
+
+  prvBenchPrintf("\r\n%s (%lu samples)\r\n", pcBenchNames[ePrimitive], (unsigned long) ulCount);
+  prvBenchPrintf("  cycles: min %lu avg %lu p99 %lu max %lu\r\n", (unsigned long) ulMin,
+                 (unsigned long) ulAvg, (unsigned long) ulP99, (unsigned long) ulMax);
+  prvBenchPrintf("  ns:     min %lu avg %lu p99 %lu max %lu\r\n",
+                 (unsigned long) ((ulMin * 1000ULL) / ulCyclesPerMicrosecond),
+                 (unsigned long) ((ulAvg * 1000ULL) / ulCyclesPerMicrosecond),
+                 (unsigned long) ((ulP99 * 1000ULL) / ulCyclesPerMicrosecond),
+                 (unsigned long) ((ulMax * 1000ULL) / ulCyclesPerMicrosecond));
+
+  for (ulBucket = 0U; ulBucket < BENCH_HISTOGRAM_BUCKETS; ulBucket++)
+  {
+    if (ulHistogram[ulBucket] == 0U)
+    {
+      continue;
+    }
+
+    ulBar = (ulHistogram[ulBucket] * BENCH_HISTOGRAM_WIDTH + ulPeak - 1U) / ulPeak;
+    i = (uint32_t) snprintf(cBenchLine, sizeof(cBenchLine), "  %10lu+ %6lu ",
+                            (unsigned long) ((ulBucket == 0U) ? 0UL : (1UL << ulBucket)),
+                            (unsigned long) ulHistogram[ulBucket]);
+    for (j = 0U; (j < ulBar) && ((i + 3U) < sizeof(cBenchLine)); j++)
+    {
+      cBenchLine[i++] = '#';
+    }
+    cBenchLine[i++] = '\r';
+    cBenchLine[i++] = '\n';
+    cBenchLine[i] = '\0';
+    prvBenchPrintf("%s", cBenchLine);
+  }
+}
+
+/**
+  * @brief  Print to USART2, or to the semihosting console under QEMU.
+  * @note   Only called from the control task.
+  */
+static void prvBenchPrintf(const char *pcFormat, ...)
+{
+  static char cBuffer[128];
+  va_list xArgs;
+  int iLength;
+
+  va_start(xArgs, pcFormat);
+  iLength = vsnprintf(cBuffer, sizeof(cBuffer), pcFormat, xArgs);
+  va_end(xArgs);
+
+  if (iLength <= 0)
+  {
+    return;
+  }
+
+#if defined(LATENCY_BENCH_QEMU)
+  {
+    register uint32_t r0 __asm("r0") = BENCH_SEMIHOSTING_WRITE0;
+    register const char *r1 __asm("r1") = cBuffer;
+    __asm volatile ("bkpt 0xAB" : "+r" (r0) : "r" (r1) : "memory");
+  }
+#else
+  if ((size_t) iLength >= sizeof(cBuffer))
+  {
+    iLength = (int) sizeof(cBuffer) - 1;
+  }
+  (void) HAL_UART_Transmit(&huart2, (uint8_t *) cBuffer, (uint16_t) iLength, HAL_MAX_DELAY);
+#endif
+}
+
+#endif /* LATENCY_BENCH */
@@ -0,0 +1,684 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : lite_printf.c
+  * @brief          : Small printf() family for tasks, with no heap and no
+  *                   shared state.
+  ******************************************************************************
+  * @attention
+  *
+  * Each conversion is written as up to four parts: padding, a prefix (the
+  * sign or "0x"), leading zeros, and a body of digits or characters.  Digits
+  * are produced into a buffer on the stack from the least significant end.
+  * Values that fit in 32 bits are converted with 32-bit division, which the
+  * Cortex-M4 does in hardware, rather than with the library's 64-bit
+  * division.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "lite_printf.h"
+#include <stdint.h>
+
+/* Private typedef -----------------------------------------------------------*/
+/* Output gathered for the sink. */
+typedef struct
+{
+  LitePrintf_Sink pfnSink;
+  void *pvContext;
+  size_t xCount;                          /* Characters produced so far. */
+  size_t xUsed;                           /* Bytes waiting in cChunk. */
+  char cChunk[LITE_PRINTF_CHUNK_SIZE];
+} LitePrintfOutput_t;
+
+/* A buffer for LitePrintf_Vsnprintf(). */
+typedef struct
+{
+  char *pcBuffer;
+  size_t xSize;
+  size_t xUsed;
+} LitePrintfBuffer_t;
+
+/* Private define ------------------------------------------------------------*/
+#define LITE_PRINTF_LEFT                0x01U   /* - */
+#define LITE_PRINTF_ZERO                0x02U   /* 0 */
+#define LITE_PRINTF_PLUS                0x04U   /* + */
+#define LITE_PRINTF_SPACE               0x08U   /* space */
+#define LITE_PRINTF_ALTERNATE           0x10U   /* # */
+#define LITE_PRINTF_UPPER               0x20U   /* X or F */
+
+#define LITE_PRINTF_NO_PRECISION        (-1)
+#define LITE_PRINTF_FLOAT_PRECISION     6
+
+/* Room for the digits of a 64-bit value, or for the integer part, point and
+   decimals of %f. */
+#define LITE_PRINTF_DIGITS_SIZE         32U
+
+#define LITE_PRINTF_STDOUT              1
+
+/* Private variables ---------------------------------------------------------*/
+static const char cLowerDigits[] = "0123456789abcdef";
+static const char cUpperDigits[] = "0123456789ABCDEF";
+
+static const uint32_t ulPowersOfTen[LITE_PRINTF_MAX_PRECISION + 1U] =
+{
+  1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvPutChar(LitePrintfOutput_t *pxOutput, char cChar);
+static void prvPutRepeated(LitePrintfOutput_t *pxOutput, char cChar, size_t xCount);
+static void prvPutChars(LitePrintfOutput_t *pxOutput, const char *pcChars, size_t xLength);
+static void prvFlush(LitePrintfOutput_t *pxOutput);
+static void prvPutField(LitePrintfOutput_t *pxOutput, uint32_t ulFlags, size_t xWidth,
+                        const char *pcPrefix, size_t xZeros, const char *pcBody, size_t xBodyLength);
+static char *prvDigits(char *pcEnd, unsigned long long ullValue, uint32_t ulBase, const char *pcDigits);
+static void prvPutInteger(LitePrintfOutput_t *pxOutput, uint32_t ulFlags, size_t xWidth, int iPrecision,
+                          unsigned long long ullMagnitude, char cSign, uint32_t ulBase);
+static void prvPutFixed(LitePrintfOutput_t *pxOutput, uint32_t ulFlags, size_t xWidth, int iPrecision,
+                        double dValue);
+static void prvBufferSink(void *pvContext, const char *pcData, size_t xLength);
+static void prvStdoutSink(void *pvContext, const char *pcData, size_t xLength);
+
+/* Provided by syscalls.c, which writes through __io_putchar(). */
+extern int _write(int file, char *ptr, int len);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Format into a sink.
+  * @param  pfnSink: Receives the output.
+  * @param  pvContext: Passed to pfnSink.
+  * @param  pcFormat: printf() style format, see lite_printf.h.
+  * @param  xArgs: Arguments of the format.
+  * @retval Number of characters produced.
+  */
+int LitePrintf_Format(LitePrintf_Sink pfnSink, void *pvContext, const char *pcFormat, va_list xArgs)
+{
+  LitePrintfOutput_t xOutput;
+  const char *pcString;
+  unsigned long long ullValue;
+  long long llValue;
+  uint32_t ulFlags;
+  size_t xWidth;
+  size_t xLength;
+  int iPrecision;
+  int iValue;
+  char cLength;
+  char cSign;
+  char cChar;
+
+  xOutput.pfnSink = pfnSink;
+  xOutput.pvContext = pvContext;
+  xOutput.xCount = 0U;
+  xOutput.xUsed = 0U;
+
+  while (*pcFormat != '\0')
+  {
+    if (*pcFormat != '%')
+    {
+      prvPutChar(&xOutput, *pcFormat++);
+      continue;
+    }
+    pcFormat++;
+
+    /* Flags */
+    ulFlags = 0U;
+    for (;;)
+    {
+      if (*pcFormat == '-')
+      {
+        ulFlags |= LITE_PRINTF_LEFT;
+      }
+      else if (*pcFormat == '0')
+      {
+        ulFlags |= LITE_PRINTF_ZERO;
+      }
+      else if (*pcFormat == '+')
+      {
+        ulFlags |= LITE_PRINTF_PLUS;
+      }
+      else if (*pcFormat == ' ')
+      {
+        ulFlags |= LITE_PRINTF_SPACE;
+      }
+      else if (*pcFormat == '#')
+      {
+        ulFlags |= LITE_PRINTF_ALTERNATE;
+      }
+      else
+      {
+        break;
+      }
+      pcFormat++;
+    }
+
+    /* Width, where a negative * argument means left justified */
+    xWidth = 0U;
+    if (*pcFormat == '*')
+    {
+      iValue = va_arg(xArgs, int);
+      if (iValue < 0)
+      {
+        ulFlags |= LITE_PRINTF_LEFT;
+        iValue = -iValue;
+      }
+      xWidth = (size_t) iValue;
+      pcFormat++;
+    }
+    else
+    {
+      while ((*pcFormat >= '0') && (*pcFormat <= '9'))
+      {
+        xWidth = (xWidth * 10U) + (size_t) (*pcFormat++ - '0');
+      }
+    }
+
+    /* Precision, where a negative * argument means none was given */
+    iPrecision = LITE_PRINTF_NO_PRECISION;
+    if (*pcFormat == '.')
+    {
+      pcFormat++;
+      if (*pcFormat == '*')
+      {
+        iPrecision = va_arg(xArgs, int);
+        if (iPrecision < 0)
+        {
+          iPrecision = LITE_PRINTF_NO_PRECISION;
+        }
+        pcFormat++;
+      }
+      else
+      {
+        iPrecision = 0;
+        while ((*pcFormat >= '0') && (*pcFormat <= '9'))
+        {
+          iPrecision = (iPrecision * 10) + (*pcFormat++ - '0');
+        }
+      }
+    }
+
+    /* Length: 'H' stands for hh and 'L' for ll */
+    cLength = '\0';
+    if ((*pcFormat == 'h') || (*pcFormat == 'l'))
+    {
+      cLength = *pcFormat++;
+      if (*pcFormat == cLength)
+      {
+        cLength = (cLength == 'h') ? 'H' : 'L';
+        pcFormat++;
+      }
+    }
+    else if ((*pcFormat == 'z') || (*pcFormat == 't'))
+    {
+      cLength = (sizeof(size_t) > sizeof(long)) ? 'L' : 'l';
+      pcFormat++;
+    }
+
+    cChar = *pcFormat;
+    if (cChar == '\0')
+    {
+      break;
+    }
+    pcFormat++;
+
+    switch (cChar)
+    {
+      case 'd':
+      case 'i':
+        if (cLength == 'L')
+        {
+          llValue = va_arg(xArgs, long long);
+        }
+        else if (cLength == 'l')
+        {
+          llValue = va_arg(xArgs, long);
+        }
+        else if (cLength == 'h')
+        {
+          llValue = (short) va_arg(xArgs, int);
+        }
+        else if (cLength == 'H')
+        {
+          llValue = (signed char) va_arg(xArgs, int);
+        }
+        else
+        {
+          llValue = va_arg(xArgs, int);
+        }
+
+        if (llValue < 0)
+        {
+          cSign = '-';
+          ullValue = 0ULL - (unsigned long long) llValue;
+        }
+        else
+        {
+          cSign = ((ulFlags & LITE_PRINTF_PLUS) != 0U) ? '+' : (((ulFlags & LITE_PRINTF_SPACE) != 0U) ? ' ' : '\0');
+          ullValue = (unsigned long long) llValue;
+        }
+        prvPutInteger(&xOutput, ulFlags, xWidth, iPrecision, ullValue, cSign, 10U);
+        break;
+
+      case 'u':
+      case 'x':
+      case 'X':
+        if (cLength == 'L')
+        {
+          ullValue = va_arg(xArgs, unsigned long long);
+        }
+        else if (cLength == 'l')
+        {
+          ullValue = va_arg(xArgs, unsigned long);
+        }
+        else if (cLength == 'h')
+        {
+          ullValue = (unsigned short) va_arg(xArgs, unsigned int);
+        }
+        else if (cLength == 'H')
+        {
+          ullValue = (unsigned char) va_arg(xArgs, unsigned int);
+        }
+        else
+        {
+          ullValue = va_arg(xArgs, unsigned int);
+        }
+
+        if (cChar == 'X')
+        {
+          ulFlags |= LITE_PRINTF_UPPER;
+        }
+        prvPutInteger(&xOutput, ulFlags, xWidth, iPrecision, ullValue, '\0', (cChar == 'u') ? 10U : 16U);
+        break;
+
+      case 'p':
+        ullValue = (uintptr_t) va_arg(xArgs, void *);
+        prvPutInteger(&xOutput, ulFlags | LITE_PRINTF_ALTERNATE, xWidth, iPrecision, ullValue, '\0', 16U);
+        break;
+
+      case 'c':
+        cChar = (char) va_arg(xArgs, int);
+        prvPutField(&xOutput, ulFlags & LITE_PRINTF_LEFT, xWidth, "", 0U, &cChar, 1U);
+        break;
+
+      case 's':
+        pcString = va_arg(xArgs, const char *);
+        if (pcString == NULL)
+        {
+          pcString = "(null)";
+        }
+
+        /* Only look as far as the precision, which need not be followed by
+           a terminator. */
+        xLength = 0U;
+        while (((iPrecision < 0) || (xLength < (size_t) iPrecision)) && (pcString[xLength] != '\0'))
+        {
+          xLength++;
+        }
+        prvPutField(&xOutput, ulFlags & LITE_PRINTF_LEFT, xWidth, "", 0U, pcString, xLength);
+        break;
+
+      case 'f':
+      case 'F':
+        if (cChar == 'F')
+        {
+          ulFlags |= LITE_PRINTF_UPPER;
+        }
+        prvPutFixed(&xOutput, ulFlags, xWidth, iPrecision, va_arg(xArgs, double));
+        break;
+
+      case '%':
+        prvPutChar(&xOutput, '%');
+        break;
+
+      default:
+        /* Not supported, so written out as it is. */
+        prvPutChar(&xOutput, '%');
+        prvPutChar(&xOutput, cChar);
+        break;
+    }
+  }
+
+  prvFlush(&xOutput);
+
+  return (int) xOutput.xCount;
+}
+
+/**
+  * @brief  Format into a buffer, as snprintf() does.
+  * @param  pcBuffer: Receives the output, always null terminated if xSize is
+  *         not 0.
+  * @param  xSize: Size of pcBuffer in bytes.
+  * @param  pcFormat: printf() style format, see lite_printf.h.
+  * @retval Number of characters the whole output has, which is xSize or more
+  *         if it was truncated.
+  */
+int LitePrintf_Snprintf(char *pcBuffer, size_t xSize, const char *pcFormat, ...)
+{
+  va_list xArgs;
+  int iLength;
+
+  va_start(xArgs, pcFormat);
+  iLength = LitePrintf_Vsnprintf(pcBuffer, xSize, pcFormat, xArgs);
+  va_end(xArgs);
+
+  return iLength;
+}
+
+/**
+  * @brief  Format into a buffer, as vsnprintf() does.
+  * @param  pcBuffer: Receives the output, always null terminated if xSize is
+  *         not 0.
+  * @param  xSize: Size of pcBuffer in bytes.
+  * @param  pcFormat: printf() style format, see lite_printf.h.
+  * @param  xArgs: Arguments of the format.
+  * @retval Number of characters the whole output has, which is xSize or more
+  *         if it was truncated.
+  */
+int LitePrintf_Vsnprintf(char *pcBuffer, size_t xSize, const char *pcFormat, va_list xArgs)
+{
+  LitePrintfBuffer_t xBuffer;
+  int iLength;
+
+  xBuffer.pcBuffer = pcBuffer;
+  xBuffer.xSize = xSize;
+  xBuffer.xUsed = 0U;
+
+  iLength = LitePrintf_Format(prvBufferSink, &xBuffer, pcFormat, xArgs);
+
+  if (xSize > 0U)
+  {
+    pcBuffer[xBuffer.xUsed] = '\0';
+  }
+
+  return iLength;
+}
+
+/**
+  * @brief  Format to standard output through _write(), without going through
+  *         newlib's stdio.
+  * @param  pcFormat: printf() style format, see lite_printf.h.
+  * @retval Number of characters written.
+  */
+int LitePrintf_Printf(const char *pcFormat, ...)
+{
+  va_list xArgs;
+  int iLength;
+
+  va_start(xArgs, pcFormat);
+  iLength = LitePrintf_Format(prvStdoutSink, NULL, pcFormat, xArgs);
+  va_end(xArgs);
+
+  return iLength;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void prvPutChar(LitePrintfOutput_t *pxOutput, char cChar)
+{
+  pxOutput->cChunk[pxOutput->xUsed++] = cChar;
+  pxOutput->xCount++;
+
+  if (pxOutput->xUsed == LITE_PRINTF_CHUNK_SIZE)
+  {
+    prvFlush(pxOutput);
+  }
+}
+
+static void prvPutRepeated(LitePrintfOutput_t *pxOutput, char cChar, size_t xCount)
+{
+  while (xCount-- > 0U)
+  {
+    prvPutChar(pxOutput, cChar);
+  }
+}
+
+static void prvPutChars(LitePrintfOutput_t *pxOutput, const char *pcChars, size_t xLength)
+{
+  while (xLength-- > 0U)
+  {
+    prvPutChar(pxOutput, *pcChars++);
+  }
+}
+
+static void prvFlush(LitePrintfOutput_t *pxOutput)
+{
+  if (pxOutput->xUsed > 0U)
+  {
+    pxOutput->pfnSink(pxOutput->pvContext, pxOutput->cChunk, pxOutput->xUsed);
+    pxOutput->xUsed = 0U;
+  }
+}
+
+/**
+  * @brief  Write one conversion padded to xWidth.
+  * @param  ulFlags: LITE_PRINTF_LEFT to pad on the right, LITE_PRINTF_ZERO to
+  *         pad with zeros between the prefix and the body.
+  * @param  pcPrefix: Null terminated sign or base prefix, possibly empty.
+  * @param  xZeros: Zeros required between the prefix and the body by the
+  *         precision.
+  * @retval None
+  */
+static void prvPutField(LitePrintfOutput_t *pxOutput, uint32_t ulFlags, size_t xWidth,
+                        const char *pcPrefix, size_t xZeros, const char *pcBody, size_t xBodyLength)
+{
+  size_t xPrefixLength = 0U;
+  size_t xPadding = 0U;
+  size_t xTotal;
+
+  while (pcPrefix[xPrefixLength] != '\0')
+  {
+    xPrefixLength++;
+  }
+
+  xTotal = xPrefixLength + xZeros + xBodyLength;
+  if (xWidth > xTotal)
+  {
+    xPadding = xWidth - xTotal;
+  }
+
+  if ((ulFlags & (LITE_PRINTF_LEFT | LITE_PRINTF_ZERO)) == 0U)
+  {
+    prvPutRepeated(pxOutput, ' ', xPadding);
+  }
+
+  prvPutChars(pxOutput, pcPrefix, xPrefixLength);
+
+  if ((ulFlags & (LITE_PRINTF_LEFT | LITE_PRINTF_ZERO)) == LITE_PRINTF_ZERO)
+  {
+    prvPutRepeated(pxOutput, '0', xPadding);
+  }
+
+  prvPutRepeated(pxOutput, '0', xZeros);
+  prvPutChars(pxOutput, pcBody, xBodyLength);
+
+  if ((ulFlags & LITE_PRINTF_LEFT) != 0U)
+  {
+    prvPutRepeated(pxOutput, ' ', xPadding);
+  }
+}
+
+/**
+  * @brief  Write the digits of ullValue so they end just before pcEnd.
+  * @retval The first digit.  No digit is written for 0.
+  */
+static char *prvDigits(char *pcEnd, unsigned long long ullValue, uint32_t ulBase, const char *pcDigits)
+{
+  uint32_t ulValue;
+
+  while (ullValue > 0xFFFFFFFFULL)
+  {
+    *--pcEnd = pcDigits[ullValue % ulBase];
+    ullValue /= ulBase;
+  }
+
+  ulValue = (uint32_t) ullValue;
+  while (ulValue > 0U)
+  {
+    *--pcEnd = pcDigits[ulValue % ulBase];
+    ulValue /= ulBase;
+  }
+
+  return pcEnd;
+}
+
+static void prvPutInteger(LitePrintfOutput_t *pxOutput, uint32_t ulFlags, size_t xWidth, int iPrecision,
+                          unsigned long long ullMagnitude, char cSign, uint32_t ulBase)
+{
+  char cDigits[LITE_PRINTF_DIGITS_SIZE];
+  char cPrefix[3] = { '\0', '\0', '\0' };
+  char *pcEnd = &cDigits[LITE_PRINTF_DIGITS_SIZE];
+  char *pcStart;
+  size_t xLength;
+  size_t xZeros = 0U;
+
+  pcStart = prvDigits(pcEnd, ullMagnitude, ulBase, ((ulFlags & LITE_PRINTF_UPPER) != 0U) ? cUpperDigits : cLowerDigits);
+  xLength = (size_t) (pcEnd - pcStart);
+
+  if (iPrecision == LITE_PRINTF_NO_PRECISION)
+  {
+    /* 0 is written as one digit unless the precision is 0. */
+    iPrecision = 1;
+  }
+  else
+  {
+    /* The 0 flag is ignored when a precision is given. */
+    ulFlags &= ~LITE_PRINTF_ZERO;
+  }
+
+  if ((size_t) iPrecision > xLength)
+  {
+    xZeros = (size_t) iPrecision - xLength;
+  }
+
+  if (cSign != '\0')
+  {
+    cPrefix[0] = cSign;
+  }
+  else if (((ulFlags & LITE_PRINTF_ALTERNATE) != 0U) && (ulBase == 16U) && (ullMagnitude != 0ULL))
+  {
+    cPrefix[0] = '0';
+    cPrefix[1] = ((ulFlags & LITE_PRINTF_UPPER) != 0U) ? 'X' : 'x';
+  }
+
+  prvPutField(pxOutput, ulFlags, xWidth, cPrefix, xZeros, pcStart, xLength);
+}
+
+/**
+  * @brief  Write dValue in fixed point with iPrecision decimals, rounded half
+  *         away from zero.
+  * @retval None
+  */
+static void prvPutFixed(LitePrintfOutput_t *pxOutput, uint32_t ulFlags, size_t xWidth, int iPrecision,
+                        double dValue)
+{
+  char cDigits[LITE_PRINTF_DIGITS_SIZE];
+  char cPrefix[2] = { '\0', '\0' };
+  char *pcEnd = &cDigits[LITE_PRINTF_DIGITS_SIZE];
+  char *pcStart = pcEnd;
+  const char *pcSpecial = NULL;
+  unsigned long long ullInteger;
+  uint32_t ulFraction;
+  uint32_t ulDecimals;
+  double dScaled;
+
+  if (iPrecision == LITE_PRINTF_NO_PRECISION)
+  {
+    iPrecision = LITE_PRINTF_FLOAT_PRECISION;
+  }
+  else if (iPrecision > (int) LITE_PRINTF_MAX_PRECISION)
+  {
+    iPrecision = (int) LITE_PRINTF_MAX_PRECISION;
+  }
+
+  /* -0.0 is not below 0.0, so is printed without a sign. */
+  if (dValue < 0.0)
+  {
+    cPrefix[0] = '-';
+    dValue = -dValue;
+  }
+  else if ((ulFlags & LITE_PRINTF_PLUS) != 0U)
+  {
+    cPrefix[0] = '+';
+  }
+  else if ((ulFlags & LITE_PRINTF_SPACE) != 0U)
+  {
+    cPrefix[0] = ' ';
+  }
+
+  if (dValue != dValue)
+  {
+    pcSpecial = ((ulFlags & LITE_PRINTF_UPPER) != 0U) ? "NAN" : "nan";
+  }
+  else if (dValue > 1.7976931348623157e308)
+  {
+    pcSpecial = ((ulFlags & LITE_PRINTF_UPPER) != 0U) ? "INF" : "inf";
+  }
+  else if (dValue >= 18446744073709551616.0)
+  {
+    pcSpecial = ((ulFlags & LITE_PRINTF_UPPER) != 0U) ? "OVF" : "ovf";
+  }
+
+  if (pcSpecial != NULL)
+  {
+    prvPutField(pxOutput, ulFlags & LITE_PRINTF_LEFT, xWidth, cPrefix, 0U, pcSpecial, 3U);
+    return;
+  }
+
+  ullInteger = (unsigned long long) dValue;
+  dScaled = ((dValue - (double) ullInteger) * (double) ulPowersOfTen[iPrecision]) + 0.5;
+  ulFraction = (uint32_t) dScaled;
+
+  /* Rounding the fraction up can carry into the integer part. */
+  if (ulFraction >= ulPowersOfTen[iPrecision])
+  {
+    ulFraction -= ulPowersOfTen[iPrecision];
+    ullInteger++;
+  }
+
+  if (iPrecision > 0)
+  {
+    for (ulDecimals = 0U; ulDecimals < (uint32_t) iPrecision; ulDecimals++)
+    {
+      *--pcStart = (char) ('0' + (ulFraction % 10U));
+      ulFraction /= 10U;
+    }
+    *--pcStart = '.';
+  }
+  else if ((ulFlags & LITE_PRINTF_ALTERNATE) != 0U)
+  {
+    *--pcStart = '.';
+  }
+
+  if (ullInteger == 0ULL)
+  {
+    *--pcStart = '0';
+  }
+  else
+  {
+    pcStart = prvDigits(pcStart, ullInteger, 10U, cLowerDigits);
+  }
+
+  prvPutField(pxOutput, ulFlags, xWidth, cPrefix, 0U, pcStart, (size_t) (pcEnd - pcStart));
+}
+
+/**
+  * @brief  Copy output into a LitePrintfBuffer_t, leaving room for the
+  *         terminator and dropping what does not fit.
+  */
+static void prvBufferSink(void *pvContext, const char *pcData, size_t xLength)
+{
+  LitePrintfBuffer_t *pxBuffer = (LitePrintfBuffer_t *) pvContext;
+
+  while ((xLength-- > 0U) && ((pxBuffer->xUsed + 1U) < pxBuffer->xSize))
+  {
+    pxBuffer->pcBuffer[pxBuffer->xUsed++] = *pcData++;
+  }
+}
+
+static void prvStdoutSink(void *pvContext, const char *pcData, size_t xLength)
+{
+  (void) pvContext;
+
+  (void) _write(LITE_PRINTF_STDOUT, (char *) pcData, (int) xLength);
+}
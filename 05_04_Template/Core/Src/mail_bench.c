@@ -0,0 +1,301 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : mail_bench.c
+  * @brief          : Bursty producer and consumer pipeline through a CMSIS
+  *                   mail queue.
+  ******************************************************************************
+  * @attention
+  *
+  * The control task runs above the pipeline.  It starts the producer with a
+  * notification, and the consumer notifies it back once it has consumed every
+  * mail of the run.
+  *
+  * The work of the consumer is a counted loop rather than a wait on the cycle
+  * counter, so time slices the producer takes from it make the work take
+  * longer instead of disappearing.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "mail_bench.h"
+#include "lite_printf.h"
+#include "cmsis_os.h"
+
+#if defined(MAIL_BENCH)
+
+#if (configUSE_COUNTING_SEMAPHORES != 1)
+#error osMailAlloc() only waits for a block with configUSE_COUNTING_SEMAPHORES set to 1.
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint32_t ulSequence;
+  uint32_t ulBurstStart;
+  uint32_t ulLast;
+} BenchMail_t;
+
+typedef enum
+{
+  BENCH_MODE_BLOCKING = 0,
+  BENCH_MODE_RETRY,
+  BENCH_MODES
+} BenchMode_t;
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_CONTROL_PRIORITY     (configMAX_PRIORITIES - 2)
+#define BENCH_PIPELINE_PRIORITY    (configMAX_PRIORITIES - 3)
+#define BENCH_STACK_DEPTH          ((uint16_t) 256)
+#define BENCH_MAILS                (MAIL_BENCH_BURST * MAIL_BENCH_BURSTS)
+
+/* Private variables ---------------------------------------------------------*/
+extern UART_HandleTypeDef huart2;
+
+osMailQDef(BenchMail, MAIL_BENCH_BLOCKS, BenchMail_t);
+
+static osMailQId xBenchQueue;
+static TaskHandle_t xBenchControlTask;
+static TaskHandle_t xBenchProducerTask;
+
+static const char * const pcBenchModeNames[BENCH_MODES] =
+{
+  "blocking",
+  "retry"
+};
+
+/* Set by the control task before each run. */
+static volatile BenchMode_t eBenchMode;
+
+/* Written by the pipeline during a run, read by the control task after it. */
+static volatile uint32_t ulBenchRetries;
+static volatile uint32_t ulBenchConsumed;
+static volatile uint32_t ulBenchOrderErrors;
+static volatile uint32_t ulBenchMaxLag;
+static volatile TickType_t xBenchEndTick;
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvBenchControlTask(void *pvParameters);
+static void prvBenchProducerTask(void *pvParameters);
+static void prvBenchConsumerTask(void *pvParameters);
+static void prvBenchWork(void);
+static void prvBenchUartSink(void *pvContext, const char *pcData, size_t xLength);
+static void prvBenchPrintf(const char *pcFormat, ...);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Start the cycle counter, create the mail queue and the tasks.
+  * @note   Call before the scheduler is started.
+  * @retval None
+  */
+void MailBench_Init(void)
+{
+  BaseType_t xCreated;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  xBenchQueue = osMailCreate(osMailQ(BenchMail), NULL);
+  configASSERT(xBenchQueue != NULL);
+
+  xCreated = xTaskCreate(prvBenchControlTask, "mbench", BENCH_STACK_DEPTH, NULL,
+                         BENCH_CONTROL_PRIORITY, &xBenchControlTask);
+  configASSERT(xCreated == pdPASS);
+  xCreated = xTaskCreate(prvBenchProducerTask, "producer", BENCH_STACK_DEPTH, NULL,
+                         BENCH_PIPELINE_PRIORITY, &xBenchProducerTask);
+  configASSERT(xCreated == pdPASS);
+  xCreated = xTaskCreate(prvBenchConsumerTask, "consumer", BENCH_STACK_DEPTH, NULL,
+                         BENCH_PIPELINE_PRIORITY, NULL);
+  configASSERT(xCreated == pdPASS);
+  (void) xCreated;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void prvBenchControlTask(void *pvParameters)
+{
+  BenchMode_t eMode;
+  TickType_t xStartTick;
+  uint32_t ulStart;
+  uint32_t ulWorkCycles;
+  uint32_t ulElapsed;
+  uint32_t ulCyclesPerUs;
+
+  (void) pvParameters;
+
+  ulCyclesPerUs = SystemCoreClock / 1000000U;
+
+  vTaskSuspendAll();
+  {
+    ulStart = DWT->CYCCNT;
+    prvBenchWork();
+    ulWorkCycles = DWT->CYCCNT - ulStart;
+  }
+  (void) xTaskResumeAll();
+
+  prvBenchPrintf("\r\nmail benchmark: %u blocks, %u mails every %u ms, %lu cycles of work per mail\r\n",
+                 (unsigned) MAIL_BENCH_BLOCKS, (unsigned) MAIL_BENCH_BURST, (unsigned) MAIL_BENCH_PERIOD_MS,
+                 (unsigned long) ulWorkCycles);
+  prvBenchPrintf("consumer load %lu%% of the core, offered rate %lu mails/s\r\n",
+                 (unsigned long) (((uint64_t) ulWorkCycles * MAIL_BENCH_BURST * 1000U * 100U) /
+                                  ((uint64_t) SystemCoreClock * MAIL_BENCH_PERIOD_MS)),
+                 (unsigned long) ((MAIL_BENCH_BURST * 1000U) / MAIL_BENCH_PERIOD_MS));
+  prvBenchPrintf("%-9s %10s %12s %10s %8s\r\n", "producer", "mails/s", "max lag us", "retries", "order");
+
+  for (eMode = BENCH_MODE_BLOCKING; eMode < BENCH_MODES; eMode++)
+  {
+    eBenchMode = eMode;
+    ulBenchRetries = 0U;
+    ulBenchConsumed = 0U;
+    ulBenchOrderErrors = 0U;
+    ulBenchMaxLag = 0U;
+
+    xStartTick = xTaskGetTickCount();
+    xTaskNotifyGive(xBenchProducerTask);
+    (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    ulElapsed = (uint32_t) (xBenchEndTick - xStartTick);
+    if (ulElapsed == 0U)
+    {
+      ulElapsed = 1U;
+    }
+
+    prvBenchPrintf("%-9s %10lu %12lu %10lu %8lu\r\n", pcBenchModeNames[eMode],
+                   (unsigned long) (((uint64_t) BENCH_MAILS * configTICK_RATE_HZ) / ulElapsed),
+                   (unsigned long) (ulBenchMaxLag / ulCyclesPerUs),
+                   (unsigned long) ulBenchRetries, (unsigned long) ulBenchOrderErrors);
+  }
+
+  prvBenchPrintf("mail benchmark done\r\n");
+  vTaskSuspend(NULL);
+}
+
+static void prvBenchProducerTask(void *pvParameters)
+{
+  BenchMail_t *pxMail;
+  TickType_t xWakeTime;
+  uint32_t ulSequence = 0U;
+  uint32_t ulBurst;
+  uint32_t ulMail;
+  uint32_t ulBurstStart;
+
+  (void) pvParameters;
+
+  for (;;)
+  {
+    (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    xWakeTime = xTaskGetTickCount();
+    for (ulBurst = 0U; ulBurst < MAIL_BENCH_BURSTS; ulBurst++)
+    {
+      ulBurstStart = DWT->CYCCNT;
+
+      for (ulMail = 0U; ulMail < MAIL_BENCH_BURST; ulMail++)
+      {
+        if (eBenchMode == BENCH_MODE_BLOCKING)
+        {
+          pxMail = osMailAlloc(xBenchQueue, osWaitForever);
+        }
+        else
+        {
+          while ((pxMail = osMailAlloc(xBenchQueue, 0)) == NULL)
+          {
+            ulBenchRetries++;
+          }
+        }
+        configASSERT(pxMail != NULL);
+
+        pxMail->ulSequence = ulSequence++;
+        pxMail->ulBurstStart = ulBurstStart;
+        pxMail->ulLast = (ulMail == (MAIL_BENCH_BURST - 1U)) ? 1U : 0U;
+        (void) osMailPut(xBenchQueue, pxMail);
+      }
+
+      /* Returns at once if the burst took longer than the period. */
+      vTaskDelayUntil(&xWakeTime, pdMS_TO_TICKS(MAIL_BENCH_PERIOD_MS));
+    }
+  }
+}
+
+static void prvBenchConsumerTask(void *pvParameters)
+{
+  osEvent xEvent;
+  BenchMail_t *pxMail;
+  uint32_t ulExpected = 0U;
+  uint32_t ulLag;
+
+  (void) pvParameters;
+
+  for (;;)
+  {
+    xEvent = osMailGet(xBenchQueue, osWaitForever);
+    if (xEvent.status != osEventMail)
+    {
+      continue;
+    }
+    pxMail = (BenchMail_t *) xEvent.value.p;
+
+    prvBenchWork();
+
+    if (pxMail->ulSequence != ulExpected)
+    {
+      ulBenchOrderErrors++;
+    }
+    ulExpected = pxMail->ulSequence + 1U;
+
+    if (pxMail->ulLast != 0U)
+    {
+      ulLag = DWT->CYCCNT - pxMail->ulBurstStart;
+      if (ulLag > ulBenchMaxLag)
+      {
+        ulBenchMaxLag = ulLag;
+      }
+    }
+
+    (void) osMailFree(xBenchQueue, pxMail);
+
+    ulBenchConsumed++;
+    if (ulBenchConsumed == BENCH_MAILS)
+    {
+      xBenchEndTick = xTaskGetTickCount();
+      xTaskNotifyGive(xBenchControlTask);
+    }
+  }
+}
+
+/**
+  * @brief  Processing of one mail.
+  * @retval None
+  */
+static void prvBenchWork(void)
+{
+  uint32_t ulLoop;
+
+  for (ulLoop = 0U; ulLoop < MAIL_BENCH_WORK_LOOPS; ulLoop++)
+  {
+    __NOP();
+  }
+}
+
+static void prvBenchUartSink(void *pvContext, const char *pcData, size_t xLength)
+{
+  (void) HAL_UART_Transmit((UART_HandleTypeDef *) pvContext, (uint8_t *) pcData, (uint16_t) xLength, HAL_MAX_DELAY);
+}
+
+/**
+  * @brief  Print to USART2.
+  * @note   Only called from the control task.
+  */
+static void prvBenchPrintf(const char *pcFormat, ...)
+{
+  va_list xArgs;
+
+  va_start(xArgs, pcFormat);
+  (void) LitePrintf_Format(prvBenchUartSink, &huart2, pcFormat, xArgs);
+  va_end(xArgs);
+}
+
+#endif /* MAIL_BENCH */
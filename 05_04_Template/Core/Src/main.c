@@ -2,6 +2,11 @@
 
 #include "main.h"
 #include "cmsis_os.h"
+#include "system_table.h"
+#include "latency_bench.h"
+#include "printf_bench.h"
+#include "pool_bench.h"
+#include "mail_bench.h"
 
 
 UART_HandleTypeDef huart2;
@@ -10,7 +15,6 @@ UART_HandleTypeDef huart2;
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_USART2_UART_Init(void);
-void StartDefaultTask(void const * argument);
 
 
 int main(void)
@@ -20,14 +24,56 @@ int main(void)
   HAL_Init();
 
 
+#if !defined(LATENCY_BENCH_QEMU)
   SystemClock_Config();
+#else
+  /* QEMU does not model the RCC, so the QEMU build of the latency benchmark
+     leaves it alone rather than waiting forever for the PLL.  The emulated
+     core, and with it the SysTick, runs at a fixed clock instead. */
+  SystemCoreClock = LATENCY_BENCH_QEMU_CORE_CLOCK;
+#endif
 
 
   MX_GPIO_Init();
   MX_USART2_UART_Init();
 
+#if (configUSE_TRACE_RECORDER == 1)
+  /* Start recording before any kernel object exists */
+  TraceRecorder_Init();
+#endif
 
+#if (configUSE_MICROSECOND_DELAYS == 1)
+  /* Start the TIM5 count behind vTaskDelayMicroseconds() */
+  MicrosecondTimer_Init();
+#endif
 
+  /* Create the kernel objects listed in system_table.h from static storage.
+     Note that main() used to stop in the loop below without ever starting
+     the kernel; it now creates these objects, including defaultTask
+     (StartDefaultTask(), tskIDLE_PRIORITY + 3), and starts the scheduler.
+     Empty the lists in system_table.h to boot without any task. */
+  SystemTable_Init();
+
+#if defined(LATENCY_BENCH)
+  LatencyBench_Init();
+#endif
+
+#if defined(PRINTF_BENCH)
+  PrintfBench_Init();
+#endif
+
+#if defined(POOL_BENCH)
+  PoolBench_Init();
+#endif
+
+#if defined(MAIL_BENCH)
+  MailBench_Init();
+#endif
+
+  /* Start scheduler */
+  osKernelStart();
+
+  /* We should never get here as control is now taken by the scheduler */
   while (1)
   {
 
@@ -164,6 +210,27 @@ void StartDefaultTask(void const * argument)
   /* USER CODE END 5 */
 }
 
+/**
+  * @brief  Period elapsed callback in non blocking mode
+  * @note   This function is called  when TIM11 interrupt took place, inside
+  * HAL_TIM_IRQHandler(). It makes a direct call to HAL_IncTick() to increment
+  * a global variable "uwTick" used as application time base.
+  * @param  htim : TIM handle
+  * @retval None
+  */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+  /* USER CODE BEGIN Callback 0 */
+
+  /* USER CODE END Callback 0 */
+  if (htim->Instance == TIM11) {
+    HAL_IncTick();
+  }
+  /* USER CODE BEGIN Callback 1 */
+
+  /* USER CODE END Callback 1 */
+}
+
 /**
   * @brief  This function is executed in case of error occurrence.
   * @retval None
@@ -0,0 +1,116 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : microsecond_timer.c
+  * @brief          : Free running 1 MHz TIM5 count and compare alarm.
+  ******************************************************************************
+  * @attention
+  *
+  * The counter is never stopped or reloaded, so it wraps every 2^32 us (about
+  * 71 minutes) and the kernel compares counts by their signed difference.  A
+  * compare match only happens when the count reaches the compare value, so an
+  * alarm set for a count that has already gone by is raised by software.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_MICROSECOND_DELAYS == 1)
+
+/* Private define ------------------------------------------------------------*/
+#define MICROSECOND_TIMER               TIM5
+#define MICROSECOND_TIMER_IRQn          TIM5_IRQn
+#define MICROSECOND_TIMER_IRQ_PRIORITY  configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Start TIM5 counting at 1 MHz with the compare interrupt enabled.
+  * @note   Call after SystemClock_Config(), as the prescaler is derived from
+  *         the APB1 clock, and before the scheduler is started.
+  * @retval None
+  */
+void MicrosecondTimer_Init(void)
+{
+  uint32_t ulTimerClock = HAL_RCC_GetPCLK1Freq();
+
+  /* The APB1 timers are clocked at twice PCLK1 unless the APB1 prescaler
+     is 1. */
+  if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+  {
+    ulTimerClock *= 2U;
+  }
+
+  __HAL_RCC_TIM5_CLK_ENABLE();
+
+  MICROSECOND_TIMER->CR1 = 0U;
+  MICROSECOND_TIMER->PSC = (ulTimerClock / 1000000U) - 1U;
+  MICROSECOND_TIMER->ARR = 0xFFFFFFFFU;
+
+  /* Channel 1 in frozen output compare mode only sets its flag on a match.
+     Keep the first match as far away as possible, as the kernel does not
+     expect the interrupt until it sets an alarm. */
+  MICROSECOND_TIMER->CCMR1 = 0U;
+  MICROSECOND_TIMER->CCR1 = 0xFFFFFFFFU;
+
+  /* Load the prescaler, then clear the update flag that loading it set. */
+  MICROSECOND_TIMER->EGR = TIM_EGR_UG;
+  MICROSECOND_TIMER->SR = 0U;
+  MICROSECOND_TIMER->DIER = TIM_DIER_CC1IE;
+
+  HAL_NVIC_SetPriority(MICROSECOND_TIMER_IRQn, MICROSECOND_TIMER_IRQ_PRIORITY, 0U);
+  HAL_NVIC_EnableIRQ(MICROSECOND_TIMER_IRQn);
+
+  MICROSECOND_TIMER->CR1 = TIM_CR1_CEN;
+}
+
+/**
+  * @brief  Read the microsecond count, configMICROSECOND_TIMER_COUNT().
+  * @retval Microseconds since MicrosecondTimer_Init(), modulo 2^32.
+  */
+uint32_t MicrosecondTimer_Count(void)
+{
+  return MICROSECOND_TIMER->CNT;
+}
+
+/**
+  * @brief  Raise the compare interrupt when the count reaches ulCount, or at
+  *         once if it already has, configMICROSECOND_TIMER_SET_ALARM().
+  * @note   Called by the kernel with interrupts masked.
+  * @param  ulCount : Microsecond count at which to interrupt.
+  * @retval None
+  */
+void MicrosecondTimer_SetAlarm(uint32_t ulCount)
+{
+  MICROSECOND_TIMER->CCR1 = ulCount;
+
+  /* Discard a match of the previous alarm.  Any task it was set for is still
+     due, and is handled by the alarm set here. */
+  MICROSECOND_TIMER->SR = ~TIM_SR_CC1IF;
+
+  if ((int32_t)(MICROSECOND_TIMER->CNT - ulCount) >= 0)
+  {
+    MICROSECOND_TIMER->EGR = TIM_EGR_CC1G;
+  }
+}
+
+/**
+  * @brief  Unblock the tasks whose microsecond delay has expired.
+  * @note   Called from TIM5_IRQHandler().
+  * @retval None
+  */
+void MicrosecondTimer_IRQHandler(void)
+{
+  BaseType_t xHigherPriorityTaskWoken;
+
+  MICROSECOND_TIMER->SR = ~TIM_SR_CC1IF;
+
+  xHigherPriorityTaskWoken = xTaskMicrosecondAlarmFromISR();
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+#endif /* configUSE_MICROSECOND_DELAYS */
@@ -0,0 +1,157 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : newlib_heap.c
+  * @brief          : newlib's malloc() family and locks on top of heap_4.
+  ******************************************************************************
+  * @attention
+  *
+  * These definitions replace the ones in the C library, which is linked after
+  * this file.  Each of malloc(), free(), realloc() and calloc() and their _r
+  * forms is defined, so no part of newlib's own allocator is pulled in to
+  * manage memory alongside heap_4.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <reent.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_NEWLIB_HEAP == 1)
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Allocate memory from heap_4.
+  * @param  ptr: Reentrancy structure of the caller, which gets ENOMEM if the
+  *         allocation fails.
+  * @param  size: Number of bytes to allocate.
+  * @retval The memory, or NULL.
+  */
+void *_malloc_r(struct _reent *ptr, size_t size)
+{
+  void *pvReturn = pvPortMalloc(size);
+
+  if ((pvReturn == NULL) && (size != 0U))
+  {
+    ptr->_errno = ENOMEM;
+  }
+
+  return pvReturn;
+}
+
+/**
+  * @brief  Give memory back to heap_4.
+  * @param  ptr: Reentrancy structure of the caller.
+  * @param  mem: Memory from _malloc_r(), _calloc_r() or _realloc_r(), or NULL.
+  * @retval None
+  */
+void _free_r(struct _reent *ptr, void *mem)
+{
+  (void) ptr;
+
+  vPortFree(mem);
+}
+
+/**
+  * @brief  Resize memory from heap_4, moving it if it cannot grow in place.
+  * @param  ptr: Reentrancy structure of the caller, which gets ENOMEM if the
+  *         memory could not be resized.
+  * @param  mem: Memory to resize, or NULL to allocate.
+  * @param  size: New size in bytes, or 0 to free.
+  * @retval The memory, or NULL with mem left as it was.
+  */
+void *_realloc_r(struct _reent *ptr, void *mem, size_t size)
+{
+  void *pvReturn = pvPortRealloc(mem, size);
+
+  if ((pvReturn == NULL) && (size != 0U))
+  {
+    ptr->_errno = ENOMEM;
+  }
+
+  return pvReturn;
+}
+
+/**
+  * @brief  Allocate zeroed memory for an array from heap_4.
+  * @param  ptr: Reentrancy structure of the caller, which gets ENOMEM if the
+  *         allocation fails.
+  * @param  nmemb: Number of elements.
+  * @param  size: Size of an element in bytes.
+  * @retval The memory, or NULL.
+  */
+void *_calloc_r(struct _reent *ptr, size_t nmemb, size_t size)
+{
+  void *pvReturn = pvPortCalloc(nmemb, size);
+
+  if ((pvReturn == NULL) && (nmemb != 0U) && (size != 0U))
+  {
+    ptr->_errno = ENOMEM;
+  }
+
+  return pvReturn;
+}
+
+void *malloc(size_t size)
+{
+  return _malloc_r(_REENT, size);
+}
+
+void free(void *mem)
+{
+  _free_r(_REENT, mem);
+}
+
+void *realloc(void *mem, size_t size)
+{
+  return _realloc_r(_REENT, mem, size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+  return _calloc_r(_REENT, nmemb, size);
+}
+
+/**
+  * @brief  Locks taken by the C library around its allocations and around
+  *         changes to the environment.
+  * @note   pvPortMalloc() is already safe to call from any task, so these only
+  *         keep the multi-step updates the library makes under them atomic.
+  *         Suspending the scheduler nests, so the locks are recursive, as the
+  *         library requires.
+  * @param  ptr: Reentrancy structure of the caller.
+  * @retval None
+  */
+void __malloc_lock(struct _reent *ptr)
+{
+  (void) ptr;
+
+  vTaskSuspendAll();
+}
+
+void __malloc_unlock(struct _reent *ptr)
+{
+  (void) ptr;
+
+  (void) xTaskResumeAll();
+}
+
+void __env_lock(struct _reent *ptr)
+{
+  (void) ptr;
+
+  vTaskSuspendAll();
+}
+
+void __env_unlock(struct _reent *ptr)
+{
+  (void) ptr;
+
+  (void) xTaskResumeAll();
+}
+
+#endif /* configUSE_NEWLIB_HEAP */
@@ -0,0 +1,309 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : pool_bench.c
+  * @brief          : osPoolAlloc()/osPoolFree() against the marker scan they
+  *                   replaced.
+  ******************************************************************************
+  * @attention
+  *
+  * prvLegacyAlloc() and prvLegacyFree() are the earlier osPoolAlloc() and
+  * osPoolFree() of cmsis_os.c, kept unchanged apart from reading IPSR
+  * directly, on a pool held in static storage.
+  *
+  * Both kinds of pool are driven through the same calls.  After filling a
+  * pool, each round frees the block allocated just before the one the last
+  * round allocated, then allocates again.  The marker scan starts from the
+  * block it last allocated, so it visits every block of the pool before it
+  * reaches the free one.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "pool_bench.h"
+#include "lite_printf.h"
+#include "cmsis_os.h"
+#include <string.h>
+
+#if defined(POOL_BENCH)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  void *pool;
+  uint8_t *markers;
+  uint32_t pool_sz;
+  uint32_t item_sz;
+  uint32_t currentIndex;
+} LegacyPool_t;
+
+typedef void *(*BenchAlloc_t)(void *pvPool);
+typedef void (*BenchFree_t)(void *pvPool, void *pvBlock);
+
+typedef struct
+{
+  uint32_t ulFillAverage;
+  uint32_t ulFillMax;
+  uint32_t ulLastBlockMax;
+  uint32_t ulFreeAverage;
+} BenchResult_t;
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_CONTROL_PRIORITY     (configMAX_PRIORITIES - 2)
+#define BENCH_CONTROL_STACK_DEPTH  ((uint16_t) 384)
+#define BENCH_MIN_BLOCKS           8U
+#define BENCH_ITEM_SIZE            8U
+
+/* Private variables ---------------------------------------------------------*/
+extern UART_HandleTypeDef huart2;
+
+static uint8_t ucLegacyBlocks[POOL_BENCH_MAX_BLOCKS * BENCH_ITEM_SIZE];
+static uint8_t ucLegacyMarkers[POOL_BENCH_MAX_BLOCKS];
+static LegacyPool_t xLegacyPool;
+
+/* The blocks of the pool under test, in the order they were allocated. */
+static void *pvBenchBlocks[POOL_BENCH_MAX_BLOCKS];
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvBenchControlTask(void *pvParameters);
+static void prvBenchRun(BenchAlloc_t pxAlloc, BenchFree_t pxFree, void *pvPool, uint32_t ulBlocks, BenchResult_t *pxResult);
+static void *prvLegacyAlloc(void *pvPool);
+static void prvLegacyFree(void *pvPool, void *pvBlock);
+static void *prvPoolAlloc(void *pvPool);
+static void prvPoolFree(void *pvPool, void *pvBlock);
+static void prvBenchUartSink(void *pvContext, const char *pcData, size_t xLength);
+static void prvBenchPrintf(const char *pcFormat, ...);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Start the cycle counter and create the control task.
+  * @note   Call before the scheduler is started.
+  * @retval None
+  */
+void PoolBench_Init(void)
+{
+  BaseType_t xCreated;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  xCreated = xTaskCreate(prvBenchControlTask, "plbench", BENCH_CONTROL_STACK_DEPTH, NULL,
+                         BENCH_CONTROL_PRIORITY, NULL);
+  configASSERT(xCreated == pdPASS);
+  (void) xCreated;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void prvBenchControlTask(void *pvParameters)
+{
+  osPoolDef_t xPoolDef;
+  osPoolId xPool;
+  BenchResult_t xLegacy;
+  BenchResult_t xFreeList;
+  uint32_t ulBlocks;
+
+  (void) pvParameters;
+
+  prvBenchPrintf("\r\npool benchmark: %u byte blocks, %u rounds, core clock %lu Hz\r\n",
+                 (unsigned) BENCH_ITEM_SIZE, (unsigned) POOL_BENCH_ROUNDS,
+                 (unsigned long) SystemCoreClock);
+  prvBenchPrintf("%6s %-11s %9s %9s %9s %9s %5s\r\n",
+                 "blocks", "pool", "fill avg", "fill max", "last max", "free avg", "hwm");
+
+  for (ulBlocks = BENCH_MIN_BLOCKS; ulBlocks <= POOL_BENCH_MAX_BLOCKS; ulBlocks *= 2U)
+  {
+    xLegacyPool.pool = ucLegacyBlocks;
+    xLegacyPool.markers = ucLegacyMarkers;
+    xLegacyPool.pool_sz = ulBlocks;
+    xLegacyPool.item_sz = BENCH_ITEM_SIZE;
+    xLegacyPool.currentIndex = 0U;
+    memset(ucLegacyMarkers, 0, sizeof(ucLegacyMarkers));
+
+    /* There is no osPoolDelete(), so each size leaves its pool behind. */
+    xPoolDef.pool_sz = ulBlocks;
+    xPoolDef.item_sz = BENCH_ITEM_SIZE;
+    xPoolDef.pool = NULL;
+    xPool = osPoolCreate(&xPoolDef);
+    configASSERT(xPool != NULL);
+
+    prvBenchRun(prvLegacyAlloc, prvLegacyFree, &xLegacyPool, ulBlocks, &xLegacy);
+    prvBenchRun(prvPoolAlloc, prvPoolFree, xPool, ulBlocks, &xFreeList);
+
+    prvBenchPrintf("%6lu %-11s %9lu %9lu %9lu %9lu %5s\r\n",
+                   (unsigned long) ulBlocks, "marker scan",
+                   (unsigned long) xLegacy.ulFillAverage, (unsigned long) xLegacy.ulFillMax,
+                   (unsigned long) xLegacy.ulLastBlockMax, (unsigned long) xLegacy.ulFreeAverage, "-");
+    prvBenchPrintf("%6lu %-11s %9lu %9lu %9lu %9lu %5lu\r\n",
+                   (unsigned long) ulBlocks, "free list",
+                   (unsigned long) xFreeList.ulFillAverage, (unsigned long) xFreeList.ulFillMax,
+                   (unsigned long) xFreeList.ulLastBlockMax, (unsigned long) xFreeList.ulFreeAverage,
+                   (unsigned long) osPoolGetHighWaterMark(xPool));
+  }
+
+  prvBenchPrintf("pool benchmark done\r\n");
+  vTaskSuspend(NULL);
+}
+
+/**
+  * @brief  Fill a pool, free and allocate its only free block
+  *         POOL_BENCH_ROUNDS times, then empty it again.
+  * @param  ulBlocks: Blocks in the pool.
+  * @param  pxResult: Receives the cycle counts.
+  * @retval None
+  */
+static void prvBenchRun(BenchAlloc_t pxAlloc, BenchFree_t pxFree, void *pvPool, uint32_t ulBlocks, BenchResult_t *pxResult)
+{
+  uint32_t ulStart;
+  uint32_t ulCycles;
+  uint32_t ulTotal;
+  uint32_t ulMax;
+  uint32_t ulFreeTotal;
+  uint32_t ulBlock;
+  uint32_t ulRound;
+
+  vTaskSuspendAll();
+  {
+    ulTotal = 0U;
+    ulMax = 0U;
+    for (ulBlock = 0U; ulBlock < ulBlocks; ulBlock++)
+    {
+      ulStart = DWT->CYCCNT;
+      pvBenchBlocks[ulBlock] = pxAlloc(pvPool);
+      ulCycles = DWT->CYCCNT - ulStart;
+
+      configASSERT(pvBenchBlocks[ulBlock] != NULL);
+      ulTotal += ulCycles;
+      if (ulCycles > ulMax)
+      {
+        ulMax = ulCycles;
+      }
+    }
+    pxResult->ulFillAverage = ulTotal / ulBlocks;
+    pxResult->ulFillMax = ulMax;
+
+    ulMax = 0U;
+    ulFreeTotal = 0U;
+    ulBlock = ulBlocks - 2U;
+    for (ulRound = 0U; ulRound < POOL_BENCH_ROUNDS; ulRound++)
+    {
+      ulStart = DWT->CYCCNT;
+      pxFree(pvPool, pvBenchBlocks[ulBlock]);
+      ulFreeTotal += DWT->CYCCNT - ulStart;
+
+      ulStart = DWT->CYCCNT;
+      pvBenchBlocks[ulBlock] = pxAlloc(pvPool);
+      ulCycles = DWT->CYCCNT - ulStart;
+
+      configASSERT(pvBenchBlocks[ulBlock] != NULL);
+      if (ulCycles > ulMax)
+      {
+        ulMax = ulCycles;
+      }
+
+      ulBlock = (ulBlock + ulBlocks - 1U) % ulBlocks;
+    }
+    pxResult->ulLastBlockMax = ulMax;
+    pxResult->ulFreeAverage = ulFreeTotal / POOL_BENCH_ROUNDS;
+
+    for (ulBlock = 0U; ulBlock < ulBlocks; ulBlock++)
+    {
+      pxFree(pvPool, pvBenchBlocks[ulBlock]);
+    }
+  }
+  (void) xTaskResumeAll();
+}
+
+static void *prvLegacyAlloc(void *pvPool)
+{
+  LegacyPool_t *pool_id = (LegacyPool_t *) pvPool;
+  int dummy = 0;
+  void *p = NULL;
+  uint32_t i;
+  uint32_t index;
+
+  if (__get_IPSR() != 0U) {
+    dummy = portSET_INTERRUPT_MASK_FROM_ISR();
+  }
+  else {
+    vPortEnterCritical();
+  }
+
+  for (i = 0; i < pool_id->pool_sz; i++) {
+    index = (pool_id->currentIndex + i) % pool_id->pool_sz;
+
+    if (pool_id->markers[index] == 0) {
+      pool_id->markers[index] = 1;
+      p = (void *)((uint32_t)(pool_id->pool) + (index * pool_id->item_sz));
+      pool_id->currentIndex = index;
+      break;
+    }
+  }
+
+  if (__get_IPSR() != 0U) {
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(dummy);
+  }
+  else {
+    vPortExitCritical();
+  }
+
+  return p;
+}
+
+static void prvLegacyFree(void *pvPool, void *pvBlock)
+{
+  LegacyPool_t *pool_id = (LegacyPool_t *) pvPool;
+  uint32_t index;
+
+  if (pvBlock == NULL) {
+    return;
+  }
+
+  if (pvBlock < pool_id->pool) {
+    return;
+  }
+
+  index = (uint32_t)pvBlock - (uint32_t)(pool_id->pool);
+  if (index % pool_id->item_sz) {
+    return;
+  }
+  index = index / pool_id->item_sz;
+  if (index >= pool_id->pool_sz) {
+    return;
+  }
+
+  pool_id->markers[index] = 0;
+}
+
+static void *prvPoolAlloc(void *pvPool)
+{
+  return osPoolAlloc((osPoolId) pvPool);
+}
+
+static void prvPoolFree(void *pvPool, void *pvBlock)
+{
+  (void) osPoolFree((osPoolId) pvPool, pvBlock);
+}
+
+static void prvBenchUartSink(void *pvContext, const char *pcData, size_t xLength)
+{
+  (void) HAL_UART_Transmit((UART_HandleTypeDef *) pvContext, (uint8_t *) pcData, (uint16_t) xLength, HAL_MAX_DELAY);
+}
+
+/**
+  * @brief  Print to USART2.
+  * @note   Only called from the control task.
+  */
+static void prvBenchPrintf(const char *pcFormat, ...)
+{
+  va_list xArgs;
+
+  va_start(xArgs, pcFormat);
+  (void) LitePrintf_Format(prvBenchUartSink, &huart2, pcFormat, xArgs);
+  va_end(xArgs);
+}
+
+#endif /* POOL_BENCH */
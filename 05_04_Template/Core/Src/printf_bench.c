@@ -0,0 +1,276 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : printf_bench.c
+  * @brief          : newlib-nano snprintf() against LitePrintf_Snprintf().
+  ******************************************************************************
+  * @attention
+  *
+  * The control task times the formatters itself, then creates one probe task
+  * per formatter and line, below its own priority.  The probe makes a single
+  * call and notifies the control task, which reads the probe's stack high
+  * water mark and the heap statistics before deleting it.  A probe that makes
+  * no call gives the stack the probe itself uses.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "printf_bench.h"
+#include "lite_printf.h"
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if defined(PRINTF_BENCH)
+
+#if (INCLUDE_uxTaskGetStackHighWaterMark != 1)
+#error The stack measurement needs INCLUDE_uxTaskGetStackHighWaterMark set to 1.
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+typedef int (*BenchFormatter_t)(char *pcBuffer, size_t xSize, const char *pcFormat, ...);
+
+typedef enum
+{
+  BENCH_INTEGERS = 0,
+  BENCH_HEX,
+  BENCH_STRINGS,
+  BENCH_FLOAT,
+  BENCH_LOG_LINE,
+  BENCH_LINES
+} BenchLine_t;
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_CONTROL_PRIORITY     (configMAX_PRIORITIES - 2)
+#define BENCH_PROBE_PRIORITY       (configMAX_PRIORITIES - 3)
+#define BENCH_CONTROL_STACK_DEPTH  ((uint16_t) 512)
+#define BENCH_FORMATTERS           2U
+#define BENCH_NO_FORMATTER         BENCH_FORMATTERS
+#define BENCH_BUFFER_SIZE          64U
+#define BENCH_PROBE_TIMEOUT        pdMS_TO_TICKS(1000)
+
+/* Private variables ---------------------------------------------------------*/
+extern UART_HandleTypeDef huart2;
+
+static const BenchFormatter_t pxBenchFormatters[BENCH_FORMATTERS] =
+{
+  snprintf,
+  LitePrintf_Snprintf
+};
+
+static const char * const pcBenchFormatterNames[BENCH_FORMATTERS] =
+{
+  "newlib snprintf",
+  "LitePrintf_Snprintf"
+};
+
+static const char * const pcBenchLineNames[BENCH_LINES] =
+{
+  "integers",
+  "hex",
+  "strings",
+  "float",
+  "log line"
+};
+
+static TaskHandle_t xBenchControlTask;
+static volatile uint32_t ulBenchFormatter;
+static volatile BenchLine_t eBenchLine;
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvBenchControlTask(void *pvParameters);
+static void prvBenchProbeTask(void *pvParameters);
+static int prvBenchFormat(uint32_t ulFormatter, BenchLine_t eLine, char *pcBuffer);
+static void prvBenchProbe(uint32_t ulFormatter, BenchLine_t eLine, uint32_t *pulStack, uint32_t *pulAllocations);
+static void prvBenchUartSink(void *pvContext, const char *pcData, size_t xLength);
+static void prvBenchPrintf(const char *pcFormat, ...);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Start the cycle counter and create the control task.
+  * @note   Call before the scheduler is started.
+  * @retval None
+  */
+void PrintfBench_Init(void)
+{
+  BaseType_t xCreated;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  xCreated = xTaskCreate(prvBenchControlTask, "pbench", BENCH_CONTROL_STACK_DEPTH, NULL,
+                         BENCH_CONTROL_PRIORITY, &xBenchControlTask);
+  configASSERT(xCreated == pdPASS);
+  (void) xCreated;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static void prvBenchControlTask(void *pvParameters)
+{
+  char cBuffer[BENCH_BUFFER_SIZE];
+  uint32_t ulFormatter;
+  uint32_t ulCall;
+  uint32_t ulStart;
+  uint32_t ulCycles;
+  uint32_t ulMin;
+  uint32_t ulTotal;
+  uint32_t ulBaseStack;
+  uint32_t ulStack;
+  uint32_t ulAllocations;
+  BenchLine_t eLine;
+
+  (void) pvParameters;
+
+  prvBenchProbe(BENCH_NO_FORMATTER, BENCH_INTEGERS, &ulBaseStack, &ulAllocations);
+
+  prvBenchPrintf("\r\nprintf benchmark: %u calls per line, core clock %lu Hz\r\n",
+                 (unsigned) PRINTF_BENCH_CALLS, (unsigned long) SystemCoreClock);
+  prvBenchPrintf("%-9s %-20s %10s %10s %8s %6s  output\r\n",
+                 "line", "formatter", "min cyc", "avg cyc", "stack B", "allocs");
+
+  for (eLine = BENCH_INTEGERS; eLine < BENCH_LINES; eLine++)
+  {
+    for (ulFormatter = 0U; ulFormatter < BENCH_FORMATTERS; ulFormatter++)
+    {
+      /* The probe runs first, so its call is the first one the formatter
+         makes for this line and includes any one-off allocation. */
+      prvBenchProbe(ulFormatter, eLine, &ulStack, &ulAllocations);
+
+      ulMin = 0xFFFFFFFFU;
+      ulTotal = 0U;
+
+      vTaskSuspendAll();
+      {
+        for (ulCall = 0U; ulCall < PRINTF_BENCH_CALLS; ulCall++)
+        {
+          ulStart = DWT->CYCCNT;
+          (void) prvBenchFormat(ulFormatter, eLine, cBuffer);
+          ulCycles = DWT->CYCCNT - ulStart;
+
+          ulTotal += ulCycles;
+          if (ulCycles < ulMin)
+          {
+            ulMin = ulCycles;
+          }
+        }
+      }
+      (void) xTaskResumeAll();
+
+      prvBenchPrintf("%-9s %-20s %10lu %10lu %8lu %6lu  %s\r\n",
+                     pcBenchLineNames[eLine], pcBenchFormatterNames[ulFormatter],
+                     (unsigned long) ulMin, (unsigned long) (ulTotal / PRINTF_BENCH_CALLS),
+                     (unsigned long) ((ulStack > ulBaseStack) ? (ulStack - ulBaseStack) : 0U),
+                     (unsigned long) ulAllocations, cBuffer);
+    }
+  }
+
+  prvBenchPrintf("printf benchmark done\r\n");
+  vTaskSuspend(NULL);
+}
+
+static void prvBenchProbeTask(void *pvParameters)
+{
+  char cBuffer[BENCH_BUFFER_SIZE];
+
+  (void) pvParameters;
+
+  if (ulBenchFormatter != BENCH_NO_FORMATTER)
+  {
+    (void) prvBenchFormat(ulBenchFormatter, eBenchLine, cBuffer);
+  }
+
+  xTaskNotifyGive(xBenchControlTask);
+  vTaskSuspend(NULL);
+}
+
+/**
+  * @brief  Make one call of a formatter from a task of its own.
+  * @param  pulStack: Receives the bytes of the probe stack that were used.
+  * @param  pulAllocations: Receives the number of heap allocations made while
+  *         the probe ran.
+  * @retval None
+  */
+static void prvBenchProbe(uint32_t ulFormatter, BenchLine_t eLine, uint32_t *pulStack, uint32_t *pulAllocations)
+{
+  TaskHandle_t xProbe;
+  HeapStats_t xBefore;
+  HeapStats_t xAfter;
+  BaseType_t xCreated;
+
+  ulBenchFormatter = ulFormatter;
+  eBenchLine = eLine;
+
+  /* The probe is below this task, so does not run until this task waits. */
+  xCreated = xTaskCreate(prvBenchProbeTask, "probe", PRINTF_BENCH_PROBE_STACK_DEPTH, NULL,
+                         BENCH_PROBE_PRIORITY, &xProbe);
+  configASSERT(xCreated == pdPASS);
+  (void) xCreated;
+
+  vPortGetHeapStats(&xBefore);
+  (void) ulTaskNotifyTake(pdTRUE, BENCH_PROBE_TIMEOUT);
+  vPortGetHeapStats(&xAfter);
+
+  *pulStack = (PRINTF_BENCH_PROBE_STACK_DEPTH - (uint32_t) uxTaskGetStackHighWaterMark(xProbe)) * sizeof(StackType_t);
+  *pulAllocations = (uint32_t) (xAfter.xNumberOfSuccessfulAllocations - xBefore.xNumberOfSuccessfulAllocations);
+
+  vTaskDelete(xProbe);
+}
+
+/**
+  * @brief  Format one of the benchmark lines.
+  * @param  ulFormatter: Index into pxBenchFormatters.
+  * @param  pcBuffer: Receives the line, BENCH_BUFFER_SIZE bytes.
+  * @retval Return value of the formatter.
+  */
+static int prvBenchFormat(uint32_t ulFormatter, BenchLine_t eLine, char *pcBuffer)
+{
+  BenchFormatter_t pxFormat = pxBenchFormatters[ulFormatter];
+  int iLength = 0;
+
+  switch (eLine)
+  {
+    case BENCH_INTEGERS:
+      iLength = pxFormat(pcBuffer, BENCH_BUFFER_SIZE, "%d %u %5ld", -123456, 7890U, 42L);
+      break;
+    case BENCH_HEX:
+      iLength = pxFormat(pcBuffer, BENCH_BUFFER_SIZE, "%08x %#x %p", 0xBEEFU, 255U, (void *) pcBuffer);
+      break;
+    case BENCH_STRINGS:
+      iLength = pxFormat(pcBuffer, BENCH_BUFFER_SIZE, "%-8s|%3c|%.3s", "task", 'x', "abcdef");
+      break;
+    case BENCH_FLOAT:
+      iLength = pxFormat(pcBuffer, BENCH_BUFFER_SIZE, "%.3f %8.2f", 3.14159, -2.5);
+      break;
+    case BENCH_LOG_LINE:
+    default:
+      iLength = pxFormat(pcBuffer, BENCH_BUFFER_SIZE, "[%6lu] %s: %d%% %.1f",
+                         123456UL, "sensor", 57, 21.75);
+      break;
+  }
+
+  return iLength;
+}
+
+static void prvBenchUartSink(void *pvContext, const char *pcData, size_t xLength)
+{
+  (void) HAL_UART_Transmit((UART_HandleTypeDef *) pvContext, (uint8_t *) pcData, (uint16_t) xLength, HAL_MAX_DELAY);
+}
+
+/**
+  * @brief  Print to USART2.
+  * @note   Only called from the control task.
+  */
+static void prvBenchPrintf(const char *pcFormat, ...)
+{
+  va_list xArgs;
+
+  va_start(xArgs, pcFormat);
+  (void) LitePrintf_Format(prvBenchUartSink, &huart2, pcFormat, xArgs);
+  va_end(xArgs);
+}
+
+#endif /* PRINTF_BENCH */
@@ -0,0 +1,184 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    stm32f4xx_hal_timebase_tim.c
+  * @brief   HAL time base based on the hardware TIM.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_hal_tim.h"
+#if defined(LATENCY_BENCH_QEMU)
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+TIM_HandleTypeDef        htim11;
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+#if !defined(LATENCY_BENCH_QEMU)
+/**
+  * @brief  This function configures the TIM11 as a time base source.
+  *         The time source is configured  to have 1ms time base with a dedicated
+  *         Tick interrupt priority.
+  * @note   This function is called  automatically at the beginning of program after
+  *         reset by HAL_Init() or at any time when clock is configured, by HAL_RCC_ClockConfig().
+  * @param  TickPriority: Tick interrupt priority.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+  RCC_ClkInitTypeDef    clkconfig;
+  uint32_t              uwTimclock = 0U;
+
+  uint32_t              uwPrescalerValue = 0U;
+  uint32_t              pFLatency;
+  HAL_StatusTypeDef     status;
+
+  /* Enable TIM11 clock */
+  __HAL_RCC_TIM11_CLK_ENABLE();
+
+  /* Get clock configuration */
+  HAL_RCC_GetClockConfig(&clkconfig, &pFLatency);
+
+  /* Compute TIM11 clock */
+  uwTimclock = HAL_RCC_GetPCLK2Freq();
+
+  /* Compute the prescaler value to have TIM11 counter clock equal to 1MHz */
+  uwPrescalerValue = (uint32_t) ((uwTimclock / 1000000U) - 1U);
+
+  /* Initialize TIM11 */
+  htim11.Instance = TIM11;
+
+  /* Initialize TIMx peripheral as follow:
+
+  + Period = [(TIM11CLK/1000) - 1]. to have a (1/1000) s time base.
+  + Prescaler = (uwTimclock/1000000 - 1) to have a 1MHz counter clock.
+  + ClockDivision = 0
+  + Counter direction = Up
+  */
+  htim11.Init.Period = (1000000U / 1000U) - 1U;
+  htim11.Init.Prescaler = uwPrescalerValue;
+  htim11.Init.ClockDivision = 0;
+  htim11.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim11.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+
+  status = HAL_TIM_Base_Init(&htim11);
+  if (status == HAL_OK)
+  {
+    /* Start the TIM time Base generation in interrupt mode */
+    status = HAL_TIM_Base_Start_IT(&htim11);
+    if (status == HAL_OK)
+    {
+      /* Enable the TIM11 global Interrupt */
+      HAL_NVIC_EnableIRQ(TIM1_TRG_COM_TIM11_IRQn);
+      /* Configure the SysTick IRQ priority */
+      if (TickPriority < (1UL << __NVIC_PRIO_BITS))
+      {
+        /* Configure the TIM IRQ priority */
+        HAL_NVIC_SetPriority(TIM1_TRG_COM_TIM11_IRQn, TickPriority, 0U);
+        uwTickPrio = TickPriority;
+      }
+      else
+      {
+        status = HAL_ERROR;
+      }
+    }
+  }
+
+  /* Return function status */
+  return status;
+}
+
+/**
+  * @brief  Suspend Tick increment.
+  * @note   Disable the tick increment by disabling TIM11 update interrupt.
+  * @param  None
+  * @retval None
+  */
+void HAL_SuspendTick(void)
+{
+  /* Disable TIM11 update Interrupt */
+  __HAL_TIM_DISABLE_IT(&htim11, TIM_IT_UPDATE);
+}
+
+/**
+  * @brief  Resume Tick increment.
+  * @note   Enable the tick increment by Enabling TIM11 update interrupt.
+  * @param  None
+  * @retval None
+  */
+void HAL_ResumeTick(void)
+{
+  /* Enable TIM11 Update interrupt */
+  __HAL_TIM_ENABLE_IT(&htim11, TIM_IT_UPDATE);
+}
+
+#else /* LATENCY_BENCH_QEMU */
+
+/**
+  * @brief  Leave TIM11 stopped in the QEMU build of the latency benchmark.
+  * @note   QEMU does not model TIM11, so its update interrupt would never
+  *         come and uwTick would stay at 0.  HAL_GetTick() reads the kernel
+  *         tick count instead, which runs from the SysTick once the scheduler
+  *         has started.
+  * @param  TickPriority: Tick interrupt priority.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+  if (TickPriority >= (1UL << __NVIC_PRIO_BITS))
+  {
+    return HAL_ERROR;
+  }
+
+  uwTickPrio = TickPriority;
+  return HAL_OK;
+}
+
+/**
+  * @brief  Provide a tick value in millisecond from the kernel tick count.
+  * @retval tick value
+  */
+uint32_t HAL_GetTick(void)
+{
+  return (uint32_t) (xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/**
+  * @brief  Nothing to suspend, the HAL tick follows the kernel tick.
+  * @param  None
+  * @retval None
+  */
+void HAL_SuspendTick(void)
+{
+}
+
+/**
+  * @brief  Nothing to resume, the HAL tick follows the kernel tick.
+  * @param  None
+  * @retval None
+  */
+void HAL_ResumeTick(void)
+{
+}
+
+#endif /* LATENCY_BENCH_QEMU */
+
@@ -24,6 +24,7 @@
 #include "task.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "latency_bench.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -57,6 +58,7 @@
 /* USER CODE END 0 */
 
 /* External variables --------------------------------------------------------*/
+extern TIM_HandleTypeDef htim11;
 
 /* USER CODE BEGIN EV */
 
@@ -101,6 +103,9 @@ void HardFault_Handler(void)
 void MemManage_Handler(void)
 {
   /* USER CODE BEGIN MemoryManagement_IRQn 0 */
+#if (configUSE_MPU_STACK_GUARD == 1)
+  vPortMemManageHandler();
+#endif
 
   /* USER CODE END MemoryManagement_IRQn 0 */
   while (1)
@@ -161,7 +166,6 @@ void SysTick_Handler(void)
   /* USER CODE BEGIN SysTick_IRQn 0 */
 
   /* USER CODE END SysTick_IRQn 0 */
-  HAL_IncTick();
 #if (INCLUDE_xTaskGetSchedulerState == 1 )
   if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
   {
@@ -182,6 +186,52 @@ void SysTick_Handler(void)
 /* please refer to the startup file (startup_stm32f4xx.s).                    */
 /******************************************************************************/
 
+/**
+  * @brief This function handles TIM1 trigger and commutation interrupts and TIM11 global interrupt.
+  */
+void TIM1_TRG_COM_TIM11_IRQHandler(void)
+{
+  /* USER CODE BEGIN TIM1_TRG_COM_TIM11_IRQn 0 */
+
+  /* USER CODE END TIM1_TRG_COM_TIM11_IRQn 0 */
+  HAL_TIM_IRQHandler(&htim11);
+  /* USER CODE BEGIN TIM1_TRG_COM_TIM11_IRQn 1 */
+
+  /* USER CODE END TIM1_TRG_COM_TIM11_IRQn 1 */
+}
+
 /* USER CODE BEGIN 1 */
+#if (configUSE_TRACE_RECORDER == 1)
+/**
+  * @brief This function handles DMA1 stream6 global interrupt, which drains
+  *        the trace recorder into USART2.
+  */
+void DMA1_Stream6_IRQHandler(void)
+{
+  TraceRecorder_IRQHandler();
+}
+#endif /* configUSE_TRACE_RECORDER */
+
+#if defined(LATENCY_BENCH)
+/**
+  * @brief This function handles EXTI line0 interrupt, which the latency
+  *        benchmark pends from software as LATENCY_BENCH_IRQn.
+  */
+void EXTI0_IRQHandler(void)
+{
+  LatencyBench_IRQHandler();
+}
+#endif /* LATENCY_BENCH */
+
+#if (configUSE_MICROSECOND_DELAYS == 1)
+/**
+  * @brief This function handles TIM5 global interrupt, the alarm behind
+  *        vTaskDelayMicroseconds().
+  */
+void TIM5_IRQHandler(void)
+{
+  MicrosecondTimer_IRQHandler();
+}
+#endif /* configUSE_MICROSECOND_DELAYS */
 
 /* USER CODE END 1 */
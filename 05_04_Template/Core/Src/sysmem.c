@@ -23,6 +23,26 @@
 /* Includes */
 #include <errno.h>
 #include <stdint.h>
+#include "FreeRTOS.h"
+
+#if (configUSE_NEWLIB_HEAP == 1)
+
+/**
+ * @brief _sbrk() is not used when newlib's malloc is mapped onto heap_4, as
+ *        the RAM it would give out is the FreeRTOS heap, see newlib_heap.h
+ *
+ * @param incr Memory size
+ * @return (void *)-1, with errno set to ENOMEM
+ */
+void *_sbrk(ptrdiff_t incr)
+{
+  (void)incr;
+
+  errno = ENOMEM;
+  return (void *)-1;
+}
+
+#else
 
 /**
  * Pointer to the current high watermark of the heap usage
@@ -77,3 +97,5 @@ void *_sbrk(ptrdiff_t incr)
 
   return (void *)prev_heap_end;
 }
+
+#endif /* configUSE_NEWLIB_HEAP */
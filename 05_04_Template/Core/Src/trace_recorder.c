@@ -0,0 +1,305 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : trace_recorder.c
+  * @brief          : Lock-free event ring buffer drained over USART2 by DMA.
+  ******************************************************************************
+  * @attention
+  *
+  * Writers claim slots by advancing the head index with a compare-and-swap
+  * (LDREX/STREX), so tasks and interrupts of any priority that may call the
+  * FreeRTOS API can record events without a critical section.  A slot is only
+  * sent once its ucEvent byte is non-zero, which each writer stores last.
+  *
+  * The single reader is the drain: it sends the longest run of complete slots
+  * that is contiguous in memory with one DMA transfer, then clears those slots
+  * and advances the tail from the transfer complete interrupt.  The drain is
+  * restarted from the tick interrupt whenever the DMA is idle.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TRACE_RECORDER == 1)
+
+/* Private define ------------------------------------------------------------*/
+#define TRACE_RECORDER_INDEX_MASK       (TRACE_RECORDER_BUFFER_EVENTS - 1U)
+#define TRACE_RECORDER_DMA_STREAM       DMA1_Stream6   /* USART2_TX, channel 4 */
+#define TRACE_RECORDER_DMA_CHANNEL      4U
+#define TRACE_RECORDER_DMA_IRQn         DMA1_Stream6_IRQn
+#define TRACE_RECORDER_DMA_FLAGS        (DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 | \
+                                         DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6)
+
+#if ((TRACE_RECORDER_BUFFER_EVENTS & TRACE_RECORDER_INDEX_MASK) != 0U)
+#error TRACE_RECORDER_BUFFER_EVENTS must be a power of two.
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+static TraceEvent_t xTraceBuffer[TRACE_RECORDER_BUFFER_EVENTS];
+
+/* Free running indices; the slot is the index masked by the buffer size.
+   ulTraceHead is advanced by writers, ulTraceTail only by the drain. */
+static volatile uint32_t ulTraceHead = 0U;
+static volatile uint32_t ulTraceTail = 0U;
+
+/* Events lost because the buffer was full, not yet reported. */
+static volatile uint32_t ulTraceDropped = 0U;
+
+/* Number of events in the DMA transfer in progress, or 0 when idle. */
+static volatile uint32_t ulTraceSending = 0U;
+static volatile uint32_t ulTraceStarted = 0U;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t prvTraceReserve(uint32_t ulCount, uint32_t *pulIndex);
+static void prvTraceCommit(uint32_t ulIndex, uint32_t ulTimestamp, uint16_t usObject,
+                           uint32_t ulArg, uint8_t ucEvent);
+static uint16_t prvTraceObjectID(const void *pvObject);
+static void prvTraceStartTransfer(void);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Start the cycle counter and the DMA stream that drains the buffer.
+  * @note   Call after MX_USART2_UART_Init() and before any kernel object is
+  *         created.  Events recorded before this call carry a zero timestamp.
+  * @retval None
+  */
+void TraceRecorder_Init(void)
+{
+  /* The DWT cycle counter provides the timestamps. */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  __HAL_RCC_DMA1_CLK_ENABLE();
+  TRACE_RECORDER_DMA_STREAM->CR = 0U;
+  while ((TRACE_RECORDER_DMA_STREAM->CR & DMA_SxCR_EN) != 0U)
+  {
+  }
+  TRACE_RECORDER_DMA_STREAM->PAR = (uint32_t) &USART2->DR;
+  TRACE_RECORDER_DMA_STREAM->FCR = 0U;
+  TRACE_RECORDER_DMA_STREAM->CR = (TRACE_RECORDER_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) |
+                                  DMA_SxCR_MINC | DMA_SxCR_DIR_0 | DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+  DMA1->HIFCR = TRACE_RECORDER_DMA_FLAGS;
+  USART2->CR3 |= USART_CR3_DMAT;
+
+  /* The drain runs at the kernel interrupt priority, the same as the tick, so
+     the two never preempt each other. */
+  HAL_NVIC_SetPriority(TRACE_RECORDER_DMA_IRQn, configLIBRARY_LOWEST_INTERRUPT_PRIORITY, 0U);
+  HAL_NVIC_EnableIRQ(TRACE_RECORDER_DMA_IRQn);
+
+  ulTraceStarted = 1U;
+  TraceRecorder_Event(TRACE_EVT_HEADER, NULL, TRACE_RECORDER_VERSION);
+}
+
+/**
+  * @brief  Record one event.
+  * @param  ucEvent: One of the TRACE_EVT_ values.
+  * @param  pvObject: Task or queue the event refers to, or NULL.
+  * @param  ulArg: Event specific argument, saturated at 255.
+  * @retval None
+  */
+void TraceRecorder_Event(uint8_t ucEvent, const void *pvObject, uint32_t ulArg)
+{
+  uint32_t ulIndex;
+  uint32_t ulDropped;
+  uint16_t usObject;
+
+  if (prvTraceReserve(1U, &ulIndex) == 0U)
+  {
+    return;
+  }
+
+  usObject = (ucEvent == TRACE_EVT_HEADER) ? (uint16_t) TRACE_RECORDER_MAGIC : prvTraceObjectID(pvObject);
+  prvTraceCommit(ulIndex, DWT->CYCCNT, usObject, ulArg, ucEvent);
+
+  /* Report any loss as soon as there is room again, so the decoder can mark
+     where the gap is. */
+  if (ulTraceDropped != 0U)
+  {
+    ulDropped = __atomic_exchange_n(&ulTraceDropped, 0U, __ATOMIC_RELAXED);
+    if ((ulDropped != 0U) && (prvTraceReserve(1U, &ulIndex) != 0U))
+    {
+      prvTraceCommit(ulIndex, DWT->CYCCNT, TRACE_OBJECT_NONE, ulDropped, TRACE_EVT_DROPPED);
+    }
+  }
+}
+
+/**
+  * @brief  Record the name of a task or queue.
+  * @note   The name is split across consecutive TRACE_EVT_NAME events that
+  *         each carry four characters in place of the timestamp.  The events
+  *         are reserved together so they cannot be interleaved with others.
+  * @param  pvObject: Task or queue being named.
+  * @param  pcName: NUL terminated name, truncated to configMAX_TASK_NAME_LEN.
+  * @retval None
+  */
+void TraceRecorder_Name(const void *pvObject, const char *pcName)
+{
+  uint32_t ulLength = 0U;
+  uint32_t ulCount;
+  uint32_t ulIndex;
+  uint32_t ulChunk;
+  uint32_t ulOffset;
+  uint32_t i;
+  uint16_t usObject = prvTraceObjectID(pvObject);
+
+  if (pcName == NULL)
+  {
+    return;
+  }
+
+  while ((ulLength < configMAX_TASK_NAME_LEN) && (pcName[ulLength] != '\0'))
+  {
+    ulLength++;
+  }
+
+  /* An empty name still needs one event, and a name that fills its last
+     chunk is terminated by the next event not being a continuation. */
+  ulCount = (ulLength + 4U) / 4U;
+  if (prvTraceReserve(ulCount, &ulIndex) == 0U)
+  {
+    return;
+  }
+
+  for (ulOffset = 0U; ulOffset < (ulCount * 4U); ulOffset += 4U)
+  {
+    ulChunk = 0U;
+    for (i = 0U; i < 4U; i++)
+    {
+      if ((ulOffset + i) < ulLength)
+      {
+        ulChunk |= (uint32_t) (uint8_t) pcName[ulOffset + i] << (8U * i);
+      }
+    }
+    prvTraceCommit(ulIndex++, ulChunk, usObject, ulOffset, TRACE_EVT_NAME);
+  }
+}
+
+/**
+  * @brief  Called from the tick interrupt by traceTASK_INCREMENT_TICK().
+  * @param  ulTickCount: Tick count before it is incremented.
+  * @retval None
+  */
+void TraceRecorder_Tick(uint32_t ulTickCount)
+{
+  if (ulTraceStarted == 0U)
+  {
+    return;
+  }
+
+  if ((ulTickCount % TRACE_RECORDER_SYNC_TICKS) == 0U)
+  {
+    TraceRecorder_Event(TRACE_EVT_HEADER, NULL, TRACE_RECORDER_VERSION);
+  }
+
+  if (ulTraceSending == 0U)
+  {
+    prvTraceStartTransfer();
+  }
+}
+
+/**
+  * @brief  DMA1 Stream 6 interrupt: release the slots that have been sent and
+  *         start on the next run.
+  * @retval None
+  */
+void TraceRecorder_IRQHandler(void)
+{
+  uint32_t ulSent = ulTraceSending;
+  uint32_t ulTail = ulTraceTail;
+  uint32_t i;
+
+  DMA1->HIFCR = TRACE_RECORDER_DMA_FLAGS;
+
+  for (i = 0U; i < ulSent; i++)
+  {
+    xTraceBuffer[(ulTail + i) & TRACE_RECORDER_INDEX_MASK].ucEvent = TRACE_EVT_NONE;
+  }
+
+  /* The slots must read as empty before writers are allowed to reuse them. */
+  __atomic_store_n(&ulTraceTail, ulTail + ulSent, __ATOMIC_RELEASE);
+  ulTraceSending = 0U;
+
+  prvTraceStartTransfer();
+}
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Claim ulCount consecutive slots.
+  * @retval 1 with the first index in *pulIndex, or 0 if the buffer is full.
+  */
+static uint32_t prvTraceReserve(uint32_t ulCount, uint32_t *pulIndex)
+{
+  uint32_t ulHead = __atomic_load_n(&ulTraceHead, __ATOMIC_RELAXED);
+
+  do
+  {
+    if ((ulHead - ulTraceTail) > (TRACE_RECORDER_BUFFER_EVENTS - ulCount))
+    {
+      __atomic_fetch_add(&ulTraceDropped, ulCount, __ATOMIC_RELAXED);
+      return 0U;
+    }
+  } while (__atomic_compare_exchange_n(&ulTraceHead, &ulHead, ulHead + ulCount, pdTRUE,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) == 0);
+
+  *pulIndex = ulHead;
+  return 1U;
+}
+
+static void prvTraceCommit(uint32_t ulIndex, uint32_t ulTimestamp, uint16_t usObject,
+                           uint32_t ulArg, uint8_t ucEvent)
+{
+  TraceEvent_t *pxEvent = &xTraceBuffer[ulIndex & TRACE_RECORDER_INDEX_MASK];
+
+  pxEvent->ulTimestamp = ulTimestamp;
+  pxEvent->usObject = usObject;
+  pxEvent->ucArg = (ulArg > 0xFFU) ? 0xFFU : (uint8_t) ulArg;
+  __atomic_store_n(&pxEvent->ucEvent, ucEvent, __ATOMIC_RELEASE);
+}
+
+static uint16_t prvTraceObjectID(const void *pvObject)
+{
+  if (pvObject == NULL)
+  {
+    return TRACE_OBJECT_NONE;
+  }
+
+  return (uint16_t) (((uint32_t) pvObject - TRACE_RECORDER_RAM_BASE) >> 2U);
+}
+
+/**
+  * @brief  Send the complete events at the tail, up to the end of the buffer.
+  * @note   Called from the tick and DMA interrupts only, which share a priority.
+  */
+static void prvTraceStartTransfer(void)
+{
+  uint32_t ulTail = ulTraceTail;
+  uint32_t ulHead = __atomic_load_n(&ulTraceHead, __ATOMIC_ACQUIRE);
+  uint32_t ulSlot = ulTail & TRACE_RECORDER_INDEX_MASK;
+  uint32_t ulCount = 0U;
+
+  while (((ulTail + ulCount) != ulHead) &&
+         ((ulSlot + ulCount) < TRACE_RECORDER_BUFFER_EVENTS) &&
+         (__atomic_load_n(&xTraceBuffer[ulSlot + ulCount].ucEvent, __ATOMIC_ACQUIRE) != TRACE_EVT_NONE))
+  {
+    ulCount++;
+  }
+
+  if (ulCount == 0U)
+  {
+    return;
+  }
+
+  ulTraceSending = ulCount;
+  TRACE_RECORDER_DMA_STREAM->M0AR = (uint32_t) &xTraceBuffer[ulSlot];
+  TRACE_RECORDER_DMA_STREAM->NDTR = ulCount * sizeof(TraceEvent_t);
+  DMA1->HIFCR = TRACE_RECORDER_DMA_FLAGS;
+  TRACE_RECORDER_DMA_STREAM->CR |= DMA_SxCR_EN;
+}
+
+#endif /* configUSE_TRACE_RECORDER */
@@ -860,19 +860,137 @@ osStatus osSemaphoreDelete (osSemaphoreId semaphore_id)
 
 #if (defined (osFeature_Pool)  &&  (osFeature_Pool != 0)) 
 
-//TODO
-//This is a primitive and inefficient wrapper around the existing FreeRTOS memory management.
-//A better implementation will have to modify heap_x.c!
+/* The free blocks of a pool form a singly linked list threaded through the
+   first word of each block, so allocating and freeing a block takes the same
+   few instructions whatever the size of the pool.
+
+   On ARMv7-M and ARMv8-M mainline the list head and the counters are updated
+   with LDREX/STREX, so the pools never mask interrupts and can be used from
+   tasks and from interrupts of any priority.  Exception entry and return
+   clear the exclusive monitor, so a STREX fails whenever anything else ran
+   since its LDREX.  That also rules out the ABA problem of a compare and swap
+   on the list head: a block taken and given back by an interrupt in between
+   makes the STREX fail rather than succeed with a stale next pointer.  Other
+   cores update them inside a short interrupt mask instead.
+
+   A block is counted as in use from just before it leaves the free list until
+   just after it returns to it.  Reserving the count first, and only while it
+   is below the size of the pool, guarantees the list holds a block for every
+   reservation, so taking one never fails. */
+#if ((defined (__ARM_ARCH_7M__      ) && (__ARM_ARCH_7M__      == 1)) || \
+     (defined (__ARM_ARCH_7EM__     ) && (__ARM_ARCH_7EM__     == 1)) || \
+     (defined (__ARM_ARCH_8M_MAIN__ ) && (__ARM_ARCH_8M_MAIN__ == 1))    )
+  #define POOL_USE_EXCLUSIVE_ACCESS  1
+#else
+  #define POOL_USE_EXCLUSIVE_ACCESS  0
+#endif
 
+typedef struct os_pool_block {
+  struct os_pool_block *next;
+} os_pool_block_t;
 
 typedef struct os_pool_cb {
   void *pool;
-  uint8_t *markers;
+  os_pool_block_t * volatile free_list;
   uint32_t pool_sz;
   uint32_t item_sz;
-  uint32_t currentIndex;
+  volatile uint32_t used;
+  volatile uint32_t max_used;
 } os_pool_cb_t;
 
+#if (POOL_USE_EXCLUSIVE_ACCESS == 1)
+
+/* Take a block off the free list of a pool, or return NULL if the pool has
+   none left. */
+static void *poolTake (osPoolId pool_id)
+{
+  uint32_t used;
+  uint32_t max_used;
+  os_pool_block_t *block;
+  
+  /* Reserve a block. */
+  do {
+    used = __LDREXW(&pool_id->used);
+    if (used >= pool_id->pool_sz) {
+      __CLREX();
+      return NULL;
+    }
+    used++;
+  } while (__STREXW(used, &pool_id->used) != 0);
+  
+  /* Raise the high water mark to it. */
+  do {
+    max_used = __LDREXW(&pool_id->max_used);
+    if (used <= max_used) {
+      __CLREX();
+      break;
+    }
+  } while (__STREXW(used, &pool_id->max_used) != 0);
+  
+  /* The list now holds at least one block for this reservation. */
+  do {
+    block = (os_pool_block_t *)__LDREXW((volatile uint32_t *)&pool_id->free_list);
+  } while (__STREXW((uint32_t)block->next, (volatile uint32_t *)&pool_id->free_list) != 0);
+  
+  return block;
+}
+
+/* Give a block back to the free list of a pool. */
+static void poolGive (osPoolId pool_id, void *block)
+{
+  uint32_t used;
+  
+  do {
+    ((os_pool_block_t *)block)->next = (os_pool_block_t *)__LDREXW((volatile uint32_t *)&pool_id->free_list);
+    /* The link must be written before the block is published. */
+    __COMPILER_BARRIER();
+  } while (__STREXW((uint32_t)block, (volatile uint32_t *)&pool_id->free_list) != 0);
+  
+  /* Then release its reservation. */
+  do {
+    used = __LDREXW(&pool_id->used) - 1;
+  } while (__STREXW(used, &pool_id->used) != 0);
+}
+
+#else
+
+static void *poolTake (osPoolId pool_id)
+{
+  UBaseType_t mask;
+  os_pool_block_t *block = NULL;
+  
+  mask = portSET_INTERRUPT_MASK_FROM_ISR();
+  
+  if (pool_id->used < pool_id->pool_sz) {
+    block = pool_id->free_list;
+    pool_id->free_list = block->next;
+    
+    pool_id->used++;
+    if (pool_id->used > pool_id->max_used) {
+      pool_id->max_used = pool_id->used;
+    }
+  }
+  
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+  
+  return block;
+}
+
+static void poolGive (osPoolId pool_id, void *block)
+{
+  UBaseType_t mask;
+  
+  mask = portSET_INTERRUPT_MASK_FROM_ISR();
+  
+  ((os_pool_block_t *)block)->next = pool_id->free_list;
+  pool_id->free_list = (os_pool_block_t *)block;
+  pool_id->used--;
+  
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+#endif /* POOL_USE_EXCLUSIVE_ACCESS */
+
 
 /**
 * @brief Create and Initialize a memory pool
@@ -884,35 +1002,36 @@ osPoolId osPoolCreate (const osPoolDef_t *pool_def)
 {
 #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
   osPoolId thePool;
-  int itemSize = 4 * ((pool_def->item_sz + 3) / 4);
+  /* Every block must hold the free list link. */
+  uint32_t itemSize = sizeof(os_pool_block_t) * ((pool_def->item_sz + sizeof(os_pool_block_t) - 1) / sizeof(os_pool_block_t));
   uint32_t i;
+  os_pool_block_t *block;
+  
+  if ((pool_def->pool_sz == 0) || (itemSize == 0)) {
+    return NULL;
+  }
   
   /* First have to allocate memory for the pool control block. */
- thePool = pvPortMalloc(sizeof(os_pool_cb_t));
-
+  thePool = pvPortMalloc(sizeof(os_pool_cb_t));
   
   if (thePool) {
     thePool->pool_sz = pool_def->pool_sz;
     thePool->item_sz = itemSize;
-    thePool->currentIndex = 0;
+    thePool->used = 0;
+    thePool->max_used = 0;
     
-    /* Memory for markers */
-    thePool->markers = pvPortMalloc(pool_def->pool_sz);
-   
-    if (thePool->markers) {
-      /* Now allocate the pool itself. */
-     thePool->pool = pvPortMalloc(pool_def->pool_sz * itemSize);
-      
-      if (thePool->pool) {
-        for (i = 0; i < pool_def->pool_sz; i++) {
-          thePool->markers[i] = 0;
-        }
-      }
-      else {
-        vPortFree(thePool->markers);
-        vPortFree(thePool);
-        thePool = NULL;
+    /* Now allocate the pool itself. */
+    thePool->pool = pvPortMalloc(pool_def->pool_sz * itemSize);
+    
+    if (thePool->pool) {
+      /* Link the blocks in address order, so the first allocations come
+         from the start of the pool. */
+      block = NULL;
+      for (i = pool_def->pool_sz; i > 0; i--) {
+        ((os_pool_block_t *)((uint8_t *)thePool->pool + ((i - 1) * itemSize)))->next = block;
+        block = (os_pool_block_t *)((uint8_t *)thePool->pool + ((i - 1) * itemSize));
       }
+      thePool->free_list = block;
     }
     else {
       vPortFree(thePool);
@@ -935,37 +1054,11 @@ osPoolId osPoolCreate (const osPoolDef_t *pool_def)
 */
 void *osPoolAlloc (osPoolId pool_id)
 {
-  int dummy = 0;
-  void *p = NULL;
-  uint32_t i;
-  uint32_t index;
-  
-  if (inHandlerMode()) {
-    dummy = portSET_INTERRUPT_MASK_FROM_ISR();
-  }
-  else {
-    vPortEnterCritical();
-  }
-  
-  for (i = 0; i < pool_id->pool_sz; i++) {
-    index = (pool_id->currentIndex + i) % pool_id->pool_sz;
-    
-    if (pool_id->markers[index] == 0) {
-      pool_id->markers[index] = 1;
-      p = (void *)((uint32_t)(pool_id->pool) + (index * pool_id->item_sz));
-      pool_id->currentIndex = index;
-      break;
-    }
-  }
-  
-  if (inHandlerMode()) {
-    portCLEAR_INTERRUPT_MASK_FROM_ISR(dummy);
-  }
-  else {
-    vPortExitCritical();
+  if (pool_id == NULL) {
+    return NULL;
   }
   
-  return p;
+  return poolTake(pool_id);
 }
 
 /**
@@ -980,7 +1073,7 @@ void *osPoolCAlloc (osPoolId pool_id)
   
   if (p != NULL)
   {
-    memset(p, 0, sizeof(pool_id->pool_sz));
+    memset(p, 0, pool_id->item_sz);
   }
   
   return p;
@@ -1009,7 +1102,7 @@ osStatus osPoolFree (osPoolId pool_id, void *block)
     return osErrorParameter;
   }
   
-  index = (uint32_t)block - (uint32_t)(pool_id->pool);
+  index = (uint32_t)((uint8_t *)block - (uint8_t *)pool_id->pool);
   if (index % pool_id->item_sz) {
     return osErrorParameter;
   }
@@ -1018,11 +1111,27 @@ osStatus osPoolFree (osPoolId pool_id, void *block)
     return osErrorParameter;
   }
   
-  pool_id->markers[index] = 0;
+  /* There is no record of which blocks are free, so a block freed twice
+     goes on the list twice. */
+  poolGive(pool_id, block);
   
   return osOK;
 }
 
+/**
+* @brief  Get the largest number of blocks of a memory pool in use at once.
+* @param  pool_id       memory pool ID obtain referenced with \ref osPoolCreate.
+* @retval high water mark of the pool, or 0 if pool_id is NULL.
+*/
+uint32_t osPoolGetHighWaterMark (osPoolId pool_id)
+{
+  if (pool_id == NULL) {
+    return 0;
+  }
+  
+  return pool_id->max_used;
+}
+
 
 #endif   /* Use Memory Pool Management */
 
@@ -1152,10 +1261,18 @@ osEvent osMessageGet (osMessageQId queue_id, uint32_t millisec)
 #if (defined (osFeature_MailQ)  &&  (osFeature_MailQ != 0))  /* Use Mail Queues */
 
 
+/* With counting semaphores, free_blocks holds a token for each free block of
+   the pool.  osMailAlloc() waits for a token before it takes a block, so it
+   blocks while the pool is empty and always finds a block once it has one,
+   and tasks waiting for a block are woken highest priority first as
+   osMailFree() returns them. */
 typedef struct os_mailQ_cb {
   const osMailQDef_t *queue_def;
   QueueHandle_t handle;
   osPoolId pool;
+#if (configUSE_COUNTING_SEMAPHORES == 1)
+  SemaphoreHandle_t free_blocks;
+#endif
 } os_mailQ_cb_t;
 
 /**
@@ -1190,10 +1307,23 @@ osMailQId osMailCreate (const osMailQDef_t *queue_def, osThreadId thread_id)
     return NULL;
   }
   
+#if (configUSE_COUNTING_SEMAPHORES == 1)
+  /* Create the tokens of the free blocks */
+  (*(queue_def->cb))->free_blocks = xSemaphoreCreateCounting(queue_def->queue_sz, queue_def->queue_sz);
+  if ((*(queue_def->cb))->free_blocks == NULL) {
+    vQueueDelete((*(queue_def->cb))->handle);
+    vPortFree(*(queue_def->cb));
+    return NULL;
+  }
+#endif
+  
   /* Create a mail pool */
   (*(queue_def->cb))->pool = osPoolCreate(&pool_def);
   if ((*(queue_def->cb))->pool == NULL) {
-    //TODO: Delete queue. How to do it in FreeRTOS?
+#if (configUSE_COUNTING_SEMAPHORES == 1)
+    vSemaphoreDelete((*(queue_def->cb))->free_blocks);
+#endif
+    vQueueDelete((*(queue_def->cb))->handle);
     vPortFree(*(queue_def->cb));
     return NULL;
   }
@@ -1210,18 +1340,51 @@ osMailQId osMailCreate (const osMailQDef_t *queue_def, osThreadId thread_id)
 * @param  millisec      timeout value or 0 in case of no time-out.
 * @retval pointer to memory block that can be filled with mail or NULL in case error.
 * @note   MUST REMAIN UNCHANGED: \b osMailAlloc shall be consistent in every CMSIS-RTOS.
+* @note   From an interrupt, and without counting semaphores, the call does not
+*         wait for a block and millisec is ignored.
 */
 void *osMailAlloc (osMailQId queue_id, uint32_t millisec)
 {
-  (void) millisec;
   void *p;
+#if (configUSE_COUNTING_SEMAPHORES == 1)
+  TickType_t ticks;
+#endif
   
   
   if (queue_id == NULL) {
     return NULL;
   }
   
+#if (configUSE_COUNTING_SEMAPHORES == 1)
+  ticks = 0;
+  if (millisec == osWaitForever) {
+    ticks = portMAX_DELAY;
+  }
+  else if (millisec != 0) {
+    ticks = millisec / portTICK_PERIOD_MS;
+    if (ticks == 0) {
+      ticks = 1;
+    }
+  }
+  
+  /* Taking a token never unblocks a task, so there is no switch to request
+     from an interrupt. */
+  if (inHandlerMode()) {
+    if (xSemaphoreTakeFromISR(queue_id->free_blocks, NULL) != pdTRUE) {
+      return NULL;
+    }
+  }
+  else if (xSemaphoreTake(queue_id->free_blocks, ticks) != pdTRUE) {
+    return NULL;
+  }
+  
   p = osPoolAlloc(queue_id->pool);
+  configASSERT(p != NULL);
+#else
+  (void) millisec;
+  
+  p = osPoolAlloc(queue_id->pool);
+#endif
   
   return p;
 }
@@ -1345,11 +1508,34 @@ osEvent osMailGet (osMailQId queue_id, uint32_t millisec)
 */
 osStatus osMailFree (osMailQId queue_id, void *mail)
 {
+#if (configUSE_COUNTING_SEMAPHORES == 1)
+  portBASE_TYPE taskWoken = pdFALSE;
+  osStatus status;
+#endif
+  
   if (queue_id == NULL) {
     return osErrorParameter;
   }
   
+#if (configUSE_COUNTING_SEMAPHORES == 1)
+  status = osPoolFree(queue_id->pool, mail);
+  if (status != osOK) {
+    return status;
+  }
+  
+  /* Hand the block to the highest priority task waiting for one. */
+  if (inHandlerMode()) {
+    (void) xSemaphoreGiveFromISR(queue_id->free_blocks, &taskWoken);
+    portEND_SWITCHING_ISR(taskWoken);
+  }
+  else {
+    (void) xSemaphoreGive(queue_id->free_blocks);
+  }
+  
+  return osOK;
+#else
   return osPoolFree(queue_id->pool, mail);
+#endif
 }
 #endif  /* Use Mail Queues */
 
@@ -1019,6 +1019,15 @@ osStatus osRecursiveMutexWait (osMutexId mutex_id, uint32_t millisec);
 */
 uint32_t osSemaphoreGetCount(osSemaphoreId semaphore_id);
 
+#if (defined (osFeature_Pool)  &&  (osFeature_Pool != 0))
+/**
+* @brief  Get the largest number of blocks of a memory pool in use at once.
+* @param  pool_id       memory pool ID obtain referenced with \ref osPoolCreate.
+* @retval high water mark of the pool, or 0 if pool_id is NULL.
+*/
+uint32_t osPoolGetHighWaterMark (osPoolId pool_id);
+#endif /* osFeature_Pool */
+
 #ifdef  __cplusplus
 }
 #endif
@@ -206,6 +206,14 @@ extern "C" {
 	#define configUSE_MUTEXES 0
 #endif
 
+#ifndef configPRIORITY_INHERITANCE_DEPTH
+	/* The number of mutex holders along a chain of blocked tasks that inherit
+	the priority of a task that blocks on a mutex.  1 raises only the task that
+	holds the mutex.  Greater values also raise the holder of the mutex that
+	task is itself blocked on, and so on. */
+	#define configPRIORITY_INHERITANCE_DEPTH 1
+#endif
+
 #ifndef configUSE_TIMERS
 	#define configUSE_TIMERS 0
 #endif
@@ -734,6 +742,29 @@ hold explicit before calling the code. */
 	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
 
+#ifndef configGENERATE_RUN_TIME_CYCLE_STATS
+	#define configGENERATE_RUN_TIME_CYCLE_STATS 0
+#endif
+
+#if ( configGENERATE_RUN_TIME_CYCLE_STATS == 1 )
+
+	#ifndef portGET_CYCLE_COUNTER_VALUE
+		#error If configGENERATE_RUN_TIME_CYCLE_STATS is defined then the port must define portGET_CYCLE_COUNTER_VALUE() to return a free running 32-bit count of CPU cycles, such as DWT_CYCCNT on ARM Cortex-M3/M4/M7 cores.
+	#endif /* portGET_CYCLE_COUNTER_VALUE */
+
+#endif /* configGENERATE_RUN_TIME_CYCLE_STATS */
+
+#ifndef portCONFIGURE_CYCLE_COUNTER
+	#define portCONFIGURE_CYCLE_COUNTER()
+#endif
+
+#ifndef portSET_STACK_GUARD
+	/* Called with the stack of the task that is about to enter the Running
+	state, so ports that can protect the end of a stack in hardware can move the
+	protected region to that stack. */
+	#define portSET_STACK_GUARD( pxStack )
+#endif
+
 #ifndef configUSE_MALLOC_FAILED_HOOK
 	#define configUSE_MALLOC_FAILED_HOOK 0
 #endif
@@ -794,6 +825,113 @@ hold explicit before calling the code. */
 	#define configUSE_TIME_SLICING 1
 #endif
 
+#ifndef configUSE_PER_TASK_TIME_SLICE
+	/* Set to 1 to allow each task to run for its own number of ticks before
+	it is round robin scheduled with ready tasks of equal priority.  See
+	vTaskSetTimeSlice(). */
+	#define configUSE_PER_TASK_TIME_SLICE 0
+#endif
+
+#ifndef configDEFAULT_TIME_SLICE_TICKS
+	/* The time slice, in ticks, given to a task when it is created. */
+	#define configDEFAULT_TIME_SLICE_TICKS 1
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+	/* Set to 1 to schedule the Ready state tasks at priority
+	configEDF_TASK_PRIORITY by earliest absolute deadline, rather than round
+	robin.  See vTaskEDFRegister(). */
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#ifndef configUSE_TASK_POOL
+	/* Set to 1 to have xTaskCreate() take the TCB and stack of a new task from
+	a pool of configTASK_POOL_SLOTS statically allocated slots, each with a
+	stack of configTASK_POOL_STACK_DEPTH words, before falling back to the heap.
+	Slots are returned to the pool as soon as their task is deleted, without
+	waiting for the idle task.  See vTaskGetPoolStats(). */
+	#define configUSE_TASK_POOL 0
+#endif
+
+#ifndef configTASK_POOL_SLOTS
+	#define configTASK_POOL_SLOTS 4
+#endif
+
+#ifndef configTASK_POOL_STACK_DEPTH
+	#define configTASK_POOL_STACK_DEPTH configMINIMAL_STACK_SIZE
+#endif
+
+#ifndef configUSE_TIMING_WHEEL
+	/* Set to 1 to hold blocked tasks in a hierarchical timing wheel, rather
+	than a sorted delayed list, so entering the Blocked state with a timeout is
+	O(1) instead of O(number of delayed tasks). */
+	#define configUSE_TIMING_WHEEL 0
+#endif
+
+#ifndef configTIMING_WHEEL_LEVELS
+	/* Each level of the timing wheel has 32 slots, so the wheel covers timeouts
+	of up to 32^configTIMING_WHEEL_LEVELS ticks.  Longer timeouts fall back to
+	the sorted delayed lists. */
+	#define configTIMING_WHEEL_LEVELS 2
+#endif
+
+#ifndef configUSE_BATCHED_WAKEUPS
+	/* Set to 1 to have the tick interrupt make at most
+	configBATCHED_WAKEUP_LIMIT of the tasks whose timeout expires on that tick
+	ready, and to leave the rest to be made ready when the scheduler next
+	selects a task.  This bounds the work done in the tick interrupt when many
+	tasks wake on the same tick. */
+	#define configUSE_BATCHED_WAKEUPS 0
+#endif
+
+#ifndef configBATCHED_WAKEUP_LIMIT
+	/* The number of timed out tasks the tick interrupt makes ready itself when
+	configUSE_BATCHED_WAKEUPS is 1.  0 leaves them all to the context
+	switch. */
+	#define configBATCHED_WAKEUP_LIMIT 4
+#endif
+
+#ifndef configUSE_MICROSECOND_DELAYS
+	/* Set to 1 to include vTaskDelayMicroseconds() and
+	xTaskNotifyWaitIndexedMicroseconds(), which unblock tasks from a
+	microsecond alarm rather than the tick.  The application must then define
+	configMICROSECOND_TIMER_COUNT() and configMICROSECOND_TIMER_SET_ALARM(), and
+	call xTaskMicrosecondAlarmFromISR() from the alarm interrupt. */
+	#define configUSE_MICROSECOND_DELAYS 0
+#endif
+
+#ifndef configNUMBER_OF_CORES
+	/* The number of cores the scheduler runs tasks on.  With more than one
+	core the port must also define portGET_CORE_ID(), portYIELD_CORE(),
+	portGET_TASK_LOCK(), portRELEASE_TASK_LOCK(), portGET_ISR_LOCK(),
+	portRELEASE_ISR_LOCK(), portSET_INTERRUPT_MASK() and
+	portCLEAR_INTERRUPT_MASK().  The two locks are spinlocks shared by all cores
+	that a core may take again while it holds them.  Critical sections take both
+	locks, as does vTaskSwitchContext(), taskENTER_CRITICAL_FROM_ISR() takes the
+	ISR lock, and suspending the scheduler holds the task lock until it
+	resumes. */
+	#define configNUMBER_OF_CORES 1
+#endif
+
+#ifndef configUSE_CORE_AFFINITY
+	/* Set to 1 to give each task a mask of the cores it may run on.  See
+	vTaskCoreAffinitySet() and xTaskCreateAffinitySet(). */
+	#define configUSE_CORE_AFFINITY 0
+#endif
+
+#ifndef configUSE_TASK_ARENAS
+	/* Set to 1 to include pvTaskArenaAlloc() and vTaskArenaReset(), which
+	allocate from chunks of heap owned by the calling task.  The chunks are
+	kept when the arena is reset, and freed when the task is deleted. */
+	#define configUSE_TASK_ARENAS 0
+#endif
+
+#ifndef configTASK_ARENA_CHUNK_SIZE
+	/* The usable size, in bytes, of each chunk a task arena takes from the
+	heap.  Allocations larger than this get a chunk of their own. */
+	#define configTASK_ARENA_CHUNK_SIZE 256
+#endif
+
 #ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
 	#define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS 0
 #endif
@@ -830,10 +968,91 @@ hold explicit before calling the code. */
 	#define configAPPLICATION_ALLOCATED_HEAP 0
 #endif
 
+#ifndef configUSE_APPLICATION_HEAP_REGION
+	/* Set to 1 to have heap_4.c manage the RAM from configHEAP_REGION_START()
+	up to configHEAP_REGION_END(), rather than an array of configTOTAL_HEAP_SIZE
+	bytes.  Both are evaluated when the heap is initialised, so the region can
+	be taken from linker symbols, for example to give the heap all the RAM left
+	after .bss. */
+	#define configUSE_APPLICATION_HEAP_REGION 0
+#endif
+
+#ifndef configUSE_TLSF_HEAP
+	/* Set to 1 to build portable/MemMang/heap_tlsf.c instead of heap_4.c.
+	Both files can then be kept in a project that compiles every file in the
+	MemMang directory. */
+	#define configUSE_TLSF_HEAP 0
+#endif
+
+#ifndef configTLSF_SL_INDEX_COUNT_LOG2
+	/* heap_tlsf.c splits each power of two of block sizes into
+	2 ^ configTLSF_SL_INDEX_COUNT_LOG2 free lists.  More lists waste less of
+	each block allocated, at the cost of a larger table of list heads. */
+	#define configTLSF_SL_INDEX_COUNT_LOG2 4
+#endif
+
+#ifndef configUSE_HEAP_SLABS
+	/* Set to 1 to have heap_4.c serve small allocations from pages of equal
+	sized objects, one list of pages per size class.  These objects have no
+	block header and are allocated and freed in constant time.  Larger sizes,
+	and small sizes when no page can be taken from the heap, are allocated as
+	normal.  See uxPortGetSlabStats(). */
+	#define configUSE_HEAP_SLABS 0
+#endif
+
+#ifndef configHEAP_SLAB_PAGE_SIZE
+	/* The size, in bytes, of the pages heap_4.c takes from the heap for the
+	slab size classes.  Must be a power of two.  Space at the end of a page that
+	is too small for another object of its class is wasted, so the page size
+	should suit the largest classes. */
+	#define configHEAP_SLAB_PAGE_SIZE 512
+#endif
+
+#ifndef configHEAP_SLAB_KEEP_EMPTY_PAGE
+	/* Set to 1 to have each slab size class keep one empty page instead of
+	giving it back to the heap, so a class that allocates and frees one object
+	at a time does not take a page from the heap each time.  Each kept page is
+	configHEAP_SLAB_PAGE_SIZE bytes the rest of the heap cannot use, which on a
+	small heap is a large share of it. */
+	#define configHEAP_SLAB_KEEP_EMPTY_PAGE 0
+#endif
+
+#ifndef configHEAP_SLAB_OBJECT_SIZES
+	/* The object size of each slab size class, as an array initialiser.  An
+	allocation uses the smallest class it fits in.  The default has classes for
+	small messages and for the kernel objects most often created and deleted
+	at run time. */
+	#define configHEAP_SLAB_OBJECT_SIZES { 8, 16, 32, sizeof( StaticEventGroup_t ), sizeof( StaticQueue_t ), sizeof( StaticTask_t ) }
+#endif
+
+#ifndef configUSE_HEAP_TELEMETRY
+	/* Set to 1 to have heap_4.c keep a histogram of the sizes of its free
+	blocks, histograms of the cycles pvPortMalloc() and vPortFree() take, and
+	a record of the most recent allocations that failed.  See
+	vPortGetHeapTelemetry(). */
+	#define configUSE_HEAP_TELEMETRY 0
+#endif
+
+#ifndef configHEAP_TELEMETRY_CALLER
+	/* The call site recorded with a failed allocation.  Expanded inside
+	pvPortMalloc(). */
+	#if defined( __GNUC__ )
+		#define configHEAP_TELEMETRY_CALLER() __builtin_return_address( 0 )
+	#else
+		#define configHEAP_TELEMETRY_CALLER() NULL
+	#endif
+#endif
+
 #ifndef configUSE_TASK_NOTIFICATIONS
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	/* The number of independent notification values each task has.  The
+	functions without an "Indexed" suffix use index 0. */
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
 #ifndef configUSE_POSIX_ERRNO
 	#define configUSE_POSIX_ERRNO 0
 #endif
@@ -880,6 +1099,115 @@ hold explicit before calling the code. */
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( configPRIORITY_INHERITANCE_DEPTH < 1 )
+	#error configPRIORITY_INHERITANCE_DEPTH must be at least 1
+#endif
+
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES < 1 )
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
+#if( configUSE_PER_TASK_TIME_SLICE == 1 )
+	#if( ( configUSE_PREEMPTION != 1 ) || ( configUSE_TIME_SLICING != 1 ) )
+		#error configUSE_PREEMPTION and configUSE_TIME_SLICING must be set to 1 if configUSE_PER_TASK_TIME_SLICE is set to 1
+	#endif
+	#if( configDEFAULT_TIME_SLICE_TICKS < 1 )
+		#error configDEFAULT_TIME_SLICE_TICKS must be at least 1
+	#endif
+#endif /* configUSE_PER_TASK_TIME_SLICE */
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+	#ifndef configEDF_TASK_PRIORITY
+		#error configEDF_TASK_PRIORITY must be defined in FreeRTOSConfig.h if configUSE_EDF_SCHEDULING is set to 1
+	#endif
+	#if( ( configEDF_TASK_PRIORITY < 1 ) || ( configEDF_TASK_PRIORITY >= configMAX_PRIORITIES ) )
+		#error configEDF_TASK_PRIORITY must be above the idle priority and less than configMAX_PRIORITIES
+	#endif
+	#if( ( configUSE_PREEMPTION != 1 ) || ( INCLUDE_vTaskDelayUntil != 1 ) )
+		#error configUSE_PREEMPTION and INCLUDE_vTaskDelayUntil must be set to 1 if configUSE_EDF_SCHEDULING is set to 1
+	#endif
+#endif /* configUSE_EDF_SCHEDULING */
+
+#if( configUSE_TASK_POOL == 1 )
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) || ( configSUPPORT_STATIC_ALLOCATION != 1 ) || ( portUSING_MPU_WRAPPERS != 0 ) )
+		#error configSUPPORT_DYNAMIC_ALLOCATION and configSUPPORT_STATIC_ALLOCATION must be set to 1, and MPU wrappers cannot be used, if configUSE_TASK_POOL is set to 1
+	#endif
+	#if( configTASK_POOL_SLOTS < 1 )
+		#error configTASK_POOL_SLOTS must be at least 1
+	#endif
+#endif /* configUSE_TASK_POOL */
+
+#if( ( configUSE_TASK_ARENAS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 if configUSE_TASK_ARENAS is set to 1
+#endif
+
+#if( configUSE_HEAP_SLABS == 1 )
+	#if( configUSE_TLSF_HEAP == 1 )
+		#error configUSE_HEAP_SLABS is only implemented by heap_4.c, so cannot be used if configUSE_TLSF_HEAP is set to 1
+	#endif
+	#if( ( configHEAP_SLAB_PAGE_SIZE < 64 ) || ( configHEAP_SLAB_PAGE_SIZE > 65536 ) || ( ( configHEAP_SLAB_PAGE_SIZE & ( configHEAP_SLAB_PAGE_SIZE - 1 ) ) != 0 ) )
+		#error configHEAP_SLAB_PAGE_SIZE must be a power of two from 64 to 65536
+	#endif
+#endif /* configUSE_HEAP_SLABS */
+
+#if( configUSE_APPLICATION_HEAP_REGION == 1 )
+	#if( ( configUSE_TLSF_HEAP == 1 ) || ( configAPPLICATION_ALLOCATED_HEAP == 1 ) )
+		#error configUSE_APPLICATION_HEAP_REGION is only implemented by heap_4.c, and replaces configAPPLICATION_ALLOCATED_HEAP, so cannot be used if configUSE_TLSF_HEAP or configAPPLICATION_ALLOCATED_HEAP is set to 1
+	#endif
+	#if !defined( configHEAP_REGION_START ) || !defined( configHEAP_REGION_END )
+		#error configHEAP_REGION_START() and configHEAP_REGION_END() must be defined to return the first byte of the heap and the byte after its last if configUSE_APPLICATION_HEAP_REGION is set to 1
+	#endif
+#endif /* configUSE_APPLICATION_HEAP_REGION */
+
+#if( configUSE_HEAP_TELEMETRY == 1 )
+	#if( configUSE_TLSF_HEAP == 1 )
+		#error configUSE_HEAP_TELEMETRY is only implemented by heap_4.c, so cannot be used if configUSE_TLSF_HEAP is set to 1
+	#endif
+	#ifndef portGET_CYCLE_COUNTER_VALUE
+		#error If configUSE_HEAP_TELEMETRY is set to 1 then the port must define portGET_CYCLE_COUNTER_VALUE() to return a free running 32-bit count of CPU cycles.
+	#endif
+#endif /* configUSE_HEAP_TELEMETRY */
+
+#if( configUSE_TIMING_WHEEL == 1 )
+	#if( ( configTIMING_WHEEL_LEVELS < 1 ) || ( ( configUSE_16_BIT_TICKS == 1 ) && ( configTIMING_WHEEL_LEVELS > 3 ) ) || ( configTIMING_WHEEL_LEVELS > 6 ) )
+		#error configTIMING_WHEEL_LEVELS must be between 1 and 6, or between 1 and 3 if configUSE_16_BIT_TICKS is 1
+	#endif
+#endif /* configUSE_TIMING_WHEEL */
+
+#if( configUSE_MICROSECOND_DELAYS == 1 )
+	#ifndef configMICROSECOND_TIMER_COUNT
+		#error configMICROSECOND_TIMER_COUNT() must be defined to return the value of a free running 32-bit microsecond counter if configUSE_MICROSECOND_DELAYS is set to 1
+	#endif
+	#ifndef configMICROSECOND_TIMER_SET_ALARM
+		#error configMICROSECOND_TIMER_SET_ALARM( ulCount ) must be defined to request an interrupt when the microsecond counter reaches ulCount, or at once if it already has, if configUSE_MICROSECOND_DELAYS is set to 1
+	#endif
+#endif /* configUSE_MICROSECOND_DELAYS */
+
+#if( configNUMBER_OF_CORES > 1 )
+	#if !defined( portGET_CORE_ID ) || !defined( portYIELD_CORE )
+		#error portGET_CORE_ID() and portYIELD_CORE( xCoreID ) must be defined by the port if configNUMBER_OF_CORES is greater than 1
+	#endif
+	#if !defined( portGET_TASK_LOCK ) || !defined( portRELEASE_TASK_LOCK ) || !defined( portGET_ISR_LOCK ) || !defined( portRELEASE_ISR_LOCK )
+		#error portGET_TASK_LOCK(), portRELEASE_TASK_LOCK(), portGET_ISR_LOCK() and portRELEASE_ISR_LOCK() must be defined by the port if configNUMBER_OF_CORES is greater than 1
+	#endif
+	#if !defined( portSET_INTERRUPT_MASK ) || !defined( portCLEAR_INTERRUPT_MASK ) || ( portCRITICAL_NESTING_IN_TCB != 1 )
+		#error portSET_INTERRUPT_MASK() and portCLEAR_INTERRUPT_MASK() must be defined, and portCRITICAL_NESTING_IN_TCB set to 1, by the port if configNUMBER_OF_CORES is greater than 1
+	#endif
+	#if( ( configUSE_PREEMPTION != 1 ) || ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) || ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 ) )
+		#error configUSE_PREEMPTION and configSUPPORT_DYNAMIC_ALLOCATION must be set to 1, and configUSE_PORT_OPTIMISED_TASK_SELECTION to 0, if configNUMBER_OF_CORES is greater than 1
+	#endif
+	#if( ( configUSE_TICKLESS_IDLE != 0 ) || ( configUSE_PER_TASK_TIME_SLICE != 0 ) || ( configUSE_EDF_SCHEDULING != 0 ) || ( configUSE_TASK_POOL != 0 ) || ( configUSE_BATCHED_WAKEUPS != 0 ) || ( configUSE_MICROSECOND_DELAYS != 0 ) )
+		#error configUSE_TICKLESS_IDLE, configUSE_PER_TASK_TIME_SLICE, configUSE_EDF_SCHEDULING, configUSE_TASK_POOL, configUSE_BATCHED_WAKEUPS and configUSE_MICROSECOND_DELAYS are not supported if configNUMBER_OF_CORES is greater than 1
+	#endif
+	#if( ( configGENERATE_RUN_TIME_CYCLE_STATS != 0 ) || ( configUSE_NEWLIB_REENTRANT != 0 ) || ( configUSE_POSIX_ERRNO != 0 ) || ( configUSE_CO_ROUTINES != 0 ) || ( portUSING_MPU_WRAPPERS != 0 ) )
+		#error configGENERATE_RUN_TIME_CYCLE_STATS, configUSE_NEWLIB_REENTRANT, configUSE_POSIX_ERRNO, configUSE_CO_ROUTINES and MPU wrappers are not supported if configNUMBER_OF_CORES is greater than 1
+	#endif
+#endif /* configNUMBER_OF_CORES */
+
+#if( ( configUSE_CORE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
+	#error configNUMBER_OF_CORES must be greater than 1 if configUSE_CORE_AFFINITY is set to 1
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
 	#define configINITIAL_TICK_COUNT 0
 #endif
@@ -1131,6 +1459,27 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_MUTEXES == 1 )
 		UBaseType_t		uxDummy12[ 2 ];
 	#endif
+	#if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+		void			*pxDummy26;
+	#endif
+	#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+		UBaseType_t		uxDummy24[ 2 ];
+	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy25[ 3 ];
+	#endif
+	#if ( configUSE_MICROSECOND_DELAYS == 1 )
+		uint32_t		ulDummy27;
+	#endif
+	#if ( configNUMBER_OF_CORES > 1 )
+		BaseType_t		xDummy28;
+	#endif
+	#if ( configUSE_CORE_AFFINITY == 1 )
+		UBaseType_t		uxDummy29;
+	#endif
+	#if ( configUSE_TASK_ARENAS == 1 )
+		void			*pxDummy30[ 4 ];
+	#endif
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		void			*pxDummy14;
 	#endif
@@ -1140,12 +1489,15 @@ typedef struct xSTATIC_TCB
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		uint32_t		ulDummy16;
 	#endif
+	#if ( configGENERATE_RUN_TIME_CYCLE_STATS == 1 )
+		uint64_t		ullDummy23;
+	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
 		uint8_t			uxDummy20;
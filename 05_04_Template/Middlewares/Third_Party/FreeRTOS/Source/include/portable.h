@@ -138,6 +138,53 @@ typedef struct xHeapStats
 	size_t xNumberOfSuccessfulFrees;		/* The number of calls to vPortFree() that has successfully freed a block of memory. */
 } HeapStats_t;
 
+/* Used to pass information about each slab size class out of
+uxPortGetSlabStats(). */
+typedef struct xSlabStats
+{
+	size_t xObjectSize;						/* The size, in bytes, of the objects of the size class. */
+	size_t xNumberOfPages;					/* The number of heap pages the size class currently holds. */
+	size_t xObjectsInUse;					/* The number of objects of the size class that are currently allocated. */
+	size_t xObjectsFree;					/* The number of objects that would fit in the pages the size class holds but are not allocated. */
+} SlabStats_t;
+
+/* The number of buckets of each histogram in HeapTelemetry_t.  Bucket n counts
+values from 2 ^ ( n + heapTELEMETRY_BUCKET_SHIFT ) up to twice that, except
+that the first bucket also counts smaller values and the last bucket also
+counts larger values. */
+#define heapTELEMETRY_BUCKETS			16
+#define heapTELEMETRY_BUCKET_SHIFT		4
+
+/* The number of most recent failed allocations kept in HeapTelemetry_t. */
+#define heapTELEMETRY_FAILURE_RECORDS	4
+
+/* A failed call to pvPortMalloc(). */
+typedef struct xHeapFailureRecord
+{
+	void *pvCaller;							/* The return address of the call to pvPortMalloc(). */
+	size_t xWantedSize;						/* The number of bytes requested. */
+	size_t xFreeBytes;						/* The sum of all the free blocks at the time. */
+	size_t xLargestFreeBlock;				/* The size of the largest free block at the time. */
+	TickType_t xTickCount;					/* The tick count at the time. */
+} HeapFailureRecord_t;
+
+/* Used to pass the heap telemetry out of vPortGetHeapTelemetry().  Block sizes
+include the header of each block. */
+typedef struct xHeapTelemetry
+{
+	uint32_t ulFreeBlocks[ heapTELEMETRY_BUCKETS ];		/* The number of free blocks of each size. */
+	uint32_t ulMallocCycles[ heapTELEMETRY_BUCKETS ];	/* The number of calls to pvPortMalloc() that took each number of cycles. */
+	uint32_t ulFreeCycles[ heapTELEMETRY_BUCKETS ];		/* The number of calls to vPortFree() that took each number of cycles. */
+	uint32_t ulMaxMallocCycles;							/* The most cycles a call to pvPortMalloc() took. */
+	uint32_t ulMaxFreeCycles;							/* The most cycles a call to vPortFree() took. */
+	size_t xFreeBytes;									/* The sum of all the free blocks. */
+	size_t xLargestFreeBlock;							/* The size of the largest free block. */
+	uint32_t ulFragmentation;							/* The share of the free bytes that are not in the largest free block, in tenths of a percent. */
+	uint32_t ulWorstFragmentation;						/* The highest ulFragmentation seen when the telemetry was read or an allocation failed. */
+	uint32_t ulFailures;								/* The number of calls to pvPortMalloc() that failed. */
+	HeapFailureRecord_t xFailures[ heapTELEMETRY_FAILURE_RECORDS ];	/* The most recent failed calls, oldest first.  Only the first ulFailures are valid if ulFailures is less than heapTELEMETRY_FAILURE_RECORDS. */
+} HeapTelemetry_t;
+
 /*
  * Used to define multiple heap regions for use by heap_5.c.  This function
  * must be called before any calls to pvPortMalloc() - not creating a task,
@@ -157,11 +204,37 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEG
  */
 void vPortGetHeapStats( HeapStats_t *pxHeapStats );
 
+/*
+ * Fills pxSlabStats with the occupancy of each slab size class, up to
+ * uxArraySize classes, and returns the number of entries filled.  Only
+ * available from heap_4.c when configUSE_HEAP_SLABS is set to 1.
+ */
+UBaseType_t uxPortGetSlabStats( SlabStats_t *pxSlabStats, UBaseType_t uxArraySize );
+
+/*
+ * Fills pxTelemetry with the heap telemetry, and vPortResetHeapTelemetry()
+ * clears the cycle histograms, failure records and worst fragmentation kept
+ * since the last reset.  The free block histogram always describes the heap as
+ * it is.  Only available from heap_4.c when configUSE_HEAP_TELEMETRY is set to
+ * 1.
+ */
+void vPortGetHeapTelemetry( HeapTelemetry_t *pxTelemetry );
+void vPortResetHeapTelemetry( void );
+
 /*
  * Map to the memory management routines required for the port.
  */
 void *pvPortMalloc( size_t xSize ) PRIVILEGED_FUNCTION;
 void vPortFree( void *pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * calloc() and realloc() equivalents, so the C library's allocator can be
+ * mapped onto the RTOS heap.  pvPortCalloc() returns NULL if xNum * xSize
+ * overflows.  pvPortRealloc() behaves as pvPortMalloc() if pv is NULL, and as
+ * vPortFree() if xSize is 0.  Only available from heap_4.c.
+ */
+void *pvPortCalloc( size_t xNum, size_t xSize ) PRIVILEGED_FUNCTION;
+void *pvPortRealloc( void *pv, size_t xSize ) PRIVILEGED_FUNCTION;
 void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
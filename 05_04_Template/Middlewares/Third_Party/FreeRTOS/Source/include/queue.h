@@ -1384,6 +1384,187 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherP
  */
 BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueSendMultiple(
+									QueueHandle_t xQueue,
+									const void *pvItems,
+									UBaseType_t uxItemCount,
+									TickType_t xTicksToWait
+								);
+ * </pre>
+ *
+ * Post uxItemCount items to the back of a queue.  The items are copied, not
+ * referenced, from an array of uxItemCount items of the size the queue was
+ * created with.
+ *
+ * Each time there is space on the queue, as many of the remaining items as
+ * fit are copied within a single critical section, and one task waiting to
+ * receive is unblocked for each item copied.  The calling task yields at
+ * most once per batch, so a producer feeding a single consumer causes one
+ * context switch per batch rather than one per item.
+ *
+ * This function must not be called from an interrupt service routine.
+ * See xQueueSendMultipleFromISR () for an alternative which may be used
+ * in an ISR.  It cannot be used with semaphores.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to the first of the items that are to be placed
+ * on the queue.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it be full.
+ * The time is for the whole call, not for each item.  The call will return
+ * immediately once the queue is full if this is set to 0.
+ *
+ * @return The number of items posted, starting from the first.  This is
+ * uxItemCount unless the block time expired first.
+ *
+ * Example usage:
+   <pre>
+ #define BLOCK_SAMPLES	16
+
+ void vADCTask( void *pvParameters )
+ {
+ uint16_t usSamples[ BLOCK_SAMPLES ];
+ UBaseType_t uxSent;
+
+	// xSampleQueue was created to hold uint16_t items.
+	for( ;; )
+	{
+		vReadADCBlock( usSamples, BLOCK_SAMPLES );
+
+		// Post the whole block, waiting up to 10 ticks for space.
+		uxSent = xQueueSendMultiple( xSampleQueue, usSamples, BLOCK_SAMPLES, ( TickType_t ) 10 );
+		if( uxSent != BLOCK_SAMPLES )
+		{
+			// The last BLOCK_SAMPLES - uxSent samples were dropped.
+		}
+	}
+ }
+ </pre>
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueSendMultipleFromISR(
+									QueueHandle_t xQueue,
+									const void *pvItems,
+									UBaseType_t uxItemCount,
+									BaseType_t *pxHigherPriorityTaskWoken
+								);
+ * </pre>
+ *
+ * Post up to uxItemCount items to the back of a queue, as many as there is
+ * space for, within a single critical section.  It is safe to use this
+ * function from within an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to the first of the items that are to be placed
+ * on the queue.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueSendMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if posting the items caused a task to
+ * unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If xQueueSendMultipleFromISR() sets this value to pdTRUE
+ * then a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items posted, starting from the first.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueReceiveMultiple(
+									QueueHandle_t xQueue,
+									void *pvBuffer,
+									UBaseType_t uxItemCount,
+									TickType_t xTicksToWait
+								);
+ * </pre>
+ *
+ * Receive uxItemCount items from a queue into an array, oldest first.
+ *
+ * Each time the queue holds data, as many of the remaining items as it holds
+ * are copied out within a single critical section, and one task waiting to
+ * send is unblocked for each item removed.  The calling task yields at most
+ * once per batch.
+ *
+ * This function must not be called from an interrupt service routine.
+ * See xQueueReceiveMultipleFromISR () for an alternative which may be used
+ * in an ISR.  It cannot be used with semaphores.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to an array of at least uxItemCount items into
+ * which the received items will be copied.
+ *
+ * @param uxItemCount The number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for items to arrive, should the queue be empty.  The time is for
+ * the whole call, not for each item.  The call will return immediately once
+ * the queue is empty if this is set to 0.
+ *
+ * @return The number of items received into the start of pvBuffer.  This is
+ * uxItemCount unless the block time expired first.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueReceiveMultipleFromISR(
+									QueueHandle_t xQueue,
+									void *pvBuffer,
+									UBaseType_t uxItemCount,
+									BaseType_t *pxHigherPriorityTaskWoken
+								);
+ * </pre>
+ *
+ * Receive up to uxItemCount items from a queue, as many as it holds, within
+ * a single critical section.  It is safe to use this function from within an
+ * interrupt service routine.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to an array of at least uxItemCount items into
+ * which the received items will be copied.
+ *
+ * @param uxItemCount The number of items to receive.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueReceiveMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if removing the items caused a task
+ * waiting to send to unblock, and the unblocked task has a priority higher
+ * than the currently running task.
+ *
+ * @return The number of items received into the start of pvBuffer.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -145,8 +145,21 @@ typedef struct xTASK_STATUS
 	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	configSTACK_DEPTH_TYPE usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+	#if ( configGENERATE_RUN_TIME_CYCLE_STATS == 1 )
+		uint64_t ullRunTimeCycles;	/* The number of CPU cycles the task has spent in the Running state.  See ullTaskGetRunTimeCycles().  Only present when configGENERATE_RUN_TIME_CYCLE_STATS is defined as 1 in FreeRTOSConfig.h. */
+	#endif
 } TaskStatus_t;
 
+/* Used to pass information about the task pool out of vTaskGetPoolStats(). */
+typedef struct xTASK_POOL_STATS
+{
+	UBaseType_t uxNumberOfSlots;			/* The number of TCB and stack slots in the pool (configTASK_POOL_SLOTS). */
+	UBaseType_t uxNumberOfFreeSlots;		/* The number of slots not in use by a task at the time vTaskGetPoolStats() is called. */
+	UBaseType_t uxMinimumEverFreeSlots;		/* The lowest number of free slots there has been since the system booted. */
+	uint32_t ulHits;						/* The number of calls to xTaskCreate() that were served from the pool. */
+	uint32_t ulMisses;						/* The number of calls to xTaskCreate() that fell back to the heap because the pool was empty or the requested stack was larger than configTASK_POOL_STACK_DEPTH. */
+} TaskPoolStats_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -162,6 +175,17 @@ typedef enum
  */
 #define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
 
+/*
+ * The notification index used by the task notification functions that do not
+ * take an index parameter.
+ */
+#define tskDEFAULT_INDEX_TO_NOTIFY	( 0 )
+
+/*
+ * The core affinity mask of a task that may run on any core.
+ */
+#define tskNO_AFFINITY				( ( UBaseType_t ) -1 )
+
 /**
  * task. h
  *
@@ -185,7 +209,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskENTER_CRITICAL()		portENTER_CRITICAL()
-#define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#if ( configNUMBER_OF_CORES == 1 )
+	#define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#else
+	#define taskENTER_CRITICAL_FROM_ISR() uxTaskEnterCriticalFromISR()
+#endif
 
 /**
  * task. h
@@ -200,7 +228,12 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskEXIT_CRITICAL()			portEXIT_CRITICAL()
-#define taskEXIT_CRITICAL_FROM_ISR( x ) portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if ( configNUMBER_OF_CORES == 1 )
+	#define taskEXIT_CRITICAL_FROM_ISR( x ) portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#else
+	#define taskEXIT_CRITICAL_FROM_ISR( x ) vTaskExitCriticalFromISR( x )
+#endif
+
 /**
  * task. h
  *
@@ -846,6 +879,45 @@ void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xT
  */
 BaseType_t xTaskAbortDelay( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskDelayMicroseconds( const uint32_t ulMicrosecondsToDelay );</pre>
+ *
+ * configUSE_MICROSECOND_DELAYS must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * Delay a task for a given number of microseconds.  The task is unblocked by
+ * the microsecond alarm supplied through configMICROSECOND_TIMER_SET_ALARM(),
+ * independently of the tick, so the delay is not rounded to a whole number of
+ * tick periods.  The accuracy of the wake time is set by the resolution of
+ * the timer and the latency of its interrupt.
+ *
+ * The tick is used as a backstop only.  If the alarm interrupt is not serviced
+ * the task is unblocked one to two tick periods after the requested time.
+ *
+ * @param ulMicrosecondsToDelay The amount of time, in microseconds, that the
+ * calling task should block.  Must be less than 2^31.  A value of 0 yields.
+ *
+ * Example usage:
+   <pre>
+ void vSampleTask( void * pvParameters )
+ {
+	 for( ;; )
+	 {
+		 vStartConversion();
+
+		 // Wait for the conversion to complete without holding the processor.
+		 vTaskDelayMicroseconds( 120 );
+
+		 vReadResult();
+	 }
+ }
+   </pre>
+ * \defgroup vTaskDelayMicroseconds vTaskDelayMicroseconds
+ * \ingroup TaskCtrl
+ */
+void vTaskDelayMicroseconds( const uint32_t ulMicrosecondsToDelay ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask );</pre>
@@ -1017,6 +1089,293 @@ void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xG
  */
 void vTaskPrioritySet( TaskHandle_t xTask, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskSetTimeSlice( TaskHandle_t xTask, UBaseType_t uxTicks );</pre>
+ *
+ * configUSE_PER_TASK_TIME_SLICE must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * Set the number of ticks a task runs for before it is round robin scheduled
+ * with other Ready state tasks of the same priority.  Tasks are created with
+ * a time slice of configDEFAULT_TIME_SLICE_TICKS, which defaults to 1 - the
+ * behaviour of the kernel when configUSE_PER_TASK_TIME_SLICE is 0.
+ *
+ * A longer time slice reduces the number of context switches between CPU
+ * bound tasks that share a priority, at the cost of a longer wait before
+ * the other tasks at that priority run.  The time slice has no effect on
+ * preemption by a higher priority task, and a preempted task carries on with
+ * the remainder of its slice when it next runs.  A task that blocks or yields
+ * gives up the remainder of its slice.
+ *
+ * @param xTask Handle to the task for which the time slice is being set.
+ * Passing a NULL handle results in the time slice of the calling task being
+ * set.
+ *
+ * @param uxTicks The length of the time slice in ticks.  Must be at least 1.
+ *
+ * Example usage:
+   <pre>
+ void vBatchTask( void *pvParameters )
+ {
+	 // This task processes data in large blocks, so let it run for 20 ticks
+	 // at a time rather than switching every tick.
+	 vTaskSetTimeSlice( NULL, 20 );
+
+	 for( ;; )
+	 {
+		 // Process data here.
+	 }
+ }
+   </pre>
+ * \defgroup vTaskSetTimeSlice vTaskSetTimeSlice
+ * \ingroup TaskCtrl
+ */
+void vTaskSetTimeSlice( TaskHandle_t xTask, UBaseType_t uxTicks ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskGetTimeSlice( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_PER_TASK_TIME_SLICE must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL handle
+ * results in the time slice of the calling task being returned.
+ *
+ * @return The length of the task's time slice in ticks.
+ *
+ * \defgroup uxTaskGetTimeSlice uxTaskGetTimeSlice
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskGetTimeSlice( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskEDFRegister( TaskHandle_t xTask, const TickType_t xPeriod, const TickType_t xRelativeDeadline );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * Place a task under earliest deadline first (EDF) scheduling.  The task must
+ * have been created at priority configEDF_TASK_PRIORITY.  Tasks at higher
+ * priorities preempt EDF tasks as normal, and tasks at lower priorities run
+ * when no EDF task is ready.  Among the Ready state tasks at
+ * configEDF_TASK_PRIORITY the one whose current job has the earliest absolute
+ * deadline runs.
+ *
+ * Each call to vTaskDelayUntil() or vTaskEDFWaitForNextPeriod() made by the
+ * task releases its next job, with a deadline xRelativeDeadline ticks after
+ * the new wake time.  The first job is released when this function is called.
+ *
+ * A set of EDF tasks whose deadlines equal their periods meets every deadline
+ * provided the sum of (worst case execution time / period) over the set does
+ * not exceed 1, less the time taken by tasks above the EDF priority and by
+ * interrupts.  Deadlines are re-evaluated at least once per tick, so execution
+ * times and periods should be long compared to a tick.  The Ready state tasks at
+ * configEDF_TASK_PRIORITY are kept in deadline order, so a task made ready by
+ * the tick, a queue, a semaphore or a notification preempts a running EDF task
+ * whose deadline is later than its own.  With configUSE_TIME_SLICING set to 1
+ * tasks with the same deadline also share the processor each tick.
+ *
+ * @param xTask Handle of the task being registered.  Passing a NULL handle
+ * registers the calling task.
+ *
+ * @param xPeriod The release period of the task in ticks, used by
+ * vTaskEDFWaitForNextPeriod().
+ *
+ * @param xRelativeDeadline The deadline of each job in ticks, measured from
+ * the time the job is released.  Normally equal to xPeriod.
+ *
+ * Example usage:
+   <pre>
+ // A control loop that must complete within 5ms of every 10ms release.
+ void vControlTask( void * pvParameters )
+ {
+ TickType_t xLastRelease;
+
+	 vTaskEDFRegister( NULL, pdMS_TO_TICKS( 10 ), pdMS_TO_TICKS( 5 ) );
+	 xLastRelease = xTaskGetTickCount();
+
+	 for( ;; )
+	 {
+		 // Run the control algorithm here.
+
+		 vTaskEDFWaitForNextPeriod( &xLastRelease );
+	 }
+ }
+   </pre>
+ * \defgroup vTaskEDFRegister vTaskEDFRegister
+ * \ingroup TaskCtrl
+ */
+void vTaskEDFRegister( TaskHandle_t xTask, const TickType_t xPeriod, const TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskEDFWaitForNextPeriod( TickType_t * const pxPreviousReleaseTime );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Called by a task registered with vTaskEDFRegister() when its current job is
+ * complete.  Equivalent to calling vTaskDelayUntil() with the period the task
+ * was registered with.
+ *
+ * @param pxPreviousReleaseTime Pointer to a variable that holds the time at
+ * which the current job was released, used and updated as by
+ * vTaskDelayUntil().
+ *
+ * \defgroup vTaskEDFWaitForNextPeriod vTaskEDFWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+void vTaskEDFWaitForNextPeriod( TickType_t * const pxPreviousReleaseTime ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>TickType_t xTaskEDFGetDeadline( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL handle
+ * queries the calling task.
+ *
+ * @return The absolute deadline, in ticks, of the task's current job.  A task
+ * can detect a missed deadline by comparing this with xTaskGetTickCount()
+ * when its job completes.
+ *
+ * \defgroup xTaskEDFGetDeadline xTaskEDFGetDeadline
+ * \ingroup TaskCtrl
+ */
+TickType_t xTaskEDFGetDeadline( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>BaseType_t xTaskCreateAffinitySet( TaskFunction_t pvTaskCode, const char * const pcName, configSTACK_DEPTH_TYPE usStackDepth, void *pvParameters, UBaseType_t uxPriority, UBaseType_t uxCoreAffinityMask, TaskHandle_t *pvCreatedTask );</pre>
+ *
+ * configUSE_CORE_AFFINITY must be defined as 1 for this function to be
+ * available.
+ *
+ * Create a task that may only run on the cores set in uxCoreAffinityMask.
+ * The other parameters and the return value are as for xTaskCreate().  Unlike
+ * creating the task with xTaskCreate() and then calling vTaskCoreAffinitySet(),
+ * the task cannot start on another core before its affinity is set.
+ *
+ * @param uxCoreAffinityMask Bit n is set if the task may run on core n.
+ * tskNO_AFFINITY allows the task to run on any core.
+ *
+ * \defgroup xTaskCreateAffinitySet xTaskCreateAffinitySet
+ * \ingroup Tasks
+ */
+BaseType_t xTaskCreateAffinitySet(	TaskFunction_t pxTaskCode,
+									const char * const pcName,	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const configSTACK_DEPTH_TYPE usStackDepth,
+									void * const pvParameters,
+									UBaseType_t uxPriority,
+									UBaseType_t uxCoreAffinityMask,
+									TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskCoreAffinitySet( TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );</pre>
+ *
+ * configUSE_CORE_AFFINITY must be defined as 1 for this function to be
+ * available.
+ *
+ * Set the cores a task may run on.  If the task is running on a core that is
+ * no longer in the mask it is switched out at once.  Tasks are created with an
+ * affinity of tskNO_AFFINITY.
+ *
+ * @param xTask Handle of the task to be updated.  Passing a NULL handle
+ * updates the calling task.
+ *
+ * @param uxCoreAffinityMask Bit n is set if the task may run on core n.  At
+ * least one of the bits for the cores in use must be set.
+ *
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup TaskCtrl
+ */
+void vTaskCoreAffinitySet( TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_CORE_AFFINITY must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL handle
+ * queries the calling task.
+ *
+ * @return The mask of the cores the task may run on.
+ *
+ * \defgroup uxTaskCoreAffinityGet uxTaskCoreAffinityGet
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void *pvTaskArenaAlloc( size_t xWantedSize );</pre>
+ *
+ * configUSE_TASK_ARENAS must be defined as 1 for this function to be
+ * available.
+ *
+ * Allocate memory from the calling task's arena.  The arena is made of chunks
+ * of configTASK_ARENA_CHUNK_SIZE bytes taken from the heap with
+ * pvPortMalloc(), and memory is allocated from the current chunk by advancing
+ * a pointer, so allocating does not suspend the scheduler unless a new chunk
+ * is needed.  Memory allocated from an arena is not freed individually, but
+ * all at once by vTaskArenaReset(), or when the task is deleted.
+ *
+ * Only the task that owns the arena may allocate from it, and not from an
+ * interrupt.
+ *
+ * @param xWantedSize The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated memory, aligned to portBYTE_ALIGNMENT, or
+ * NULL if a new chunk was needed and could not be allocated.
+ *
+ * Example usage:
+   <pre>
+ void vWorkerTask( void * pvParameters )
+ {
+ Job_t *pxJob;
+
+	 for( ;; )
+	 {
+		 pxJob = pvTaskArenaAlloc( sizeof( Job_t ) );
+		 pxJob->pcText = pvTaskArenaAlloc( 32 );
+
+		 // ... Process the job ...
+
+		 // Free everything allocated for the job.
+		 vTaskArenaReset();
+	 }
+ }
+   </pre>
+ * \defgroup pvTaskArenaAlloc pvTaskArenaAlloc
+ * \ingroup Tasks
+ */
+void *pvTaskArenaAlloc( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskArenaReset( void );</pre>
+ *
+ * configUSE_TASK_ARENAS must be defined as 1 for this function to be
+ * available.
+ *
+ * Free everything allocated from the calling task's arena by
+ * pvTaskArenaAlloc().  The chunks of the arena are kept for the task's next
+ * allocations rather than returned to the heap, so resetting takes constant
+ * time.  They are returned to the heap when the task is deleted.
+ *
+ * \defgroup vTaskArenaReset vTaskArenaReset
+ * \ingroup Tasks
+ */
+void vTaskArenaReset( void ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>void vTaskSuspend( TaskHandle_t xTaskToSuspend );</pre>
@@ -1537,7 +1896,9 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask, void *pvParameter )
  * INCLUDE_xTaskGetIdleTaskHandle is set to 1 in FreeRTOSConfig.h.
  *
  * Simply returns the handle of the idle task.  It is not valid to call
- * xTaskGetIdleTaskHandle() before the scheduler has been started.
+ * xTaskGetIdleTaskHandle() before the scheduler has been started.  If
+ * configNUMBER_OF_CORES is greater than 1 each core has an idle task, and the
+ * handle of the idle task created for core 0 is returned.
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
@@ -1771,9 +2132,92 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 */
 uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 
+/**
+* task. h
+* <PRE>uint64_t ullTaskGetRunTimeCycles( TaskHandle_t xTask );</PRE>
+*
+* configGENERATE_RUN_TIME_CYCLE_STATS must be defined as 1 for this function
+* to be available.  The port must provide portGET_CYCLE_COUNTER_VALUE(), and
+* optionally portCONFIGURE_CYCLE_COUNTER(), to read and start a free running
+* 32-bit counter that increments once per CPU cycle.  The ARM_CM4F port uses
+* the DWT cycle counter (DWT_CYCCNT).
+*
+* Unlike configGENERATE_RUN_TIME_STATS, no application timer is needed and the
+* time a task runs is measured exactly rather than sampled.  The kernel charges
+* the elapsed cycles to the running task on every context switch and every
+* tick, and accumulates them in a 64-bit count held in the task's TCB.  The
+* 32-bit counter therefore never has to be read more than once per wrap (every
+* 51 seconds at 84MHz), and the 64-bit count does not wrap in practice.  The
+* cycles used by interrupts are charged to whichever task they interrupted.
+*
+* The cost is one read of DWT_CYCCNT, a 32-bit subtraction and two 64-bit
+* additions per context switch and per tick.  Compiled for the Cortex-M4 that
+* is 22 Thumb-2 instructions, which LLVM's Cortex-M4 scheduling model
+* (llvm-mca) puts at 25 cycles with every access taking no wait states.  On
+* the STM32F411 at 84MHz the flash needs 2 wait states, which the ART
+* accelerator hides only while the code stays in its instruction cache, so the
+* cost on the board can be higher.  No figure has been measured on hardware
+* yet.  To measure it, build the template's latency benchmark (LATENCY_BENCH,
+* see Core/Inc/latency_bench.h), which ends by timing context switches between
+* two tasks that yield to each other, with configGENERATE_RUN_TIME_CYCLE_STATS
+* set to 1 and then to 0, and subtract the two "cycles per switch" figures.
+* QEMU does not count cycles, so the figures must come from the board.
+*
+* @param xTask Handle of the task to query.  Passing NULL queries the calling
+* task.
+*
+* @return The number of CPU cycles the task has spent in the Running state
+* since it was created.  uxTaskGetSystemState() reports the same value in the
+* ullRunTimeCycles member of each TaskStatus_t structure.
+*
+* \defgroup ullTaskGetRunTimeCycles ullTaskGetRunTimeCycles
+* \ingroup TaskUtils
+*/
+uint64_t ullTaskGetRunTimeCycles( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+* task. h
+* <PRE>uint64_t ullTaskGetTotalRunTimeCycles( void );</PRE>
+*
+* configGENERATE_RUN_TIME_CYCLE_STATS must be defined as 1 for this function
+* to be available.  See ullTaskGetRunTimeCycles().
+*
+* @return The number of CPU cycles that have elapsed since the scheduler was
+* started.  Dividing the value returned by ullTaskGetRunTimeCycles() by this
+* value gives the share of the CPU used by a task.
+*
+* \defgroup ullTaskGetTotalRunTimeCycles ullTaskGetTotalRunTimeCycles
+* \ingroup TaskUtils
+*/
+uint64_t ullTaskGetTotalRunTimeCycles( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>void vTaskGetPoolStats( TaskPoolStats_t *pxPoolStats );</PRE>
+ *
+ * configUSE_TASK_POOL must be defined as 1 for this function to be available.
+ *
+ * When configUSE_TASK_POOL is 1, xTaskCreate() takes the TCB and stack of a
+ * task that needs no more than configTASK_POOL_STACK_DEPTH words of stack from
+ * a pool of configTASK_POOL_SLOTS statically allocated slots, and only calls
+ * pvPortMalloc() if no slot is free.  vTaskDelete() returns the slot to the
+ * pool immediately, or, if a task deletes itself, as soon as it has been
+ * switched out, so short lived tasks do not depend on the idle task running
+ * to free their memory.  A task that deletes itself frees its arena and newlib
+ * reentrancy structure in vTaskDelete(), before it is switched out.
+ *
+ * @param pxPoolStats Pointer to the structure into which the number of free
+ * slots and the pool hit and miss counts are written.
+ *
+ * \defgroup vTaskGetPoolStats vTaskGetPoolStats
+ * \ingroup TaskUtils
+ */
+void vTaskGetPoolStats( TaskPoolStats_t *pxPoolStats ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1781,6 +2225,14 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * When configUSE_TASK_NOTIFICATIONS is set to one each task has its own private
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
+ * Each task has an array of configTASK_NOTIFICATION_ARRAY_ENTRIES notification
+ * values, each with its own pending state, so a task can wait on several
+ * independent event sources.  A notification sent to one index only unblocks
+ * the task if it is waiting on that same index.  The functions and macros that
+ * end in "Indexed" take the array index as a parameter.  Those that do not
+ * operate on index 0 (tskDEFAULT_INDEX_TO_NOTIFY), and behave exactly as they
+ * did before the array was introduced.
+ *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
  * are a method of sending an event directly to a task without the need for such
@@ -1809,6 +2261,11 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index within the target task's array of
+ * notification values to which the notification is sent.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  xTaskNotify() does not have this
+ * parameter and always sends notifications to index 0.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1850,13 +2307,17 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskGenericNotify( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue ) xTaskGenericNotifyIndexed( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ) )
 #define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction ) xTaskGenericNotifyIndexed( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL )
 #define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotifyIndexed( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1895,6 +2356,11 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index within the target task's array of
+ * notification values to which the notification is sent.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  xTaskNotifyFromISR() does not have
+ * this parameter and always sends notifications to index 0.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1941,13 +2407,17 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskGenericNotifyFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyIndexedFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
 #define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyIndexedFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
 #define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyIndexedFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
+ * <PRE>BaseType_t xTaskNotifyWaitIndexed( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1978,6 +2448,11 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn The index within the calling task's array of
+ * notification values on which to wait.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  The variant without "Indexed" in its
+ * name does not have this parameter and always waits on index 0.
+ *
  * @param ulBitsToClearOnEntry Bits that are set in ulBitsToClearOnEntry value
  * will be cleared in the calling task's notification value before the task
  * checks to see if any notifications are pending, and optionally blocks if no
@@ -2018,11 +2493,38 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskNotifyWaitIndexed( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskNotifyWaitIndexed( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+
+/**
+ * task. h
+ * <PRE>BaseType_t xTaskNotifyWaitMicroseconds( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, uint32_t ulMicrosecondsToWait );</pre>
+ * <PRE>BaseType_t xTaskNotifyWaitIndexedMicroseconds( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, uint32_t ulMicrosecondsToWait );</pre>
+ *
+ * configUSE_TASK_NOTIFICATIONS and configUSE_MICROSECOND_DELAYS must both be
+ * defined as 1 for these functions to be available.
+ *
+ * Identical to xTaskNotifyWait() and xTaskNotifyWaitIndexed(), except the
+ * maximum time to wait is given in microseconds and is timed by the
+ * microsecond alarm, as described for vTaskDelayMicroseconds().
+ *
+ * @param ulMicrosecondsToWait The maximum amount of time, in microseconds,
+ * that the task should wait in the Blocked state for a notification to be
+ * received.  Must be less than 2^31.  A value of 0 does not block.
+ *
+ * @return pdTRUE if a notification was received (including notifications that
+ * were already pending when the function was called), otherwise pdFALSE.
+ *
+ * \defgroup xTaskNotifyWaitMicroseconds xTaskNotifyWaitMicroseconds
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskNotifyWaitIndexedMicroseconds( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, uint32_t ulMicrosecondsToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWaitMicroseconds( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, ulMicrosecondsToWait ) xTaskNotifyWaitIndexedMicroseconds( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( ulMicrosecondsToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );</PRE>
+ * <PRE>BaseType_t xTaskNotifyGiveIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2058,6 +2560,11 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index within the target task's array of
+ * notification values to which the notification is sent.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  The variant without "Indexed" in its
+ * name does not have this parameter and always sends notifications to index 0.
+ *
  * @return xTaskNotifyGive() is a macro that calls xTaskNotify() with the
  * eAction parameter set to eIncrement - so pdPASS is always returned.
  *
@@ -2065,10 +2572,12 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \ingroup TaskNotifications
  */
 #define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) xTaskGenericNotifyIndexed( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
 /**
  * task. h
  * <PRE>void vTaskNotifyGiveFromISR( TaskHandle_t xTaskHandle, BaseType_t *pxHigherPriorityTaskWoken );
+ * void vTaskNotifyGiveIndexedFromISR( TaskHandle_t xTaskHandle, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken );
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2107,6 +2616,11 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index within the target task's array of
+ * notification values to which the notification is sent.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  The variant without "Indexed" in its
+ * name does not have this parameter and always sends notifications to index 0.
+ *
  * @param pxHigherPriorityTaskWoken  vTaskNotifyGiveFromISR() will set
  * *pxHigherPriorityTaskWoken to pdTRUE if sending the notification caused the
  * task to which the notification was sent to leave the Blocked state, and the
@@ -2119,11 +2633,13 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void vTaskNotifyGiveIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) vTaskNotifyGiveIndexedFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
+ * <PRE>uint32_t ulTaskNotifyTakeIndexed( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -2167,6 +2683,11 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn The index within the calling task's array of
+ * notification values on which to wait.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  The variant without "Indexed" in its
+ * name does not have this parameter and always waits on index 0.
+ *
  * @param xClearCountOnExit if xClearCountOnExit is pdFALSE then the task's
  * notification value is decremented when the function exits.  In this way the
  * notification value acts like a counting semaphore.  If xClearCountOnExit is
@@ -2188,27 +2709,35 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  * \defgroup ulTaskNotifyTake ulTaskNotifyTake
  * \ingroup TaskNotifications
  */
-uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskNotifyTakeIndexed( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyTake( xClearCountOnExit, xTicksToWait ) ulTaskNotifyTakeIndexed( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );</pre>
+ * <PRE>BaseType_t xTaskNotifyStateClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear );</pre>
  *
  * If the notification state of the task referenced by the handle xTask is
  * eNotified, then set the task's notification state to eNotWaitingNotification.
  * The task's notification value is not altered.  Set xTask to NULL to clear the
  * notification state of the calling task.
  *
+ * @param uxIndexToClear The index within the task's array of notification
+ * values to act upon.  Must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ * The variant without "Indexed" in its name always acts on index 0.
+ *
  * @return pdTRUE if the task's notification state was set to
  * eNotWaitingNotification, otherwise pdFALSE.
  * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t xTaskNotifyStateClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyStateClear( xTask ) xTaskNotifyStateClearIndexed( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ) )
 
 /**
 * task. h
 * <PRE>uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear );</pre>
+* <PRE>uint32_t ulTaskNotifyValueClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear );</pre>
 *
 * Clears the bits specified by the ulBitsToClear bit mask in the notification
 * value of the task referenced by xTask.
@@ -2217,12 +2746,17 @@ BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
 * the notification value to 0.  Set ulBitsToClear to 0 to query the task's
 * notification value without clearing any bits.
 *
+* @param uxIndexToClear The index within the task's array of notification
+* values to act upon.  Must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+* The variant without "Indexed" in its name always acts on index 0.
+*
 * @return The value of the target task's notification value before the bits
 * specified by ulBitsToClear were cleared.
 * \defgroup ulTaskNotifyValueClear ulTaskNotifyValueClear
 * \ingroup TaskNotifications
 */
-uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskNotifyValueClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyValueClear( xTask, ulBitsToClear ) ulTaskNotifyValueClearIndexed( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClear ) )
 
 /**
  * task.h
@@ -2342,6 +2876,18 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut, TickType_t * const
  */
 BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE, OTHER THAN THE
+ * INTERRUPT HANDLER OF THE TIMER BEHIND configMICROSECOND_TIMER_SET_ALARM().
+ *
+ * Called from the microsecond alarm interrupt when configUSE_MICROSECOND_DELAYS
+ * is 1.  Unblocks every task whose microsecond delay or timeout has expired
+ * and sets the alarm for the next one.  If a non-zero value is returned then
+ * an unblocked task has a priority above the interrupted task, and the
+ * handler should request a context switch with portYIELD_FROM_ISR().
+ */
+BaseType_t xTaskMicrosecondAlarmFromISR( void ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -2437,6 +2983,20 @@ TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Return the handle of the task running on core xCoreID.  Used by ports for
+ * more than one core.
+ */
+TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used by taskENTER_CRITICAL_FROM_ISR() and taskEXIT_CRITICAL_FROM_ISR() when
+ * configNUMBER_OF_CORES is greater than 1.  Masks interrupts on the calling
+ * core and takes the ISR lock, which keeps out interrupts on the other cores.
+ */
+UBaseType_t uxTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+
 /*
  * Shortcut used by the queue implementation to prevent unnecessary call to
  * taskYIELD();
@@ -2451,7 +3011,10 @@ BaseType_t xTaskGetSchedulerState( void ) PRIVILEGED_FUNCTION;
 
 /*
  * Raises the priority of the mutex holder to that of the calling task should
- * the mutex holder have a priority less than the calling task.
+ * the mutex holder have a priority less than the calling task.  If
+ * configPRIORITY_INHERITANCE_DEPTH is greater than 1 and the mutex holder is
+ * itself blocked on a mutex then the priority is also passed on to the holder
+ * of that mutex, and so on, up to configPRIORITY_INHERITANCE_DEPTH holders.
  */
 BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
 
@@ -2471,6 +3034,16 @@ BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGE
  */
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Record the holder field of the mutex the calling
+ * task is about to block on, or NULL once the task is no longer blocked on it.
+ * Only available when configPRIORITY_INHERITANCE_DEPTH is greater than 1,
+ * in which case it allows xTaskPriorityInherit() and
+ * vTaskPriorityDisinheritAfterTimeout() to pass a priority along a chain of
+ * tasks that are each blocked on a mutex held by the next.
+ */
+void vTaskSetBlockingMutexHolder( TaskHandle_t * const pxMutexHolder ) PRIVILEGED_FUNCTION;
+
 /*
  * Get the uxTCBNumber assigned to the task referenced by the xTask parameter.
  */
@@ -37,6 +37,10 @@
 	#error This port can only be used when the project options are configured to enable hardware floating point support.
 #endif
 
+#if( ( configUSE_MPU_STACK_GUARD == 1 ) && ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MPU_STACK_GUARD requires INCLUDE_xTaskGetCurrentTaskHandle to be set to 1, so the task that overflowed its stack can be reported.
+#endif
+
 #ifndef configSYSTICK_CLOCK_HZ
 	#define configSYSTICK_CLOCK_HZ configCPU_CLOCK_HZ
 	/* Ensure the SysTick is clocked at the same frequency as the core. */
@@ -59,6 +63,34 @@
 #define portNVIC_PENDSVCLEAR_BIT 			( 1UL << 27UL )
 #define portNVIC_PEND_SYSTICK_CLEAR_BIT		( 1UL << 25UL )
 
+/* Constants required to start the DWT cycle counter. */
+#define portDCB_DEMCR_REG					( * ( ( volatile uint32_t * ) 0xe000edfc ) )
+#define portDWT_CTRL_REG					( * ( ( volatile uint32_t * ) 0xe0001000 ) )
+#define portDCB_DEMCR_TRCENA_BIT			( 1UL << 24UL )
+#define portDWT_CTRL_CYCCNTENA_BIT			( 1UL << 0UL )
+
+/* Constants required to set up the MPU stack guard, and to decode the
+MemManage fault it raises. */
+#define portMPU_TYPE_REG					( * ( ( volatile uint32_t * ) 0xe000ed90 ) )
+#define portMPU_CTRL_REG					( * ( ( volatile uint32_t * ) 0xe000ed94 ) )
+#define portMPU_RNR_REG						( * ( ( volatile uint32_t * ) 0xe000ed98 ) )
+#define portMPU_RASR_REG					( * ( ( volatile uint32_t * ) 0xe000eda0 ) )
+#define portNVIC_SHCSR_REG					( * ( ( volatile uint32_t * ) 0xe000ed24 ) )
+#define portSCB_CFSR_REG					( * ( ( volatile uint32_t * ) 0xe000ed28 ) )
+#define portSCB_MMFAR_REG					( * ( ( volatile uint32_t * ) 0xe000ed34 ) )
+#define portMPU_CTRL_ENABLE_BIT				( 1UL << 0UL )
+#define portMPU_CTRL_PRIVDEFENA_BIT			( 1UL << 2UL )
+#define portMPU_RASR_ENABLE_BIT				( 1UL << 0UL )
+#define portMPU_RASR_SIZE_32_BYTES			( 4UL << 1UL )
+#define portMPU_RASR_CACHEABLE_BUFFERABLE	( 3UL << 16UL )
+#define portMPU_RASR_PRIV_READ_ONLY			( 5UL << 24UL )
+#define portMPU_RASR_XN_BIT					( 1UL << 28UL )
+#define portNVIC_MEMFAULTENA_BIT			( 1UL << 16UL )
+#define portSCB_MMFSR_DACCVIOL_BIT			( 1UL << 1UL )
+#define portSCB_MMFSR_MSTKERR_BIT			( 1UL << 4UL )
+#define portSCB_MMFSR_MLSPERR_BIT			( 1UL << 5UL )
+#define portSCB_MMFSR_MMARVALID_BIT			( 1UL << 7UL )
+
 /* Constants used to detect a Cortex-M7 r0p1 core, which should use the ARM_CM7
 r0p1 port. */
 #define portCPUID							( * ( ( volatile uint32_t * ) 0xE000ed00 ) )
@@ -139,6 +171,13 @@ static void vPortEnableVFP( void ) __attribute__ (( naked ));
  */
 static void prvTaskExitError( void );
 
+/*
+ * Program the MPU region that guards the end of the running task's stack.
+ */
+#if( configUSE_MPU_STACK_GUARD == 1 )
+	static void prvSetupStackGuard( void );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Each task maintains its own interrupt status in the critical nesting
@@ -366,6 +405,14 @@ BaseType_t xPortStartScheduler( void )
 	here already. */
 	vPortSetupTimerInterrupt();
 
+	#if( configUSE_MPU_STACK_GUARD == 1 )
+	{
+		/* The kernel has already moved the guard region to the stack of the
+		first task. */
+		prvSetupStackGuard();
+	}
+	#endif /* configUSE_MPU_STACK_GUARD */
+
 	/* Initialise the critical nesting count ready for the first task. */
 	uxCriticalNesting = 0;
 
@@ -697,6 +744,77 @@ __attribute__(( weak )) void vPortSetupTimerInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( ( configGENERATE_RUN_TIME_CYCLE_STATS == 1 ) || ( configUSE_HEAP_TELEMETRY == 1 ) )
+
+	void vPortConfigureCycleCounter( void )
+	{
+		/* The DWT unit is only clocked when trace is enabled in the DEMCR.  A
+		debugger may have started the counter already, in which case it is
+		left running as only the difference between two reads is used. */
+		portDCB_DEMCR_REG |= portDCB_DEMCR_TRCENA_BIT;
+		portDWT_CTRL_REG |= portDWT_CTRL_CYCCNTENA_BIT;
+	}
+
+#endif /* configGENERATE_RUN_TIME_CYCLE_STATS || configUSE_HEAP_TELEMETRY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPU_STACK_GUARD == 1 )
+
+	static void prvSetupStackGuard( void )
+	{
+		/* The guard uses the highest numbered region so it takes precedence
+		over any regions the application has set up. */
+		configASSERT( ( ( portMPU_TYPE_REG >> 8UL ) & 0xffUL ) > portSTACK_GUARD_REGION );
+
+		/* portSET_STACK_GUARD() selected the region and set its base, so only
+		the attributes remain.  The region is readable so the kernel can still
+		measure the stack high water mark. */
+		portMPU_RASR_REG = portMPU_RASR_XN_BIT | portMPU_RASR_PRIV_READ_ONLY | portMPU_RASR_CACHEABLE_BUFFERABLE | portMPU_RASR_SIZE_32_BYTES | portMPU_RASR_ENABLE_BIT;
+
+		/* Report overflows as MemManage faults rather than escalating them to
+		HardFault, and keep the default memory map as the background region
+		for all other privileged accesses. */
+		portNVIC_SHCSR_REG |= portNVIC_MEMFAULTENA_BIT;
+		portMPU_CTRL_REG |= portMPU_CTRL_PRIVDEFENA_BIT | portMPU_CTRL_ENABLE_BIT;
+		__asm volatile( "dsb" ::: "memory" );
+		__asm volatile( "isb" );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortMemManageHandler( void )
+	{
+	extern void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName );
+	const uint32_t ulFaultStatus = portSCB_CFSR_REG;
+	uint32_t ulGuardBase;
+	BaseType_t xStackOverflow = pdFALSE;
+
+		if( ( ulFaultStatus & ( portSCB_MMFSR_MSTKERR_BIT | portSCB_MMFSR_MLSPERR_BIT ) ) != 0UL )
+		{
+			/* The exception frame of the running task, or its lazily stacked
+			floating point context, did not fit on its stack. */
+			xStackOverflow = pdTRUE;
+		}
+		else if( ( ulFaultStatus & ( portSCB_MMFSR_DACCVIOL_BIT | portSCB_MMFSR_MMARVALID_BIT ) ) == ( portSCB_MMFSR_DACCVIOL_BIT | portSCB_MMFSR_MMARVALID_BIT ) )
+		{
+			/* A write hit a read only region - was it the guard? */
+			portMPU_RNR_REG = portSTACK_GUARD_REGION;
+			ulGuardBase = portMPU_RBAR_REG & ~( portSTACK_GUARD_SIZE - 1UL );
+
+			if( ( portSCB_MMFAR_REG - ulGuardBase ) < portSTACK_GUARD_SIZE )
+			{
+				xStackOverflow = pdTRUE;
+			}
+		}
+
+		if( xStackOverflow != pdFALSE )
+		{
+			vApplicationStackOverflowHook( xTaskGetCurrentTaskHandle(), pcTaskGetName( NULL ) );
+		}
+	}
+
+#endif /* configUSE_MPU_STACK_GUARD */
+/*-----------------------------------------------------------*/
+
 /* This is a naked function. */
 static void vPortEnableVFP( void )
 {
@@ -112,6 +112,39 @@ not necessary for to use this port.  They are defined so the common demo files
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
 /*-----------------------------------------------------------*/
 
+/* Cycle accurate run time statistics (configGENERATE_RUN_TIME_CYCLE_STATS).
+The DWT cycle counter is a free running 32-bit count of core clock cycles. */
+#define portDWT_CYCCNT_REG					( * ( ( volatile uint32_t * ) 0xe0001004 ) )
+#define portGET_CYCLE_COUNTER_VALUE()		( portDWT_CYCCNT_REG )
+extern void vPortConfigureCycleCounter( void );
+#define portCONFIGURE_CYCLE_COUNTER()		vPortConfigureCycleCounter()
+/*-----------------------------------------------------------*/
+
+/* Hardware stack overflow detection (configUSE_MPU_STACK_GUARD).  An MPU
+region that is read only to privileged code, and so to every task in this
+port, covers the lowest portSTACK_GUARD_SIZE bytes of the running task's stack,
+so the first write past the end of the stack raises a MemManage fault.  32
+bytes is the smallest region the ARMv7-M MPU supports.  The region base must be
+a multiple of its size, so the base is rounded up into the stack, and moving
+the region to the stack of the next task is a single write to the RBAR. */
+#ifndef configUSE_MPU_STACK_GUARD
+	#define configUSE_MPU_STACK_GUARD 0
+#endif
+
+#if( configUSE_MPU_STACK_GUARD == 1 )
+	#define portMPU_RBAR_REG				( * ( ( volatile uint32_t * ) 0xe000ed9c ) )
+	#define portMPU_RBAR_VALID_BIT			( 1UL << 4UL )
+	#define portSTACK_GUARD_REGION			( 7UL )
+	#define portSTACK_GUARD_SIZE			( 32UL )
+	#define portSET_STACK_GUARD( pxStack )	portMPU_RBAR_REG = ( ( ( uint32_t ) ( pxStack ) + ( portSTACK_GUARD_SIZE - 1UL ) ) & ~( portSTACK_GUARD_SIZE - 1UL ) ) | portMPU_RBAR_VALID_BIT | portSTACK_GUARD_REGION
+
+	/* To be called from the MemManage fault handler.  Calls
+	vApplicationStackOverflowHook() if the fault was caused by the running task
+	overflowing its stack. */
+	extern void vPortMemManageHandler( void );
+#endif /* configUSE_MPU_STACK_GUARD */
+/*-----------------------------------------------------------*/
+
 /* Tickless idle/low power functionality. */
 #ifndef portSUPPRESS_TICKS_AND_SLEEP
 	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
@@ -135,9 +168,11 @@ not necessary for to use this port.  They are defined so the common demo files
 		return ucReturn;
 	}
 
-	/* Check the configuration. */
-	#if( configMAX_PRIORITIES > 32 )
-		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	/* Check the configuration.  Above 32 priorities the kernel keeps the ready
+	priorities in a two level bitmap built on the macros below, which covers
+	32 groups of 32 priorities. */
+	#if( configMAX_PRIORITIES > 1024 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
 	#endif
 
 	/* Store/clear the ready priorities in a bit map. */
@@ -30,10 +30,33 @@
  * (coalescences) adjacent memory blocks as they are freed, and in so doing
  * limits memory fragmentation.
  *
- * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the
- * memory management pages of http://www.FreeRTOS.org for more information.
+ * If configUSE_HEAP_SLABS is set to 1 then small allocations are served from
+ * slab pages instead.  Each size class listed in configHEAP_SLAB_OBJECT_SIZES
+ * takes pages of configHEAP_SLAB_PAGE_SIZE bytes from the heap and divides
+ * them into equal objects.  Objects are allocated from and freed to the free
+ * list of their page in constant time, and need no block header, as their
+ * page is found from their address.  Taking a new page from the heap walks the
+ * list of free blocks, as any other allocation does.  A page that becomes
+ * empty goes back to the heap, unless configHEAP_SLAB_KEEP_EMPTY_PAGE is 1.
+ *
+ * If configUSE_APPLICATION_HEAP_REGION is set to 1 then the heap is the RAM
+ * between configHEAP_REGION_START() and configHEAP_REGION_END() rather than an
+ * array of configTOTAL_HEAP_SIZE bytes.  The slab page bitmap is then sized
+ * from the region and taken from its start.  pvPortCalloc() and
+ * pvPortRealloc() let the C library's malloc() family be built on this heap.
+ *
+ * If configUSE_HEAP_TELEMETRY is set to 1 then a histogram of the sizes of the
+ * free blocks is kept up to date as blocks enter and leave the list of free
+ * blocks, the cycles each allocation and free take with the scheduler
+ * suspended are counted into histograms, and the most recent failed
+ * allocations are recorded with their call site and the state of the heap.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c and heap_tlsf.c for alternative
+ * implementations, and the memory management pages of http://www.FreeRTOS.org
+ * for more information.
  */
 #include <stdlib.h>
+#include <string.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
 all the API functions to use the MPU wrappers.  That should only be done when
@@ -45,6 +68,9 @@ task.h is included from an application file. */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* heap_tlsf.c is built instead if configUSE_TLSF_HEAP is 1. */
+#if( configUSE_TLSF_HEAP == 0 )
+
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
 	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
@@ -56,7 +82,10 @@ task.h is included from an application file. */
 #define heapBITS_PER_BYTE		( ( size_t ) 8 )
 
 /* Allocate the memory for the heap. */
-#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+#if( configUSE_APPLICATION_HEAP_REGION == 1 )
+	/* The heap is the region of RAM between configHEAP_REGION_START() and
+	configHEAP_REGION_END(), which are read when the heap is initialised. */
+#elif( configAPPLICATION_ALLOCATED_HEAP == 1 )
 	/* The application writer has already defined the array used for the RTOS
 	heap - probably so it can be placed in a special segment or address. */
 	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
@@ -72,6 +101,52 @@ typedef struct A_BLOCK_LINK
 	size_t xBlockSize;						/*<< The size of the free block. */
 } BlockLink_t;
 
+#if( configUSE_HEAP_SLABS == 1 )
+
+	/* The header at the start of each slab page. */
+	typedef struct A_SLAB_PAGE
+	{
+		struct A_SLAB_PAGE *pxNextPage;		/*<< The next page of the same size class that has a free object. */
+		struct A_SLAB_PAGE *pxPreviousPage;	/*<< The previous page of the same size class that has a free object. */
+		void *pvFreeObjects;				/*<< The free objects of the page, linked through their first word. */
+		uint16_t usObjectsInUse;			/*<< The number of objects of the page that are allocated. */
+		uint8_t ucClass;					/*<< The size class the page belongs to. */
+	} SlabPage_t;
+
+	/* The pages and occupancy of a size class. */
+	typedef struct A_SLAB_CLASS
+	{
+		SlabPage_t *pxPartialPages;			/*<< The pages of the class that have a free object. */
+		size_t xObjectSize;					/*<< The object size, rounded up to the byte alignment. */
+		size_t xObjectsPerPage;
+		size_t xNumberOfPages;
+		size_t xObjectsInUse;
+	} SlabClass_t;
+
+	static const size_t xSlabObjectSizes[] = configHEAP_SLAB_OBJECT_SIZES;
+
+	#define heapSLAB_CLASS_COUNT	( sizeof( xSlabObjectSizes ) / sizeof( xSlabObjectSizes[ 0 ] ) )
+	#define heapSLAB_NO_CLASS		( ( uint8_t ) 0xff )
+
+	/* The number of words of page bitmap for a heap of xHeapSize bytes. */
+	#define heapSLAB_BITMAP_WORDS( xHeapSize )	( ( ( ( xHeapSize ) / configHEAP_SLAB_PAGE_SIZE ) + 1 + 31 ) / 32 )
+
+	/* The number of portBYTE_ALIGNMENT sized steps in a page, which is the
+	number of entries needed to map any request up to a page to its class. */
+	#define heapSLAB_SIZE_STEPS		( configHEAP_SLAB_PAGE_SIZE / portBYTE_ALIGNMENT )
+
+#endif /* configUSE_HEAP_SLABS */
+
+/* Keep the free block histogram up to date as blocks enter and leave the list
+of free blocks. */
+#if( configUSE_HEAP_TELEMETRY == 1 )
+	#define heapFREE_BLOCK_ADDED( xSize )		( ulFreeBlockHistogram[ prvTelemetryBucket( xSize ) ]++ )
+	#define heapFREE_BLOCK_REMOVED( xSize )		( ulFreeBlockHistogram[ prvTelemetryBucket( xSize ) ]-- )
+#else
+	#define heapFREE_BLOCK_ADDED( xSize )
+	#define heapFREE_BLOCK_REMOVED( xSize )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -88,6 +163,69 @@ static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
  */
 static void prvHeapInit( void );
 
+#if( configUSE_HEAP_SLABS == 1 )
+
+	/*
+	 * Work out the object size of each size class, and which class serves
+	 * each request size.  Called from prvHeapInit().
+	 */
+	static void prvSlabInit( uint8_t *pucAlignedHeap );
+
+	/*
+	 * Allocate an object of the smallest size class that xWantedSize fits in,
+	 * taking a new page from the heap if the class has no free object.
+	 * Returns NULL if xWantedSize does not fit in any class or no page could
+	 * be taken.
+	 */
+	static void *prvSlabAllocate( size_t xWantedSize );
+
+	/*
+	 * Free pv if it is an object of a slab page, and return pdTRUE.  Returns
+	 * pdFALSE without doing anything if it is not.
+	 */
+	static BaseType_t prvSlabFree( void *pv );
+
+	/*
+	 * The slab page that pv is an object of, or NULL if pv is not a slab
+	 * object.
+	 */
+	static SlabPage_t *prvSlabPageOf( const void *pv );
+
+	/*
+	 * Take a page for a size class from the heap, or give a page back to the
+	 * heap.  A page is a heap block whose usable space is aligned to
+	 * configHEAP_SLAB_PAGE_SIZE from the start of the heap, so the page of an
+	 * object is found by rounding its address down.
+	 */
+	static SlabPage_t *prvSlabTakePage( uint8_t ucClass );
+	static void prvSlabReleasePage( SlabPage_t *pxPage );
+
+#endif /* configUSE_HEAP_SLABS */
+
+#if( configUSE_HEAP_TELEMETRY == 1 )
+
+	/*
+	 * The histogram bucket that counts xValue.
+	 */
+	static UBaseType_t prvTelemetryBucket( size_t xValue );
+
+	/*
+	 * Count the cycles since ulStartCycles into the histogram of pvPortMalloc()
+	 * or vPortFree(), and record the allocation if it failed.  Called with the
+	 * scheduler suspended.
+	 */
+	static void prvTelemetryRecordMalloc( const void *pvReturn, size_t xWantedSize, uint32_t ulStartCycles, void *pvCaller );
+	static void prvTelemetryRecordFree( uint32_t ulStartCycles );
+
+	/*
+	 * Walk the list of free blocks for the largest, and work out the share of
+	 * the free bytes outside it.
+	 */
+	static size_t prvLargestFreeBlock( void );
+	static uint32_t prvFragmentation( size_t xFreeBytes, size_t xLargestFreeBlock );
+
+#endif /* configUSE_HEAP_TELEMETRY */
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -110,15 +248,68 @@ application.  When the bit is free the block is still part of the free heap
 space. */
 static size_t xBlockAllocatedBit = 0;
 
+#if( configUSE_HEAP_SLABS == 1 )
+
+	/* The size of the header at the start of each slab page, rounded up so
+	the objects after it are correctly byte aligned. */
+	static const size_t xSlabPageHeaderSize = ( sizeof( SlabPage_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+	static SlabClass_t xSlabClasses[ heapSLAB_CLASS_COUNT ];
+
+	/* The size class that serves each request size, in steps of
+	portBYTE_ALIGNMENT, or heapSLAB_NO_CLASS. */
+	static uint8_t ucSlabClassForSize[ heapSLAB_SIZE_STEPS ];
+
+	/* Pages are counted from the start of the heap.  A bit is set in
+	pulSlabPageBitmap for each page that belongs to a size class.  The size of
+	an application heap region is only known when the heap is initialised, so
+	its bitmap is then taken from the start of the region. */
+	static uint8_t *pucSlabPageBase = NULL;
+	#if( configUSE_APPLICATION_HEAP_REGION == 1 )
+		static uint32_t *pulSlabPageBitmap = NULL;
+	#else
+		static uint32_t ulSlabPageBitmap[ heapSLAB_BITMAP_WORDS( configTOTAL_HEAP_SIZE ) ];
+		static uint32_t * const pulSlabPageBitmap = ulSlabPageBitmap;
+	#endif
+
+#endif /* configUSE_HEAP_SLABS */
+
+#if( configUSE_HEAP_TELEMETRY == 1 )
+
+	static uint32_t ulFreeBlockHistogram[ heapTELEMETRY_BUCKETS ];
+	static uint32_t ulMallocCycleHistogram[ heapTELEMETRY_BUCKETS ];
+	static uint32_t ulFreeCycleHistogram[ heapTELEMETRY_BUCKETS ];
+	static uint32_t ulMaxMallocCycles = 0UL;
+	static uint32_t ulMaxFreeCycles = 0UL;
+	static uint32_t ulWorstFragmentation = 0UL;
+
+	/* Failed allocations are recorded in xFailureRecords as a ring, in which
+	ulAllocationFailures modulo heapTELEMETRY_FAILURE_RECORDS is the next
+	record to write. */
+	static uint32_t ulAllocationFailures = 0UL;
+	static HeapFailureRecord_t xFailureRecords[ heapTELEMETRY_FAILURE_RECORDS ];
+
+#endif /* configUSE_HEAP_TELEMETRY */
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc( size_t xWantedSize )
 {
 BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 void *pvReturn = NULL;
+#if( configUSE_HEAP_TELEMETRY == 1 )
+	size_t xRequestedSize = xWantedSize;
+	uint32_t ulStartCycles;
+#endif
 
 	vTaskSuspendAll();
 	{
+		#if( configUSE_HEAP_TELEMETRY == 1 )
+		{
+			ulStartCycles = ( uint32_t ) portGET_CYCLE_COUNTER_VALUE();
+		}
+		#endif
+
 		/* If this is the first call to malloc then the heap will require
 		initialisation to setup the list of free blocks. */
 		if( pxEnd == NULL )
@@ -130,11 +321,18 @@ void *pvReturn = NULL;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		#if( configUSE_HEAP_SLABS == 1 )
+		{
+			pvReturn = prvSlabAllocate( xWantedSize );
+		}
+		#endif
+
 		/* Check the requested block size is not so large that the top bit is
 		set.  The top bit of the block size member of the BlockLink_t structure
 		is used to determine who owns the block - the application or the
-		kernel, so it must be free. */
-		if( ( xWantedSize & xBlockAllocatedBit ) == 0 )
+		kernel, so it must be free.  Nothing more is done if a slab object was
+		allocated above. */
+		if( ( pvReturn == NULL ) && ( ( xWantedSize & xBlockAllocatedBit ) == 0 ) )
 		{
 			/* The wanted size is increased so it can contain a BlockLink_t
 			structure in addition to the requested amount of bytes. */
@@ -183,6 +381,7 @@ void *pvReturn = NULL;
 					/* This block is being returned for use so must be taken out
 					of the list of free blocks. */
 					pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+					heapFREE_BLOCK_REMOVED( pxBlock->xBlockSize );
 
 					/* If the block is larger than required it can be split into
 					two. */
@@ -240,6 +439,12 @@ void *pvReturn = NULL;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		#if( configUSE_HEAP_TELEMETRY == 1 )
+		{
+			prvTelemetryRecordMalloc( pvReturn, xRequestedSize, ulStartCycles, configHEAP_TELEMETRY_CALLER() );
+		}
+		#endif
+
 		traceMALLOC( pvReturn, xWantedSize );
 	}
 	( void ) xTaskResumeAll();
@@ -267,6 +472,24 @@ void vPortFree( void *pv )
 {
 uint8_t *puc = ( uint8_t * ) pv;
 BlockLink_t *pxLink;
+#if( configUSE_HEAP_TELEMETRY == 1 )
+	uint32_t ulStartCycles;
+#endif
+
+	#if( configUSE_HEAP_SLABS == 1 )
+	{
+		/* Slab objects have no BlockLink_t structure, so are freed to their
+		page instead. */
+		if( prvSlabFree( pv ) != pdFALSE )
+		{
+			pv = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
 
 	if( pv != NULL )
 	{
@@ -291,13 +514,170 @@ BlockLink_t *pxLink;
 
 				vTaskSuspendAll();
 				{
+					#if( configUSE_HEAP_TELEMETRY == 1 )
+					{
+						ulStartCycles = ( uint32_t ) portGET_CYCLE_COUNTER_VALUE();
+					}
+					#endif
+
 					/* Add this block to the list of free blocks. */
 					xFreeBytesRemaining += pxLink->xBlockSize;
 					traceFREE( pv, pxLink->xBlockSize );
 					prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
 					xNumberOfSuccessfulFrees++;
+
+					#if( configUSE_HEAP_TELEMETRY == 1 )
+					{
+						prvTelemetryRecordFree( ulStartCycles );
+					}
+					#endif
+				}
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortCalloc( size_t xNum, size_t xSize )
+{
+void *pvReturn = NULL;
+
+	/* Refuse a request whose size in bytes does not fit in a size_t. */
+	if( ( xSize == 0 ) || ( xNum <= ( ( ( size_t ) -1 ) / xSize ) ) )
+	{
+		pvReturn = pvPortMalloc( xNum * xSize );
+
+		if( pvReturn != NULL )
+		{
+			( void ) memset( pvReturn, 0x00, xNum * xSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortRealloc( void *pv, size_t xWantedSize )
+{
+BlockLink_t *pxLink, *pxNewBlockLink;
+void *pvReturn = NULL;
+size_t xCurrentSize, xBlockSize;
+
+	if( pv == NULL )
+	{
+		pvReturn = pvPortMalloc( xWantedSize );
+	}
+	else if( xWantedSize == 0 )
+	{
+		vPortFree( pv );
+	}
+	else
+	{
+		pxLink = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+		xCurrentSize = 0;
+
+		#if( configUSE_HEAP_SLABS == 1 )
+		{
+			SlabPage_t *pxPage = prvSlabPageOf( pv );
+
+			if( pxPage != NULL )
+			{
+				/* A slab object keeps its size, so is moved by the copy below
+				if it grows. */
+				xCurrentSize = xSlabClasses[ pxPage->ucClass ].xObjectSize;
+				pxLink = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		if( pxLink != NULL )
+		{
+			configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+			configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+			xBlockSize = pxLink->xBlockSize & ~xBlockAllocatedBit;
+			xCurrentSize = xBlockSize - xHeapStructSize;
+
+			if( xWantedSize <= xCurrentSize )
+			{
+				/* The block is shrinking.  Give the end of it back to the heap
+				if that is large enough to be a block of its own. */
+				xWantedSize += xHeapStructSize;
+
+				if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+				{
+					xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				vTaskSuspendAll();
+				{
+					if( ( xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+					{
+						pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxLink ) + xWantedSize );
+						pxNewBlockLink->xBlockSize = xBlockSize - xWantedSize;
+						pxLink->xBlockSize = xWantedSize | xBlockAllocatedBit;
+
+						xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+						prvInsertBlockIntoFreeList( pxNewBlockLink );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 				( void ) xTaskResumeAll();
+
+				pvReturn = pv;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( xWantedSize <= xCurrentSize )
+		{
+			pvReturn = pv;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pvReturn == NULL )
+		{
+			/* The allocation is growing.  pv is left as it is if there is no
+			room for the new size. */
+			pvReturn = pvPortMalloc( xWantedSize );
+
+			if( pvReturn != NULL )
+			{
+				( void ) memcpy( pvReturn, pv, xCurrentSize );
+				vPortFree( pv );
 			}
 			else
 			{
@@ -309,6 +689,8 @@ BlockLink_t *pxLink;
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
+
+	return pvReturn;
 }
 /*-----------------------------------------------------------*/
 
@@ -335,20 +717,52 @@ static void prvHeapInit( void )
 BlockLink_t *pxFirstFreeBlock;
 uint8_t *pucAlignedHeap;
 size_t uxAddress;
-size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+#if( configUSE_APPLICATION_HEAP_REGION == 1 )
+	uint8_t * const pucHeap = ( uint8_t * ) ( configHEAP_REGION_START() );
+	size_t xTotalHeapSize = ( size_t ) ( ( uint8_t * ) ( configHEAP_REGION_END() ) - pucHeap );
+	#if( configUSE_HEAP_SLABS == 1 )
+		size_t xBitmapSize;
+	#endif
+#else
+	uint8_t * const pucHeap = ucHeap;
+	size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+#endif
+
+	#if( configUSE_APPLICATION_HEAP_REGION == 1 )
+	{
+		/* The region must at least hold the end marker and one block. */
+		configASSERT( ( uint8_t * ) ( configHEAP_REGION_END() ) > pucHeap );
+		configASSERT( xTotalHeapSize > ( portBYTE_ALIGNMENT + xHeapStructSize + heapMINIMUM_BLOCK_SIZE ) );
+	}
+	#endif
 
 	/* Ensure the heap starts on a correctly aligned boundary. */
-	uxAddress = ( size_t ) ucHeap;
+	uxAddress = ( size_t ) pucHeap;
 
 	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
 	{
 		uxAddress += ( portBYTE_ALIGNMENT - 1 );
 		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
-		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+		xTotalHeapSize -= uxAddress - ( size_t ) pucHeap;
 	}
 
 	pucAlignedHeap = ( uint8_t * ) uxAddress;
 
+	#if( ( configUSE_APPLICATION_HEAP_REGION == 1 ) && ( configUSE_HEAP_SLABS == 1 ) )
+	{
+		/* Take the slab page bitmap from the start of the region, with a bit
+		for each page the rest of the region could hold. */
+		xBitmapSize = heapSLAB_BITMAP_WORDS( xTotalHeapSize ) * sizeof( uint32_t );
+		xBitmapSize = ( xBitmapSize + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		configASSERT( xTotalHeapSize > ( xBitmapSize + xHeapStructSize + heapMINIMUM_BLOCK_SIZE ) );
+
+		pulSlabPageBitmap = ( uint32_t * ) pucAlignedHeap; /*lint !e9087 !e826 The region is aligned to portBYTE_ALIGNMENT. */
+		( void ) memset( pulSlabPageBitmap, 0, xBitmapSize );
+		pucAlignedHeap += xBitmapSize;
+		xTotalHeapSize -= xBitmapSize;
+	}
+	#endif
+
 	/* xStart is used to hold a pointer to the first item in the list of free
 	blocks.  The void cast is used to prevent compiler warnings. */
 	xStart.pxNextFreeBlock = ( void * ) pucAlignedHeap;
@@ -372,9 +786,24 @@ size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
 	/* Only one block exists - and it covers the entire usable heap space. */
 	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
 	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+	heapFREE_BLOCK_ADDED( pxFirstFreeBlock->xBlockSize );
 
 	/* Work out the position of the top bit in a size_t variable. */
 	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+	#if( configUSE_HEAP_SLABS == 1 )
+	{
+		prvSlabInit( pucAlignedHeap );
+	}
+	#endif
+
+	#if( configUSE_HEAP_TELEMETRY == 1 )
+	{
+		/* The heap is initialised by the first allocation, which may be made
+		before the scheduler starts the cycle counter. */
+		portCONFIGURE_CYCLE_COUNTER();
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -395,6 +824,7 @@ uint8_t *puc;
 	puc = ( uint8_t * ) pxIterator;
 	if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
 	{
+		heapFREE_BLOCK_REMOVED( pxIterator->xBlockSize );
 		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
 		pxBlockToInsert = pxIterator;
 	}
@@ -411,6 +841,7 @@ uint8_t *puc;
 		if( pxIterator->pxNextFreeBlock != pxEnd )
 		{
 			/* Form one big block from the two blocks. */
+			heapFREE_BLOCK_REMOVED( pxIterator->pxNextFreeBlock->xBlockSize );
 			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
 			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
 		}
@@ -424,6 +855,8 @@ uint8_t *puc;
 		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
 	}
 
+	heapFREE_BLOCK_ADDED( pxBlockToInsert->xBlockSize );
+
 	/* If the block being inserted plugged a gab, so was merged with the block
 	before and the block after, then it's pxNextFreeBlock pointer will have
 	already been set, and should not be set here as that would make it point
@@ -489,4 +922,750 @@ size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY use
 	}
 	taskEXIT_CRITICAL();
 }
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_SLABS == 1 )
+
+	static void prvSlabInit( uint8_t *pucAlignedHeap )
+	{
+	size_t xClass, xStep, xSize;
+
+		configASSERT( heapSLAB_CLASS_COUNT < heapSLAB_NO_CLASS );
+
+		pucSlabPageBase = pucAlignedHeap;
+
+		for( xClass = 0; xClass < heapSLAB_CLASS_COUNT; xClass++ )
+		{
+			/* Each object must be aligned, and must be large enough to link
+			it into the free list of its page. */
+			xSize = xSlabObjectSizes[ xClass ];
+
+			if( xSize < sizeof( void * ) )
+			{
+				xSize = sizeof( void * );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xSize = ( xSize + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+			xSlabClasses[ xClass ].xObjectSize = xSize;
+			xSlabClasses[ xClass ].xObjectsPerPage = ( configHEAP_SLAB_PAGE_SIZE - xSlabPageHeaderSize ) / xSize;
+		}
+
+		for( xStep = 0; xStep < heapSLAB_SIZE_STEPS; xStep++ )
+		{
+			/* Find the smallest class that holds the largest request of this
+			step.  A class is only used if its objects are no larger than the
+			heap block the request would otherwise take, and if a page has room
+			for more than one of them, so a slab object never costs more memory
+			than a heap block. */
+			xSize = ( xStep + 1 ) * portBYTE_ALIGNMENT;
+			ucSlabClassForSize[ xStep ] = heapSLAB_NO_CLASS;
+
+			for( xClass = 0; xClass < heapSLAB_CLASS_COUNT; xClass++ )
+			{
+				if( ( xSlabClasses[ xClass ].xObjectSize >= xSize ) &&
+					( xSlabClasses[ xClass ].xObjectSize <= ( xSize + xHeapStructSize ) ) &&
+					( xSlabClasses[ xClass ].xObjectsPerPage > 1 ) &&
+					( ( ucSlabClassForSize[ xStep ] == heapSLAB_NO_CLASS ) ||
+					  ( xSlabClasses[ xClass ].xObjectSize < xSlabClasses[ ucSlabClassForSize[ xStep ] ].xObjectSize ) ) )
+				{
+					ucSlabClassForSize[ xStep ] = ( uint8_t ) xClass;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+
+#endif /* configUSE_HEAP_SLABS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_SLABS == 1 )
+
+	static void *prvSlabAllocate( size_t xWantedSize )
+	{
+	SlabClass_t *pxClass;
+	SlabPage_t *pxPage;
+	uint8_t ucClass;
+	void *pvReturn = NULL;
+
+		if( ( xWantedSize > 0 ) && ( xWantedSize <= configHEAP_SLAB_PAGE_SIZE ) )
+		{
+			ucClass = ucSlabClassForSize[ ( xWantedSize - 1 ) / portBYTE_ALIGNMENT ];
+
+			if( ucClass != heapSLAB_NO_CLASS )
+			{
+				pxClass = &( xSlabClasses[ ucClass ] );
+				pxPage = pxClass->pxPartialPages;
+
+				if( pxPage == NULL )
+				{
+					pxPage = prvSlabTakePage( ucClass );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( pxPage != NULL )
+				{
+					pvReturn = pxPage->pvFreeObjects;
+					pxPage->pvFreeObjects = *( ( void ** ) pvReturn );
+					pxPage->usObjectsInUse++;
+					pxClass->xObjectsInUse++;
+
+					/* A full page is taken off the list of pages with a free
+					object.  The page is always at the head of the list. */
+					if( pxPage->pvFreeObjects == NULL )
+					{
+						pxClass->pxPartialPages = pxPage->pxNextPage;
+
+						if( pxPage->pxNextPage != NULL )
+						{
+							pxPage->pxNextPage->pxPreviousPage = NULL;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						pxPage->pxNextPage = NULL;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xNumberOfSuccessfulAllocations++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pvReturn;
+	}
+
+#endif /* configUSE_HEAP_SLABS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_SLABS == 1 )
+
+	static SlabPage_t *prvSlabPageOf( const void *pv )
+	{
+	const uint8_t *puc = ( const uint8_t * ) pv;
+	SlabPage_t *pxPage = NULL;
+	size_t xPageIndex;
+
+		/* pv is a slab object if it is inside a page that belongs to a size
+		class.  The bit of the page cannot change while pv is allocated, so
+		can be read without the scheduler suspended. */
+		if( ( pucSlabPageBase != NULL ) && ( puc >= pucSlabPageBase ) && ( puc < ( uint8_t * ) pxEnd ) )
+		{
+			xPageIndex = ( size_t ) ( puc - pucSlabPageBase ) / configHEAP_SLAB_PAGE_SIZE;
+
+			if( ( pulSlabPageBitmap[ xPageIndex / 32 ] & ( 1UL << ( xPageIndex % 32 ) ) ) != 0UL )
+			{
+				pxPage = ( void * ) ( pucSlabPageBase + ( xPageIndex * configHEAP_SLAB_PAGE_SIZE ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxPage;
+	}
+
+#endif /* configUSE_HEAP_SLABS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_SLABS == 1 )
+
+	static BaseType_t prvSlabFree( void *pv )
+	{
+	SlabClass_t *pxClass;
+	SlabPage_t *pxPage;
+	BaseType_t xReturn = pdFALSE;
+	#if( configUSE_HEAP_TELEMETRY == 1 )
+		uint32_t ulStartCycles;
+	#endif
+
+		pxPage = prvSlabPageOf( pv );
+
+		if( pxPage != NULL )
+		{
+			pxClass = &( xSlabClasses[ pxPage->ucClass ] );
+
+			/* Check pv is the start of an object that is allocated. */
+			configASSERT( ( ( size_t ) ( ( uint8_t * ) pv - ( ( uint8_t * ) pxPage + xSlabPageHeaderSize ) ) % pxClass->xObjectSize ) == 0 );
+			configASSERT( pxPage->usObjectsInUse > 0 );
+
+			vTaskSuspendAll();
+			{
+				#if( configUSE_HEAP_TELEMETRY == 1 )
+				{
+					ulStartCycles = ( uint32_t ) portGET_CYCLE_COUNTER_VALUE();
+				}
+				#endif
+
+				traceFREE( pv, pxClass->xObjectSize );
+
+				/* A page that was full goes back on the list of pages with
+				a free object. */
+				if( pxPage->pvFreeObjects == NULL )
+				{
+					pxPage->pxPreviousPage = NULL;
+					pxPage->pxNextPage = pxClass->pxPartialPages;
+
+					if( pxClass->pxPartialPages != NULL )
+					{
+						pxClass->pxPartialPages->pxPreviousPage = pxPage;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					pxClass->pxPartialPages = pxPage;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				*( ( void ** ) pv ) = pxPage->pvFreeObjects;
+				pxPage->pvFreeObjects = pv;
+				pxPage->usObjectsInUse--;
+				pxClass->xObjectsInUse--;
+				xNumberOfSuccessfulFrees++;
+
+				/* An empty page goes back to the heap.  If
+				configHEAP_SLAB_KEEP_EMPTY_PAGE is 1 then it is kept instead
+				if it is the only page of the class with a free object. */
+				#if( configHEAP_SLAB_KEEP_EMPTY_PAGE == 1 )
+				{
+					if( ( pxPage->usObjectsInUse == 0 ) && ( ( pxPage->pxNextPage != NULL ) || ( pxPage->pxPreviousPage != NULL ) ) )
+					{
+						prvSlabReleasePage( pxPage );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#else
+				{
+					if( pxPage->usObjectsInUse == 0 )
+					{
+						prvSlabReleasePage( pxPage );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configHEAP_SLAB_KEEP_EMPTY_PAGE */
+
+				#if( configUSE_HEAP_TELEMETRY == 1 )
+				{
+					prvTelemetryRecordFree( ulStartCycles );
+				}
+				#endif
+			}
+			( void ) xTaskResumeAll();
+
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_HEAP_SLABS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_SLABS == 1 )
+
+	static SlabPage_t *prvSlabTakePage( uint8_t ucClass )
+	{
+	BlockLink_t *pxBlock, *pxPreviousBlock, *pxPageBlock, *pxNewBlockLink;
+	SlabClass_t *pxClass = &( xSlabClasses[ ucClass ] );
+	SlabPage_t *pxPage = NULL;
+	size_t xOffset, xLeadingSize, xTrailingSize, xPageIndex, xObject;
+	uint8_t *pucObject;
+
+		/* Find the first free block that contains a whole page, with a
+		BlockLink_t structure before it.  The space in front of the
+		BlockLink_t structure stays a free block, so must be either empty or
+		large enough to be a block. */
+		pxPreviousBlock = &xStart;
+		pxBlock = xStart.pxNextFreeBlock;
+
+		while( pxBlock != pxEnd )
+		{
+			xOffset = ( size_t ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize - pucSlabPageBase );
+			xOffset = ( xOffset + ( configHEAP_SLAB_PAGE_SIZE - 1 ) ) & ~( ( size_t ) ( configHEAP_SLAB_PAGE_SIZE - 1 ) );
+			xLeadingSize = ( size_t ) ( ( pucSlabPageBase + xOffset - xHeapStructSize ) - ( uint8_t * ) pxBlock );
+
+			if( ( xLeadingSize != 0 ) && ( xLeadingSize < heapMINIMUM_BLOCK_SIZE ) )
+			{
+				xOffset += configHEAP_SLAB_PAGE_SIZE;
+				xLeadingSize += configHEAP_SLAB_PAGE_SIZE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( xLeadingSize + xHeapStructSize + configHEAP_SLAB_PAGE_SIZE ) <= pxBlock->xBlockSize )
+			{
+				break;
+			}
+
+			pxPreviousBlock = pxBlock;
+			pxBlock = pxBlock->pxNextFreeBlock;
+		}
+
+		if( pxBlock != pxEnd )
+		{
+			pxPageBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xLeadingSize );
+			xTrailingSize = pxBlock->xBlockSize - xLeadingSize - xHeapStructSize - configHEAP_SLAB_PAGE_SIZE;
+
+			/* Either the page starts the free block, which is taken out of
+			the list, or the free block is cut short in front of the page. */
+			heapFREE_BLOCK_REMOVED( pxBlock->xBlockSize );
+
+			if( xLeadingSize == 0 )
+			{
+				pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+			}
+			else
+			{
+				pxBlock->xBlockSize = xLeadingSize;
+				heapFREE_BLOCK_ADDED( xLeadingSize );
+			}
+
+			pxPageBlock->xBlockSize = xHeapStructSize + configHEAP_SLAB_PAGE_SIZE;
+
+			/* Any space after the page large enough to be a block goes back
+			into the list of free blocks. */
+			if( xTrailingSize > heapMINIMUM_BLOCK_SIZE )
+			{
+				pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxPageBlock ) + pxPageBlock->xBlockSize );
+				pxNewBlockLink->xBlockSize = xTrailingSize;
+				prvInsertBlockIntoFreeList( pxNewBlockLink );
+			}
+			else
+			{
+				pxPageBlock->xBlockSize += xTrailingSize;
+			}
+
+			xFreeBytesRemaining -= pxPageBlock->xBlockSize;
+
+			if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+			{
+				xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxPageBlock->xBlockSize |= xBlockAllocatedBit;
+			pxPageBlock->pxNextFreeBlock = NULL;
+
+			/* Divide the page into objects, all of them free. */
+			pxPage = ( void * ) ( pucSlabPageBase + xOffset );
+			pxPage->ucClass = ucClass;
+			pxPage->usObjectsInUse = 0;
+			pxPage->pvFreeObjects = NULL;
+
+			pucObject = ( ( uint8_t * ) pxPage ) + xSlabPageHeaderSize + ( pxClass->xObjectsPerPage * pxClass->xObjectSize );
+
+			for( xObject = 0; xObject < pxClass->xObjectsPerPage; xObject++ )
+			{
+				pucObject -= pxClass->xObjectSize;
+				*( ( void ** ) pucObject ) = pxPage->pvFreeObjects;
+				pxPage->pvFreeObjects = pucObject;
+			}
+
+			pxPage->pxPreviousPage = NULL;
+			pxPage->pxNextPage = pxClass->pxPartialPages;
+
+			if( pxClass->pxPartialPages != NULL )
+			{
+				pxClass->pxPartialPages->pxPreviousPage = pxPage;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxClass->pxPartialPages = pxPage;
+			pxClass->xNumberOfPages++;
+
+			xPageIndex = xOffset / configHEAP_SLAB_PAGE_SIZE;
+			pulSlabPageBitmap[ xPageIndex / 32 ] |= ( 1UL << ( xPageIndex % 32 ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxPage;
+	}
+
+#endif /* configUSE_HEAP_SLABS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_SLABS == 1 )
+
+	static void prvSlabReleasePage( SlabPage_t *pxPage )
+	{
+	SlabClass_t *pxClass = &( xSlabClasses[ pxPage->ucClass ] );
+	BlockLink_t *pxLink;
+	size_t xPageIndex;
+
+		if( pxPage->pxPreviousPage != NULL )
+		{
+			pxPage->pxPreviousPage->pxNextPage = pxPage->pxNextPage;
+		}
+		else
+		{
+			pxClass->pxPartialPages = pxPage->pxNextPage;
+		}
+
+		if( pxPage->pxNextPage != NULL )
+		{
+			pxPage->pxNextPage->pxPreviousPage = pxPage->pxPreviousPage;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxClass->xNumberOfPages--;
+
+		xPageIndex = ( size_t ) ( ( uint8_t * ) pxPage - pucSlabPageBase ) / configHEAP_SLAB_PAGE_SIZE;
+		pulSlabPageBitmap[ xPageIndex / 32 ] &= ~( 1UL << ( xPageIndex % 32 ) );
+
+		/* The page is the usable space of a heap block, which is freed as in
+		vPortFree(). */
+		pxLink = ( void * ) ( ( ( uint8_t * ) pxPage ) - xHeapStructSize );
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+		pxLink->xBlockSize &= ~xBlockAllocatedBit;
+		xFreeBytesRemaining += pxLink->xBlockSize;
+		prvInsertBlockIntoFreeList( pxLink );
+	}
+
+#endif /* configUSE_HEAP_SLABS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_SLABS == 1 )
+
+	UBaseType_t uxPortGetSlabStats( SlabStats_t *pxSlabStats, UBaseType_t uxArraySize )
+	{
+	UBaseType_t uxClass;
+
+		vTaskSuspendAll();
+		{
+			/* The object sizes are worked out when the heap is initialised. */
+			if( pxEnd == NULL )
+			{
+				prvHeapInit();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			for( uxClass = 0; ( uxClass < ( UBaseType_t ) heapSLAB_CLASS_COUNT ) && ( uxClass < uxArraySize ); uxClass++ )
+			{
+				pxSlabStats[ uxClass ].xObjectSize = xSlabClasses[ uxClass ].xObjectSize;
+				pxSlabStats[ uxClass ].xNumberOfPages = xSlabClasses[ uxClass ].xNumberOfPages;
+				pxSlabStats[ uxClass ].xObjectsInUse = xSlabClasses[ uxClass ].xObjectsInUse;
+				pxSlabStats[ uxClass ].xObjectsFree = ( xSlabClasses[ uxClass ].xNumberOfPages * xSlabClasses[ uxClass ].xObjectsPerPage ) - xSlabClasses[ uxClass ].xObjectsInUse;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return uxClass;
+	}
+
+#endif /* configUSE_HEAP_SLABS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_TELEMETRY == 1 )
+
+	static UBaseType_t prvTelemetryBucket( size_t xValue )
+	{
+	UBaseType_t uxBucket = 0;
+
+		xValue >>= heapTELEMETRY_BUCKET_SHIFT;
+
+		#if defined( __GNUC__ )
+		{
+			if( xValue > 1U )
+			{
+				uxBucket = ( UBaseType_t ) ( ( sizeof( unsigned long ) * heapBITS_PER_BYTE ) - 1U - ( size_t ) __builtin_clzl( ( unsigned long ) xValue ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			while( xValue > 1U )
+			{
+				xValue >>= 1;
+				uxBucket++;
+			}
+		}
+		#endif
+
+		if( uxBucket >= heapTELEMETRY_BUCKETS )
+		{
+			uxBucket = heapTELEMETRY_BUCKETS - 1;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxBucket;
+	}
+
+#endif /* configUSE_HEAP_TELEMETRY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_TELEMETRY == 1 )
+
+	static void prvTelemetryRecordMalloc( const void *pvReturn, size_t xWantedSize, uint32_t ulStartCycles, void *pvCaller )
+	{
+	uint32_t ulCycles = ( uint32_t ) portGET_CYCLE_COUNTER_VALUE() - ulStartCycles;
+	HeapFailureRecord_t *pxRecord;
+
+		ulMallocCycleHistogram[ prvTelemetryBucket( ulCycles ) ]++;
+
+		if( ulCycles > ulMaxMallocCycles )
+		{
+			ulMaxMallocCycles = ulCycles;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* A request for zero bytes is not counted as a failure. */
+		if( ( pvReturn == NULL ) && ( xWantedSize > 0 ) )
+		{
+			pxRecord = &( xFailureRecords[ ulAllocationFailures % heapTELEMETRY_FAILURE_RECORDS ] );
+			pxRecord->pvCaller = pvCaller;
+			pxRecord->xWantedSize = xWantedSize;
+			pxRecord->xFreeBytes = xFreeBytesRemaining;
+			pxRecord->xLargestFreeBlock = prvLargestFreeBlock();
+			pxRecord->xTickCount = xTaskGetTickCount();
+			ulAllocationFailures++;
+
+			if( prvFragmentation( pxRecord->xFreeBytes, pxRecord->xLargestFreeBlock ) > ulWorstFragmentation )
+			{
+				ulWorstFragmentation = prvFragmentation( pxRecord->xFreeBytes, pxRecord->xLargestFreeBlock );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_HEAP_TELEMETRY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_TELEMETRY == 1 )
+
+	static void prvTelemetryRecordFree( uint32_t ulStartCycles )
+	{
+	uint32_t ulCycles = ( uint32_t ) portGET_CYCLE_COUNTER_VALUE() - ulStartCycles;
+
+		ulFreeCycleHistogram[ prvTelemetryBucket( ulCycles ) ]++;
+
+		if( ulCycles > ulMaxFreeCycles )
+		{
+			ulMaxFreeCycles = ulCycles;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_HEAP_TELEMETRY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_TELEMETRY == 1 )
+
+	static size_t prvLargestFreeBlock( void )
+	{
+	BlockLink_t *pxBlock;
+	size_t xMaxSize = 0;
+
+		/* pxEnd is NULL if the heap has not been initialised. */
+		if( pxEnd != NULL )
+		{
+			for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				if( pxBlock->xBlockSize > xMaxSize )
+				{
+					xMaxSize = pxBlock->xBlockSize;
+				}
+			}
+		}
+
+		return xMaxSize;
+	}
+
+#endif /* configUSE_HEAP_TELEMETRY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_TELEMETRY == 1 )
+
+	static uint32_t prvFragmentation( size_t xFreeBytes, size_t xLargestFreeBlock )
+	{
+	uint32_t ulFragmentation = 0UL;
+
+		if( xFreeBytes > 0 )
+		{
+			ulFragmentation = 1000UL - ( uint32_t ) ( ( ( uint64_t ) xLargestFreeBlock * 1000ULL ) / ( uint64_t ) xFreeBytes );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ulFragmentation;
+	}
+
+#endif /* configUSE_HEAP_TELEMETRY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_TELEMETRY == 1 )
+
+	void vPortGetHeapTelemetry( HeapTelemetry_t *pxTelemetry )
+	{
+	UBaseType_t uxBucket, uxRecord, uxValidRecords;
+	uint32_t ulOldest;
+
+		vTaskSuspendAll();
+		{
+			for( uxBucket = 0; uxBucket < heapTELEMETRY_BUCKETS; uxBucket++ )
+			{
+				pxTelemetry->ulFreeBlocks[ uxBucket ] = ulFreeBlockHistogram[ uxBucket ];
+				pxTelemetry->ulMallocCycles[ uxBucket ] = ulMallocCycleHistogram[ uxBucket ];
+				pxTelemetry->ulFreeCycles[ uxBucket ] = ulFreeCycleHistogram[ uxBucket ];
+			}
+
+			pxTelemetry->ulMaxMallocCycles = ulMaxMallocCycles;
+			pxTelemetry->ulMaxFreeCycles = ulMaxFreeCycles;
+			pxTelemetry->xFreeBytes = xFreeBytesRemaining;
+			pxTelemetry->xLargestFreeBlock = prvLargestFreeBlock();
+			pxTelemetry->ulFragmentation = prvFragmentation( pxTelemetry->xFreeBytes, pxTelemetry->xLargestFreeBlock );
+
+			if( pxTelemetry->ulFragmentation > ulWorstFragmentation )
+			{
+				ulWorstFragmentation = pxTelemetry->ulFragmentation;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTelemetry->ulWorstFragmentation = ulWorstFragmentation;
+			pxTelemetry->ulFailures = ulAllocationFailures;
+
+			/* Copy the ring of failure records out oldest first. */
+			if( ulAllocationFailures < heapTELEMETRY_FAILURE_RECORDS )
+			{
+				uxValidRecords = ( UBaseType_t ) ulAllocationFailures;
+				ulOldest = 0UL;
+			}
+			else
+			{
+				uxValidRecords = heapTELEMETRY_FAILURE_RECORDS;
+				ulOldest = ulAllocationFailures % heapTELEMETRY_FAILURE_RECORDS;
+			}
+
+			for( uxRecord = 0; uxRecord < heapTELEMETRY_FAILURE_RECORDS; uxRecord++ )
+			{
+				if( uxRecord < uxValidRecords )
+				{
+					pxTelemetry->xFailures[ uxRecord ] = xFailureRecords[ ( ulOldest + uxRecord ) % heapTELEMETRY_FAILURE_RECORDS ];
+				}
+				else
+				{
+					pxTelemetry->xFailures[ uxRecord ].pvCaller = NULL;
+					pxTelemetry->xFailures[ uxRecord ].xWantedSize = 0;
+					pxTelemetry->xFailures[ uxRecord ].xFreeBytes = 0;
+					pxTelemetry->xFailures[ uxRecord ].xLargestFreeBlock = 0;
+					pxTelemetry->xFailures[ uxRecord ].xTickCount = 0;
+				}
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* configUSE_HEAP_TELEMETRY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_TELEMETRY == 1 )
+
+	void vPortResetHeapTelemetry( void )
+	{
+	UBaseType_t uxBucket;
+
+		vTaskSuspendAll();
+		{
+			for( uxBucket = 0; uxBucket < heapTELEMETRY_BUCKETS; uxBucket++ )
+			{
+				ulMallocCycleHistogram[ uxBucket ] = 0UL;
+				ulFreeCycleHistogram[ uxBucket ] = 0UL;
+			}
+
+			ulMaxMallocCycles = 0UL;
+			ulMaxFreeCycles = 0UL;
+			ulWorstFragmentation = 0UL;
+			ulAllocationFailures = 0UL;
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* configUSE_HEAP_TELEMETRY */
 
+#endif /* configUSE_TLSF_HEAP */
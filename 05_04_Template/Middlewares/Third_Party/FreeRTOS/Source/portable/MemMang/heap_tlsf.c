@@ -0,0 +1,668 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() that, like heap_4.c,
+ * combines adjacent free blocks as they are freed, but finds free blocks with
+ * the Two-Level Segregated Fit algorithm, so allocating and freeing take a
+ * bounded time that does not depend on the number of free blocks.
+ *
+ * Free blocks are kept in lists of blocks of similar size.  The first level
+ * splits sizes by powers of two and the second level splits each power of two
+ * into heapSL_INDEX_COUNT equal ranges.  A bitmap for each level records which
+ * lists are not empty, so the smallest list whose blocks are all large enough
+ * for a request is found with two find-first-set operations.  A request may be
+ * served from a larger list than strictly necessary, so up to
+ * 1 / heapSL_INDEX_COUNT of a block can be left unused in exchange for the
+ * bounded search.
+ *
+ * Each block, allocated or free, records the address of the block before it in
+ * memory, so a block being freed can be merged with its neighbours without
+ * walking a list.
+ *
+ * Only one of heap_4.c and this file is built, selected by configUSE_TLSF_HEAP,
+ * so both can stay in projects that compile every file in this directory.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c and heap_4.c for alternative
+ * implementations, and the memory management pages of
+ * http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configUSE_TLSF_HEAP == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#if( ( configTLSF_SL_INDEX_COUNT_LOG2 < 1 ) || ( configTLSF_SL_INDEX_COUNT_LOG2 > 5 ) )
+	#error configTLSF_SL_INDEX_COUNT_LOG2 must be between 1 and 5
+#endif
+
+/* The floor of the base 2 logarithm of a 32-bit constant, usable where a
+constant expression is required. */
+#define heapLOG2_2( x )		( ( ( ( x ) & 0x2UL ) != 0UL ) ? 1 : 0 )
+#define heapLOG2_4( x )		( ( ( ( x ) & 0xCUL ) != 0UL ) ? ( 2 + heapLOG2_2( ( x ) >> 2 ) ) : heapLOG2_2( x ) )
+#define heapLOG2_8( x )		( ( ( ( x ) & 0xF0UL ) != 0UL ) ? ( 4 + heapLOG2_4( ( x ) >> 4 ) ) : heapLOG2_4( x ) )
+#define heapLOG2_16( x )	( ( ( ( x ) & 0xFF00UL ) != 0UL ) ? ( 8 + heapLOG2_8( ( x ) >> 8 ) ) : heapLOG2_8( x ) )
+#define heapLOG2_32( x )	( ( ( ( x ) & 0xFFFF0000UL ) != 0UL ) ? ( 16 + heapLOG2_16( ( x ) >> 16 ) ) : heapLOG2_16( x ) )
+
+#define heapALIGNMENT_LOG2		heapLOG2_8( ( uint32_t ) portBYTE_ALIGNMENT )
+
+/* The number of second level lists per first level list. */
+#define heapSL_INDEX_COUNT_LOG2	( configTLSF_SL_INDEX_COUNT_LOG2 )
+#define heapSL_INDEX_COUNT		( 1U << heapSL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE are all kept in the first first
+level list, whose second level lists are one alignment unit apart.  Larger
+blocks go in the first level list of their highest set bit. */
+#define heapFL_INDEX_SHIFT		( heapSL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE	( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* Enough first level lists for a block the size of the whole heap. */
+#define heapFL_INDEX_MAX		heapLOG2_32( ( uint32_t ) configTOTAL_HEAP_SIZE )
+#define heapFL_INDEX_COUNT		( ( heapFL_INDEX_MAX >= heapFL_INDEX_SHIFT ) ? ( heapFL_INDEX_MAX - heapFL_INDEX_SHIFT + 2 ) : 1 )
+
+/* Set in the size of a block that is free.  Block sizes are multiples of
+portBYTE_ALIGNMENT, so the low bits are otherwise zero. */
+#define heapBLOCK_FREE_BIT		( ( size_t ) 1 )
+#define heapBLOCK_SIZE( pxBlock )	( ( pxBlock )->xBlockSize & ~heapBLOCK_FREE_BIT )
+#define heapBLOCK_IS_FREE( pxBlock )	( ( ( pxBlock )->xBlockSize & heapBLOCK_FREE_BIT ) != 0 )
+
+/* The block after pxBlock in memory. */
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )	( ( TLSFBlock_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/* Find the highest and lowest set bits of a non-zero 32-bit value. */
+#if defined( __GNUC__ )
+	#define heapFLS( ulValue )	( ( UBaseType_t ) ( 31 - __builtin_clz( ( unsigned int ) ( ulValue ) ) ) )
+	#define heapFFS( ulValue )	( ( UBaseType_t ) __builtin_ctz( ( unsigned int ) ( ulValue ) ) )
+#else
+	#define heapFLS( ulValue )	prvFindLastSet( ulValue )
+	#define heapFFS( ulValue )	prvFindLastSet( ( ulValue ) & ( 0UL - ( ulValue ) ) )
+#endif
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The header of every block.  The header of an allocated block ends before
+pxNextFreeBlock, which is where the memory returned to the application
+starts. */
+typedef struct A_TLSF_BLOCK
+{
+	struct A_TLSF_BLOCK *pxPreviousPhysicalBlock;	/*<< The block before this one in memory, or NULL for the first block. */
+	size_t xBlockSize;								/*<< The size of the block including its header, with heapBLOCK_FREE_BIT set if it is free. */
+	struct A_TLSF_BLOCK *pxNextFreeBlock;			/*<< The next block in the same free list.  Only valid while the block is free. */
+	struct A_TLSF_BLOCK *pxPreviousFreeBlock;		/*<< The previous block in the same free list.  Only valid while the block is free. */
+} TLSFBlock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Work out the first and second level list indexes of a free block of
+ * xBlockSize bytes.
+ */
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel );
+
+/*
+ * Find a free block of at least xBlockSize bytes, and remove it from its free
+ * list.  Returns NULL if there is none.
+ */
+static TLSFBlock_t *prvTakeFreeBlock( size_t xBlockSize );
+
+/*
+ * Add a free block to, or remove a free block from, its free list.
+ */
+static void prvInsertFreeBlock( TLSFBlock_t *pxBlock );
+static void prvRemoveFreeBlock( TLSFBlock_t *pxBlock );
+
+#if !defined( __GNUC__ )
+	static UBaseType_t prvFindLastSet( uint32_t ulValue );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The size of the header of an allocated block, and the smallest block that
+can hold the header of a free block, both correctly byte aligned. */
+static const size_t xHeapStructSize = ( offsetof( TLSFBlock_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+static const size_t xMinimumBlockSize = ( sizeof( TLSFBlock_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The free lists, and the bitmaps of the lists that are not empty.  Bit n of
+ulFirstLevelBitmap is set if any bit of ulSecondLevelBitmaps[ n ] is set, and
+bit m of ulSecondLevelBitmaps[ n ] is set if pxFreeLists[ n ][ m ] is not
+empty. */
+static TLSFBlock_t *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static uint32_t ulFirstLevelBitmap = 0UL;
+static uint32_t ulSecondLevelBitmaps[ heapFL_INDEX_COUNT ];
+
+/* Marks the end of the heap.  It has the size of a header and is never
+free, so a block never has to check whether it is the last one. */
+static TLSFBlock_t *pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+number of free bytes remaining, but says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+TLSFBlock_t *pxBlock, *pxNewBlock;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the free lists. */
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Only sizes that cannot overflow when the header and alignment are
+		added, and that fit in the heap, are attempted. */
+		if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+		{
+			/* The wanted size is increased so it can contain the header in
+			addition to the requested amount of bytes, rounded up so blocks are
+			always aligned, and is at least large enough to hold the header of
+			a free block once it is freed. */
+			xWantedSize += xHeapStructSize;
+
+			if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+			{
+				/* Byte alignment required. */
+				xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+				configASSERT( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xWantedSize < xMinimumBlockSize )
+			{
+				xWantedSize = xMinimumBlockSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxBlock = prvTakeFreeBlock( xWantedSize );
+
+			if( pxBlock != NULL )
+			{
+				/* If the block is larger than required it can be split into
+				two, the second of which goes back on a free list. */
+				if( ( heapBLOCK_SIZE( pxBlock ) - xWantedSize ) >= xMinimumBlockSize )
+				{
+					pxNewBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+					configASSERT( ( ( ( size_t ) pxNewBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+					pxNewBlock->xBlockSize = ( heapBLOCK_SIZE( pxBlock ) - xWantedSize ) | heapBLOCK_FREE_BIT;
+					pxNewBlock->pxPreviousPhysicalBlock = pxBlock;
+					heapNEXT_PHYSICAL_BLOCK( pxNewBlock )->pxPreviousPhysicalBlock = pxNewBlock;
+					pxBlock->xBlockSize = xWantedSize;
+
+					prvInsertFreeBlock( pxNewBlock );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The block is being returned - it is allocated and owned by
+				the application. */
+				pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+				xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+				xNumberOfSuccessfulAllocations++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+TLSFBlock_t *pxBlock, *pxNeighbour;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have a header immediately before it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxBlock = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( heapBLOCK_IS_FREE( pxBlock ) == pdFALSE );
+
+		if( heapBLOCK_IS_FREE( pxBlock ) == pdFALSE )
+		{
+			vTaskSuspendAll();
+			{
+				xFreeBytesRemaining += pxBlock->xBlockSize;
+				traceFREE( pv, pxBlock->xBlockSize );
+
+				/* Merge the block with the block after it if that is free.
+				pxEnd is never free. */
+				pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxBlock );
+
+				if( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxBlock->xBlockSize += heapBLOCK_SIZE( pxNeighbour );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Merge the block with the block before it if that is
+				free. */
+				pxNeighbour = pxBlock->pxPreviousPhysicalBlock;
+
+				if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE ) )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxNeighbour->xBlockSize = heapBLOCK_SIZE( pxNeighbour ) + pxBlock->xBlockSize;
+					pxBlock = pxNeighbour;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxBlock->xBlockSize |= heapBLOCK_FREE_BIT;
+				heapNEXT_PHYSICAL_BLOCK( pxBlock )->pxPreviousPhysicalBlock = pxBlock;
+				prvInsertFreeBlock( pxBlock );
+				xNumberOfSuccessfulFrees++;
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+TLSFBlock_t *pxFirstFreeBlock;
+uint8_t *pucAlignedHeap;
+size_t uxAddress;
+size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) ucHeap;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+	}
+
+	pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+	/* pxEnd is used to mark the end of the heap and is inserted at the end of
+	the heap space.  It is never free, so is never merged with the block before
+	it. */
+	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( void * ) uxAddress;
+	pxEnd->xBlockSize = 0;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+	pxFirstFreeBlock->pxPreviousPhysicalBlock = NULL;
+	pxFirstFreeBlock->xBlockSize = ( uxAddress - ( size_t ) pxFirstFreeBlock ) | heapBLOCK_FREE_BIT;
+	pxEnd->pxPreviousPhysicalBlock = pxFirstFreeBlock;
+	prvInsertFreeBlock( pxFirstFreeBlock );
+
+	/* Only one block exists - and it covers the entire usable heap space. */
+	xMinimumEverFreeBytesRemaining = heapBLOCK_SIZE( pxFirstFreeBlock );
+	xFreeBytesRemaining = heapBLOCK_SIZE( pxFirstFreeBlock );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel )
+{
+UBaseType_t uxHighestBit;
+
+	if( xBlockSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* Small blocks are kept in lists one alignment unit apart. */
+		*puxFirstLevel = 0;
+		*puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> heapALIGNMENT_LOG2 );
+	}
+	else
+	{
+		/* The next heapSL_INDEX_COUNT_LOG2 bits below the highest set bit
+		select the second level list. */
+		uxHighestBit = heapFLS( ( uint32_t ) xBlockSize );
+		*puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> ( uxHighestBit - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT;
+		*puxFirstLevel = uxHighestBit - ( heapFL_INDEX_SHIFT - 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TLSFBlock_t *prvTakeFreeBlock( size_t xBlockSize )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+uint32_t ulBitmap;
+TLSFBlock_t *pxBlock = NULL;
+
+	/* Round the size up to the next list boundary, so every block in the list
+	it maps to is large enough. */
+	if( xBlockSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xBlockSize += ( ( size_t ) 1 << ( heapFLS( ( uint32_t ) xBlockSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	prvMappingInsert( xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( uxFirstLevel < ( UBaseType_t ) heapFL_INDEX_COUNT )
+	{
+		/* Look for a non-empty list in the same first level list, then for
+		the smallest non-empty list of a larger first level list. */
+		ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ] & ( ~0UL << uxSecondLevel );
+
+		if( ulBitmap == 0UL )
+		{
+			ulBitmap = ulFirstLevelBitmap & ( ( ~0UL << uxFirstLevel ) << 1 );
+
+			if( ulBitmap != 0UL )
+			{
+				uxFirstLevel = heapFFS( ulBitmap );
+				ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ];
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ulBitmap != 0UL )
+		{
+			uxSecondLevel = heapFFS( ulBitmap );
+			pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+			configASSERT( pxBlock != NULL );
+			prvRemoveFreeBlock( pxBlock );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( TLSFBlock_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+TLSFBlock_t *pxHead;
+
+	prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+
+	pxHead = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+	pxBlock->pxNextFreeBlock = pxHead;
+	pxBlock->pxPreviousFreeBlock = NULL;
+
+	if( pxHead != NULL )
+	{
+		pxHead->pxPreviousFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+	ulFirstLevelBitmap |= ( 1UL << uxFirstLevel );
+	ulSecondLevelBitmaps[ uxFirstLevel ] |= ( 1UL << uxSecondLevel );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( TLSFBlock_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPreviousFreeBlock != NULL )
+	{
+		pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was the head of its list. */
+		pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+		if( pxBlock->pxNextFreeBlock == NULL )
+		{
+			ulSecondLevelBitmaps[ uxFirstLevel ] &= ~( 1UL << uxSecondLevel );
+
+			if( ulSecondLevelBitmaps[ uxFirstLevel ] == 0UL )
+			{
+				ulFirstLevelBitmap &= ~( 1UL << uxFirstLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if !defined( __GNUC__ )
+
+	static UBaseType_t prvFindLastSet( uint32_t ulValue )
+	{
+	UBaseType_t uxBit = 0;
+
+		while( ulValue > 1UL )
+		{
+			ulValue >>= 1;
+			uxBit++;
+		}
+
+		return uxBit;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+TLSFBlock_t *pxBlock;
+size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	vTaskSuspendAll();
+	{
+		/* The free lists are empty if the heap has not been initialised.  The
+		heap is initialised automatically when the first allocation is made. */
+		for( uxFirstLevel = 0; uxFirstLevel < ( UBaseType_t ) heapFL_INDEX_COUNT; uxFirstLevel++ )
+		{
+			for( uxSecondLevel = 0; uxSecondLevel < ( UBaseType_t ) heapSL_INDEX_COUNT; uxSecondLevel++ )
+			{
+				for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+				{
+					/* Increment the number of blocks and record the largest
+					block seen so far. */
+					xBlocks++;
+
+					if( heapBLOCK_SIZE( pxBlock ) > xMaxSize )
+					{
+						xMaxSize = heapBLOCK_SIZE( pxBlock );
+					}
+
+					if( heapBLOCK_SIZE( pxBlock ) < xMinSize )
+					{
+						xMinSize = heapBLOCK_SIZE( pxBlock );
+					}
+				}
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+	pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+	taskENTER_CRITICAL();
+	{
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	taskEXIT_CRITICAL();
+}
+
+#endif /* configUSE_TLSF_HEAP */
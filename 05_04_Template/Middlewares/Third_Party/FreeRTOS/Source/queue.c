@@ -51,6 +51,7 @@ correct privileged Vs unprivileged linkage and placement. */
 /* Constants used with the cRxLock and cTxLock structure members. */
 #define queueUNLOCKED					( ( int8_t ) -1 )
 #define queueLOCKED_UNMODIFIED			( ( int8_t ) 0 )
+#define queueMAX_LOCK_COUNT			( ( int8_t ) 127 )
 
 /* When the Queue_t structure is used to represent a base queue its pcHead and
 pcTail members are used as pointers into the queue storage area.  When the
@@ -198,6 +199,25 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvIte
  */
 static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copy uxCount items to the back of a queue, or out of the front of a queue,
+ * wrapping around the end of the storage area at most once.  The queue must
+ * have room for, or hold, all of them.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock up to one task waiting to receive from, or send to, a queue for
+ * each of the uxCount items that were added to, or removed from, it.  Called
+ * from a critical section while the queue is not locked.
+ *
+ * @return pdTRUE if an unblocked task has a priority above the running task,
+ * otherwise pdFALSE.
+ */
+static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+static BaseType_t prvUnblockSenders( Queue_t * const pxQueue, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 	/*
 	 * Checks to see if a queue is a member of a queue set, and if so, notifies
@@ -978,7 +998,7 @@ Queue_t * const pxQueue = xQueue;
 	read, instead return a flag to say whether a context switch is required or
 	not (i.e. has a task with a higher priority than us been woken by this
 	post). */
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
 		{
@@ -1103,7 +1123,7 @@ Queue_t * const pxQueue = xQueue;
 			xReturn = errQUEUE_FULL;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1148,7 +1168,7 @@ Queue_t * const pxQueue = xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1268,7 +1288,7 @@ Queue_t * const pxQueue = xQueue;
 			xReturn = errQUEUE_FULL;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1555,6 +1575,14 @@ Queue_t * const pxQueue = xQueue;
 					{
 						taskENTER_CRITICAL();
 						{
+							#if ( configPRIORITY_INHERITANCE_DEPTH > 1 )
+							{
+								/* Allow a priority later inherited by this task
+								to be passed on to the mutex holder. */
+								vTaskSetBlockingMutexHolder( &( pxQueue->u.xSemaphore.xMutexHolder ) );
+							}
+							#endif
+
 							xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
 						}
 						taskEXIT_CRITICAL();
@@ -1576,6 +1604,14 @@ Queue_t * const pxQueue = xQueue;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				#if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+				{
+					/* The task has left the Blocked state so is no longer
+					waiting for the mutex. */
+					vTaskSetBlockingMutexHolder( NULL );
+				}
+				#endif
 			}
 			else
 			{
@@ -1601,7 +1637,24 @@ Queue_t * const pxQueue = xQueue;
 				{
 					/* xInheritanceOccurred could only have be set if
 					pxQueue->uxQueueType == queueQUEUE_IS_MUTEX so no need to
-					test the mutex type again to check it is actually a mutex. */
+					test the mutex type again to check it is actually a mutex.
+					When inheritance is passed along chains of mutex holders
+					this task might have inherited a priority, and passed it
+					on, after it blocked, so the holder's priority is always
+					re-evaluated. */
+					#if ( configPRIORITY_INHERITANCE_DEPTH > 1 )
+					{
+						if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+						{
+							xInheritanceOccurred = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif
+
 					if( xInheritanceOccurred != pdFALSE )
 					{
 						taskENTER_CRITICAL();
@@ -1807,7 +1860,7 @@ Queue_t * const pxQueue = xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1867,7 +1920,7 @@ Queue_t * const pxQueue = xQueue;
 			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1900,7 +1953,7 @@ Queue_t * const pxQueue = xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		/* Cannot block in an ISR, so check there is data available. */
 		if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
@@ -1921,12 +1974,410 @@ Queue_t * const pxQueue = xQueue;
 			traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+UBaseType_t uxSent = 0, uxBatch;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores have no items. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+
+	/*lint -save -e904 This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Send as many of the remaining items as there is room for. */
+			uxBatch = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+			if( uxBatch > ( uxItemCount - uxSent ) )
+			{
+				uxBatch = uxItemCount - uxSent;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( uxBatch > ( UBaseType_t ) 0 )
+			{
+				traceQUEUE_SEND( pxQueue );
+				prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItems + ( uxSent * pxQueue->uxItemSize ), uxBatch );
+				uxSent += uxBatch;
+
+				/* However many receivers the batch unblocks, the yield only
+				happens once, when the critical section is exited. */
+				if( prvUnblockReceivers( pxQueue, uxBatch ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( uxSent == uxItemCount )
+			{
+				taskEXIT_CRITICAL();
+				return uxSent;
+			}
+			else if( xTicksToWait == ( TickType_t ) 0 )
+			{
+				/* The queue is full and no block time is specified (or the
+				block time has expired) so leave with the items sent so far. */
+				taskEXIT_CRITICAL();
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return uxSent;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskInternalSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else
+			{
+				/* Entry time was already set. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* The rest is as xQueueGenericSend() waiting for space. */
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return uxSent;
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxSent;
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores have no items. */
+
+	/* See the comment in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		uxSent = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+		if( uxSent > uxItemCount )
+		{
+			uxSent = uxItemCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxSent > ( UBaseType_t ) 0 )
+		{
+			const int8_t cTxLock = pxQueue->cTxLock;
+
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+			prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItems, uxSent );
+
+			/* The event list is not altered if the queue is locked.  This will
+			be done when the queue is unlocked later. */
+			if( cTxLock == queueUNLOCKED )
+			{
+				if( prvUnblockReceivers( pxQueue, uxSent ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Count every item posted while the queue was locked, up to
+				the most the lock count can hold. */
+				if( uxSent < ( UBaseType_t ) ( queueMAX_LOCK_COUNT - cTxLock ) )
+				{
+					pxQueue->cTxLock = ( int8_t ) ( cTxLock + ( int8_t ) uxSent );
+				}
+				else
+				{
+					pxQueue->cTxLock = queueMAX_LOCK_COUNT;
+				}
+			}
+		}
+		else
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxSent;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxItemCount, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+UBaseType_t uxReceived = 0, uxBatch;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( ( pxQueue ) );
+	configASSERT( !( ( pvBuffer == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores have no items. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+
+	/*lint -save -e904  This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Receive as many of the remaining items as the queue holds. */
+			uxBatch = pxQueue->uxMessagesWaiting;
+			if( uxBatch > ( uxItemCount - uxReceived ) )
+			{
+				uxBatch = uxItemCount - uxReceived;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( uxBatch > ( UBaseType_t ) 0 )
+			{
+				prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer + ( uxReceived * pxQueue->uxItemSize ), uxBatch );
+				traceQUEUE_RECEIVE( pxQueue );
+				pxQueue->uxMessagesWaiting -= uxBatch;
+				uxReceived += uxBatch;
+
+				if( prvUnblockSenders( pxQueue, uxBatch ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( uxReceived == uxItemCount )
+			{
+				taskEXIT_CRITICAL();
+				return uxReceived;
+			}
+			else if( xTicksToWait == ( TickType_t ) 0 )
+			{
+				/* The queue is empty and no block time is specified (or the
+				block time has expired) so leave with the items received so
+				far. */
+				taskEXIT_CRITICAL();
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return uxReceived;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskInternalSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else
+			{
+				/* Entry time was already set. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* The rest is as xQueueReceive() waiting for data. */
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The queue contains data again.  Loop back to read it. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* Timed out.  xTicksToWait is now 0, so looping back reads any
+			data that arrived meanwhile and then leaves. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxReceived;
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvBuffer == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores have no items. */
+
+	/* See the comment in xQueueReceiveFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		uxReceived = pxQueue->uxMessagesWaiting;
+		if( uxReceived > uxItemCount )
+		{
+			uxReceived = uxItemCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxReceived > ( UBaseType_t ) 0 )
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+			prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxReceived );
+			pxQueue->uxMessagesWaiting -= uxReceived;
+
+			/* If the queue is locked the event list will not be modified.
+			Instead update the lock count so the task that unlocks the queue
+			will know that an ISR has removed data while the queue was
+			locked. */
+			if( cRxLock == queueUNLOCKED )
+			{
+				if( prvUnblockSenders( pxQueue, uxReceived ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				if( uxReceived < ( UBaseType_t ) ( queueMAX_LOCK_COUNT - cRxLock ) )
+				{
+					pxQueue->cRxLock = ( int8_t ) ( cRxLock + ( int8_t ) uxReceived );
+				}
+				else
+				{
+					pxQueue->cRxLock = queueMAX_LOCK_COUNT;
+				}
+			}
+		}
+		else
+		{
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxReceived;
+}
+/*-----------------------------------------------------------*/
+
 UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
 {
 UBaseType_t uxReturn;
@@ -2168,6 +2619,148 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, const UBaseType_t uxCount )
+{
+size_t xBytes, xFirst;
+
+	/* This function is called from a critical section. */
+
+	xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+	xFirst = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+	if( xFirst >= xBytes )
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytes );
+		pxQueue->pcWriteTo += xBytes;
+		if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+		{
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xFirst );
+		( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) ( pcItems + xFirst ), xBytes - xFirst );
+		pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xFirst );
+	}
+
+	pxQueue->uxMessagesWaiting += uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, const UBaseType_t uxCount )
+{
+size_t xBytes, xFirst;
+int8_t *pcReadFrom;
+
+	/* This function is called from a critical section.  pcReadFrom points to
+	the last item read, so the first item to read follows it. */
+
+	xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+	pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+	if( pcReadFrom >= pxQueue->u.xQueue.pcTail )
+	{
+		pcReadFrom = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xFirst = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom );
+
+	if( xFirst >= xBytes )
+	{
+		( void ) memcpy( ( void * ) pcBuffer, ( void * ) pcReadFrom, xBytes );
+		pcReadFrom += xBytes;
+	}
+	else
+	{
+		( void ) memcpy( ( void * ) pcBuffer, ( void * ) pcReadFrom, xFirst );
+		( void ) memcpy( ( void * ) ( pcBuffer + xFirst ), ( void * ) pxQueue->pcHead, xBytes - xFirst );
+		pcReadFrom = pxQueue->pcHead + ( xBytes - xFirst );
+	}
+
+	/* At least one item was read, so this stays inside the storage area. */
+	pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue, UBaseType_t uxCount )
+{
+BaseType_t xYieldRequired = pdFALSE;
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		if( pxQueue->pxQueueSetContainer != NULL )
+		{
+			/* The queue set holds one entry for each item in its member
+			queues. */
+			while( uxCount > ( UBaseType_t ) 0 )
+			{
+				if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+				{
+					xYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				--uxCount;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	while( ( uxCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+		{
+			xYieldRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		--uxCount;
+	}
+
+	return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockSenders( Queue_t * const pxQueue, UBaseType_t uxCount )
+{
+BaseType_t xYieldRequired = pdFALSE;
+
+	while( ( uxCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+		{
+			xYieldRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		--uxCount;
+	}
+
+	return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -79,6 +79,7 @@ functions but without including stdio.h here. */
 #define tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB 		( ( uint8_t ) 0 )
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY 			( ( uint8_t ) 1 )
 #define tskSTATICALLY_ALLOCATED_STACK_AND_TCB		( ( uint8_t ) 2 )
+#define tskTASK_POOL_STACK_AND_TCB					( ( uint8_t ) 3 )
 
 /* If any of the following are set then task stacks are filled with a known
 value so the high water mark can be determined.  If none of the following are
@@ -149,10 +150,11 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 	/*-----------------------------------------------------------*/
 
-	/* Define away taskRESET_READY_PRIORITY() and portRESET_READY_PRIORITY() as
-	they are only required when a port optimised method of task selection is
-	being used. */
+	/* Define away taskRESET_READY_PRIORITY(), taskCLEAR_READY_PRIORITY() and
+	portRESET_READY_PRIORITY() as they are only required when a port optimised
+	method of task selection is being used. */
 	#define taskRESET_READY_PRIORITY( uxPriority )
+	#define taskCLEAR_READY_PRIORITY( uxPriority )
 	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
 
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
@@ -161,20 +163,69 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	performed in a way that is tailored to the particular microcontroller
 	architecture being used. */
 
-	/* A port optimised version is provided.  Call the port defined macros. */
-	#define taskRECORD_READY_PRIORITY( uxPriority )	portRECORD_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+	#if ( configMAX_PRIORITIES <= 32 )
 
-	/*-----------------------------------------------------------*/
+		/* A port optimised version is provided.  Call the port defined macros. */
+		#define taskRECORD_READY_PRIORITY( uxPriority )	portRECORD_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+		#define taskCLEAR_READY_PRIORITY( uxPriority )	portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) )
 
-	#define taskSELECT_HIGHEST_PRIORITY_TASK()														\
-	{																								\
-	UBaseType_t uxTopPriority;																		\
-																									\
-		/* Find the highest priority list that contains ready tasks. */								\
-		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
-		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
-	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
+		/*-----------------------------------------------------------*/
+
+		#define taskSELECT_HIGHEST_PRIORITY_TASK()														\
+		{																								\
+		UBaseType_t uxTopPriority;																		\
+																										\
+			/* Find the highest priority list that contains ready tasks. */								\
+			portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
+			configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
+
+	#else /* configMAX_PRIORITIES */
+
+		/* The port macros operate on a single 32-bit bitmap, so with more than
+		32 priorities the ready priorities are held in two levels.  Bit n of
+		uxReadyPriorityGroups[ g ] is set when priority ( g * 32 ) + n has a
+		ready task, and bit g of uxTopReadyPriority is set when
+		uxReadyPriorityGroups[ g ] is not zero.  Selecting the highest priority
+		then takes two calls to portGET_HIGHEST_PRIORITY() for up to 32 * 32 =
+		1024 priorities, rather than a search of the ready lists. */
+		#define taskREADY_GROUP_SHIFT		( 5U )
+		#define taskREADY_GROUP_MASK		( ( UBaseType_t ) 0x1fU )
+		#define taskREADY_PRIORITY_GROUPS	( ( ( UBaseType_t ) configMAX_PRIORITIES + taskREADY_GROUP_MASK ) >> taskREADY_GROUP_SHIFT )
+
+		#define taskRECORD_READY_PRIORITY( uxPriority )																			\
+		{																														\
+			portRECORD_READY_PRIORITY( ( uxPriority ) & taskREADY_GROUP_MASK, uxReadyPriorityGroups[ ( uxPriority ) >> taskREADY_GROUP_SHIFT ] );	\
+			portRECORD_READY_PRIORITY( ( uxPriority ) >> taskREADY_GROUP_SHIFT, uxTopReadyPriority );							\
+		} /* taskRECORD_READY_PRIORITY */
+
+		#define taskCLEAR_READY_PRIORITY( uxPriority )																			\
+		{																														\
+			portRESET_READY_PRIORITY( ( uxPriority ) & taskREADY_GROUP_MASK, uxReadyPriorityGroups[ ( uxPriority ) >> taskREADY_GROUP_SHIFT ] );	\
+																																\
+			if( uxReadyPriorityGroups[ ( uxPriority ) >> taskREADY_GROUP_SHIFT ] == ( UBaseType_t ) 0 )						\
+			{																													\
+				portRESET_READY_PRIORITY( ( uxPriority ) >> taskREADY_GROUP_SHIFT, uxTopReadyPriority );						\
+			}																													\
+		} /* taskCLEAR_READY_PRIORITY */
+
+		/*-----------------------------------------------------------*/
+
+		#define taskSELECT_HIGHEST_PRIORITY_TASK()														\
+		{																								\
+		UBaseType_t uxTopGroup, uxTopPriority;															\
+																										\
+			/* Find the highest group that contains ready tasks, then the				\
+			highest priority list within that group. */													\
+			portGET_HIGHEST_PRIORITY( uxTopGroup, uxTopReadyPriority );									\
+			portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorityGroups[ uxTopGroup ] );				\
+			uxTopPriority += uxTopGroup << taskREADY_GROUP_SHIFT;										\
+			configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
+
+	#endif /* configMAX_PRIORITIES */
 
 	/*-----------------------------------------------------------*/
 
@@ -185,7 +236,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	{																									\
 		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 )	\
 		{																								\
-			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
+			taskCLEAR_READY_PRIORITY( ( uxPriority ) );													\
 		}																								\
 	}
 
@@ -211,14 +262,99 @@ count overflows. */
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	/* Every level of the timing wheel has one slot per bit of a 32-bit
+	occupancy map.  A slot on level n covers 32^n ticks, so level 0 holds the
+	tasks that time out within the next 32 ticks, one slot per tick. */
+	#define taskWHEEL_SLOT_BITS					( 5U )
+	#define taskWHEEL_SLOTS						( 1U << taskWHEEL_SLOT_BITS )
+	#define taskWHEEL_SLOT_MASK					( ( TickType_t ) taskWHEEL_SLOTS - ( TickType_t ) 1 )
+	#define taskWHEEL_LEVEL_SHIFT( uxLevel )	( ( uxLevel ) * taskWHEEL_SLOT_BITS )
+
+	/* Blocked tasks whose wake time is at least this many ticks away do not
+	fit in the wheel and are held in the sorted delayed lists instead. */
+	#define taskWHEEL_HORIZON					( ( TickType_t ) 1 << taskWHEEL_LEVEL_SHIFT( configTIMING_WHEEL_LEVELS ) )
+
+	/* Evaluates to pdTRUE if pxList is one of the timing wheel slots, which
+	means a task referenced from it is in the Blocked state. */
+	#define taskLIST_IS_TIMING_WHEEL_SLOT( pxList ) ( ( ( pxList ) >= &( xTimingWheel[ 0 ][ 0 ] ) ) && ( ( pxList ) <= &( xTimingWheel[ configTIMING_WHEEL_LEVELS - 1 ][ taskWHEEL_SLOTS - 1U ] ) ) )
+
+#endif /* configUSE_TIMING_WHEEL */
+
+#if ( configUSE_BATCHED_WAKEUPS == 1 )
+
+	/* Passed to prvReadyDueTasks() when every due task must be made ready. */
+	#define taskWAKE_ALL_DUE	( ~( UBaseType_t ) 0 )
+
+#endif /* configUSE_BATCHED_WAKEUPS */
+
+#if ( configUSE_MICROSECOND_DELAYS == 1 )
+
+	#define taskMICROSECONDS_PER_TICK	( ( uint32_t ) 1000000UL / ( uint32_t ) configTICK_RATE_HZ )
+
+	/* A task blocked waiting for a notification is not on any event list,
+	unless it waits with a microsecond timeout, in which case its event list
+	item is in xMicrosecondDelayList.  A notification cancels the timeout. */
+	#define taskCANCEL_MICROSECOND_TIMEOUT( pxTCB )												\
+		if( listLIST_ITEM_CONTAINER( &( ( pxTCB )->xEventListItem ) ) == &xMicrosecondDelayList )	\
+		{																						\
+			( void ) uxListRemove( &( ( pxTCB )->xEventListItem ) );							\
+		}
+
+#else
+
+	#define taskCANCEL_MICROSECOND_TIMEOUT( pxTCB )
+
+#endif /* configUSE_MICROSECOND_DELAYS */
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/* Deadlines are compared by the sign of their difference, so the order of
+	two deadlines does not change as the tick count advances and is correct
+	across a tick count overflow, provided no two deadlines are more than half
+	the tick range apart.  Tasks in the EDF priority that have not been
+	registered with vTaskEDFRegister() - such as a task that has inherited the
+	priority because it holds a mutex an EDF task is waiting for - sort
+	first. */
+	#define taskEDF_HALF_RANGE					( ( ( TickType_t ) portMAX_DELAY >> 1 ) + ( TickType_t ) 1 )
+	#define taskEDF_EARLIER( pxA, pxB )			( ( ( pxB )->xEDFRelativeDeadline != ( TickType_t ) 0U ) && ( ( ( pxA )->xEDFRelativeDeadline == ( TickType_t ) 0U ) || ( ( TickType_t ) ( ( pxA )->xEDFAbsoluteDeadline - ( pxB )->xEDFAbsoluteDeadline ) >= taskEDF_HALF_RANGE ) ) )
+
+	/* A task at configEDF_TASK_PRIORITY only shares the processor in time
+	slices with tasks whose deadline is the same as its own. */
+	#define taskTIME_SLICE_SHARED( pxTCB )		( ( ( pxTCB )->uxPriority != ( UBaseType_t ) configEDF_TASK_PRIORITY ) || ( prvEDFOtherTaskReady() != pdFALSE ) )
+
+#else
+
+	#define taskTIME_SLICE_SHARED( pxTCB )		pdTRUE
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/* The ready list of configEDF_TASK_PRIORITY is kept in deadline order, so
+	the task to run is always at its head. */
+	#define taskINSERT_INTO_READY_LIST( pxTCB )																\
+		( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) ?							\
+			prvInsertEDFReadyTask( ( pxTCB ), listGET_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ) ) ) : \
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ) )
+
+#else
+
+	#define taskINSERT_INTO_READY_LIST( pxTCB ) vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
 #define prvAddTaskToReadyList( pxTCB )																\
 	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
 	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+	taskINSERT_INTO_READY_LIST( pxTCB );															\
 	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 /*-----------------------------------------------------------*/
 
@@ -230,6 +366,95 @@ count overflows. */
  */
 #define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? pxCurrentTCB : ( pxHandle ) )
 
+#if ( configNUMBER_OF_CORES == 1 )
+
+	/* Is the task in the Running state? */
+	#define taskTASK_IS_RUNNING( pxTCB ) ( ( pxTCB ) == pxCurrentTCB )
+
+	/*
+	 * Called when pxTCB has entered the Ready state.  Evaluates to pdTRUE if it
+	 * should preempt the running task, which it does if it has a higher
+	 * priority, or an equal priority and xYieldEqualPriority is pdTRUE.
+	 */
+	#define taskYIELD_FOR_PRIORITY( pxTCB, xYieldEqualPriority )				\
+		( ( ( xYieldEqualPriority ) != pdFALSE ) ?								\
+			( ( pxTCB )->uxPriority >= pxCurrentTCB->uxPriority ) :				\
+			( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) )
+
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+
+		/* Between two tasks at configEDF_TASK_PRIORITY the earlier deadline
+		wins instead, so a task made ready by an event preempts a running EDF
+		task with a later deadline at once. */
+		#define taskYIELD_FOR_TASK( pxTCB, xYieldEqualPriority )											\
+			( ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) && ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) ) ? \
+				taskEDF_EARLIER( ( pxTCB ), pxCurrentTCB ) :												\
+				taskYIELD_FOR_PRIORITY( ( pxTCB ), ( xYieldEqualPriority ) ) )
+
+	#else
+
+		#define taskYIELD_FOR_TASK( pxTCB, xYieldEqualPriority ) taskYIELD_FOR_PRIORITY( ( pxTCB ), ( xYieldEqualPriority ) )
+
+	#endif /* configUSE_EDF_SCHEDULING */
+
+#else
+
+	/* The xTaskRunState of a task that is not running on any core. */
+	#define taskTASK_NOT_RUNNING ( ( BaseType_t ) -1 )
+
+	#define taskTASK_IS_RUNNING( pxTCB ) ( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING )
+
+	/* As above, but the task may instead preempt a task running on another
+	core, in which case a yield is requested on that core and the macro
+	evaluates to pdFALSE. */
+	#define taskYIELD_FOR_TASK( pxTCB, xYieldEqualPriority ) prvYieldForTask( ( pxTCB ), ( xYieldEqualPriority ) )
+
+	/* Request a context switch on another core.  The yield is recorded as
+	pending until that core has selected a task, so prvYieldForTask() does not
+	pick the same core twice. */
+	#define taskYIELD_OTHER_CORE( xCoreID )				\
+	{													\
+		xYieldPendings[ ( xCoreID ) ] = pdTRUE;			\
+		portYIELD_CORE( ( xCoreID ) );					\
+	}
+
+	#if ( configUSE_CORE_AFFINITY == 1 )
+		#define taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) ( ( ( pxTCB )->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) ( xCoreID ) ) ) != 0U )
+	#else
+		#define taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) pdTRUE
+	#endif
+
+#endif /* configNUMBER_OF_CORES */
+
+/*
+ * Charge the CPU cycles that have elapsed since the last update to the task
+ * that is in the Running state.  This is done on every context switch and on
+ * every tick, so two consecutive reads of the 32-bit cycle counter are never
+ * more than one tick period apart (unless the tick is suppressed by tickless
+ * idle, which on Cortex-M is limited to the 24-bit SysTick reload range).  The
+ * counter wraps every 51 seconds at 84MHz, so the unsigned subtraction below is
+ * never ambiguous, and the 64-bit totals do not wrap in practice.  Must be
+ * called with interrupts masked, or from an interrupt running at the kernel
+ * interrupt priority.
+ */
+#if ( configGENERATE_RUN_TIME_CYCLE_STATS == 1 )
+
+	#define taskUPDATE_RUN_TIME_CYCLES()												\
+	{																					\
+	const uint32_t ulCyclesNow = ( uint32_t ) portGET_CYCLE_COUNTER_VALUE();			\
+	const uint32_t ulCyclesElapsed = ulCyclesNow - ulCyclesAtLastUpdate;				\
+																						\
+		ulCyclesAtLastUpdate = ulCyclesNow;												\
+		pxCurrentTCB->ullRunTimeCycles += ( uint64_t ) ulCyclesElapsed;					\
+		ullTotalRunTimeCycles += ( uint64_t ) ulCyclesElapsed;							\
+	}
+
+#else
+
+	#define taskUPDATE_RUN_TIME_CYCLES()
+
+#endif /* configGENERATE_RUN_TIME_CYCLE_STATS */
+
 /* The item value of the event list item is normally used to hold the priority
 of the task to which it belongs (coded to allow it to be held in reverse
 priority order).  However, it is occasionally borrowed for other purposes.  It
@@ -244,6 +469,22 @@ to its original value when it is released. */
 	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
 #endif
 
+#if ( configUSE_TASK_ARENAS == 1 )
+
+	/* The header of each chunk of a task arena.  The memory allocated from the
+	chunk follows it. */
+	typedef struct tskTaskArenaChunk
+	{
+		struct tskTaskArenaChunk *pxNextChunk;	/*< The next chunk of the same arena, or NULL. */
+		size_t xSize;							/*< The number of bytes that follow the header. */
+	} TaskArenaChunk_t;
+
+	/* The size of the chunk header, rounded up so the memory that follows it
+	is aligned. */
+	#define taskARENA_CHUNK_HEADER_SIZE	( ( sizeof( TaskArenaChunk_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+#endif /* configUSE_TASK_ARENAS */
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -281,6 +522,40 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		UBaseType_t		uxMutexesHeld;
 	#endif
 
+	#if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+		TaskHandle_t	*pxBlockingMutexHolder;	/*< Points to the holder of the mutex the task is blocked on, or NULL.  Used to pass inherited priorities along a chain of mutex holders. */
+	#endif
+
+	#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+		UBaseType_t		uxTimeSliceTicks;	/*< The number of ticks the task runs for before ready tasks of equal priority are given the processor. */
+		UBaseType_t		uxTimeSliceRemaining;	/*< The number of ticks left of the current time slice. */
+	#endif
+
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xEDFPeriod;				/*< The period of the task, used by vTaskEDFWaitForNextPeriod(). */
+		TickType_t		xEDFRelativeDeadline;	/*< The deadline of each job relative to its release time.  0 if the task is not scheduled by deadline. */
+		TickType_t		xEDFAbsoluteDeadline;	/*< The tick by which the current job must complete. */
+	#endif
+
+	#if ( configUSE_MICROSECOND_DELAYS == 1 )
+		uint32_t		ulMicrosecondAlarm;	/*< The microsecond count at which the task is unblocked, valid while its event list item is in xMicrosecondDelayList. */
+	#endif
+
+	#if ( configNUMBER_OF_CORES > 1 )
+		volatile BaseType_t	xTaskRunState;	/*< The core the task is running on, or taskTASK_NOT_RUNNING. */
+	#endif
+
+	#if ( configUSE_CORE_AFFINITY == 1 )
+		UBaseType_t		uxCoreAffinityMask;	/*< Bit n is set if the task may run on core n. */
+	#endif
+
+	#if ( configUSE_TASK_ARENAS == 1 )
+		TaskArenaChunk_t	*pxArenaFirstChunk;	/*< The first chunk of the task's arena, or NULL if it has none. */
+		TaskArenaChunk_t	*pxArenaChunk;		/*< The chunk being allocated from, or NULL if the arena is empty or has just been reset. */
+		uint8_t			*pucArenaNext;		/*< The first free byte of pxArenaChunk. */
+		uint8_t			*pucArenaEnd;		/*< The byte after the end of pxArenaChunk. */
+	#endif
+
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		TaskHookFunction_t pxTaskTag;
 	#endif
@@ -293,6 +568,10 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
+	#if( configGENERATE_RUN_TIME_CYCLE_STATS == 1 )
+		uint64_t		ullRunTimeCycles;	/*< Stores the number of CPU cycles the task has spent in the Running state. */
+	#endif
+
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		/* Allocate a Newlib reent structure that is specific to this task.
 		Note Newlib support has been included by popular demand, but is not
@@ -308,8 +587,8 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments in FreeRTOS.h with the definition of
@@ -334,7 +613,14 @@ typedef tskTCB TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
-PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if ( configNUMBER_OF_CORES == 1 )
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#else
+	/* The task running on each core.  Within this file pxCurrentTCB is the
+	task running on the calling core. */
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ] = { NULL };
+	#define pxCurrentTCB prvGetCurrentTCB()
+#endif
 
 /* Lists for ready and blocked tasks. --------------------
 xDelayedTaskList1 and xDelayedTaskList2 could be move to function scople but
@@ -347,6 +633,28 @@ PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	PRIVILEGED_DATA static List_t xTimingWheel[ configTIMING_WHEEL_LEVELS ][ taskWHEEL_SLOTS ];	/*< Delayed tasks that wake within taskWHEEL_HORIZON ticks, bucketed by wake time.  The slots are not sorted. */
+	PRIVILEGED_DATA static uint32_t ulTimingWheelOccupied[ configTIMING_WHEEL_LEVELS ];			/*< One bit per slot that might hold tasks.  Bits are only cleared once the slot is found to be empty. */
+	PRIVILEGED_DATA static TickType_t xTimingWheelTime = ( TickType_t ) configINITIAL_TICK_COUNT;	/*< The most recent tick for which the wheel has been serviced. */
+
+#endif
+
+#if( configUSE_BATCHED_WAKEUPS == 1 )
+
+	PRIVILEGED_DATA static List_t * volatile pxExpiringTaskList = NULL;	/*< The delayed list or timing wheel slot on which the tick interrupt left tasks that have timed out, for the context switch to make ready.  NULL if there are none. */
+
+#endif
+
+#if( configUSE_MICROSECOND_DELAYS == 1 )
+
+	PRIVILEGED_DATA static List_t xMicrosecondDelayList;					/*< Tasks blocked with a microsecond delay or timeout, referenced through their event list items.  The list is not sorted. */
+	PRIVILEGED_DATA static uint32_t ulMicrosecondAlarm = 0UL;				/*< The count the microsecond alarm was last set to. */
+	PRIVILEGED_DATA static BaseType_t xMicrosecondAlarmSet = pdFALSE;		/*< pdTRUE if the alarm is set for a task that might still be waiting. */
+
+#endif
+
 #if( INCLUDE_vTaskDelete == 1 )
 
 	PRIVILEGED_DATA static List_t xTasksWaitingTermination;				/*< Tasks that have been deleted - but their memory not yet freed. */
@@ -354,6 +662,19 @@ PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been r
 
 #endif
 
+#if( configUSE_TASK_POOL == 1 )
+
+	PRIVILEGED_DATA static TCB_t xTaskPoolTCBs[ configTASK_POOL_SLOTS ];
+	PRIVILEGED_DATA static StackType_t xTaskPoolStacks[ configTASK_POOL_SLOTS ][ configTASK_POOL_STACK_DEPTH ];
+	PRIVILEGED_DATA static List_t xTaskPoolFreeList;						/*< Pool slots not in use by a task, linked through the xStateListItem of each TCB. */
+	PRIVILEGED_DATA static BaseType_t xTaskPoolInitialised = pdFALSE;
+	PRIVILEGED_DATA static UBaseType_t uxTaskPoolMinimumEverFreeSlots = ( UBaseType_t ) configTASK_POOL_SLOTS;
+	PRIVILEGED_DATA static uint32_t ulTaskPoolHits = 0UL;
+	PRIVILEGED_DATA static uint32_t ulTaskPoolMisses = 0UL;
+	PRIVILEGED_DATA static TCB_t * volatile pxTaskPoolPendingRelease = NULL;	/*< A pool task that deleted itself, whose slot is returned to the pool once the task has been switched out. */
+
+#endif
+
 #if ( INCLUDE_vTaskSuspend == 1 )
 
 	PRIVILEGED_DATA static List_t xSuspendedTaskList;					/*< Tasks that are currently suspended. */
@@ -370,13 +691,25 @@ the errno of the currently running task. */
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks 	= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) configINITIAL_TICK_COUNT;
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) && ( configMAX_PRIORITIES > 32 ) )
+	PRIVILEGED_DATA static volatile UBaseType_t uxReadyPriorityGroups[ taskREADY_PRIORITY_GROUPS ] = { 0U };
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks 			= ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
+#if ( configNUMBER_OF_CORES == 1 )
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPending 		= pdFALSE;
+#else
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE };
+	#define xYieldPending xYieldPendings[ portGET_CORE_ID() ]
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#if ( configNUMBER_OF_CORES == 1 )
+	PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle				= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#else
+	PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ] = { NULL };	/*< Holds the handles of the idle tasks, one for each core. */
+#endif
 
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
@@ -392,11 +725,23 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 	/* Do not move these variables to function scope as doing so prevents the
 	code working with debuggers that need to remove the static qualifier. */
-	PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	#if ( configNUMBER_OF_CORES == 1 )
+		PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	#else
+		PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTimes[ configNUMBER_OF_CORES ] = { 0UL };
+		#define ulTaskSwitchedInTime ulTaskSwitchedInTimes[ portGET_CORE_ID() ]
+	#endif
 	PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
 
+#if ( configGENERATE_RUN_TIME_CYCLE_STATS == 1 )
+
+	PRIVILEGED_DATA static uint32_t ulCyclesAtLastUpdate = 0UL;		/*< Holds the cycle counter value at which the running task's cycle count was last brought up to date. */
+	PRIVILEGED_DATA static uint64_t ullTotalRunTimeCycles = 0ULL;	/*< Holds the number of CPU cycles that have elapsed since the scheduler was started. */
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -465,6 +810,48 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
 
 #endif
 
+/*
+ * Take a free slot from the task pool for a task that needs usStackDepth words
+ * of stack.  Returns NULL if the stack is too large for a slot or no slot is
+ * free, in which case the caller allocates the task from the heap.
+ */
+#if( configUSE_TASK_POOL == 1 )
+
+	static TCB_t *prvTaskPoolTake( const configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called by pvTaskArenaAlloc() when the allocation does not fit in the current
+ * chunk of the arena.  Moves on to the next chunk, taking a new one from the
+ * heap if there is no next chunk or the allocation does not fit in it either.
+ */
+#if ( configUSE_TASK_ARENAS == 1 )
+
+	static void *prvTaskArenaGrow( TCB_t * const pxTCB, const size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Return the chunks of a task's arena to the heap.
+ */
+#if ( ( configUSE_TASK_ARENAS == 1 ) && ( INCLUDE_vTaskDelete == 1 ) )
+
+	static void prvTaskArenaFree( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called by a pool task that is deleting itself to free the heap memory it
+ * holds - its arena and its newlib reentrancy structure - before its slot is
+ * returned to the pool from vTaskSwitchContext(), which cannot use the heap.
+ */
+#if( ( configUSE_TASK_POOL == 1 ) && ( INCLUDE_vTaskDelete == 1 ) && ( ( configUSE_TASK_ARENAS == 1 ) || ( configUSE_NEWLIB_REENTRANT == 1 ) ) )
+
+	static void prvTaskPoolFreeHeapMemory( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Used only by the idle task.  This checks to see if anything has been placed
  * in the list of tasks waiting to be deleted.  If so the task is cleaned up
@@ -478,6 +865,19 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
  */
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_MICROSECOND_DELAYS == 1 )
+
+	/*
+	 * The currently executing task is entering the Blocked state for at most
+	 * ulMicrosecondsToWait microseconds.  Add the task to the delayed task
+	 * lists with a slightly longer timeout, add it to xMicrosecondDelayList and
+	 * move the microsecond alarm forward if necessary.  Must be called from a
+	 * critical section so the alarm cannot fire before the task has blocked.
+	 */
+	static void prvAddCurrentTaskToMicrosecondDelayList( const uint32_t ulMicrosecondsToWait ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_MICROSECOND_DELAYS */
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -534,6 +934,127 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	/*
+	 * Place the state list item of a blocked task into the timing wheel slot
+	 * that covers xPosition, which must be less than taskWHEEL_HORIZON ticks
+	 * after xTimingWheelTime.  Returns the tick at which that slot is next
+	 * serviced - either the wake time itself or the time at which the slot is
+	 * cascaded onto a lower level.
+	 */
+	static TickType_t prvTimingWheelInsert( ListItem_t * const pxStateListItem, const TickType_t xPosition ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the number of ticks after xTimingWheelTime at which the wheel
+	 * next needs servicing, or portMAX_DELAY if no tasks are delayed.
+	 */
+	static TickType_t prvTimingWheelTicksToNextEvent( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from the tick interrupt once xTimingWheelTime has been moved on to
+	 * the current tick.  Moves tasks that are now within reach from the delayed
+	 * list and the outer levels of the wheel inwards, so every task due on this
+	 * tick is left in a single level 0 slot.  Returns that slot.
+	 */
+	static List_t * prvTimingWheelAdvance( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The currently executing task is entering the Blocked state with a wake
+	 * time that is within reach of the timing wheel.  Add it to the wheel and
+	 * update xNextTaskUnblockTime if necessary.
+	 */
+	static void prvAddCurrentTaskToTimingWheel( const TickType_t xTimeToWake ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMING_WHEEL */
+
+#if ( configUSE_BATCHED_WAKEUPS == 1 )
+
+	/*
+	 * Move at most uxLimit of the tasks at the head of pxList whose wake time
+	 * is not after xConstTickCount into the appropriate ready lists.  pxList is
+	 * either the delayed list or, when the timing wheel is in use, a level 0
+	 * slot, in which case every task in it is due.  If due tasks are left
+	 * behind, pxList is recorded in pxExpiringTaskList for the context switch
+	 * to finish.  Returns pdTRUE if a context switch should be performed.
+	 */
+	static BaseType_t prvReadyDueTasks( List_t * const pxList, const TickType_t xConstTickCount, const UBaseType_t uxLimit ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_BATCHED_WAKEUPS */
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/*
+	 * Inserts pxTCB into the ready list of configEDF_TASK_PRIORITY after every
+	 * task whose deadline is not later than its own, searching from pxFrom,
+	 * which must not be after the place it belongs.
+	 */
+	static void prvInsertEDFReadyTask( TCB_t *pxTCB, ListItem_t *pxFrom ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Moves pxTCB, which is in the ready list of configEDF_TASK_PRIORITY, to
+	 * the place its deadline now calls for.
+	 */
+	static void prvReorderEDFReadyTask( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+
+		/*
+		 * Called from the tick interrupt when the running task is at
+		 * configEDF_TASK_PRIORITY.  Returns pdTRUE if another Ready state task
+		 * at that priority has a deadline no later than that of the running
+		 * task.
+		 */
+		static BaseType_t prvEDFOtherTaskReady( void ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	/*
+	 * Returns the task running on the calling core.  Interrupts are masked
+	 * while the core number is read and used, so the calling task cannot be
+	 * moved to another core in between.
+	 */
+	static TCB_t *prvGetCurrentTCB( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from vTaskSwitchContext(), and for every core when the scheduler
+	 * starts, to make the highest priority Ready state task that may run on
+	 * core xCoreID, and is not running on another core, the task running on
+	 * xCoreID.
+	 */
+	static void prvSelectHighestPriorityTask( const BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from a critical section when pxTCB has entered the Ready state.
+	 * If pxTCB should preempt one of the tasks running on the cores it may run
+	 * on, the core running the lowest priority such task is chosen.  Returns
+	 * pdTRUE if that is the calling core, and the caller must yield.  Otherwise
+	 * a yield is requested on the chosen core, if there is one, and pdFALSE is
+	 * returned.  Tasks of equal priority are only preempted if
+	 * xYieldEqualPriority is pdTRUE.
+	 */
+	static BaseType_t prvYieldForTask( const TCB_t * const pxTCB, const BaseType_t xYieldEqualPriority ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+
+	/*
+	 * Called after the priority of a mutex holder has been changed by priority
+	 * inheritance or disinheritance.  If the holder is itself blocked on a mutex
+	 * then the holder of that mutex is set to the greater of its base priority
+	 * and the priority of the highest priority task waiting for the mutex, and
+	 * so on along the chain of holders, up to configPRIORITY_INHERITANCE_DEPTH
+	 * holders in total.
+	 */
+	static void prvPropagateInheritedPriority( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -740,72 +1261,91 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 	TCB_t *pxNewTCB;
 	BaseType_t xReturn;
 
-		/* If the stack grows down then allocate the stack then the TCB so the stack
-		does not grow into the TCB.  Likewise if the stack grows up then allocate
-		the TCB then the stack. */
-		#if( portSTACK_GROWTH > 0 )
+		#if( configUSE_TASK_POOL == 1 )
 		{
-			/* Allocate space for the TCB.  Where the memory comes from depends on
-			the implementation of the port malloc function and whether or not static
-			allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			/* Use a recycled slot from the task pool if there is one, as that
+			does not need the heap. */
+			pxNewTCB = prvTaskPoolTake( usStackDepth );
+		}
+		#else
+		{
+			pxNewTCB = NULL;
+		}
+		#endif /* configUSE_TASK_POOL */
 
-			if( pxNewTCB != NULL )
+		if( pxNewTCB == NULL )
+		{
+			/* If the stack grows down then allocate the stack then the TCB so the stack
+			does not grow into the TCB.  Likewise if the stack grows up then allocate
+			the TCB then the stack. */
+			#if( portSTACK_GROWTH > 0 )
 			{
-				/* Allocate space for the stack used by the task being created.
-				The base of the stack memory stored in the TCB so the task can
-				be deleted later if required. */
-				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				/* Allocate space for the TCB.  Where the memory comes from depends on
+				the implementation of the port malloc function and whether or not static
+				allocation is being used. */
+				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
 
-				if( pxNewTCB->pxStack == NULL )
+				if( pxNewTCB != NULL )
 				{
-					/* Could not allocate the stack.  Delete the allocated TCB. */
-					vPortFree( pxNewTCB );
-					pxNewTCB = NULL;
+					/* Allocate space for the stack used by the task being created.
+					The base of the stack memory stored in the TCB so the task can
+					be deleted later if required. */
+					pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+					if( pxNewTCB->pxStack == NULL )
+					{
+						/* Could not allocate the stack.  Delete the allocated TCB. */
+						vPortFree( pxNewTCB );
+						pxNewTCB = NULL;
+					}
 				}
 			}
-		}
-		#else /* portSTACK_GROWTH */
-		{
-		StackType_t *pxStack;
-
-			/* Allocate space for the stack used by the task being created. */
-			pxStack = pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
-
-			if( pxStack != NULL )
+			#else /* portSTACK_GROWTH */
 			{
-				/* Allocate space for the TCB. */
-				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+			StackType_t *pxStack;
 
-				if( pxNewTCB != NULL )
+				/* Allocate space for the stack used by the task being created. */
+				pxStack = pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+
+				if( pxStack != NULL )
 				{
-					/* Store the stack location in the TCB. */
-					pxNewTCB->pxStack = pxStack;
+					/* Allocate space for the TCB. */
+					pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+
+					if( pxNewTCB != NULL )
+					{
+						/* Store the stack location in the TCB. */
+						pxNewTCB->pxStack = pxStack;
+					}
+					else
+					{
+						/* The stack cannot be used as the TCB was not created.  Free
+						it again. */
+						vPortFree( pxStack );
+					}
 				}
 				else
 				{
-					/* The stack cannot be used as the TCB was not created.  Free
-					it again. */
-					vPortFree( pxStack );
+					pxNewTCB = NULL;
 				}
 			}
-			else
+			#endif /* portSTACK_GROWTH */
+
+			if( pxNewTCB != NULL )
 			{
-				pxNewTCB = NULL;
+				#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
+				{
+					/* Tasks can be created statically or dynamically, so note
+					this task was created dynamically in case it is later
+					deleted. */
+					pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
+				}
+				#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 			}
 		}
-		#endif /* portSTACK_GROWTH */
 
 		if( pxNewTCB != NULL )
 		{
-			#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
-			{
-				/* Tasks can be created statically or dynamically, so note this
-				task was created dynamically in case it is later deleted. */
-				pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
-			}
-			#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
-
 			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
 			prvAddNewTaskToReadyList( pxNewTCB );
 			xReturn = pdPASS;
@@ -821,22 +1361,63 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
-									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-									const uint32_t ulStackDepth,
-									void * const pvParameters,
-									UBaseType_t uxPriority,
-									TaskHandle_t * const pxCreatedTask,
-									TCB_t *pxNewTCB,
-									const MemoryRegion_t * const xRegions )
-{
-StackType_t *pxTopOfStack;
-UBaseType_t x;
+#if ( configUSE_CORE_AFFINITY == 1 )
 
-	#if( portUSING_MPU_WRAPPERS == 1 )
-		/* Should the task be created in privileged mode? */
-		BaseType_t xRunPrivileged;
-		if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
+	BaseType_t xTaskCreateAffinitySet(	TaskFunction_t pxTaskCode,
+										const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+										const configSTACK_DEPTH_TYPE usStackDepth,
+										void * const pvParameters,
+										UBaseType_t uxPriority,
+										UBaseType_t uxCoreAffinityMask,
+										TaskHandle_t * const pxCreatedTask )
+	{
+	TaskHandle_t xCreatedTask = NULL;
+	BaseType_t xReturn;
+
+		/* With the scheduler suspended no core can switch to the new task
+		before its affinity is set. */
+		vTaskSuspendAll();
+		{
+			xReturn = xTaskCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, &xCreatedTask );
+
+			if( xReturn == pdPASS )
+			{
+				vTaskCoreAffinitySet( xCreatedTask, uxCoreAffinityMask );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		if( pxCreatedTask != NULL )
+		{
+			*pxCreatedTask = xCreatedTask;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CORE_AFFINITY */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
+									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const uint32_t ulStackDepth,
+									void * const pvParameters,
+									UBaseType_t uxPriority,
+									TaskHandle_t * const pxCreatedTask,
+									TCB_t *pxNewTCB,
+									const MemoryRegion_t * const xRegions )
+{
+StackType_t *pxTopOfStack;
+UBaseType_t x;
+
+	#if( portUSING_MPU_WRAPPERS == 1 )
+		/* Should the task be created in privileged mode? */
+		BaseType_t xRunPrivileged;
+		if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
 		{
 			xRunPrivileged = pdTRUE;
 		}
@@ -938,6 +1519,48 @@ UBaseType_t x;
 	}
 	#endif /* configUSE_MUTEXES */
 
+	#if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+	{
+		pxNewTCB->pxBlockingMutexHolder = NULL;
+	}
+	#endif
+
+	#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+	{
+		pxNewTCB->uxTimeSliceTicks = ( UBaseType_t ) configDEFAULT_TIME_SLICE_TICKS;
+		pxNewTCB->uxTimeSliceRemaining = ( UBaseType_t ) configDEFAULT_TIME_SLICE_TICKS;
+	}
+	#endif /* configUSE_PER_TASK_TIME_SLICE */
+
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+	{
+		pxNewTCB->xEDFPeriod = ( TickType_t ) 0U;
+		pxNewTCB->xEDFRelativeDeadline = ( TickType_t ) 0U;
+		pxNewTCB->xEDFAbsoluteDeadline = ( TickType_t ) 0U;
+	}
+	#endif /* configUSE_EDF_SCHEDULING */
+
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+	}
+	#endif /* configNUMBER_OF_CORES */
+
+	#if ( configUSE_CORE_AFFINITY == 1 )
+	{
+		pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+	}
+	#endif /* configUSE_CORE_AFFINITY */
+
+	#if ( configUSE_TASK_ARENAS == 1 )
+	{
+		pxNewTCB->pxArenaFirstChunk = NULL;
+		pxNewTCB->pxArenaChunk = NULL;
+		pxNewTCB->pucArenaNext = NULL;
+		pxNewTCB->pucArenaEnd = NULL;
+	}
+	#endif /* configUSE_TASK_ARENAS */
+
 	vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
 	vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -967,6 +1590,12 @@ UBaseType_t x;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configGENERATE_RUN_TIME_CYCLE_STATS == 1 )
+	{
+		pxNewTCB->ullRunTimeCycles = 0ULL;
+	}
+	#endif /* configGENERATE_RUN_TIME_CYCLE_STATS */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -989,8 +1618,11 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+		{
+			pxNewTCB->ulNotifiedValue[ x ] = 0;
+			pxNewTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+		}
 	}
 	#endif
 
@@ -1081,45 +1713,63 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	taskENTER_CRITICAL();
 	{
 		uxCurrentNumberOfTasks++;
-		if( pxCurrentTCB == NULL )
-		{
-			/* There are no other tasks, or all the other tasks are in
-			the suspended state - make this the current task. */
-			pxCurrentTCB = pxNewTCB;
 
-			if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+		#if ( configNUMBER_OF_CORES == 1 )
+		{
+			if( pxCurrentTCB == NULL )
 			{
-				/* This is the first task to be created so do the preliminary
-				initialisation required.  We will not recover if this call
-				fails, but we will report the failure. */
-				prvInitialiseTaskLists();
+				/* There are no other tasks, or all the other tasks are in
+				the suspended state - make this the current task. */
+				pxCurrentTCB = pxNewTCB;
+
+				if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+				{
+					/* This is the first task to be created so do the preliminary
+					initialisation required.  We will not recover if this call
+					fails, but we will report the failure. */
+					prvInitialiseTaskLists();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
-				mtCOVERAGE_TEST_MARKER();
-			}
-		}
-		else
-		{
-			/* If the scheduler is not already running, make this task the
-			current task if it is the highest priority task to be created
-			so far. */
-			if( xSchedulerRunning == pdFALSE )
-			{
-				if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+				/* If the scheduler is not already running, make this task the
+				current task if it is the highest priority task to be created
+				so far. */
+				if( xSchedulerRunning == pdFALSE )
 				{
-					pxCurrentTCB = pxNewTCB;
+					if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+					{
+						pxCurrentTCB = pxNewTCB;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
+		}
+		#else
+		{
+			/* The task each core runs first is selected when the scheduler
+			starts. */
+			if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+			{
+				prvInitialiseTaskLists();
+			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#endif /* configNUMBER_OF_CORES */
 
 		uxTaskNumber++;
 
@@ -1134,26 +1784,52 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		prvAddTaskToReadyList( pxNewTCB );
 
 		portSETUP_TCB( pxNewTCB );
+
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+			/* Another core may start running the task as soon as the
+			critical section is exited, so the yield is decided here. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				if( prvYieldForTask( pxNewTCB, pdFALSE ) != pdFALSE )
+				{
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configNUMBER_OF_CORES */
 	}
 	taskEXIT_CRITICAL();
 
-	if( xSchedulerRunning != pdFALSE )
+	#if ( configNUMBER_OF_CORES == 1 )
 	{
-		/* If the created task is of a higher priority than the current task
-		then it should run now. */
-		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		if( xSchedulerRunning != pdFALSE )
 		{
-			taskYIELD_IF_USING_PREEMPTION();
+			/* If the created task is of a higher priority than the current task
+			then it should run now. */
+			if( taskYIELD_FOR_TASK( pxNewTCB, pdFALSE ) != pdFALSE )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+	#endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -1163,6 +1839,23 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	{
 	TCB_t *pxTCB;
 
+		#if( ( configUSE_TASK_POOL == 1 ) && ( ( configUSE_TASK_ARENAS == 1 ) || ( configUSE_NEWLIB_REENTRANT == 1 ) ) )
+		{
+			/* A pool task deleting itself frees its heap memory now, while it
+			is still running, so its slot can go straight back to the pool. */
+			pxTCB = prvGetTCBFromHandle( xTaskToDelete );
+
+			if( ( pxTCB == pxCurrentTCB ) && ( pxTCB->ucStaticallyAllocated == tskTASK_POOL_STACK_AND_TCB ) )
+			{
+				prvTaskPoolFreeHeapMemory( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_POOL */
+
 		taskENTER_CRITICAL();
 		{
 			/* If null is passed in here then it is the calling task that is
@@ -1195,19 +1888,34 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			not return. */
 			uxTaskNumber++;
 
-			if( pxTCB == pxCurrentTCB )
+			if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
 			{
-				/* A task is deleting itself.  This cannot complete within the
-				task itself, as a context switch to another task is required.
-				Place the task in the termination list.  The idle task will
-				check the termination list and free up any memory allocated by
-				the scheduler for the TCB and stack of the deleted task. */
-				vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
-
-				/* Increment the ucTasksDeleted variable so the idle task knows
-				there is a task that has been deleted and that it should therefore
-				check the xTasksWaitingTermination list. */
-				++uxDeletedTasksWaitingCleanUp;
+				#if( configUSE_TASK_POOL == 1 )
+				if( pxTCB->ucStaticallyAllocated == tskTASK_POOL_STACK_AND_TCB )
+				{
+					/* A pool task is deleting itself.  It is still running on
+					its stack, so vTaskSwitchContext() returns its slot to the
+					pool once it has been switched out, rather than leaving it
+					for the idle task. */
+					pxTaskPoolPendingRelease = pxTCB;
+					--uxCurrentNumberOfTasks;
+				}
+				else
+				#endif /* configUSE_TASK_POOL */
+				{
+					/* A task is deleting itself.  This cannot complete within
+					the task itself, as a context switch to another task is
+					required.  Place the task in the termination list.  The idle
+					task will check the termination list and free up any memory
+					allocated by the scheduler for the TCB and stack of the
+					deleted task. */
+					vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+
+					/* Increment the ucTasksDeleted variable so the idle task
+					knows there is a task that has been deleted and that it
+					should therefore check the xTasksWaitingTermination list. */
+					++uxDeletedTasksWaitingCleanUp;
+				}
 
 				/* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
 				portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
@@ -1219,6 +1927,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				hence xYieldPending is used to latch that a context switch is
 				required. */
 				portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+
+				#if ( configNUMBER_OF_CORES > 1 )
+				{
+					/* If the task is running on another core then that core
+					must switch away from it before the idle task can free it. */
+					if( pxTCB->xTaskRunState != portGET_CORE_ID() )
+					{
+						taskYIELD_OTHER_CORE( pxTCB->xTaskRunState );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configNUMBER_OF_CORES */
 			}
 			else
 			{
@@ -1306,6 +2029,35 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			/* Update the wake time ready for the next call. */
 			*pxPreviousWakeTime = xTimeToWake;
 
+			#if ( configUSE_EDF_SCHEDULING == 1 )
+			{
+				/* The wake time is the release time of the task's next job,
+				so it also sets the deadline of that job.  This is done even if
+				the task is not going to delay, in which case the deadline may
+				already have passed and the task is scheduled accordingly. */
+				if( pxCurrentTCB->xEDFRelativeDeadline != ( TickType_t ) 0U )
+				{
+					pxCurrentTCB->xEDFAbsoluteDeadline = xTimeToWake + pxCurrentTCB->xEDFRelativeDeadline;
+
+					/* A task that stays Ready must be moved to the place its
+					new deadline calls for.  The yield below then runs whichever
+					task is now at the head. */
+					if( ( xShouldDelay == pdFALSE ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE ) )
+					{
+						prvReorderEDFReadyTask( pxCurrentTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_SCHEDULING */
+
 			if( xShouldDelay != pdFALSE )
 			{
 				traceTASK_DELAY_UNTIL( xTimeToWake );
@@ -1381,6 +2133,40 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskDelay */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MICROSECOND_DELAYS == 1 )
+
+	void vTaskDelayMicroseconds( const uint32_t ulMicrosecondsToDelay )
+	{
+		configASSERT( uxSchedulerSuspended == 0 );
+
+		/* A delay time of zero just forces a reschedule. */
+		if( ulMicrosecondsToDelay > 0UL )
+		{
+			/* The alarm interrupt is masked until the task has blocked, as it
+			would otherwise find the task still running if the delay is short,
+			and leave it to be unblocked by the tick. */
+			taskENTER_CRITICAL();
+			{
+				traceTASK_DELAY();
+				prvAddCurrentTaskToMicrosecondDelayList( ulMicrosecondsToDelay );
+
+				/* All ports are written to allow a yield in a critical
+				section (some will yield immediately, others wait until the
+				critical section exits) - but it is not something that
+				application code should ever do. */
+				portYIELD_WITHIN_API();
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			portYIELD_WITHIN_API();
+		}
+	}
+
+#endif /* configUSE_MICROSECOND_DELAYS */
+/*-----------------------------------------------------------*/
+
 #if( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
 
 	eTaskState eTaskGetState( TaskHandle_t xTask )
@@ -1391,9 +2177,10 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		configASSERT( pxTCB );
 
-		if( pxTCB == pxCurrentTCB )
+		if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
 		{
-			/* The task calling this function is querying its own state. */
+			/* The task calling this function is querying its own state, or
+			the task is running on another core. */
 			eReturn = eRunning;
 		}
 		else
@@ -1413,6 +2200,14 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				eReturn = eBlocked;
 			}
 
+			#if ( configUSE_TIMING_WHEEL == 1 )
+				else if( taskLIST_IS_TIMING_WHEEL_SLOT( pxStateList ) )
+				{
+					/* The task being queried is waiting in the timing wheel. */
+					eReturn = eBlocked;
+				}
+			#endif
+
 			#if ( INCLUDE_vTaskSuspend == 1 )
 				else if( pxStateList == &xSuspendedTaskList )
 				{
@@ -1423,17 +2218,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					{
 						#if( configUSE_TASK_NOTIFICATIONS == 1 )
 						{
+						UBaseType_t x;
+
 							/* The task does not appear on the event list item of
 							and of the RTOS objects, but could still be in the
-							blocked state if it is waiting on its notification
-							rather than waiting on an object. */
-							if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
-							{
-								eReturn = eBlocked;
-							}
-							else
+							blocked state if it is waiting on one of its
+							notifications rather than waiting on an object. */
+							eReturn = eSuspended;
+
+							for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 							{
-								eReturn = eSuspended;
+								if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+								{
+									eReturn = eBlocked;
+									break;
+								}
 							}
 						}
 						#else
@@ -1520,14 +2319,14 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		https://www.freertos.org/RTOS-Cortex-M3-M4.html */
 		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
 		{
 			/* If null is passed in here then it is the priority of the calling
 			task that is being queried. */
 			pxTCB = prvGetTCBFromHandle( xTask );
 			uxReturn = pxTCB->uxPriority;
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptState );
 
 		return uxReturn;
 	}
@@ -1575,44 +2374,48 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			if( uxCurrentBasePriority != uxNewPriority )
 			{
-				/* The priority change may have readied a task of higher
-				priority than the calling task. */
-				if( uxNewPriority > uxCurrentBasePriority )
+				#if ( configNUMBER_OF_CORES == 1 )
 				{
-					if( pxTCB != pxCurrentTCB )
+					/* The priority change may have readied a task of higher
+					priority than the calling task. */
+					if( uxNewPriority > uxCurrentBasePriority )
 					{
-						/* The priority of a task other than the currently
-						running task is being raised.  Is the priority being
-						raised above that of the running task? */
-						if( uxNewPriority >= pxCurrentTCB->uxPriority )
+						if( pxTCB != pxCurrentTCB )
 						{
-							xYieldRequired = pdTRUE;
+							/* The priority of a task other than the currently
+							running task is being raised.  Is the priority being
+							raised above that of the running task? */
+							if( uxNewPriority >= pxCurrentTCB->uxPriority )
+							{
+								xYieldRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
 						}
 						else
 						{
-							mtCOVERAGE_TEST_MARKER();
+							/* The priority of the running task is being raised,
+							but the running task must already be the highest
+							priority task able to run so no yield is required. */
 						}
 					}
+					else if( pxTCB == pxCurrentTCB )
+					{
+						/* Setting the priority of the running task down means
+						there may now be another task of higher priority that
+						is ready to execute. */
+						xYieldRequired = pdTRUE;
+					}
 					else
 					{
-						/* The priority of the running task is being raised,
-						but the running task must already be the highest
-						priority task able to run so no yield is required. */
+						/* Setting the priority of any other task down does not
+						require a yield as the running task must be above the
+						new priority of the task being modified. */
 					}
 				}
-				else if( pxTCB == pxCurrentTCB )
-				{
-					/* Setting the priority of the running task down means
-					there may now be another task of higher priority that
-					is ready to execute. */
-					xYieldRequired = pdTRUE;
-				}
-				else
-				{
-					/* Setting the priority of any other task down does not
-					require a yield as the running task must be above the
-					new priority of the task being modified. */
-				}
+				#endif /* configNUMBER_OF_CORES */
 
 				/* Remember the ready list the task might be referenced from
 				before its uxPriority member is changed so the
@@ -1664,9 +2467,9 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 					{
 						/* It is known that the task is in its ready list so
-						there is no need to check again and the port level
-						reset macro can be called directly. */
-						portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+						there is no need to check again and
+						taskCLEAR_READY_PRIORITY() can be called directly. */
+						taskCLEAR_READY_PRIORITY( uxPriorityUsedOnEntry );
 					}
 					else
 					{
@@ -1679,6 +2482,53 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					mtCOVERAGE_TEST_MARKER();
 				}
 
+				#if ( configNUMBER_OF_CORES > 1 )
+				{
+					/* With more than one core the yield is decided once the
+					task is in the right ready list, as another core may need
+					to yield instead of this one. */
+					if( xSchedulerRunning == pdFALSE )
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+					else if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+					{
+						/* Setting the priority of a running task down means a
+						ready task may now have a higher priority. */
+						if( uxNewPriority < uxCurrentBasePriority )
+						{
+							if( pxTCB->xTaskRunState == portGET_CORE_ID() )
+							{
+								xYieldRequired = pdTRUE;
+							}
+							else
+							{
+								taskYIELD_OTHER_CORE( pxTCB->xTaskRunState );
+							}
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+					{
+						if( uxNewPriority > uxCurrentBasePriority )
+						{
+							xYieldRequired = prvYieldForTask( pxTCB, pdTRUE );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configNUMBER_OF_CORES */
+
 				if( xYieldRequired != pdFALSE )
 				{
 					taskYIELD_IF_USING_PREEMPTION();
@@ -1699,26 +2549,341 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
 
-	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+	void vTaskSetTimeSlice( TaskHandle_t xTask, UBaseType_t uxTicks )
 	{
 	TCB_t *pxTCB;
 
+		configASSERT( uxTicks > ( UBaseType_t ) 0U );
+
 		taskENTER_CRITICAL();
 		{
-			/* If null is passed in here then it is the running task that is
-			being suspended. */
-			pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+			/* If null is passed in here then it is the time slice of the
+			calling task that is being changed. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->uxTimeSliceTicks = uxTicks;
 
-			traceTASK_SUSPEND( pxTCB );
+			/* The change takes effect from the current slice of the running
+			task, and from the next time it runs for any other task. */
+			pxTCB->uxTimeSliceRemaining = uxTicks;
+		}
+		taskEXIT_CRITICAL();
+	}
 
-			/* Remove task from the ready/delayed list and place in the
-			suspended list. */
-			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-			{
-				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-			}
+#endif /* configUSE_PER_TASK_TIME_SLICE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+
+	UBaseType_t uxTaskGetTimeSlice( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxTimeSliceTicks;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_PER_TASK_TIME_SLICE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CORE_AFFINITY == 1 )
+
+	void vTaskCoreAffinitySet( TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xCoreID;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+			if( xSchedulerRunning != pdFALSE )
+			{
+				xCoreID = pxTCB->xTaskRunState;
+
+				if( xCoreID != taskTASK_NOT_RUNNING )
+				{
+					/* A running task that may no longer run on its core is
+					moved off it. */
+					if( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) == pdFALSE )
+					{
+						if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+						{
+							taskYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+							taskYIELD_OTHER_CORE( xCoreID );
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+				{
+					/* A ready task may now be able to run on a core it
+					could not run on before. */
+					if( prvYieldForTask( pxTCB, pdFALSE ) != pdFALSE )
+					{
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_CORE_AFFINITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CORE_AFFINITY == 1 )
+
+	UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxCoreAffinityMask;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_CORE_AFFINITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_ARENAS == 1 )
+
+	void *pvTaskArenaAlloc( size_t xWantedSize )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+	void *pvReturn = NULL;
+
+		/* Round the size up so the next allocation is aligned too, checking
+		it does not wrap. */
+		if( ( xWantedSize + ( size_t ) portBYTE_ALIGNMENT_MASK ) >= xWantedSize )
+		{
+			xWantedSize = ( xWantedSize + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+			if( ( size_t ) ( pxTCB->pucArenaEnd - pxTCB->pucArenaNext ) >= xWantedSize )
+			{
+				pvReturn = pxTCB->pucArenaNext;
+				pxTCB->pucArenaNext += xWantedSize;
+			}
+			else
+			{
+				pvReturn = prvTaskArenaGrow( pxTCB, xWantedSize );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pvReturn;
+	}
+
+#endif /* configUSE_TASK_ARENAS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_ARENAS == 1 )
+
+	void vTaskArenaReset( void )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+
+		/* The next allocation starts again from the first chunk. */
+		pxTCB->pxArenaChunk = NULL;
+		pxTCB->pucArenaNext = NULL;
+		pxTCB->pucArenaEnd = NULL;
+	}
+
+#endif /* configUSE_TASK_ARENAS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_ARENAS == 1 )
+
+	static void *prvTaskArenaGrow( TCB_t * const pxTCB, const size_t xWantedSize )
+	{
+	TaskArenaChunk_t *pxChunk, *pxNewChunk;
+	size_t xChunkSize;
+	uint8_t *pucStart;
+	void *pvReturn = NULL;
+
+		/* Chunks after the current one were used before the arena was last
+		reset. */
+		if( pxTCB->pxArenaChunk == NULL )
+		{
+			pxChunk = pxTCB->pxArenaFirstChunk;
+		}
+		else
+		{
+			pxChunk = pxTCB->pxArenaChunk->pxNextChunk;
+		}
+
+		if( ( pxChunk == NULL ) || ( pxChunk->xSize < xWantedSize ) )
+		{
+			/* Put a new chunk in front of the next one, large enough for the
+			allocation if it is larger than a chunk. */
+			if( xWantedSize > ( size_t ) configTASK_ARENA_CHUNK_SIZE )
+			{
+				xChunkSize = xWantedSize;
+			}
+			else
+			{
+				xChunkSize = ( size_t ) configTASK_ARENA_CHUNK_SIZE;
+			}
+
+			if( ( xChunkSize + taskARENA_CHUNK_HEADER_SIZE ) > xChunkSize )
+			{
+				pxNewChunk = ( TaskArenaChunk_t * ) pvPortMalloc( xChunkSize + taskARENA_CHUNK_HEADER_SIZE ); /*lint !e9087 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the chunk header. */
+			}
+			else
+			{
+				pxNewChunk = NULL;
+			}
+
+			if( pxNewChunk != NULL )
+			{
+				pxNewChunk->xSize = xChunkSize;
+				pxNewChunk->pxNextChunk = pxChunk;
+
+				if( pxTCB->pxArenaChunk == NULL )
+				{
+					pxTCB->pxArenaFirstChunk = pxNewChunk;
+				}
+				else
+				{
+					pxTCB->pxArenaChunk->pxNextChunk = pxNewChunk;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxChunk = pxNewChunk;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pxChunk != NULL )
+		{
+			pucStart = ( ( uint8_t * ) pxChunk ) + taskARENA_CHUNK_HEADER_SIZE;
+			pxTCB->pxArenaChunk = pxChunk;
+			pxTCB->pucArenaNext = pucStart + xWantedSize;
+			pxTCB->pucArenaEnd = pucStart + pxChunk->xSize;
+			pvReturn = pucStart;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pvReturn;
+	}
+
+#endif /* configUSE_TASK_ARENAS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TASK_ARENAS == 1 ) && ( INCLUDE_vTaskDelete == 1 ) )
+
+	static void prvTaskArenaFree( TCB_t * const pxTCB )
+	{
+	TaskArenaChunk_t *pxChunk, *pxNextChunk;
+
+		for( pxChunk = pxTCB->pxArenaFirstChunk; pxChunk != NULL; pxChunk = pxNextChunk )
+		{
+			pxNextChunk = pxChunk->pxNextChunk;
+			vPortFree( pxChunk );
+		}
+
+		pxTCB->pxArenaFirstChunk = NULL;
+		pxTCB->pxArenaChunk = NULL;
+		pxTCB->pucArenaNext = NULL;
+		pxTCB->pucArenaEnd = NULL;
+	}
+
+#endif /* configUSE_TASK_ARENAS */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_TASK_POOL == 1 ) && ( INCLUDE_vTaskDelete == 1 ) && ( ( configUSE_TASK_ARENAS == 1 ) || ( configUSE_NEWLIB_REENTRANT == 1 ) ) )
+
+	static void prvTaskPoolFreeHeapMemory( TCB_t * const pxTCB )
+	{
+		vTaskSuspendAll();
+		{
+			#if ( configUSE_NEWLIB_REENTRANT == 1 )
+			{
+				/* _reclaim_reent() leaves the _reent structure newlib is using
+				alone, so point newlib back at its global one first.  The task
+				does not call into newlib again before it is switched out. */
+				_impure_ptr = _global_impure_ptr;
+				_reclaim_reent( &( pxTCB->xNewLib_reent ) );
+			}
+			#endif /* configUSE_NEWLIB_REENTRANT */
+
+			#if ( configUSE_TASK_ARENAS == 1 )
+			{
+				prvTaskArenaFree( pxTCB );
+			}
+			#endif /* configUSE_TASK_ARENAS */
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* configUSE_TASK_POOL */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+	{
+	TCB_t *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then it is the running task that is
+			being suspended. */
+			pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+
+			traceTASK_SUSPEND( pxTCB );
+
+			/* Remove task from the ready/delayed list and place in the
+			suspended list. */
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
@@ -1738,14 +2903,34 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			UBaseType_t x;
+
+				for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but is
+						now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
+
+			#if ( configNUMBER_OF_CORES > 1 )
+			{
+				/* A task running on another core is switched out by that
+				core. */
+				if( ( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE ) && ( pxTCB->xTaskRunState != portGET_CORE_ID() ) )
+				{
+					taskYIELD_OTHER_CORE( pxTCB->xTaskRunState );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configNUMBER_OF_CORES */
 		}
 		taskEXIT_CRITICAL();
 
@@ -1772,6 +2957,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				configASSERT( uxSchedulerSuspended == 0 );
 				portYIELD_WITHIN_API();
 			}
+			#if ( configNUMBER_OF_CORES == 1 )
 			else
 			{
 				/* The scheduler is not running, but the task that was pointed
@@ -1790,6 +2976,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					vTaskSwitchContext();
 				}
 			}
+			#endif /* configNUMBER_OF_CORES */
 		}
 		else
 		{
@@ -1871,7 +3058,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					prvAddTaskToReadyList( pxTCB );
 
 					/* A higher priority task may have just been resumed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskYIELD_FOR_TASK( pxTCB, pdTRUE ) != pdFALSE )
 					{
 						/* This yield may not cause the task just resumed to run,
 						but will leave the lists in the correct state for the
@@ -1928,7 +3115,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		https://www.freertos.org/RTOS-Cortex-M3-M4.html */
 		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
 			{
@@ -1939,7 +3126,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskYIELD_FOR_TASK( pxTCB, pdTRUE ) != pdFALSE )
 					{
 						xYieldRequired = pdTRUE;
 					}
@@ -1964,7 +3151,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xYieldRequired;
 	}
@@ -1977,7 +3164,48 @@ void vTaskStartScheduler( void )
 BaseType_t xReturn;
 
 	/* Add the idle task at the lowest priority. */
-	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+	BaseType_t xCoreID;
+	UBaseType_t x;
+	char cIdleName[ configMAX_TASK_NAME_LEN ];
+
+		xReturn = pdPASS;
+
+		/* Each core has its own idle task, so there is always a task a core
+		can run.  The core number is appended to the name of each. */
+		for( xCoreID = 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+		{
+			for( x = ( UBaseType_t ) 0; ( x < ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 2 ) ) && ( configIDLE_TASK_NAME[ x ] != ( char ) 0x00 ); x++ )
+			{
+				cIdleName[ x ] = configIDLE_TASK_NAME[ x ];
+			}
+			cIdleName[ x ] = ( char ) ( '0' + xCoreID );
+			cIdleName[ x + 1U ] = ( char ) 0x00;
+
+			#if( configUSE_CORE_AFFINITY == 1 )
+			{
+				xReturn = xTaskCreateAffinitySet(	prvIdleTask,
+													cIdleName,
+													configMINIMAL_STACK_SIZE,
+													( void * ) NULL,
+													portPRIVILEGE_BIT,
+													( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID,
+													&xIdleTaskHandles[ xCoreID ] );
+			}
+			#else
+			{
+				xReturn = xTaskCreate(	prvIdleTask,
+										cIdleName,
+										configMINIMAL_STACK_SIZE,
+										( void * ) NULL,
+										portPRIVILEGE_BIT,
+										&xIdleTaskHandles[ xCoreID ] );
+			}
+			#endif /* configUSE_CORE_AFFINITY */
+		}
+	}
+	#elif( configSUPPORT_STATIC_ALLOCATION == 1 )
 	{
 		StaticTask_t *pxIdleTaskTCBBuffer = NULL;
 		StackType_t *pxIdleTaskStackBuffer = NULL;
@@ -2060,6 +3288,18 @@ BaseType_t xReturn;
 		xSchedulerRunning = pdTRUE;
 		xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
 
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+		BaseType_t xCoreID;
+
+			/* Select the task each core runs first. */
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				prvSelectHighestPriorityTask( xCoreID );
+			}
+		}
+		#endif /* configNUMBER_OF_CORES */
+
 		/* If configGENERATE_RUN_TIME_STATS is defined then the following
 		macro must be defined to configure the timer/counter used to generate
 		the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
@@ -2068,7 +3308,17 @@ BaseType_t xReturn;
 		FreeRTOSConfig.h file. */
 		portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+		#if ( configGENERATE_RUN_TIME_CYCLE_STATS == 1 )
+		{
+			/* Start the cycle counter, and charge cycles to the first task from
+			the point it is started. */
+			portCONFIGURE_CYCLE_COUNTER();
+			ulCyclesAtLastUpdate = ( uint32_t ) portGET_CYCLE_COUNTER_VALUE();
+		}
+		#endif /* configGENERATE_RUN_TIME_CYCLE_STATS */
+
 		traceTASK_SWITCHED_IN();
+		portSET_STACK_GUARD( pxCurrentTCB->pxStack );
 
 		/* Setting up the timer tick is hardware specific and thus in the
 		portable interface. */
@@ -2092,7 +3342,11 @@ BaseType_t xReturn;
 
 	/* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
 	meaning xIdleTaskHandle is not used anywhere else. */
-	( void ) xIdleTaskHandle;
+	#if ( configNUMBER_OF_CORES == 1 )
+		( void ) xIdleTaskHandle;
+	#else
+		( void ) xIdleTaskHandles;
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -2109,28 +3363,59 @@ void vTaskEndScheduler( void )
 
 void vTaskSuspendAll( void )
 {
-	/* A critical section is not required as the variable is of type
-	BaseType_t.  Please read Richard Barry's reply in the following link to a
-	post in the FreeRTOS support forum before reporting this as a bug! -
-	http://goo.gl/wu4acr */
-
-	/* portSOFRWARE_BARRIER() is only implemented for emulated/simulated ports that
-	do not otherwise exhibit real time behaviour. */
-	portSOFTWARE_BARRIER();
-
-	/* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
-	is used to allow calls to vTaskSuspendAll() to nest. */
-	++uxSchedulerSuspended;
-
-	/* Enforces ordering for ports and optimised compilers that may otherwise place
-	the above increment elsewhere. */
-	portMEMORY_BARRIER();
-}
-/*----------------------------------------------------------*/
-
-#if ( configUSE_TICKLESS_IDLE != 0 )
-
-	static TickType_t prvGetExpectedIdleTime( void )
+	#if ( configNUMBER_OF_CORES == 1 )
+	{
+		/* A critical section is not required as the variable is of type
+		BaseType_t.  Please read Richard Barry's reply in the following link to a
+		post in the FreeRTOS support forum before reporting this as a bug! -
+		http://goo.gl/wu4acr */
+
+		/* portSOFRWARE_BARRIER() is only implemented for emulated/simulated ports that
+		do not otherwise exhibit real time behaviour. */
+		portSOFTWARE_BARRIER();
+
+		/* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
+		is used to allow calls to vTaskSuspendAll() to nest. */
+		++uxSchedulerSuspended;
+
+		/* Enforces ordering for ports and optimised compilers that may otherwise place
+		the above increment elsewhere. */
+		portMEMORY_BARRIER();
+	}
+	#else
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			/* The task lock keeps the other cores out of the kernel until
+			xTaskResumeAll() releases it.  The ISR lock is only held while
+			the count is incremented, so an interrupt on another core cannot be
+			part way through updating the lists the tick and scheduler use.
+			Interrupts are masked so the calling task cannot be switched out
+			while it holds the task lock but has not yet suspended the
+			scheduler. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+			portGET_TASK_LOCK();
+			portGET_ISR_LOCK();
+
+			++uxSchedulerSuspended;
+
+			portRELEASE_ISR_LOCK();
+			portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+		}
+		else
+		{
+			++uxSchedulerSuspended;
+		}
+	}
+	#endif /* configNUMBER_OF_CORES */
+}
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	static TickType_t prvGetExpectedIdleTime( void )
 	{
 	TickType_t xReturn;
 	UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
@@ -2159,6 +3444,29 @@ void vTaskSuspendAll( void )
 			{
 				uxHigherPriorityReadyTasks = pdTRUE;
 			}
+
+			#if ( configMAX_PRIORITIES > 32 )
+			{
+				/* uxTopReadyPriority only has a bit per group of 32 priorities,
+				the idle priority being in the first group. */
+				if( uxReadyPriorityGroups[ 0 ] > uxLeastSignificantBit )
+				{
+					uxHigherPriorityReadyTasks = pdTRUE;
+				}
+			}
+			#endif
+		}
+		#endif
+
+		#if( configUSE_BATCHED_WAKEUPS == 1 )
+		{
+			/* Tasks that have timed out but not yet been moved to a ready list
+			will be made ready by the next context switch, whatever their
+			priority. */
+			if( pxExpiringTaskList != NULL )
+			{
+				uxHigherPriorityReadyTasks = pdTRUE;
+			}
 		}
 		#endif
 
@@ -2209,6 +3517,22 @@ BaseType_t xAlreadyYielded = pdFALSE;
 	{
 		--uxSchedulerSuspended;
 
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+			/* Release the task lock taken by vTaskSuspendAll().  The critical
+			section still holds it, so the other cores remain outside the
+			kernel until the lists have been brought up to date below. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				portRELEASE_TASK_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configNUMBER_OF_CORES */
+
 		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 		{
 			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
@@ -2224,7 +3548,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 					/* If the moved task has a priority higher than the current
 					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskYIELD_FOR_TASK( pxTCB, pdTRUE ) != pdFALSE )
 					{
 						xYieldPending = pdTRUE;
 					}
@@ -2472,6 +3796,20 @@ TCB_t *pxTCB;
 				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
 			}
 
+			#if ( configUSE_TIMING_WHEEL == 1 )
+			{
+			UBaseType_t uxLevel, uxSlot;
+
+				for( uxLevel = 0; ( uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS ) && ( pxTCB == NULL ); uxLevel++ )
+				{
+					for( uxSlot = 0; ( uxSlot < ( UBaseType_t ) taskWHEEL_SLOTS ) && ( pxTCB == NULL ); uxSlot++ )
+					{
+						pxTCB = prvSearchForNameWithinSingleList( &( xTimingWheel[ uxLevel ][ uxSlot ] ), pcNameToQuery );
+					}
+				}
+			}
+			#endif
+
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
 				if( pxTCB == NULL )
@@ -2525,6 +3863,20 @@ TCB_t *pxTCB;
 				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
 				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
 
+				#if( configUSE_TIMING_WHEEL == 1 )
+				{
+				UBaseType_t uxLevel, uxSlot;
+
+					for( uxLevel = 0; uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel++ )
+					{
+						for( uxSlot = 0; uxSlot < ( UBaseType_t ) taskWHEEL_SLOTS; uxSlot++ )
+						{
+							uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xTimingWheel[ uxLevel ][ uxSlot ] ), eBlocked );
+						}
+					}
+				}
+				#endif
+
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
 					/* Fill in an TaskStatus_t structure with information on
@@ -2580,8 +3932,17 @@ TCB_t *pxTCB;
 	{
 		/* If xTaskGetIdleTaskHandle() is called before the scheduler has been
 		started, then xIdleTaskHandle will be NULL. */
-		configASSERT( ( xIdleTaskHandle != NULL ) );
-		return xIdleTaskHandle;
+		#if ( configNUMBER_OF_CORES == 1 )
+		{
+			configASSERT( ( xIdleTaskHandle != NULL ) );
+			return xIdleTaskHandle;
+		}
+		#else
+		{
+			configASSERT( ( xIdleTaskHandles[ 0 ] != NULL ) );
+			return xIdleTaskHandles[ 0 ];
+		}
+		#endif /* configNUMBER_OF_CORES */
 	}
 
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
@@ -2600,6 +3961,13 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 		each stepped tick. */
 		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
 		xTickCount += xTicksToJump;
+
+		#if( configUSE_TIMING_WHEEL == 1 )
+		{
+			/* No slot needed servicing during the skipped ticks. */
+			xTimingWheelTime = xTickCount;
+		}
+		#endif
 		traceINCREASE_TICK_COUNT( xTicksToJump );
 	}
 
@@ -2678,7 +4046,7 @@ BaseType_t xYieldRequired = pdFALSE;
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskYIELD_FOR_TASK( pxTCB, pdFALSE ) != pdFALSE )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2706,14 +4074,16 @@ BaseType_t xYieldRequired = pdFALSE;
 
 BaseType_t xTaskIncrementTick( void )
 {
-TCB_t * pxTCB;
-TickType_t xItemValue;
 BaseType_t xSwitchRequired = pdFALSE;
 
 	/* Called by the portable layer each time a tick interrupt occurs.
 	Increments the tick then checks to see if the new tick value will cause any
 	tasks to be unblocked. */
 	traceTASK_INCREMENT_TICK( xTickCount );
+
+	/* Keep the cycle count of the running task up to date even if it runs for
+	longer than the cycle counter takes to wrap. */
+	taskUPDATE_RUN_TIME_CYCLES();
 	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 	{
 		/* Minor optimisation.  The tick count cannot change in this
@@ -2726,6 +4096,31 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
 		{
+			#if ( configUSE_BATCHED_WAKEUPS == 1 )
+			{
+				/* Tasks the previous tick left behind woke on or before the
+				last tick of the old epoch, and the delayed list must be empty
+				before it is switched, so they are made ready here.  This only
+				exceeds configBATCHED_WAKEUP_LIMIT if no context switch ran
+				during the final tick of the epoch. */
+				if( pxExpiringTaskList != NULL )
+				{
+					if( prvReadyDueTasks( pxExpiringTaskList, portMAX_DELAY, taskWAKE_ALL_DUE ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_BATCHED_WAKEUPS */
+
 			taskSWITCH_DELAYED_LISTS();
 		}
 		else
@@ -2733,101 +4128,309 @@ BaseType_t xSwitchRequired = pdFALSE;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		/* See if this tick has made a timeout expire.  Tasks are stored in
-		the	queue in the order of their wake time - meaning once one task
-		has been found whose block time has not expired there is no need to
-		look any further down the list. */
-		if( xConstTickCount >= xNextTaskUnblockTime )
+		#if ( configUSE_TIMING_WHEEL == 1 )
 		{
-			for( ;; )
+			#if ( configUSE_BATCHED_WAKEUPS == 1 )
 			{
-				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+				/* Only one slot can have tasks left behind, so if the context
+				switch has not run since the previous tick the tasks that tick
+				left in its slot are made ready before another slot falls
+				due. */
+				if( pxExpiringTaskList != NULL )
 				{
-					/* The delayed list is empty.  Set xNextTaskUnblockTime
-					to the maximum possible value so it is extremely
-					unlikely that the
-					if( xTickCount >= xNextTaskUnblockTime ) test will pass
-					next time through. */
-					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					break;
+					if( prvReadyDueTasks( pxExpiringTaskList, xConstTickCount, taskWAKE_ALL_DUE ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 				else
 				{
-					/* The delayed list is not empty, get the value of the
-					item at the head of the delayed list.  This is the time
-					at which the task at the head of the delayed list must
-					be removed from the Blocked state. */
-					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-					xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_BATCHED_WAKEUPS */
+
+			/* xNextTaskUnblockTime holds the next tick on which a wheel slot
+			falls due or must be cascaded, so on every other tick there is
+			nothing to do. */
+			if( xConstTickCount >= xNextTaskUnblockTime )
+			{
+			List_t *pxDueList;
+
+				xTimingWheelTime = xConstTickCount;
 
-					if( xConstTickCount < xItemValue )
+				/* Every task in the slot returned is due on this tick, so they
+				can be unblocked without looking at their wake times, and no
+				other list needs to be examined. */
+				pxDueList = prvTimingWheelAdvance();
+
+				#if ( configUSE_BATCHED_WAKEUPS == 1 )
+				{
+					/* Make at most configBATCHED_WAKEUP_LIMIT of the tasks ready
+					here and leave the rest to the context switch, so the time
+					spent here does not depend on the number of tasks waking
+					together. */
+					if( prvReadyDueTasks( pxDueList, xConstTickCount, ( UBaseType_t ) configBATCHED_WAKEUP_LIMIT ) != pdFALSE )
 					{
-						/* It is not time to unblock this item yet, but the
-						item value is the time at which the task at the head
-						of the blocked list must be removed from the Blocked
-						state -	so record the item value in
-						xNextTaskUnblockTime. */
-						xNextTaskUnblockTime = xItemValue;
-						break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
+						xSwitchRequired = pdTRUE;
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
+				}
+				#else
+				{
+				TCB_t * pxTCB;
 
-					/* It is time to remove the item from the Blocked state. */
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					while( listLIST_IS_EMPTY( pxDueList ) == pdFALSE )
+					{
+						pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDueList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-					/* Is the task waiting on an event also?  If so remove
-					it from the event list. */
-					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+						/* It is time to remove the item from the Blocked state. */
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+						/* Is the task waiting on an event also?  If so remove
+						it from the event list. */
+						if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+						{
+							( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						/* Place the unblocked task into the appropriate ready
+						list. */
+						prvAddTaskToReadyList( pxTCB );
+
+						/* A task being unblocked cannot cause an immediate
+						context switch if preemption is turned off. */
+						#if (  configUSE_PREEMPTION == 1 )
+						{
+							/* Preemption is on, but a context switch should
+							only be performed if the unblocked task has a
+							priority that is equal to or higher than the
+							currently executing task. */
+							if( taskYIELD_FOR_TASK( pxTCB, pdTRUE ) != pdFALSE )
+							{
+								xSwitchRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_PREEMPTION */
+					}
+				}
+				#endif /* configUSE_BATCHED_WAKEUPS */
+
+				prvResetNextTaskUnblockTime();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xTimingWheelTime = xConstTickCount;
+		}
+		#else /* configUSE_TIMING_WHEEL */
+		{
+			/* See if this tick has made a timeout expire.  Tasks are stored in
+			the	queue in the order of their wake time - meaning once one task
+			has been found whose block time has not expired there is no need to
+			look any further down the list. */
+			if( xConstTickCount >= xNextTaskUnblockTime )
+			{
+				#if ( configUSE_BATCHED_WAKEUPS == 1 )
+				{
+					/* Make at most configBATCHED_WAKEUP_LIMIT of the due tasks
+					ready here and leave the rest to the context switch, so the
+					time spent here does not depend on the number of tasks
+					waking together.  Any left behind are still at the head of
+					the delayed list, so if the context switch does not run
+					before the next tick, that tick carries on from them. */
+					if( prvReadyDueTasks( pxDelayedTaskList, xConstTickCount, ( UBaseType_t ) configBATCHED_WAKEUP_LIMIT ) != pdFALSE )
 					{
-						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						xSwitchRequired = pdTRUE;
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
 
-					/* Place the unblocked task into the appropriate ready
-					list. */
-					prvAddTaskToReadyList( pxTCB );
+					prvResetNextTaskUnblockTime();
+				}
+				#else
+				{
+				TCB_t * pxTCB;
+				TickType_t xItemValue;
 
-					/* A task being unblocked cannot cause an immediate
-					context switch if preemption is turned off. */
-					#if (  configUSE_PREEMPTION == 1 )
+					for( ;; )
 					{
-						/* Preemption is on, but a context switch should
-						only be performed if the unblocked task has a
-						priority that is equal to or higher than the
-						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
 						{
-							xSwitchRequired = pdTRUE;
+							/* The delayed list is empty.  Set xNextTaskUnblockTime
+							to the maximum possible value so it is extremely
+							unlikely that the
+							if( xTickCount >= xNextTaskUnblockTime ) test will pass
+							next time through. */
+							xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+							break;
 						}
 						else
 						{
-							mtCOVERAGE_TEST_MARKER();
+							/* The delayed list is not empty, get the value of the
+							item at the head of the delayed list.  This is the time
+							at which the task at the head of the delayed list must
+							be removed from the Blocked state. */
+							pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+							xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+							if( xConstTickCount < xItemValue )
+							{
+								/* It is not time to unblock this item yet, but the
+								item value is the time at which the task at the head
+								of the blocked list must be removed from the Blocked
+								state -	so record the item value in
+								xNextTaskUnblockTime. */
+								xNextTaskUnblockTime = xItemValue;
+								break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+
+							/* It is time to remove the item from the Blocked state. */
+							( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+							/* Is the task waiting on an event also?  If so remove
+							it from the event list. */
+							if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+							{
+								( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+
+							/* Place the unblocked task into the appropriate ready
+							list. */
+							prvAddTaskToReadyList( pxTCB );
+
+							/* A task being unblocked cannot cause an immediate
+							context switch if preemption is turned off. */
+							#if (  configUSE_PREEMPTION == 1 )
+							{
+								/* Preemption is on, but a context switch should
+								only be performed if the unblocked task has a
+								priority that is equal to or higher than the
+								currently executing task. */
+								if( taskYIELD_FOR_TASK( pxTCB, pdTRUE ) != pdFALSE )
+								{
+									xSwitchRequired = pdTRUE;
+								}
+								else
+								{
+									mtCOVERAGE_TEST_MARKER();
+								}
+							}
+							#endif /* configUSE_PREEMPTION */
 						}
 					}
-					#endif /* configUSE_PREEMPTION */
 				}
+				#endif /* configUSE_BATCHED_WAKEUPS */
 			}
 		}
+		#endif /* configUSE_TIMING_WHEEL */
 
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
 		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
 			{
-				xSwitchRequired = pdTRUE;
+				/* The running task keeps the processor until its own time
+				slice has been used up.  The remaining count is not decremented
+				past 1 so a task that has used up its slice while it was the
+				only ready task at its priority yields as soon as another one
+				becomes ready.  A count of 0 marks a slice that has ended, and
+				is reloaded when the task is switched out. */
+				if( pxCurrentTCB->uxTimeSliceRemaining > ( UBaseType_t ) 1 )
+				{
+					( pxCurrentTCB->uxTimeSliceRemaining )--;
+				}
+				else if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) && ( taskTIME_SLICE_SHARED( pxCurrentTCB ) != pdFALSE ) )
+				{
+					pxCurrentTCB->uxTimeSliceRemaining = ( UBaseType_t ) 0;
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
-			else
+			#elif ( configNUMBER_OF_CORES == 1 )
 			{
-				mtCOVERAGE_TEST_MARKER();
+				if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) && ( taskTIME_SLICE_SHARED( pxCurrentTCB ) != pdFALSE ) )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#else
+			{
+			BaseType_t xCoreID, xOtherCoreID;
+			UBaseType_t uxPriority, uxRunning;
+
+				/* Every core is time sliced from the tick, which only
+				interrupts one core.  A core is switched if there are more
+				ready tasks at the priority of the task it is running than
+				there are cores running tasks of that priority. */
+				for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+				{
+					uxPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+					uxRunning = 0U;
+
+					for( xOtherCoreID = 0; xOtherCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xOtherCoreID++ )
+					{
+						if( pxCurrentTCBs[ xOtherCoreID ]->uxPriority == uxPriority )
+						{
+							uxRunning++;
+						}
+					}
+
+					if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxPriority ] ) ) <= uxRunning )
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+					else if( xCoreID == portGET_CORE_ID() )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else if( xYieldPendings[ xCoreID ] == pdFALSE )
+					{
+						taskYIELD_OTHER_CORE( xCoreID );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
 			}
+			#endif /* configUSE_PER_TASK_TIME_SLICE */
 		}
 		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
@@ -2858,6 +4461,26 @@ BaseType_t xSwitchRequired = pdFALSE;
 			}
 		}
 		#endif /* configUSE_PREEMPTION */
+
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+		BaseType_t xCoreID;
+
+			/* As above for the other cores, whose pending yield may have been
+			latched by an interrupt handler that did not yield. */
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				if( ( xYieldPendings[ xCoreID ] != pdFALSE ) && ( xCoreID != portGET_CORE_ID() ) )
+				{
+					portYIELD_CORE( xCoreID );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		#endif /* configNUMBER_OF_CORES */
 	}
 	else
 	{
@@ -2942,11 +4565,11 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 		/* Save the hook function in the TCB.  A critical section is required as
 		the value can be accessed from an interrupt. */
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			xReturn = pxTCB->pxTaskTag;
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xReturn;
 	}
@@ -2988,6 +4611,21 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 void vTaskSwitchContext( void )
 {
+#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+TCB_t *pxPreviousTCB;
+#endif
+
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		/* Called with interrupts masked on the calling core.  The locks are
+		taken in the same order as by a critical section.  If the scheduler is
+		suspended it is suspended by this core, as otherwise the task lock
+		would not have been obtained. */
+		portGET_TASK_LOCK();
+		portGET_ISR_LOCK();
+	}
+	#endif /* configNUMBER_OF_CORES */
+
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -3026,6 +4664,10 @@ void vTaskSwitchContext( void )
 		}
 		#endif /* configGENERATE_RUN_TIME_STATS */
 
+		/* Charge the cycles used since the last tick or context switch to the
+		task being switched out. */
+		taskUPDATE_RUN_TIME_CYCLES();
+
 		/* Check for stack overflow, if configured. */
 		taskCHECK_FOR_STACK_OVERFLOW();
 
@@ -3036,36 +4678,321 @@ void vTaskSwitchContext( void )
 		}
 		#endif
 
-		/* Select a new task to run using either the generic C or port
-		optimised asm code. */
-		taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		traceTASK_SWITCHED_IN();
-
-		/* After the new task is switched in, update the global errno. */
-		#if( configUSE_POSIX_ERRNO == 1 )
+		/* Make ready any tasks the tick interrupt left behind when it reached
+		configBATCHED_WAKEUP_LIMIT, so they are considered by the selection
+		below. */
+		#if ( configUSE_BATCHED_WAKEUPS == 1 )
 		{
-			FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+			if( pxExpiringTaskList != NULL )
+			{
+				( void ) prvReadyDueTasks( pxExpiringTaskList, xTickCount, taskWAKE_ALL_DUE );
+				prvResetNextTaskUnblockTime();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		#endif
 
-		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		/* A task at configEDF_TASK_PRIORITY that is switched out while still
+		Ready goes behind the tasks that have the same deadline, so that they
+		share the processor. */
+		#if ( configUSE_EDF_SCHEDULING == 1 )
 		{
-			/* Switch Newlib's _impure_ptr variable to point to the _reent
-			structure specific to this task.
-			See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-			for additional information. */
-			_impure_ptr = &( pxCurrentTCB->xNewLib_reent );
-		}
-		#endif /* configUSE_NEWLIB_REENTRANT */
-	}
-}
-/*-----------------------------------------------------------*/
-
-void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
-{
-	configASSERT( pxEventList );
+			if( ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE ) )
+			{
+				ListItem_t * const pxNextItem = listGET_NEXT( &( pxCurrentTCB->xStateListItem ) );
 
-	/* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+				if( ( pxNextItem != listGET_END_MARKER( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ) ) ) && ( taskEDF_EARLIER( pxCurrentTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxNextItem ) ) == pdFALSE ) )
+				{
+					( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+					prvInsertEDFReadyTask( pxCurrentTCB, pxNextItem );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_SCHEDULING */
+
+		#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+		{
+			pxPreviousTCB = pxCurrentTCB;
+		}
+		#endif
+
+		/* Select a new task to run using either the generic C or port
+		optimised asm code. */
+		#if ( configNUMBER_OF_CORES == 1 )
+		{
+			taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		}
+		#else
+		{
+			prvSelectHighestPriorityTask( portGET_CORE_ID() );
+		}
+		#endif /* configNUMBER_OF_CORES */
+		#if ( configUSE_EDF_SCHEDULING == 1 )
+		{
+			if( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY )
+			{
+				/* The task with the earliest deadline is at the head. */
+				pxCurrentTCB = listGET_LIST_ITEM_OWNER( listGET_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ) ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_SCHEDULING */
+
+		/* A task that is preempted by a higher priority task part way through
+		its time slice keeps the rest of it, and is the next task at its
+		priority to run so that it can finish it.  A task whose slice has
+		ended, or that blocks or yields to a task of its own priority, starts
+		a new slice the next time it runs. */
+		#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+		{
+			if( ( pxPreviousTCB != pxCurrentTCB ) && ( pxPreviousTCB->uxTimeSliceRemaining != ( UBaseType_t ) 0 ) && ( pxCurrentTCB->uxPriority > pxPreviousTCB->uxPriority ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+			{
+				/* The ready list is walked from the item after pxIndex. */
+				pxReadyTasksLists[ pxPreviousTCB->uxPriority ].pxIndex = pxPreviousTCB->xStateListItem.pxPrevious;
+			}
+			else if( ( pxPreviousTCB != pxCurrentTCB ) || ( pxPreviousTCB->uxTimeSliceRemaining == ( UBaseType_t ) 0 ) )
+			{
+				pxPreviousTCB->uxTimeSliceRemaining = pxPreviousTCB->uxTimeSliceTicks;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_PER_TASK_TIME_SLICE */
+
+		traceTASK_SWITCHED_IN();
+		portSET_STACK_GUARD( pxCurrentTCB->pxStack );
+
+		#if( ( configUSE_TASK_POOL == 1 ) && ( INCLUDE_vTaskDelete == 1 ) )
+		{
+			if( pxTaskPoolPendingRelease != NULL )
+			{
+				/* The pool task that deleted itself has been switched out, so
+				nothing uses its stack any more.  This runs with interrupts
+				masked, so the free list can be updated directly. */
+				portCLEAN_UP_TCB( pxTaskPoolPendingRelease );
+				vListInsertEnd( &xTaskPoolFreeList, &( pxTaskPoolPendingRelease->xStateListItem ) );
+				pxTaskPoolPendingRelease = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_POOL */
+
+		/* After the new task is switched in, update the global errno. */
+		#if( configUSE_POSIX_ERRNO == 1 )
+		{
+			FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+		}
+		#endif
+
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		{
+			/* Switch Newlib's _impure_ptr variable to point to the _reent
+			structure specific to this task.
+			See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+			for additional information. */
+			_impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+		}
+		#endif /* configUSE_NEWLIB_REENTRANT */
+	}
+
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		portRELEASE_ISR_LOCK();
+		portRELEASE_TASK_LOCK();
+	}
+	#endif /* configNUMBER_OF_CORES */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	static TCB_t *prvGetCurrentTCB( void )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+		{
+			pxTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+		}
+		portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+
+		return pxTCB;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	static void prvSelectHighestPriorityTask( const BaseType_t xCoreID )
+	{
+	UBaseType_t uxPriority;
+	List_t *pxReadyList;
+	ListItem_t const *pxEndMarker;
+	ListItem_t *pxIterator;
+	TCB_t *pxTCB = NULL;
+	TCB_t * const pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+
+		/* uxTopReadyPriority is only raised as tasks become ready, so first
+		lower it past any lists that have since emptied. */
+		while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) != pdFALSE )
+		{
+			configASSERT( uxTopReadyPriority );
+			--uxTopReadyPriority;
+		}
+
+		/* Find the first task, from the highest priority down, that is not
+		running on another core and may run on this one.  One is always found
+		at or above the idle priority, as there is an idle task for every
+		core. */
+		uxPriority = uxTopReadyPriority;
+
+		for( ;; )
+		{
+			pxReadyList = &( pxReadyTasksLists[ uxPriority ] );
+			pxEndMarker = listGET_END_MARKER( pxReadyList );
+
+			for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+			{
+				pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+				if( ( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) || ( pxTCB->xTaskRunState == xCoreID ) ) && ( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) != pdFALSE ) )
+				{
+					break;
+				}
+
+				pxTCB = NULL;
+			}
+
+			if( pxTCB != NULL )
+			{
+				break;
+			}
+
+			configASSERT( uxPriority > tskIDLE_PRIORITY );
+			--uxPriority;
+		}
+
+		/* Move the selected task to the end of its ready list, so tasks of
+		equal priority are selected in turn. */
+		( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+		vListInsertEnd( pxReadyList, &( pxTCB->xStateListItem ) );
+
+		if( pxTCB != pxPreviousTCB )
+		{
+			if( pxPreviousTCB != NULL )
+			{
+				pxPreviousTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->xTaskRunState = xCoreID;
+			pxCurrentTCBs[ xCoreID ] = pxTCB;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	static BaseType_t prvYieldForTask( const TCB_t * const pxTCB, const BaseType_t xYieldEqualPriority )
+	{
+	BaseType_t xCoreID, xLowestPriorityCoreID = taskTASK_NOT_RUNNING;
+	UBaseType_t uxLowestPriority = pxTCB->uxPriority;
+	BaseType_t xReturn = pdFALSE;
+
+		/* A task that is already running does not preempt another, and no
+		task is running on any core before the scheduler has started. */
+		if( ( xSchedulerRunning != pdFALSE ) && ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) )
+		{
+			/* Only cores running a task of lower priority, or of equal
+			priority if xYieldEqualPriority is set, are candidates. */
+			if( xYieldEqualPriority != pdFALSE )
+			{
+				uxLowestPriority++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Cores that already have a yield pending are skipped, as they
+			will select the highest priority task able to run anyway. */
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				if( ( xYieldPendings[ xCoreID ] == pdFALSE ) &&
+					( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) != pdFALSE ) &&
+					( pxCurrentTCBs[ xCoreID ]->uxPriority < uxLowestPriority ) )
+				{
+					uxLowestPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+					xLowestPriorityCoreID = xCoreID;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			if( xLowestPriorityCoreID == taskTASK_NOT_RUNNING )
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else if( xLowestPriorityCoreID == portGET_CORE_ID() )
+			{
+				/* The caller yields.  Also mark the yield as pending in case
+				the caller is an interrupt whose handler does not yield. */
+				xYieldPendings[ xLowestPriorityCoreID ] = pdTRUE;
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				taskYIELD_OTHER_CORE( xLowestPriorityCoreID );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
+{
+	configASSERT( pxEventList );
+
+	/* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
 	SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
 
 	/* Place the event list item of the TCB in the appropriate event list.
@@ -3183,7 +5110,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskYIELD_FOR_TASK( pxUnblockedTCB, pdFALSE ) != pdFALSE )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3240,7 +5167,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskYIELD_FOR_TASK( pxUnblockedTCB, pdFALSE ) != pdFALSE )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3427,9 +5354,10 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 
 			A critical region is not required here as we are just reading from
 			the list, and an occasional incorrect value will not matter.  If
-			the ready list at the idle priority contains more than one task
-			then a task other than the idle task is ready to execute. */
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			the ready list at the idle priority contains more tasks than there
+			are idle tasks then a task other than an idle task is ready to
+			execute. */
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
 			{
 				taskYIELD();
 			}
@@ -3521,6 +5449,14 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			/* A task was made ready while the scheduler was suspended. */
 			eReturn = eAbortSleep;
 		}
+		#if( configUSE_BATCHED_WAKEUPS == 1 )
+			else if( pxExpiringTaskList != NULL )
+			{
+				/* A task has timed out but not yet been moved to a ready
+				list. */
+				eReturn = eAbortSleep;
+			}
+		#endif
 		else if( xYieldPending != pdFALSE )
 		{
 			/* A yield was pended while the scheduler was suspended. */
@@ -3617,6 +5553,26 @@ UBaseType_t uxPriority;
 	vListInitialise( &xDelayedTaskList2 );
 	vListInitialise( &xPendingReadyList );
 
+	#if ( configUSE_MICROSECOND_DELAYS == 1 )
+	{
+		vListInitialise( &xMicrosecondDelayList );
+	}
+	#endif
+
+	#if ( configUSE_TIMING_WHEEL == 1 )
+	{
+	UBaseType_t uxLevel, uxSlot;
+
+		for( uxLevel = 0; uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel++ )
+		{
+			for( uxSlot = 0; uxSlot < ( UBaseType_t ) taskWHEEL_SLOTS; uxSlot++ )
+			{
+				vListInitialise( &( xTimingWheel[ uxLevel ][ uxSlot ] ) );
+			}
+		}
+	}
+	#endif /* configUSE_TIMING_WHEEL */
+
 	#if ( INCLUDE_vTaskDelete == 1 )
 	{
 		vListInitialise( &xTasksWaitingTermination );
@@ -3649,14 +5605,54 @@ static void prvCheckTasksWaitingTermination( void )
 		being called too often in the idle task. */
 		while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
 		{
-			taskENTER_CRITICAL();
+			#if ( configNUMBER_OF_CORES == 1 )
 			{
-				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-				--uxCurrentNumberOfTasks;
-				--uxDeletedTasksWaitingCleanUp;
+				taskENTER_CRITICAL();
+				{
+					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					--uxCurrentNumberOfTasks;
+					--uxDeletedTasksWaitingCleanUp;
+				}
+				taskEXIT_CRITICAL();
 			}
-			taskEXIT_CRITICAL();
+			#else
+			{
+				/* The idle task of every core runs this, so the count is
+				checked again within the critical section.  A task that deleted
+				itself is only freed once its core has switched away from it. */
+				pxTCB = NULL;
+
+				taskENTER_CRITICAL();
+				{
+					if( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+					{
+						pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+						if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+						{
+							( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+							--uxCurrentNumberOfTasks;
+							--uxDeletedTasksWaitingCleanUp;
+						}
+						else
+						{
+							pxTCB = NULL;
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				if( pxTCB == NULL )
+				{
+					break;
+				}
+			}
+			#endif /* configNUMBER_OF_CORES */
 
 			prvDeleteTCB( pxTCB );
 		}
@@ -3700,12 +5696,18 @@ static void prvCheckTasksWaitingTermination( void )
 		}
 		#endif
 
+		#if ( configGENERATE_RUN_TIME_CYCLE_STATS == 1 )
+		{
+			pxTaskStatus->ullRunTimeCycles = ullTaskGetRunTimeCycles( pxTCB );
+		}
+		#endif
+
 		/* Obtaining the task state is a little fiddly, so is only done if the
 		value of eState passed into this function is eInvalid - otherwise the
 		state is just set to whatever is passed in. */
 		if( eState != eInvalid )
 		{
-			if( pxTCB == pxCurrentTCB )
+			if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
 			{
 				pxTaskStatus->eCurrentState = eRunning;
 			}
@@ -3901,6 +5903,12 @@ static void prvCheckTasksWaitingTermination( void )
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 
+		#if ( configUSE_TASK_ARENAS == 1 )
+		{
+			prvTaskArenaFree( pxTCB );
+		}
+		#endif /* configUSE_TASK_ARENAS */
+
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
 		{
 			/* The task can only have been allocated dynamically - free both
@@ -3926,6 +5934,18 @@ static void prvCheckTasksWaitingTermination( void )
 				only memory that must be freed. */
 				vPortFree( pxTCB );
 			}
+			#if( configUSE_TASK_POOL == 1 )
+			else if( pxTCB->ucStaticallyAllocated == tskTASK_POOL_STACK_AND_TCB )
+			{
+				/* The stack and TCB came from the task pool, so return the slot
+				to the pool where it can be reused straight away. */
+				taskENTER_CRITICAL();
+				{
+					vListInsertEnd( &xTaskPoolFreeList, &( pxTCB->xStateListItem ) );
+				}
+				taskEXIT_CRITICAL();
+			}
+			#endif /* configUSE_TASK_POOL */
 			else
 			{
 				/* Neither the stack nor the TCB were allocated dynamically, so
@@ -3940,30 +5960,580 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-TCB_t *pxTCB;
+#if( configUSE_TASK_POOL == 1 )
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-	{
-		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-		the maximum possible value so it is	extremely unlikely that the
-		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-		there is an item in the delayed list. */
-		xNextTaskUnblockTime = portMAX_DELAY;
-	}
-	else
+	static TCB_t *prvTaskPoolTake( const configSTACK_DEPTH_TYPE usStackDepth )
 	{
-		/* The new current delayed list is not empty, get the value of
-		the item at the head of the delayed list.  This is the time at
+	TCB_t *pxTCB = NULL;
+	UBaseType_t uxSlot;
+
+		taskENTER_CRITICAL();
+		{
+			if( xTaskPoolInitialised == pdFALSE )
+			{
+				/* The stack of each slot never changes, so it is only set
+				once. */
+				vListInitialise( &xTaskPoolFreeList );
+
+				for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) configTASK_POOL_SLOTS; uxSlot++ )
+				{
+					xTaskPoolTCBs[ uxSlot ].pxStack = &( xTaskPoolStacks[ uxSlot ][ 0 ] );
+					vListInitialiseItem( &( xTaskPoolTCBs[ uxSlot ].xStateListItem ) );
+					listSET_LIST_ITEM_OWNER( &( xTaskPoolTCBs[ uxSlot ].xStateListItem ), &( xTaskPoolTCBs[ uxSlot ] ) );
+					vListInsertEnd( &xTaskPoolFreeList, &( xTaskPoolTCBs[ uxSlot ].xStateListItem ) );
+				}
+
+				xTaskPoolInitialised = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( usStackDepth <= ( configSTACK_DEPTH_TYPE ) configTASK_POOL_STACK_DEPTH ) && ( listLIST_IS_EMPTY( &xTaskPoolFreeList ) == pdFALSE ) )
+			{
+				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( &xTaskPoolFreeList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+				/* Note the task came from the pool so deleting it returns the
+				slot rather than freeing memory. */
+				pxTCB->ucStaticallyAllocated = tskTASK_POOL_STACK_AND_TCB;
+				ulTaskPoolHits++;
+
+				if( listCURRENT_LIST_LENGTH( &xTaskPoolFreeList ) < uxTaskPoolMinimumEverFreeSlots )
+				{
+					uxTaskPoolMinimumEverFreeSlots = listCURRENT_LIST_LENGTH( &xTaskPoolFreeList );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				ulTaskPoolMisses++;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return pxTCB;
+	}
+
+#endif /* configUSE_TASK_POOL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_POOL == 1 )
+
+	void vTaskGetPoolStats( TaskPoolStats_t *pxPoolStats )
+	{
+		configASSERT( pxPoolStats );
+
+		taskENTER_CRITICAL();
+		{
+			pxPoolStats->uxNumberOfSlots = ( UBaseType_t ) configTASK_POOL_SLOTS;
+
+			/* The free list is only created when the first task is created. */
+			if( xTaskPoolInitialised != pdFALSE )
+			{
+				pxPoolStats->uxNumberOfFreeSlots = listCURRENT_LIST_LENGTH( &xTaskPoolFreeList );
+			}
+			else
+			{
+				pxPoolStats->uxNumberOfFreeSlots = ( UBaseType_t ) configTASK_POOL_SLOTS;
+			}
+
+			pxPoolStats->uxMinimumEverFreeSlots = uxTaskPoolMinimumEverFreeSlots;
+			pxPoolStats->ulHits = ulTaskPoolHits;
+			pxPoolStats->ulMisses = ulTaskPoolMisses;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_POOL */
+/*-----------------------------------------------------------*/
+
+static void prvResetNextTaskUnblockTime( void )
+{
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+TickType_t xTicksToNextEvent, xNextEventTime;
+
+	xTicksToNextEvent = prvTimingWheelTicksToNextEvent();
+	xNextEventTime = xTimingWheelTime + xTicksToNextEvent;
+
+	if( ( xTicksToNextEvent == portMAX_DELAY ) || ( xNextEventTime < xTickCount ) )
+	{
+		/* Either nothing is delayed, or the next event is only reached after
+		the tick count wraps - in which case it is picked up again when the
+		delayed lists are switched. */
+		xNextTaskUnblockTime = portMAX_DELAY;
+	}
+	else
+	{
+		xNextTaskUnblockTime = xNextEventTime;
+	}
+
+#else /* configUSE_TIMING_WHEEL */
+
+TCB_t *pxTCB;
+
+	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+	{
+		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+		the maximum possible value so it is	extremely unlikely that the
+		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+		there is an item in the delayed list. */
+		xNextTaskUnblockTime = portMAX_DELAY;
+	}
+	else
+	{
+		/* The new current delayed list is not empty, get the value of
+		the item at the head of the delayed list.  This is the time at
 		which the task at the head of the delayed list should be removed
 		from the Blocked state. */
 		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
 	}
+
+#endif /* configUSE_TIMING_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	static TickType_t prvTimingWheelInsert( ListItem_t * const pxStateListItem, const TickType_t xPosition )
+	{
+	const TickType_t xTicksAhead = xPosition - xTimingWheelTime;
+	UBaseType_t uxLevel = 0, uxSlot;
+
+		configASSERT( xTicksAhead < taskWHEEL_HORIZON );
+
+		/* Level n holds the tasks that are between 32^n and 32^(n+1) ticks
+		away.  The number of levels is fixed, so this loop is bounded. */
+		while( ( ( uxLevel + 1U ) < ( UBaseType_t ) configTIMING_WHEEL_LEVELS ) && ( xTicksAhead >= ( ( TickType_t ) 1 << taskWHEEL_LEVEL_SHIFT( uxLevel + 1U ) ) ) )
+		{
+			uxLevel++;
+		}
+
+		/* Slots are indexed by the absolute tick count rather than by the
+		distance from now, so the wheel never has to be rotated. */
+		uxSlot = ( UBaseType_t ) ( ( xPosition >> taskWHEEL_LEVEL_SHIFT( uxLevel ) ) & taskWHEEL_SLOT_MASK );
+		vListInsertEnd( &( xTimingWheel[ uxLevel ][ uxSlot ] ), pxStateListItem );
+		ulTimingWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+
+		/* A slot on level n is serviced when the tick count reaches the start
+		of the 32^n tick period it covers. */
+		return xPosition & ~( ( ( TickType_t ) 1 << taskWHEEL_LEVEL_SHIFT( uxLevel ) ) - ( TickType_t ) 1 );
+	}
+	/*-----------------------------------------------------------*/
+
+	static TickType_t prvTimingWheelTicksToNextEvent( void )
+	{
+	TickType_t xTicksToNextEvent = portMAX_DELAY, xTicksToBoundary, xTicksToSlot, xTicksAhead;
+	UBaseType_t uxLevel, uxFirstSlot, uxSlot, uxSteps;
+	uint32_t ulRotated;
+
+		for( uxLevel = 0; uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel++ )
+		{
+			/* The number of ticks until the next slot on this level starts, and
+			the index of that slot.  On level 0 a new slot starts every tick. */
+			xTicksToBoundary = ( ( ~xTimingWheelTime ) & ( ( ( TickType_t ) 1 << taskWHEEL_LEVEL_SHIFT( uxLevel ) ) - ( TickType_t ) 1 ) ) + ( TickType_t ) 1;
+			uxFirstSlot = ( UBaseType_t ) ( ( ( xTimingWheelTime + xTicksToBoundary ) >> taskWHEEL_LEVEL_SHIFT( uxLevel ) ) & taskWHEEL_SLOT_MASK );
+
+			while( ulTimingWheelOccupied[ uxLevel ] != 0UL )
+			{
+				/* Rotate the occupancy map so bit 0 is the next slot, then find
+				the first slot that might hold a task. */
+				ulRotated = ulTimingWheelOccupied[ uxLevel ];
+
+				if( uxFirstSlot != 0U )
+				{
+					ulRotated = ( ulRotated >> uxFirstSlot ) | ( ulRotated << ( taskWHEEL_SLOTS - uxFirstSlot ) );
+				}
+
+				#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+				{
+					/* Isolate the lowest set bit, then use the port's count
+					leading zeros helper to find its position. */
+					ulRotated &= ( ~ulRotated + 1UL );
+					portGET_HIGHEST_PRIORITY( uxSteps, ulRotated );
+				}
+				#else
+				{
+					for( uxSteps = 0; ( ulRotated & ( 1UL << uxSteps ) ) == 0UL; uxSteps++ )
+					{
+						/* Nothing to do, the loop condition finds the bit. */
+					}
+				}
+				#endif
+
+				uxSlot = ( uxFirstSlot + uxSteps ) & ( UBaseType_t ) taskWHEEL_SLOT_MASK;
+
+				if( listLIST_IS_EMPTY( &( xTimingWheel[ uxLevel ][ uxSlot ] ) ) != pdFALSE )
+				{
+					/* The tasks that were in this slot left the Blocked state
+					for a reason other than a timeout. */
+					ulTimingWheelOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+				}
+				else
+				{
+					xTicksToSlot = xTicksToBoundary + ( ( TickType_t ) uxSteps << taskWHEEL_LEVEL_SHIFT( uxLevel ) );
+
+					if( xTicksToSlot < xTicksToNextEvent )
+					{
+						xTicksToNextEvent = xTicksToSlot;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					break;
+				}
+			}
+		}
+
+		/* Tasks that are too far away to fit in the wheel must be moved into it
+		once their wake time comes within the horizon. */
+		if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+		{
+			xTicksAhead = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList ) - xTimingWheelTime;
+
+			if( xTicksAhead >= taskWHEEL_HORIZON )
+			{
+				xTicksToSlot = ( xTicksAhead - taskWHEEL_HORIZON ) + ( TickType_t ) 1;
+			}
+			else
+			{
+				/* Only possible just after the delayed lists have been
+				switched. */
+				xTicksToSlot = ( TickType_t ) 1;
+			}
+
+			if( xTicksToSlot < xTicksToNextEvent )
+			{
+				xTicksToNextEvent = xTicksToSlot;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xTicksToNextEvent;
+	}
+	/*-----------------------------------------------------------*/
+
+	static List_t * prvTimingWheelAdvance( void )
+	{
+	const TickType_t xConstTickCount = xTimingWheelTime;
+	ListItem_t *pxItem;
+	List_t *pxSlot;
+	UBaseType_t uxLevel, uxSlot;
+
+		/* Bring in tasks from the delayed list that have come within the
+		horizon.  The delayed list is sorted, so this stops at the first task
+		that is still too far away. */
+		while( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+		{
+			pxItem = listGET_HEAD_ENTRY( pxDelayedTaskList );
+
+			if( ( TickType_t ) ( listGET_LIST_ITEM_VALUE( pxItem ) - xConstTickCount ) >= taskWHEEL_HORIZON )
+			{
+				break;
+			}
+
+			( void ) uxListRemove( pxItem );
+			( void ) prvTimingWheelInsert( pxItem, listGET_LIST_ITEM_VALUE( pxItem ) );
+		}
+
+		/* When this tick starts a new slot on an outer level, spread the tasks
+		from that slot over the levels below it.  Each task is moved at most
+		once per level during its delay. */
+		for( uxLevel = ( UBaseType_t ) ( configTIMING_WHEEL_LEVELS - 1 ); uxLevel > 0U; uxLevel-- )
+		{
+			if( ( xConstTickCount & ( ( ( TickType_t ) 1 << taskWHEEL_LEVEL_SHIFT( uxLevel ) ) - ( TickType_t ) 1 ) ) == ( TickType_t ) 0 )
+			{
+				uxSlot = ( UBaseType_t ) ( ( xConstTickCount >> taskWHEEL_LEVEL_SHIFT( uxLevel ) ) & taskWHEEL_SLOT_MASK );
+				pxSlot = &( xTimingWheel[ uxLevel ][ uxSlot ] );
+
+				while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+				{
+					pxItem = listGET_HEAD_ENTRY( pxSlot );
+					( void ) uxListRemove( pxItem );
+					( void ) prvTimingWheelInsert( pxItem, listGET_LIST_ITEM_VALUE( pxItem ) );
+				}
+
+				ulTimingWheelOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* The caller empties the level 0 slot for this tick. */
+		uxSlot = ( UBaseType_t ) ( xConstTickCount & taskWHEEL_SLOT_MASK );
+		ulTimingWheelOccupied[ 0 ] &= ~( 1UL << uxSlot );
+
+		return &( xTimingWheel[ 0 ][ uxSlot ] );
+	}
+
+#endif /* configUSE_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BATCHED_WAKEUPS == 1 )
+
+	static BaseType_t prvReadyDueTasks( List_t * const pxList, const TickType_t xConstTickCount, const UBaseType_t uxLimit )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxReadied = ( UBaseType_t ) 0;
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		pxExpiringTaskList = NULL;
+
+		while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+		{
+			pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+			/* A timing wheel slot only holds tasks that wake on the tick it
+			was serviced for, but the delayed list is sorted by wake time and
+			the first task that is not yet due ends the run. */
+			#if ( configUSE_TIMING_WHEEL == 0 )
+			{
+				if( xConstTickCount < listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) )
+				{
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#else
+			{
+				( void ) xConstTickCount;
+			}
+			#endif /* configUSE_TIMING_WHEEL */
+
+			if( uxReadied == uxLimit )
+			{
+				pxExpiringTaskList = pxList;
+
+				/* The priorities of the tasks left behind are not known, so
+				the context switch that makes them ready must run. */
+				#if ( configUSE_PREEMPTION == 1 )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				#endif
+
+				break;
+			}
+			else
+			{
+				uxReadied++;
+			}
+
+			/* It is time to remove the item from the Blocked state. */
+			( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+			/* Is the task waiting on an event also?  If so remove it from the
+			event list. */
+			if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+			{
+				( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvAddTaskToReadyList( pxTCB );
+
+			/* A task being unblocked cannot cause an immediate context switch
+			if preemption is turned off. */
+			#if ( configUSE_PREEMPTION == 1 )
+			{
+				if( taskYIELD_FOR_TASK( pxTCB, pdTRUE ) != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_PREEMPTION */
+		}
+
+		return xSwitchRequired;
+	}
+
+#endif /* configUSE_BATCHED_WAKEUPS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvInsertEDFReadyTask( TCB_t *pxTCB, ListItem_t *pxFrom )
+	{
+	List_t * const pxReadyList = &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] );
+	ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+	ListItem_t *pxIterator;
+
+		/* Tasks with the same deadline stay in the order they were inserted
+		in. */
+		for( pxIterator = pxFrom; pxIterator != ( ListItem_t * ) listGET_END_MARKER( pxReadyList ); pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		{
+			if( taskEDF_EARLIER( pxTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) ) != pdFALSE )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* Insert the new item in front of pxIterator. */
+		pxNewListItem->pxNext = pxIterator;
+		pxNewListItem->pxPrevious = pxIterator->pxPrevious;
+		pxIterator->pxPrevious->pxNext = pxNewListItem;
+		pxIterator->pxPrevious = pxNewListItem;
+		pxNewListItem->pxContainer = pxReadyList;
+
+		( pxReadyList->uxNumberOfItems )++;
+	}
+/*-----------------------------------------------------------*/
+
+	static void prvReorderEDFReadyTask( TCB_t *pxTCB )
+	{
+		/* The task stays in the list, so its priority is still recorded as
+		ready whatever uxListRemove() returns. */
+		( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+		prvInsertEDFReadyTask( pxTCB, listGET_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ) ) );
+	}
+/*-----------------------------------------------------------*/
+
+	#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+
+		static BaseType_t prvEDFOtherTaskReady( void )
+		{
+		ListItem_t const * const pxHeadItem = listGET_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ) );
+		ListItem_t const *pxNextItem;
+		BaseType_t xReturn;
+
+			/* The list is in deadline order and the running task is in it, so
+			another task ready with a deadline no later than its own is either at
+			the head or straight after it. */
+			if( pxHeadItem != &( pxCurrentTCB->xStateListItem ) )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				pxNextItem = listGET_NEXT( pxHeadItem );
+
+				if( ( pxNextItem != listGET_END_MARKER( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ) ) ) && ( taskEDF_EARLIER( pxCurrentTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxNextItem ) ) == pdFALSE ) )
+				{
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					xReturn = pdFALSE;
+				}
+			}
+
+			return xReturn;
+		}
+
+	#endif /* ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) */
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskEDFRegister( TaskHandle_t xTask, const TickType_t xPeriod, const TickType_t xRelativeDeadline )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( xPeriod > ( TickType_t ) 0U );
+		configASSERT( ( xRelativeDeadline > ( TickType_t ) 0U ) && ( xRelativeDeadline < taskEDF_HALF_RANGE ) );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* Only tasks in the EDF priority are scheduled by deadline. */
+			configASSERT( pxTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY );
+
+			/* The first job is released now. */
+			pxTCB->xEDFPeriod = xPeriod;
+			pxTCB->xEDFRelativeDeadline = xRelativeDeadline;
+			pxTCB->xEDFAbsoluteDeadline = xTickCount + xRelativeDeadline;
+
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+			{
+				prvReorderEDFReadyTask( pxTCB );
+
+				/* The new deadline may have changed which task should be
+				running. */
+				if( ( xSchedulerRunning != pdFALSE ) &&
+					( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) &&
+					( listGET_LIST_ITEM_OWNER( listGET_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ) ) ) != pxCurrentTCB ) )
+				{
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskEDFWaitForNextPeriod( TickType_t * const pxPreviousReleaseTime )
+	{
+		configASSERT( pxCurrentTCB->xEDFRelativeDeadline != ( TickType_t ) 0U );
+
+		/* vTaskDelayUntil() sets the deadline of the next job. */
+		vTaskDelayUntil( pxPreviousReleaseTime, pxCurrentTCB->xEDFPeriod );
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	TickType_t xTaskEDFGetDeadline( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	TickType_t xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			xReturn = pxTCB->xEDFAbsoluteDeadline;
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
 
 	TaskHandle_t xTaskGetCurrentTaskHandle( void )
@@ -3981,6 +6551,17 @@ TCB_t *pxTCB;
 #endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+	TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+	{
+		configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+		return pxCurrentTCBs[ xCoreID ];
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xTaskGetSchedulerState( void )
@@ -4045,9 +6626,9 @@ TCB_t *pxTCB;
 					if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 					{
 						/* It is known that the task is in its ready list so
-						there is no need to check again and the port level
-						reset macro can be called directly. */
-						portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
+						there is no need to check again and
+						taskCLEAR_READY_PRIORITY() can be called directly. */
+						taskCLEAR_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
 					}
 					else
 					{
@@ -4066,6 +6647,15 @@ TCB_t *pxTCB;
 
 				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
 
+				#if ( configPRIORITY_INHERITANCE_DEPTH > 1 )
+				{
+					/* The mutex holder might itself be blocked on a mutex, in
+					which case the holder of that mutex must also run at the
+					inherited priority for the mutex holder to make progress. */
+					prvPropagateInheritedPriority( pxMutexHolderTCB );
+				}
+				#endif
+
 				/* Inheritance occurred. */
 				xReturn = pdTRUE;
 			}
@@ -4249,9 +6839,9 @@ TCB_t *pxTCB;
 						if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 						{
 							/* It is known that the task is in its ready list so
-							there is no need to check again and the port level
-							reset macro can be called directly. */
-							portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+							there is no need to check again and
+							taskCLEAR_READY_PRIORITY() can be called directly. */
+							taskCLEAR_READY_PRIORITY( pxTCB->uxPriority );
 						}
 						else
 						{
@@ -4264,6 +6854,14 @@ TCB_t *pxTCB;
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
+
+					#if ( configPRIORITY_INHERITANCE_DEPTH > 1 )
+					{
+						/* Pass the lowered priority on to the holder of any
+						mutex the mutex holder is itself blocked on. */
+						prvPropagateInheritedPriority( pxTCB );
+					}
+					#endif
 				}
 				else
 				{
@@ -4284,14 +6882,144 @@ TCB_t *pxTCB;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+
+	void vTaskSetBlockingMutexHolder( TaskHandle_t * const pxMutexHolder )
+	{
+		/* Only the running task sets its own blocking mutex, so no critical
+		section is needed.  The pointer is only followed while the task's event
+		list item is in the list of tasks waiting for the mutex. */
+		pxCurrentTCB->pxBlockingMutexHolder = pxMutexHolder;
+	}
+
+#endif /* configPRIORITY_INHERITANCE_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+
+	static void prvPropagateInheritedPriority( TCB_t *pxTCB )
+	{
+	TCB_t *pxHolderTCB;
+	List_t *pxMutexWaitingList;
+	UBaseType_t uxDepth, uxPriorityToUse, uxPriorityUsedOnEntry;
+
+		for( uxDepth = ( UBaseType_t ) 1; uxDepth < ( UBaseType_t ) configPRIORITY_INHERITANCE_DEPTH; uxDepth++ )
+		{
+			/* Nothing more to do if pxTCB is not blocked on a mutex. */
+			pxMutexWaitingList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+			if( ( pxTCB->pxBlockingMutexHolder == NULL ) || ( pxMutexWaitingList == NULL ) )
+			{
+				break;
+			}
+
+			/* The event list item value of pxTCB already reflects its new
+			priority, so re-sort it within the list of tasks waiting for the
+			mutex.  The highest priority waiting task is the one that obtains
+			the mutex when it is given back. */
+			( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+			vListInsert( pxMutexWaitingList, &( pxTCB->xEventListItem ) );
+
+			pxHolderTCB = *( pxTCB->pxBlockingMutexHolder );
+
+			if( pxHolderTCB == NULL )
+			{
+				break;
+			}
+
+			/* The holder should run at the greater of its base priority and
+			the priority of the highest priority task waiting for the mutex. */
+			uxPriorityToUse = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxMutexWaitingList );
+
+			if( uxPriorityToUse < pxHolderTCB->uxBasePriority )
+			{
+				uxPriorityToUse = pxHolderTCB->uxBasePriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* As in vTaskPriorityDisinheritAfterTimeout(), only lower the
+			priority of a holder that does not hold other mutexes, as the other
+			mutexes may have caused the inheritance. */
+			if( ( uxPriorityToUse == pxHolderTCB->uxPriority ) ||
+				( ( uxPriorityToUse < pxHolderTCB->uxPriority ) && ( pxHolderTCB->uxMutexesHeld != ( UBaseType_t ) 1 ) ) )
+			{
+				break;
+			}
+
+			uxPriorityUsedOnEntry = pxHolderTCB->uxPriority;
+
+			if( uxPriorityToUse > uxPriorityUsedOnEntry )
+			{
+				traceTASK_PRIORITY_INHERIT( pxHolderTCB, uxPriorityToUse );
+			}
+			else
+			{
+				traceTASK_PRIORITY_DISINHERIT( pxHolderTCB, uxPriorityToUse );
+			}
+
+			if( ( listGET_LIST_ITEM_VALUE( &( pxHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+			{
+				listSET_LIST_ITEM_VALUE( &( pxHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxHolderTCB->xStateListItem ) ) != pdFALSE )
+			{
+				if( uxListRemove( &( pxHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+				{
+					taskCLEAR_READY_PRIORITY( uxPriorityUsedOnEntry );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxHolderTCB->uxPriority = uxPriorityToUse;
+				prvAddTaskToReadyList( pxHolderTCB );
+			}
+			else
+			{
+				pxHolderTCB->uxPriority = uxPriorityToUse;
+			}
+
+			pxTCB = pxHolderTCB;
+		}
+	}
+
+#endif /* configPRIORITY_INHERITANCE_DEPTH */
+/*-----------------------------------------------------------*/
+
 #if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
 	void vTaskEnterCritical( void )
 	{
 		portDISABLE_INTERRUPTS();
 
-		if( xSchedulerRunning != pdFALSE )
-		{
+		if( xSchedulerRunning != pdFALSE )
+		{
+			#if ( configNUMBER_OF_CORES > 1 )
+			{
+				/* The task lock keeps the other cores' tasks, and the ISR lock
+				their interrupts, out of the kernel.  Both are only taken on
+				entry to the outermost critical section. */
+				if( pxCurrentTCB->uxCriticalNesting == 0U )
+				{
+					portGET_TASK_LOCK();
+					portGET_ISR_LOCK();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configNUMBER_OF_CORES */
+
 			( pxCurrentTCB->uxCriticalNesting )++;
 
 			/* This is not the interrupt safe version of the enter critical
@@ -4326,6 +7054,13 @@ TCB_t *pxTCB;
 
 				if( pxCurrentTCB->uxCriticalNesting == 0U )
 				{
+					#if ( configNUMBER_OF_CORES > 1 )
+					{
+						portRELEASE_ISR_LOCK();
+						portRELEASE_TASK_LOCK();
+					}
+					#endif /* configNUMBER_OF_CORES */
+
 					portENABLE_INTERRUPTS();
 				}
 				else
@@ -4347,6 +7082,50 @@ TCB_t *pxTCB;
 #endif /* portCRITICAL_NESTING_IN_TCB */
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+	UBaseType_t uxTaskEnterCriticalFromISR( void )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+		/* The ISR lock may already be held by this core, if the interrupt
+		is nested or was taken from a task level critical section. */
+		if( xSchedulerRunning != pdFALSE )
+		{
+			portGET_ISR_LOCK();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxSavedInterruptStatus;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
+	{
+		if( xSchedulerRunning != pdFALSE )
+		{
+			portRELEASE_ISR_LOCK();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	static char *prvWriteNameToBuffer( char *pcBuffer, const char *pcTaskName )
@@ -4632,17 +7411,19 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskNotifyTakeIndexed( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4670,17 +7451,17 @@ TickType_t uxReturn;
 		taskENTER_CRITICAL();
 		{
 			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4688,7 +7469,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4700,22 +7481,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskNotifyWaitIndexed( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4748,14 +7531,14 @@ TickType_t uxReturn;
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
 			}
 
 			/* If ucNotifyValue is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4764,11 +7547,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4778,46 +7561,129 @@ TickType_t uxReturn;
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_MICROSECOND_DELAYS == 1 ) )
+
+	BaseType_t xTaskNotifyWaitIndexedMicroseconds( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, uint32_t ulMicrosecondsToWait )
+	{
+	BaseType_t xReturn;
+
+		configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if a notification is not already pending. */
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
+			{
+				/* Clear bits in the task's notification value as bits may get
+				set	by the notifying task or interrupt.  This can be used to
+				clear the value to zero. */
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnEntry;
+
+				/* Mark this task as waiting for a notification. */
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
+
+				if( ulMicrosecondsToWait > 0UL )
+				{
+					prvAddCurrentTaskToMicrosecondDelayList( ulMicrosecondsToWait );
+					traceTASK_NOTIFY_WAIT_BLOCK();
+
+					/* All ports are written to allow a yield in a critical
+					section (some will yield immediately, others wait until the
+					critical section exits) - but it is not something that
+					application code should ever do. */
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			traceTASK_NOTIFY_WAIT();
+
+			if( pulNotificationValue != NULL )
+			{
+				/* Output the current notification value, which may or may not
+				have changed. */
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
+			}
+
+			/* If ucNotifyValue is set then either the task never entered the
+			blocked state (because a notification was already pending) or the
+			task unblocked because of a notification.  Otherwise the task
+			unblocked because of a timeout. */
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
+			{
+				/* A notification was not received. */
+				xReturn = pdFALSE;
+			}
+			else
+			{
+				/* A notification was already pending or a notification was
+				received while the task was waiting. */
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnExit;
+				xReturn = pdTRUE;
+			}
+
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS && configUSE_MICROSECOND_DELAYS */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotifyIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4835,7 +7701,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 
 					break;
 			}
@@ -4850,6 +7716,7 @@ TickType_t uxReturn;
 				prvAddTaskToReadyList( pxTCB );
 
 				/* The task should not have been on an event list. */
+				taskCANCEL_MICROSECOND_TIMEOUT( pxTCB );
 				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
 				#if( configUSE_TICKLESS_IDLE != 0 )
@@ -4868,7 +7735,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskYIELD_FOR_TASK( pxTCB, pdFALSE ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4894,7 +7761,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4902,6 +7769,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4923,34 +7791,34 @@ TickType_t uxReturn;
 
 		pxTCB = xTaskToNotify;
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4968,7 +7836,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 					break;
 			}
 
@@ -4979,6 +7847,7 @@ TickType_t uxReturn;
 			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
 			{
 				/* The task should not have been on an event list. */
+				taskCANCEL_MICROSECOND_TIMEOUT( pxTCB );
 				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
 				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
@@ -4993,7 +7862,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskYIELD_FOR_TASK( pxTCB, pdFALSE ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5013,7 +7882,7 @@ TickType_t uxReturn;
 				}
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xReturn;
 	}
@@ -5023,13 +7892,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskNotifyGiveIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -5051,14 +7921,14 @@ TickType_t uxReturn;
 
 		pxTCB = xTaskToNotify;
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
@@ -5067,6 +7937,7 @@ TickType_t uxReturn;
 			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
 			{
 				/* The task should not have been on an event list. */
+				taskCANCEL_MICROSECOND_TIMEOUT( pxTCB );
 				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
 				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
@@ -5081,7 +7952,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskYIELD_FOR_TASK( pxTCB, pdFALSE ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5101,7 +7972,7 @@ TickType_t uxReturn;
 				}
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 	}
 
 #endif /* configUSE_TASK_NOTIFICATIONS */
@@ -5109,20 +7980,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskNotifyStateClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
@@ -5140,11 +8013,13 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear )
+	uint32_t ulTaskNotifyValueClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear )
 	{
 	TCB_t *pxTCB;
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
@@ -5153,8 +8028,8 @@ TickType_t uxReturn;
 		{
 			/* Return the notification as it was before the bits were cleared,
 			then clear the bit mask. */
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
-			pxTCB->ulNotifiedValue &= ~ulBitsToClear;
+			ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
+			pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
 		}
 		taskEXIT_CRITICAL();
 
@@ -5168,12 +8043,120 @@ TickType_t uxReturn;
 
 	uint32_t ulTaskGetIdleRunTimeCounter( void )
 	{
-		return xIdleTaskHandle->ulRunTimeCounter;
+		#if ( configNUMBER_OF_CORES == 1 )
+		{
+			return xIdleTaskHandle->ulRunTimeCounter;
+		}
+		#else
+		{
+		uint32_t ulReturn = 0UL;
+		BaseType_t xCoreID;
+
+			/* The total for all the idle tasks. */
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				ulReturn += xIdleTaskHandles[ xCoreID ]->ulRunTimeCounter;
+			}
+
+			return ulReturn;
+		}
+		#endif /* configNUMBER_OF_CORES */
 	}
 
 #endif
 /*-----------------------------------------------------------*/
 
+#if( configGENERATE_RUN_TIME_CYCLE_STATS == 1 )
+
+	uint64_t ullTaskGetRunTimeCycles( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	uint64_t ullReturn;
+
+		/* The counters are 64-bit so cannot be read atomically, and the
+		running task's counter is updated from the tick interrupt. */
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then the cycle count of the calling
+			task is being queried. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* Include the cycles used by the running task since the last tick
+			or context switch. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				taskUPDATE_RUN_TIME_CYCLES();
+			}
+
+			ullReturn = pxTCB->ullRunTimeCycles;
+		}
+		taskEXIT_CRITICAL();
+
+		return ullReturn;
+	}
+
+#endif /* configGENERATE_RUN_TIME_CYCLE_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_RUN_TIME_CYCLE_STATS == 1 )
+
+	uint64_t ullTaskGetTotalRunTimeCycles( void )
+	{
+	uint64_t ullReturn;
+
+		taskENTER_CRITICAL();
+		{
+			if( xSchedulerRunning != pdFALSE )
+			{
+				taskUPDATE_RUN_TIME_CYCLES();
+			}
+
+			ullReturn = ullTotalRunTimeCycles;
+		}
+		taskEXIT_CRITICAL();
+
+		return ullReturn;
+	}
+
+#endif /* configGENERATE_RUN_TIME_CYCLE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	static void prvAddCurrentTaskToTimingWheel( const TickType_t xTimeToWake )
+	{
+	TickType_t xServiceTime;
+
+		if( xTimeToWake == xTimingWheelTime )
+		{
+			/* A zero tick block time.  The slot for the current tick has
+			already been serviced, so use the next one - which matches the
+			sorted delayed list, where the task would be removed on the next
+			tick. */
+			xServiceTime = prvTimingWheelInsert( &( pxCurrentTCB->xStateListItem ), xTimeToWake + ( TickType_t ) 1 );
+		}
+		else
+		{
+			xServiceTime = prvTimingWheelInsert( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+		}
+
+		/* If the slot has to be serviced before anything else in the wheel
+		then xNextTaskUnblockTime needs to be updated too.  A service time that
+		is lower than the tick count is after the tick count wraps, and is
+		found again when the delayed lists are switched. */
+		if( ( xServiceTime >= xTickCount ) && ( xServiceTime < xNextTaskUnblockTime ) )
+		{
+			xNextTaskUnblockTime = xServiceTime;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
 {
 TickType_t xTimeToWake;
@@ -5193,8 +8176,8 @@ const TickType_t xConstTickCount = xTickCount;
 	if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 	{
 		/* The current task must be in a ready list, so there is no need to
-		check, and the port reset macro can be called directly. */
-		portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
+		check, and taskCLEAR_READY_PRIORITY() can be called directly. */
+		taskCLEAR_READY_PRIORITY( pxCurrentTCB->uxPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
 	}
 	else
 	{
@@ -5220,6 +8203,13 @@ const TickType_t xConstTickCount = xTickCount;
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+			#if ( configUSE_TIMING_WHEEL == 1 )
+				if( xTicksToWait < taskWHEEL_HORIZON )
+				{
+					prvAddCurrentTaskToTimingWheel( xTimeToWake );
+				}
+				else
+			#endif /* configUSE_TIMING_WHEEL */
 			if( xTimeToWake < xConstTickCount )
 			{
 				/* Wake time has overflowed.  Place this item in the overflow
@@ -5256,6 +8246,13 @@ const TickType_t xConstTickCount = xTickCount;
 		/* The list item will be inserted in wake time order. */
 		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+		#if ( configUSE_TIMING_WHEEL == 1 )
+			if( xTicksToWait < taskWHEEL_HORIZON )
+			{
+				prvAddCurrentTaskToTimingWheel( xTimeToWake );
+			}
+			else
+		#endif /* configUSE_TIMING_WHEEL */
 		if( xTimeToWake < xConstTickCount )
 		{
 			/* Wake time has overflowed.  Place this item in the overflow list. */
@@ -5284,6 +8281,147 @@ const TickType_t xConstTickCount = xTickCount;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 }
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MICROSECOND_DELAYS == 1 )
+
+	static void prvAddCurrentTaskToMicrosecondDelayList( const uint32_t ulMicrosecondsToWait )
+	{
+	const uint32_t ulAlarm = configMICROSECOND_TIMER_COUNT() + ulMicrosecondsToWait;
+
+		/* Alarms are compared by their signed distance from the counter. */
+		configASSERT( ulMicrosecondsToWait < 0x80000000UL );
+
+		/* The task is held in the delayed lists as well, so it is still
+		unblocked by the tick if the alarm interrupt is not serviced.  Three
+		extra ticks make sure that can only happen after the alarm time.  The
+		first tick may already be pending, and the second may be due at any
+		point in its period. */
+		prvAddCurrentTaskToDelayedList( ( TickType_t ) ( ulMicrosecondsToWait / taskMICROSECONDS_PER_TICK ) + ( TickType_t ) 3, pdFALSE );
+
+		/* The event list item is not otherwise used while a task waits for a
+		delay or a notification. */
+		pxCurrentTCB->ulMicrosecondAlarm = ulAlarm;
+		vListInsertEnd( &xMicrosecondDelayList, &( pxCurrentTCB->xEventListItem ) );
+
+		if( ( xMicrosecondAlarmSet == pdFALSE ) || ( ( int32_t ) ( ulAlarm - ulMicrosecondAlarm ) < 0 ) )
+		{
+			ulMicrosecondAlarm = ulAlarm;
+			xMicrosecondAlarmSet = pdTRUE;
+			configMICROSECOND_TIMER_SET_ALARM( ulAlarm );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xTaskMicrosecondAlarmFromISR( void )
+	{
+	ListItem_t const * const pxEndMarker = listGET_END_MARKER( &xMicrosecondDelayList );
+	ListItem_t *pxIterator, *pxNext;
+	TCB_t *pxTCB;
+	uint32_t ulNow, ulNextAlarm = 0UL;
+	BaseType_t xSwitchRequired = pdFALSE, xNextAlarmSet = pdFALSE;
+	UBaseType_t uxSavedInterruptStatus;
+
+		/* The alarm interrupt must not have a priority above
+		configMAX_SYSCALL_INTERRUPT_PRIORITY, see the comments in
+		xTaskGenericNotifyFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			ulNow = configMICROSECOND_TIMER_COUNT();
+
+			/* The list only holds the tasks blocked with a microsecond delay,
+			so it is short and is simply searched. */
+			for( pxIterator = listGET_HEAD_ENTRY( &xMicrosecondDelayList ); pxIterator != pxEndMarker; pxIterator = pxNext )
+			{
+				pxNext = listGET_NEXT( pxIterator );
+				pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+				if( ( int32_t ) ( pxTCB->ulMicrosecondAlarm - ulNow ) <= 0 )
+				{
+					( void ) uxListRemove( pxIterator );
+
+					if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+					{
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+						prvAddTaskToReadyList( pxTCB );
+					}
+					else
+					{
+						/* The delayed and ready lists cannot be accessed, so
+						hold this task pending until the scheduler is
+						resumed. */
+						vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+
+						#if( configUSE_TASK_NOTIFICATIONS == 1 )
+						{
+						UBaseType_t x;
+
+							/* The event list item is now in xPendingReadyList,
+							so a notification that arrives before the scheduler
+							is resumed must not try to unblock the task again.
+							The wait has timed out, so no notification was
+							received while the task was waiting. */
+							for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+							{
+								if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+								{
+									pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+								}
+							}
+						}
+						#endif
+					}
+
+					if( taskYIELD_FOR_TASK( pxTCB, pdFALSE ) != pdFALSE )
+					{
+						/* Mark that a yield is pending in case the interrupt
+						handler does not yield. */
+						xSwitchRequired = pdTRUE;
+						xYieldPending = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( ( xNextAlarmSet == pdFALSE ) || ( ( pxTCB->ulMicrosecondAlarm - ulNow ) < ( ulNextAlarm - ulNow ) ) )
+				{
+					ulNextAlarm = pxTCB->ulMicrosecondAlarm;
+					xNextAlarmSet = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			/* If the alarm was set for the task that woke first it now has to
+			be moved on to the next one.  The alarm is left alone if no task is
+			waiting, in which case it fires once more to no effect. */
+			if( xNextAlarmSet != pdFALSE )
+			{
+				ulMicrosecondAlarm = ulNextAlarm;
+				configMICROSECOND_TIMER_SET_ALARM( ulNextAlarm );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xMicrosecondAlarmSet = xNextAlarmSet;
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		return xSwitchRequired;
+	}
+
+#endif /* configUSE_MICROSECOND_DELAYS */
 
 /* Code below here allows additional code to be inserted into this source file,
 especially where access to file scope functions and data is needed (for example
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""Decode heap_telemetry frames into a readable report.
+
+Capture the output of HeapTelemetry_Dump() from the ST-LINK virtual COM
+port, for example on Linux:
+
+    stty -F /dev/ttyACM0 115200 raw -echo
+    cat /dev/ttyACM0 > heap.bin
+
+then print every frame found in the capture:
+
+    python3 heap_telemetry_decode.py heap.bin
+
+Failure call sites are printed as addresses; pass the firmware with --elf to
+resolve them with arm-none-eabi-addr2line.
+
+The frame layout must match Core/Src/heap_telemetry.c.
+"""
+
+import argparse
+import struct
+import subprocess
+import sys
+
+MAGIC = b"HT"
+VERSION = 1
+HEADER = struct.Struct("<2sBH")  # magic, version, payload length
+CHECKSUM = struct.Struct("<BB")
+
+
+def fletcher16(data):
+    sum1 = sum2 = 0
+    for byte in data:
+        sum1 = (sum1 + byte) % 255
+        sum2 = (sum2 + sum1) % 255
+    return sum1, sum2
+
+
+class Payload:
+    """Reads unsigned LEB128 numbers from a frame payload."""
+
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def number(self):
+        value = shift = 0
+        while True:
+            byte = self.data[self.offset]
+            self.offset += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if byte < 0x80:
+                return value
+
+    def numbers(self, count):
+        return [self.number() for _ in range(count)]
+
+
+def frames(data):
+    """Yield the payload of every frame with a valid checksum."""
+    offset = data.find(MAGIC)
+    while offset >= 0 and offset + HEADER.size <= len(data):
+        magic, version, length = HEADER.unpack_from(data, offset)
+        end = offset + HEADER.size + length
+        if version == VERSION and end + CHECKSUM.size <= len(data):
+            payload = data[offset + HEADER.size:end]
+            if CHECKSUM.unpack_from(data, end) == fletcher16(payload):
+                yield payload
+                offset = data.find(MAGIC, end + CHECKSUM.size)
+                continue
+        offset = data.find(MAGIC, offset + 1)
+
+
+def decode(payload):
+    p = Payload(payload)
+    frame = {}
+    frame["heap_size"], frame["clock"], frame["tick"] = p.numbers(3)
+    buckets, frame["shift"] = p.numbers(2)
+    frame["free_blocks"] = p.numbers(buckets)
+    frame["malloc_cycles"] = p.numbers(buckets)
+    frame["free_cycles"] = p.numbers(buckets)
+    frame["max_malloc"], frame["max_free"] = p.numbers(2)
+    frame["free_bytes"], frame["largest"] = p.numbers(2)
+    frame["fragmentation"], frame["worst_fragmentation"] = p.numbers(2)
+    frame["failures"] = p.number()
+    frame["records"] = []
+    for _ in range(p.number()):
+        caller, wanted, free, largest, tick = p.numbers(5)
+        frame["records"].append({"caller": caller, "wanted": wanted,
+                                 "free": free, "largest": largest,
+                                 "tick": tick})
+    return frame
+
+
+def bucket_label(index, count, shift):
+    low = 1 << (index + shift) if index else 0
+    if index == count - 1:
+        return "%d+" % low
+    return "%d-%d" % (low, (1 << (index + shift + 1)) - 1)
+
+
+def print_histogram(title, counts, shift, unit):
+    print("  %s" % title)
+    total = sum(counts)
+    if total == 0:
+        print("    (empty)")
+        return
+    peak = max(counts)
+    for index, count in enumerate(counts):
+        if count:
+            bar = "#" * max(1, count * 40 // peak)
+            print("    %16s %s %8d  %s" % (bucket_label(index, len(counts), shift),
+                                           unit, count, bar))
+
+
+def resolve(elf, addresses):
+    if not elf or not addresses:
+        return {}
+    command = ["arm-none-eabi-addr2line", "-f", "-p", "-e", elf]
+    command += ["0x%08x" % address for address in addresses]
+    try:
+        output = subprocess.run(command, capture_output=True, text=True,
+                                check=True).stdout.splitlines()
+    except (OSError, subprocess.CalledProcessError) as error:
+        print("addr2line failed: %s" % error, file=sys.stderr)
+        return {}
+    return dict(zip(addresses, output))
+
+
+def print_frame(frame, elf):
+    us_per_cycle = 1e6 / frame["clock"] if frame["clock"] else 0.0
+    print("heap %d bytes, tick %d, core clock %d Hz" %
+          (frame["heap_size"], frame["tick"], frame["clock"]))
+    print("  %d bytes free, largest free block %d bytes" %
+          (frame["free_bytes"], frame["largest"]))
+    print("  fragmentation %.1f%%, worst seen %.1f%%" %
+          (frame["fragmentation"] / 10.0, frame["worst_fragmentation"] / 10.0))
+    print_histogram("free blocks by size", frame["free_blocks"],
+                    frame["shift"], "bytes ")
+    print_histogram("pvPortMalloc() by duration (max %d cycles, %.1f us)" %
+                    (frame["max_malloc"], frame["max_malloc"] * us_per_cycle),
+                    frame["malloc_cycles"], frame["shift"], "cycles")
+    print_histogram("vPortFree() by duration (max %d cycles, %.1f us)" %
+                    (frame["max_free"], frame["max_free"] * us_per_cycle),
+                    frame["free_cycles"], frame["shift"], "cycles")
+
+    print("  %d failed allocations" % frame["failures"])
+    names = resolve(elf, [record["caller"] for record in frame["records"]])
+    for record in frame["records"]:
+        print("    tick %d: %d bytes from 0x%08x, %d free, largest %d%s" %
+              (record["tick"], record["wanted"], record["caller"],
+               record["free"], record["largest"],
+               ("  " + names[record["caller"]]) if record["caller"] in names else ""))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="captured byte stream, or - for stdin")
+    parser.add_argument("--elf", help="firmware to resolve call sites with")
+    parser.add_argument("--last", action="store_true",
+                        help="only print the last frame in the capture")
+    options = parser.parse_args()
+
+    if options.input == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(options.input, "rb") as f:
+            data = f.read()
+
+    decoded = [decode(payload) for payload in frames(data)]
+    if not decoded:
+        print("no heap telemetry frames found", file=sys.stderr)
+        sys.exit(1)
+    if options.last:
+        decoded = decoded[-1:]
+
+    for index, frame in enumerate(decoded):
+        if index:
+            print()
+        print_frame(frame, options.elf)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,65 @@
+#!/bin/sh
+# Run the QEMU build of the wake latency benchmark and check that it
+# completed.  Build the ELF first with
+#
+#     make -f latency_bench_qemu.mk
+#
+# or let "make -f latency_bench_qemu.mk run" build it and call this script.
+#
+#     Utilities/run_latency_bench_qemu.sh [ELF] [LOG]
+#
+# The report is printed and also written to LOG (default
+# QEMU/latency_bench.log).  The script fails if QEMU does not exit through
+# semihosting within LATENCY_BENCH_TIMEOUT seconds (default 600), or if the
+# report is incomplete.  It then prints which timestamp source the benchmark
+# used: QEMU does not count DWT cycles, so the SysTick fallback is expected.
+
+ELF=${1:-QEMU/05_04_Template.elf}
+LOG=${2:-QEMU/latency_bench.log}
+QEMU=${QEMU:-qemu-system-arm}
+TIMEOUT=${LATENCY_BENCH_TIMEOUT:-600}
+
+if [ ! -f "$ELF" ]; then
+    echo "$ELF not found, build it with: make -f latency_bench_qemu.mk" >&2
+    exit 1
+fi
+
+mkdir -p "$(dirname "$LOG")"
+
+# The benchmark ends with a semihosting exit, which makes QEMU exit with 0.
+{
+    timeout "$TIMEOUT" "$QEMU" -M netduinoplus2 -nographic -monitor none -serial null \
+        -semihosting-config enable=on,target=native -kernel "$ELF"
+    echo $? > "$LOG.status"
+} | tee "$LOG"
+status=$(cat "$LOG.status")
+rm -f "$LOG.status"
+
+if ! grep -q "^wake latency:" "$LOG"; then
+    echo "FAIL: no report header, the benchmark did not start" >&2
+    exit 1
+fi
+
+for primitive in "task notification" "binary semaphore" "queue" "event group" "stream buffer" \
+        "context switch"; do
+    if ! grep -q "^$primitive (" "$LOG"; then
+        echo "FAIL: no result for $primitive" >&2
+        exit 1
+    fi
+done
+
+if ! grep -q "^done" "$LOG"; then
+    echo "FAIL: the run did not complete within ${TIMEOUT} s" >&2
+    exit 1
+fi
+
+if grep -q "DWT cycle counter" "$LOG"; then
+    echo "timestamps: DWT cycle counter"
+else
+    echo "timestamps: SysTick counter (DWT fallback)"
+fi
+
+if [ "$status" -ne 0 ]; then
+    echo "FAIL: QEMU exited with status $status" >&2
+    exit 1
+fi
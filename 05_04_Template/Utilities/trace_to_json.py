@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+"""Convert a trace_recorder byte stream into Chrome trace JSON.
+
+Build the firmware with configUSE_TRACE_RECORDER=1 defined, then capture the
+stream from the ST-LINK virtual COM port, for example on Linux:
+
+    stty -F /dev/ttyACM0 115200 raw -echo
+    cat /dev/ttyACM0 > trace.bin
+
+then convert it and open the result in https://ui.perfetto.dev or
+chrome://tracing:
+
+    python3 trace_to_json.py trace.bin -o trace.json
+
+Each task gets its own track showing when it was running, with instant
+events for the queue, notification and delay operations it performed.
+Operations from interrupts are shown on an "ISR" track.
+
+The record layout and event numbers must match Core/Inc/trace_recorder.h.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+RECORD = struct.Struct("<IHBB")  # ulTimestamp, usObject, ucArg, ucEvent
+
+MAGIC = 0x5254
+VERSION = 1
+OBJECT_NONE = 0xFFFF
+RAM_BASE = 0x20000000
+
+EVT_HEADER = 1
+EVT_DROPPED = 2
+EVT_NAME = 3
+EVT_TASK_CREATE = 4
+EVT_TASK_DELETE = 5
+EVT_TASK_SWITCHED_IN = 6
+EVT_TASK_READY = 7
+EVT_TASK_DELAY = 8
+EVT_TASK_SUSPEND = 9
+EVT_TASK_RESUME = 10
+EVT_TASK_PRIORITY_SET = 11
+EVT_TASK_PRIORITY_INHERIT = 12
+EVT_TASK_NOTIFY = 13
+EVT_TASK_NOTIFY_FROM_ISR = 14
+EVT_TASK_NOTIFY_WAIT = 15
+EVT_QUEUE_CREATE = 16
+EVT_MUTEX_CREATE = 17
+EVT_QUEUE_SEND = 18
+EVT_QUEUE_SEND_FROM_ISR = 19
+EVT_QUEUE_SEND_FAILED = 20
+EVT_QUEUE_RECEIVE = 21
+EVT_QUEUE_RECEIVE_FROM_ISR = 22
+EVT_QUEUE_RECEIVE_FAILED = 23
+EVT_QUEUE_BLOCK_SEND = 24
+EVT_QUEUE_BLOCK_RECEIVE = 25
+EVT_LAST = EVT_QUEUE_BLOCK_RECEIVE
+
+# Events shown as instants on the track of the task that was running.
+TASK_CONTEXT = {
+    EVT_TASK_DELAY: "delay",
+    EVT_TASK_NOTIFY: "notify",
+    EVT_TASK_NOTIFY_WAIT: "wait notification",
+    EVT_QUEUE_SEND: "send",
+    EVT_QUEUE_SEND_FAILED: "send failed",
+    EVT_QUEUE_RECEIVE: "receive",
+    EVT_QUEUE_RECEIVE_FAILED: "receive failed",
+    EVT_QUEUE_BLOCK_SEND: "block on send",
+    EVT_QUEUE_BLOCK_RECEIVE: "block on receive",
+    EVT_TASK_SUSPEND: "suspend",
+    EVT_TASK_RESUME: "resume",
+    EVT_TASK_PRIORITY_SET: "priority set",
+    EVT_TASK_PRIORITY_INHERIT: "priority inherit",
+}
+
+# Events shown as instants on the ISR track.
+ISR_CONTEXT = {
+    EVT_TASK_NOTIFY_FROM_ISR: "notify from ISR",
+    EVT_QUEUE_SEND_FROM_ISR: "send from ISR",
+    EVT_QUEUE_RECEIVE_FROM_ISR: "receive from ISR",
+}
+
+PID = 1
+ISR_TID = 0
+
+
+def is_header(data, offset):
+    _, obj, arg, event = RECORD.unpack_from(data, offset)
+    return event == EVT_HEADER and obj == MAGIC and arg == VERSION
+
+
+def records(data):
+    """Yield (timestamp, object, arg, event) tuples, resynchronising on the
+    periodic header events whenever the stream does not decode."""
+    offset = 0
+    synced = False
+    skipped = 0
+    while offset + RECORD.size <= len(data):
+        if not synced:
+            if is_header(data, offset):
+                synced = True
+            else:
+                offset += 1
+                skipped += 1
+                continue
+        record = RECORD.unpack_from(data, offset)
+        if record[3] == 0 or record[3] > EVT_LAST:
+            synced = False
+            offset += 1
+            skipped += 1
+            continue
+        yield record
+        offset += RECORD.size
+    if skipped:
+        print("skipped %d bytes while synchronising" % skipped, file=sys.stderr)
+
+
+def object_label(obj):
+    return "0x%08x" % (RAM_BASE + (obj << 2))
+
+
+class Converter:
+    def __init__(self, clock_hz):
+        self.us_per_cycle = 1e6 / clock_hz
+        self.events = []
+        self.names = {}
+        self.pending_name = {}
+        self.queues = set()
+        self.running = None
+        self.running_since = None
+        self.last_raw = None
+        self.cycles = 0
+        self.dropped = 0
+
+    def timestamp(self, raw):
+        # The cycle counter is 32 bits wide.  Events are written every sync
+        # period, so the signed difference from the previous event is the
+        # elapsed time even across a wrap; a small negative difference comes
+        # from an interrupt that recorded an event while another was being
+        # written.
+        if self.last_raw is not None:
+            delta = (raw - self.last_raw) & 0xFFFFFFFF
+            if delta & 0x80000000:
+                delta -= 0x100000000
+            self.cycles += delta
+        self.last_raw = raw
+        return self.cycles * self.us_per_cycle
+
+    def name_of(self, obj):
+        return self.names.get(obj, object_label(obj))
+
+    def instant(self, ts, tid, name, args):
+        self.events.append({"ph": "i", "s": "t", "pid": PID, "tid": tid,
+                            "ts": ts, "name": name, "args": args})
+
+    def end_slice(self, ts):
+        if self.running is not None and ts > self.running_since:
+            self.events.append({"ph": "X", "pid": PID, "tid": self.running,
+                                "ts": self.running_since,
+                                "dur": ts - self.running_since,
+                                "name": "running"})
+
+    def add(self, raw, obj, arg, event):
+        if event == EVT_NAME:
+            # raw holds four characters rather than a timestamp.
+            chars = struct.pack("<I", raw)
+            if arg == 0:
+                self.pending_name[obj] = b""
+            self.pending_name[obj] = self.pending_name.get(obj, b"") + chars
+            self.names[obj] = self.pending_name[obj].split(b"\0")[0].decode(
+                "ascii", "replace")
+            return
+
+        ts = self.timestamp(raw)
+
+        if event == EVT_HEADER:
+            return
+        if event == EVT_DROPPED:
+            self.dropped += arg
+            self.instant(ts, ISR_TID, "events dropped", {"count": arg})
+            return
+        if event == EVT_TASK_SWITCHED_IN:
+            self.end_slice(ts)
+            self.running = obj
+            self.running_since = ts
+            return
+        if event == EVT_TASK_CREATE:
+            self.instant(ts, obj, "created", {"priority": arg})
+            return
+        if event == EVT_TASK_DELETE:
+            self.instant(ts, obj, "deleted", {})
+            return
+        if event == EVT_TASK_READY:
+            self.instant(ts, obj, "ready", {})
+            return
+        if event in (EVT_QUEUE_CREATE, EVT_MUTEX_CREATE):
+            self.queues.add(obj)
+            return
+
+        args = {"object": obj}
+        if event >= EVT_QUEUE_SEND:
+            args = {"queue": obj, "waiting": arg}
+        elif event in (EVT_TASK_PRIORITY_SET, EVT_TASK_PRIORITY_INHERIT):
+            args = {"task": obj, "priority": arg}
+        elif event != EVT_TASK_DELAY:
+            args = {"task": obj}
+
+        if event in ISR_CONTEXT:
+            self.instant(ts, ISR_TID, ISR_CONTEXT[event], args)
+        elif event in TASK_CONTEXT:
+            tid = self.running if self.running is not None else ISR_TID
+            self.instant(ts, tid, TASK_CONTEXT[event], args)
+
+    def finish(self):
+        if self.running is not None:
+            self.end_slice(self.cycles * self.us_per_cycle)
+
+        # Resolve object ids in the arguments now that all names are known.
+        for e in self.events:
+            for key in ("queue", "task", "object"):
+                if key in e.get("args", {}):
+                    e["args"][key] = self.name_of(e["args"][key])
+
+        tids = {ISR_TID} | {e["tid"] for e in self.events}
+        meta = [{"ph": "M", "pid": PID, "name": "process_name",
+                 "args": {"name": "FreeRTOS"}}]
+        for tid in sorted(tids):
+            name = "ISR" if tid == ISR_TID else self.name_of(tid)
+            meta.append({"ph": "M", "pid": PID, "tid": tid,
+                         "name": "thread_name", "args": {"name": name}})
+        return {"traceEvents": meta + self.events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="captured byte stream, or - for stdin")
+    parser.add_argument("-o", "--output", default="-",
+                        help="JSON file to write (default: stdout)")
+    parser.add_argument("--clock", type=float, default=84e6,
+                        help="core clock in Hz (default: 84e6)")
+    options = parser.parse_args()
+
+    if options.input == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(options.input, "rb") as f:
+            data = f.read()
+
+    converter = Converter(options.clock)
+    for record in records(data):
+        converter.add(*record)
+    trace = converter.finish()
+
+    if converter.dropped:
+        print("%d events were dropped on the target" % converter.dropped,
+              file=sys.stderr)
+
+    if options.output == "-":
+        json.dump(trace, sys.stdout)
+    else:
+        with open(options.output, "w") as f:
+            json.dump(trace, f)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,69 @@
+# Builds the wake latency benchmark (Core/Inc/latency_bench.h) for QEMU's
+# netduinoplus2 machine and runs it.  From this directory, with
+# arm-none-eabi-gcc and qemu-system-arm on the PATH:
+#
+#     make -f latency_bench_qemu.mk          build QEMU/05_04_Template.elf
+#     make -f latency_bench_qemu.mk run      build it and run it under QEMU
+#
+# The compiler and linker flags follow the Debug configuration in .cproject,
+# with LATENCY_BENCH and LATENCY_BENCH_QEMU defined.
+
+PREFIX ?= arm-none-eabi-
+CC = $(PREFIX)gcc
+SIZE = $(PREFIX)size
+BUILD = QEMU
+TARGET = $(BUILD)/05_04_Template.elf
+
+FREERTOS = Middlewares/Third_Party/FreeRTOS/Source
+
+MCU = -mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard
+DEFS = -DUSE_HAL_DRIVER -DSTM32F411xE -DDEBUG -DLATENCY_BENCH -DLATENCY_BENCH_QEMU
+INCLUDES = -ICore/Inc \
+           -IDrivers/STM32F4xx_HAL_Driver/Inc \
+           -IDrivers/STM32F4xx_HAL_Driver/Inc/Legacy \
+           -IDrivers/CMSIS/Device/ST/STM32F4xx/Include \
+           -IDrivers/CMSIS/Include \
+           -I$(FREERTOS)/include \
+           -I$(FREERTOS)/CMSIS_RTOS \
+           -I$(FREERTOS)/portable/GCC/ARM_CM4F
+CFLAGS = $(MCU) $(DEFS) $(INCLUDES) -std=gnu11 -g3 -Os -ffunction-sections -fdata-sections \
+         -Wall -fstack-usage -MMD -MP
+ASFLAGS = $(MCU) -g3 -x assembler-with-cpp
+LDFLAGS = $(MCU) -TSTM32F411RETX_FLASH.ld --specs=nosys.specs --specs=nano.specs \
+          -Wl,-Map=$(BUILD)/05_04_Template.map -Wl,--gc-sections -static \
+          -Wl,--start-group -lc -lm -Wl,--end-group
+
+# Everything the IDE builds: Core, Drivers and Middlewares.
+C_SRC = $(wildcard Core/Src/*.c) \
+        $(wildcard Drivers/STM32F4xx_HAL_Driver/Src/*.c) \
+        $(wildcard $(FREERTOS)/*.c) \
+        $(wildcard $(FREERTOS)/CMSIS_RTOS/*.c) \
+        $(wildcard $(FREERTOS)/portable/GCC/ARM_CM4F/*.c) \
+        $(wildcard $(FREERTOS)/portable/MemMang/*.c)
+ASM_SRC = Core/Startup/startup_stm32f411retx.s
+
+OBJ = $(addprefix $(BUILD)/,$(C_SRC:.c=.o) $(ASM_SRC:.s=.o))
+
+.PHONY: all run clean
+
+all: $(TARGET)
+
+$(TARGET): $(OBJ) STM32F411RETX_FLASH.ld
+	$(CC) $(OBJ) $(LDFLAGS) -o $@
+	$(SIZE) $@
+
+$(BUILD)/%.o: %.c latency_bench_qemu.mk
+	@mkdir -p $(dir $@)
+	$(CC) $(CFLAGS) -c $< -o $@
+
+$(BUILD)/%.o: %.s latency_bench_qemu.mk
+	@mkdir -p $(dir $@)
+	$(CC) $(ASFLAGS) -c $< -o $@
+
+run: $(TARGET)
+	Utilities/run_latency_bench_qemu.sh $(TARGET)
+
+clean:
+	rm -rf $(BUILD)
+
+-include $(OBJ:.o=.d)
@@ -2,13 +2,12 @@
 #define FREERTOS_CONFIG_H
 
 #define configUSE_PREEMPTION                    1
-#define configUSE_IDLE_HOOK                     0
+#ifndef configUSE_TICK_HOOK
 #define configUSE_TICK_HOOK                     0
+#endif
 #define configCPU_CLOCK_HZ                      ( ( unsigned long ) 1000000 )
 #define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
-#define configMAX_PRIORITIES                    4
 #define configMINIMAL_STACK_SIZE                ( ( unsigned short ) 130 )
-#define configTOTAL_HEAP_SIZE                   ( ( size_t ) ( 20 * 1024 ) )
 #define configMAX_TASK_NAME_LEN                 10
 #define configUSE_16_BIT_TICKS                  0
 #define configIDLE_SHOULD_YIELD                 1
@@ -16,4 +15,45 @@
 /* Enable the simple malloc scheme */
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
 
+#if defined( __linux__ )
+
+/* Linux simulator build (portable/Linux_SMP), which runs the kernel from
+   05_04_Template on configNUMBER_OF_CORES simulated cores.  The Makefile sets
+   the number of cores from CORES. */
+#include <assert.h>
+
+#ifndef configNUMBER_OF_CORES
+#define configNUMBER_OF_CORES                   2
+#endif
+#define configUSE_CORE_AFFINITY                 ( configNUMBER_OF_CORES > 1 )
+
+/* The port's idle hook sleeps until the next interrupt. */
+#define configUSE_IDLE_HOOK                     1
+
+/* ESP-IDF numbers priorities up to 24. */
+#ifndef configMAX_PRIORITIES
+#define configMAX_PRIORITIES                    25
+#endif
+#define configTOTAL_HEAP_SIZE                   ( ( size_t ) ( 4 * 1024 * 1024 ) )
+
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+
+#define configASSERT( x )                       assert( x )
+
+/* Microsecond delays run from the port's microsecond clock and alarm. */
+#define configMICROSECOND_TIMER_COUNT()         ulPortMicrosecondCount()
+#define configMICROSECOND_TIMER_SET_ALARM( x )  vPortSetMicrosecondAlarm( x )
+
+#else
+
+#define configUSE_IDLE_HOOK                     0
+#define configMAX_PRIORITIES                    4
+#define configTOTAL_HEAP_SIZE                   ( ( size_t ) ( 20 * 1024 ) )
+
+#endif /* __linux__ */
+
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,128 @@
+// File: benchmarks/core_scaling.c
+// Description:
+// Measures how a task set scales with the number of cores of the Linux
+// simulator build.  WORKER_TASKS tasks take jobs from a shared queue, run
+// each job for a fixed amount of computation and report it done on a second
+// queue.  The dispatcher hands out JOBS jobs, waits for all of them and
+// prints the throughput.  Build and run for 1 to 4 cores with:
+//
+//     make scaling
+//
+// The simulated cores are host threads, so results only mean something on a
+// host with at least as many idle CPUs as simulated cores.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#ifndef WORKER_TASKS
+#define WORKER_TASKS      8
+#endif
+
+#ifndef JOBS
+#define JOBS              2000
+#endif
+
+// Computation per job, in iterations of the loop in run_job().
+#ifndef JOB_ITERATIONS
+#define JOB_ITERATIONS    200000
+#endif
+
+#define WORKER_PRIORITY       2
+#define DISPATCHER_PRIORITY   3
+#define TASK_STACK_SIZE       2048
+
+static QueueHandle_t job_queue;
+static QueueHandle_t done_queue;
+
+static uint32_t run_job(uint32_t seed)
+{
+    uint32_t x = seed | 1U;
+
+    for (uint32_t i = 0; i < JOB_ITERATIONS; i++)
+    {
+        // xorshift32, kept live through the volatile store below.
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+    }
+
+    return x;
+}
+
+static void worker_task(void *pvParameters)
+{
+    (void) pvParameters;
+    uint32_t job;
+    volatile uint32_t result;
+
+    for (;;)
+    {
+        xQueueReceive(job_queue, &job, portMAX_DELAY);
+        result = run_job(job);
+        (void) result;
+        xQueueSend(done_queue, &job, portMAX_DELAY);
+    }
+}
+
+static double seconds_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+}
+
+static void dispatcher_task(void *pvParameters)
+{
+    (void) pvParameters;
+    uint32_t job;
+    uint32_t sent = 0;
+    uint32_t done = 0;
+    TickType_t start_ticks;
+    double start;
+
+    start_ticks = xTaskGetTickCount();
+    start = seconds_now();
+
+    // Keep every worker busy, then send a new job as each one finishes.
+    while (done < JOBS)
+    {
+        while ((sent < JOBS) && (xQueueSend(job_queue, &sent, 0) == pdPASS))
+        {
+            sent++;
+        }
+
+        xQueueReceive(done_queue, &job, portMAX_DELAY);
+        done++;
+    }
+
+    double elapsed = seconds_now() - start;
+    TickType_t ticks = xTaskGetTickCount() - start_ticks;
+
+    printf("cores=%d tasks=%d jobs=%d elapsed=%.3f s (%u ticks) throughput=%.1f jobs/s\n",
+           configNUMBER_OF_CORES, WORKER_TASKS, JOBS, elapsed, (unsigned) ticks,
+           (double) JOBS / elapsed);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    job_queue = xQueueCreate(WORKER_TASKS, sizeof(uint32_t));
+    done_queue = xQueueCreate(JOBS, sizeof(uint32_t));
+
+    for (int i = 0; i < WORKER_TASKS; i++)
+    {
+        xTaskCreate(worker_task, "Worker", TASK_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+    }
+
+    xTaskCreate(dispatcher_task, "Dispatch", TASK_STACK_SIZE, NULL, DISPATCHER_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    return 0;
+}
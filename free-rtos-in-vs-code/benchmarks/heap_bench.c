@@ -0,0 +1,292 @@
+// File: benchmarks/heap_bench.c
+// Description:
+// Compares the kernel heaps on the same random trace of allocations and
+// frees.  The trace keeps up to LIVE_SLOTS blocks live: each step picks a
+// slot at random and frees its block if it has one, or allocates a new block
+// of random size if it does not.  Most blocks are small, with a tail of
+// blocks of a few KB, so the heap fragments the way a long-running
+// application's heap does.
+//
+// The time of every pvPortMalloc() and vPortFree() call is measured, and the
+// average, 99th percentile and worst case are printed with the state of the
+// heap at the end of the trace.
+//
+// Before that, a second trace keeps up to MIX_SLOTS kernel sized objects
+// live: task control blocks, queues and messages of 8 to 32 bytes.  The bytes
+// taken from the heap are printed against the bytes asked for, at the end of
+// the trace and at the peak, and once every object has been freed again.
+// With slabs, the heap used includes the unused objects of slab pages.
+//
+// Build and run for heap_4.c without and with slabs, and for heap_tlsf.c,
+// with:
+//
+//     make heap_bench
+//
+// The trace runs from main() before the scheduler starts, so nothing else
+// uses the heap meanwhile.  Times are host times and include the cost of
+// reading the clock, so compare the heaps with each other rather than with
+// a target.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef LIVE_SLOTS
+#define LIVE_SLOTS        8192
+#endif
+
+#ifndef TRACE_STEPS
+#define TRACE_STEPS       1000000
+#endif
+
+#ifndef TRACE_SEED
+#define TRACE_SEED        0x2545F491U
+#endif
+
+#ifndef MIX_SLOTS
+#define MIX_SLOTS         256
+#endif
+
+#ifndef MIX_STEPS
+#define MIX_STEPS         100000
+#endif
+
+// Larger than any slab class, so the first allocation does not take a page.
+#define INIT_SIZE         4096
+
+#if (configUSE_TLSF_HEAP == 1)
+#define HEAP_NAME         "heap_tlsf"
+#elif (configUSE_HEAP_SLABS == 1)
+#define HEAP_NAME         "heap_4 with slabs"
+#else
+#define HEAP_NAME         "heap_4"
+#endif
+
+static void *slots[LIVE_SLOTS];
+static void *mix_slots[MIX_SLOTS];
+static size_t mix_sizes[MIX_SLOTS];
+static uint32_t trace_state = TRACE_SEED;
+
+static uint32_t next_random(void)
+{
+    // xorshift32, so every build replays the same trace.
+    trace_state ^= trace_state << 13;
+    trace_state ^= trace_state >> 17;
+    trace_state ^= trace_state << 5;
+
+    return trace_state;
+}
+
+static size_t next_size(void)
+{
+    uint32_t r = next_random();
+    uint32_t kind = r % 100U;
+
+    r >>= 8;
+
+    if (kind < 70U)
+    {
+        return 8U + (r % 120U);         // 8 to 127 bytes
+    }
+    else if (kind < 95U)
+    {
+        return 128U + (r % 896U);       // 128 bytes to 1 KB
+    }
+    else
+    {
+        return 1024U + (r % 7168U);     // 1 KB to 8 KB
+    }
+}
+
+static size_t next_mix_size(void)
+{
+    uint32_t r = next_random();
+    uint32_t kind = r % 100U;
+
+    r >>= 8;
+
+    if (kind < 10U)
+    {
+        return sizeof(StaticTask_t);
+    }
+    else if (kind < 25U)
+    {
+        return sizeof(StaticQueue_t);
+    }
+    else
+    {
+        return 8U + (r % 25U);          // 8 to 32 bytes
+    }
+}
+
+// Runs the kernel object trace and prints the heap used, counted from the
+// free bytes left after the heap was set up.
+static void run_object_mix(void)
+{
+    size_t free_at_start;
+    size_t requested = 0;
+    size_t live = 0;
+    size_t used, peak_used = 0, peak_requested = 0;
+
+    vPortFree(pvPortMalloc(INIT_SIZE));
+    free_at_start = xPortGetFreeHeapSize();
+
+    for (uint32_t step = 0; step < MIX_STEPS; step++)
+    {
+        uint32_t slot = next_random() % MIX_SLOTS;
+
+        if (mix_slots[slot] != NULL)
+        {
+            vPortFree(mix_slots[slot]);
+            mix_slots[slot] = NULL;
+            requested -= mix_sizes[slot];
+            live--;
+        }
+        else
+        {
+            mix_sizes[slot] = next_mix_size();
+            mix_slots[slot] = pvPortMalloc(mix_sizes[slot]);
+
+            if (mix_slots[slot] != NULL)
+            {
+                requested += mix_sizes[slot];
+                live++;
+
+                used = free_at_start - xPortGetFreeHeapSize();
+                if (used > peak_used)
+                {
+                    peak_used = used;
+                    peak_requested = requested;
+                }
+            }
+        }
+    }
+
+    used = free_at_start - xPortGetFreeHeapSize();
+
+    printf("%s: kernel object mix of %u steps, %zu live objects\n", HEAP_NAME, (unsigned) MIX_STEPS, live);
+    printf("  end    %6zu bytes asked for, %6zu bytes of heap used (%+.1f%%)\n",
+           requested, used, 100.0 * ((double) used - (double) requested) / (double) requested);
+    printf("  peak   %6zu bytes asked for, %6zu bytes of heap used (%+.1f%%)\n",
+           peak_requested, peak_used, 100.0 * ((double) peak_used - (double) peak_requested) / (double) peak_requested);
+
+    for (uint32_t slot = 0; slot < MIX_SLOTS; slot++)
+    {
+        vPortFree(mix_slots[slot]);
+        mix_slots[slot] = NULL;
+    }
+
+    printf("  freed  %6zu bytes of heap still used\n", free_at_start - xPortGetFreeHeapSize());
+}
+
+static uint32_t elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+    return (uint32_t) ((end->tv_sec - start->tv_sec) * 1000000000L + (end->tv_nsec - start->tv_nsec));
+}
+
+static int compare_ns(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a;
+    uint32_t y = *(const uint32_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+static void print_latency(const char *name, uint32_t *samples, size_t count)
+{
+    uint64_t total = 0;
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        total += samples[i];
+    }
+
+    qsort(samples, count, sizeof(samples[0]), compare_ns);
+
+    printf("  %-6s %8zu calls  avg %6.1f ns  p99 %6u ns  max %8u ns\n",
+           name, count, (double) total / (double) count,
+           (unsigned) samples[(count * 99U) / 100U], (unsigned) samples[count - 1U]);
+}
+
+int main(void)
+{
+    // The samples live on the host heap so they do not disturb the heap
+    // being measured.
+    uint32_t *malloc_ns = malloc(TRACE_STEPS * sizeof(uint32_t));
+    uint32_t *free_ns = malloc(TRACE_STEPS * sizeof(uint32_t));
+    size_t mallocs = 0;
+    size_t frees = 0;
+    size_t failures = 0;
+    size_t live = 0;
+    struct timespec start, end;
+    HeapStats_t stats;
+
+    if ((malloc_ns == NULL) || (free_ns == NULL))
+    {
+        printf("could not allocate the latency samples\n");
+        return 1;
+    }
+
+    run_object_mix();
+
+    for (uint32_t step = 0; step < TRACE_STEPS; step++)
+    {
+        uint32_t slot = next_random() % LIVE_SLOTS;
+
+        if (slots[slot] != NULL)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            vPortFree(slots[slot]);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+
+            free_ns[frees++] = elapsed_ns(&start, &end);
+            slots[slot] = NULL;
+            live--;
+        }
+        else
+        {
+            size_t size = next_size();
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            slots[slot] = pvPortMalloc(size);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+
+            malloc_ns[mallocs++] = elapsed_ns(&start, &end);
+
+            if (slots[slot] != NULL)
+            {
+                live++;
+            }
+            else
+            {
+                failures++;
+            }
+        }
+    }
+
+    // Fragmentation is measured with the end of the trace still live.
+    vPortGetHeapStats(&stats);
+
+    printf("%s: %u steps, %zu live blocks, %zu failed allocations\n",
+           HEAP_NAME, (unsigned) TRACE_STEPS, live, failures);
+    print_latency("malloc", malloc_ns, mallocs);
+    print_latency("free", free_ns, frees);
+    printf("  heap   %zu bytes free in %zu blocks, largest %zu, minimum ever free %zu\n",
+           stats.xAvailableHeapSpaceInBytes, stats.xNumberOfFreeBlocks,
+           stats.xSizeOfLargestFreeBlockInBytes, stats.xMinimumEverFreeBytesRemaining);
+    printf("  fragmentation %.1f%% (free bytes not in the largest free block)\n",
+           100.0 * (1.0 - (double) stats.xSizeOfLargestFreeBlockInBytes / (double) stats.xAvailableHeapSpaceInBytes));
+
+    free(malloc_ns);
+    free(free_ns);
+
+    return 0;
+}
@@ -0,0 +1,237 @@
+// File: benchmarks/inheritance_bench.c
+// Description:
+// Measures how long a high priority task waits for a mutex at the end of a
+// chain of three nested mutexes, with a CPU bound task in the middle of the
+// priority range.  Every PERIOD ticks:
+//
+//   Low      (priority 1) takes mutex A and works for LOW_WORK ticks.
+//   Middle1  (priority 2) takes B, then blocks on A.
+//   Middle2  (priority 3) takes C, then blocks on B.
+//   Spinner  (priority 4) works for SPIN_WORK ticks.
+//   High     (priority 5) blocks on C.
+//
+// With configPRIORITY_INHERITANCE_DEPTH set to 1 only Middle2 inherits
+// High's priority, so Spinner starves Low and High waits for all of
+// Spinner's work.  With a depth of 3 Low inherits it too, and High waits
+// only for Low's work.  Before the timed rounds High first times out on C
+// once, after which no task in the chain may keep High's priority.  After
+// every round each task must be back at its own priority.
+//
+// The worst wait of High over ROUNDS rounds is printed.  With a depth of 3
+// or more the benchmark fails if it is more than MAX_WAIT ticks.  Build and
+// run with depths of 1 and 3 on one core with:
+//
+//     make inheritance_bench
+
+#include <stdint.h>
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#ifndef ROUNDS
+#define ROUNDS            10
+#endif
+
+#ifndef PERIOD
+#define PERIOD            400
+#endif
+
+#ifndef LOW_WORK
+#define LOW_WORK          10
+#endif
+
+#ifndef SPIN_WORK
+#define SPIN_WORK         200
+#endif
+
+// Low's work, plus a tick for each of the three hand-overs.
+#ifndef MAX_WAIT
+#define MAX_WAIT          (LOW_WORK + 3)
+#endif
+
+#define LOW_PRIORITY          1
+#define MIDDLE1_PRIORITY      2
+#define MIDDLE2_PRIORITY      3
+#define SPINNER_PRIORITY      4
+#define HIGH_PRIORITY         5
+#define TASK_STACK_SIZE       2048
+
+static SemaphoreHandle_t mutex_a;
+static SemaphoreHandle_t mutex_b;
+static SemaphoreHandle_t mutex_c;
+static TaskHandle_t low_handle;
+static TaskHandle_t middle1_handle;
+static TaskHandle_t middle2_handle;
+static int failures;
+
+// Burns CPU until the tick count has moved on ticks times while this task
+// was running.  A jump of more than one tick means the task was preempted,
+// and counts as a single tick of work.
+static void work(uint32_t ticks)
+{
+    TickType_t last = xTaskGetTickCount();
+
+    while (ticks > 0)
+    {
+        TickType_t now = xTaskGetTickCount();
+
+        if (now != last)
+        {
+            last = now;
+            ticks--;
+        }
+    }
+}
+
+static void low_task(void *pvParameters)
+{
+    (void) pvParameters;
+    TickType_t last_wake = xTaskGetTickCount();
+
+    for (;;)
+    {
+        xSemaphoreTake(mutex_a, portMAX_DELAY);
+        work(LOW_WORK);
+        xSemaphoreGive(mutex_a);
+        vTaskDelayUntil(&last_wake, PERIOD);
+    }
+}
+
+static void middle1_task(void *pvParameters)
+{
+    (void) pvParameters;
+    TickType_t last_wake;
+
+    vTaskDelay(1);
+    last_wake = xTaskGetTickCount();
+
+    for (;;)
+    {
+        xSemaphoreTake(mutex_b, portMAX_DELAY);
+        xSemaphoreTake(mutex_a, portMAX_DELAY);
+        xSemaphoreGive(mutex_a);
+        xSemaphoreGive(mutex_b);
+        vTaskDelayUntil(&last_wake, PERIOD);
+    }
+}
+
+static void middle2_task(void *pvParameters)
+{
+    (void) pvParameters;
+    TickType_t last_wake;
+
+    vTaskDelay(2);
+    last_wake = xTaskGetTickCount();
+
+    for (;;)
+    {
+        xSemaphoreTake(mutex_c, portMAX_DELAY);
+        xSemaphoreTake(mutex_b, portMAX_DELAY);
+        xSemaphoreGive(mutex_b);
+        xSemaphoreGive(mutex_c);
+        vTaskDelayUntil(&last_wake, PERIOD);
+    }
+}
+
+static void spinner_task(void *pvParameters)
+{
+    (void) pvParameters;
+    TickType_t last_wake;
+
+    vTaskDelay(3);
+    last_wake = xTaskGetTickCount();
+
+    for (;;)
+    {
+        work(SPIN_WORK);
+        vTaskDelayUntil(&last_wake, PERIOD);
+    }
+}
+
+static int chain_below(UBaseType_t priority)
+{
+    return uxTaskPriorityGet(low_handle) < priority &&
+           uxTaskPriorityGet(middle1_handle) < priority &&
+           uxTaskPriorityGet(middle2_handle) < priority;
+}
+
+static int priorities_restored(void)
+{
+    return uxTaskPriorityGet(low_handle) == LOW_PRIORITY &&
+           uxTaskPriorityGet(middle1_handle) == MIDDLE1_PRIORITY &&
+           uxTaskPriorityGet(middle2_handle) == MIDDLE2_PRIORITY;
+}
+
+static void high_task(void *pvParameters)
+{
+    (void) pvParameters;
+    TickType_t last_wake;
+    TickType_t wait;
+    TickType_t worst_wait = 0;
+
+    vTaskDelay(4);
+    last_wake = xTaskGetTickCount();
+
+    // Time out once while the chain is blocked.
+    if (xSemaphoreTake(mutex_c, 2) == pdTRUE)
+    {
+        printf("  took mutex C while the chain held it\n");
+        failures++;
+        xSemaphoreGive(mutex_c);
+    }
+    if (!chain_below(HIGH_PRIORITY))
+    {
+        printf("  High's priority kept after a timeout\n");
+        failures++;
+    }
+    vTaskDelayUntil(&last_wake, PERIOD);
+
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        wait = xTaskGetTickCount();
+        xSemaphoreTake(mutex_c, portMAX_DELAY);
+        wait = xTaskGetTickCount() - wait;
+        xSemaphoreGive(mutex_c);
+
+        if (wait > worst_wait)
+        {
+            worst_wait = wait;
+        }
+        if (!priorities_restored())
+        {
+            printf("  priorities not restored after round %d\n", round);
+            failures++;
+        }
+
+        vTaskDelayUntil(&last_wake, PERIOD);
+    }
+
+    if (configPRIORITY_INHERITANCE_DEPTH >= 3 && worst_wait > MAX_WAIT)
+    {
+        printf("  worst wait above the %d tick bound\n", MAX_WAIT);
+        failures++;
+    }
+
+    printf("inheritance depth %d: 3 nested mutexes, %d tick spinner, worst wait %u ticks over %d rounds, %d failures\n",
+           configPRIORITY_INHERITANCE_DEPTH, SPIN_WORK, (unsigned) worst_wait, ROUNDS, failures);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    mutex_a = xSemaphoreCreateMutex();
+    mutex_b = xSemaphoreCreateMutex();
+    mutex_c = xSemaphoreCreateMutex();
+
+    xTaskCreate(low_task, "Low", TASK_STACK_SIZE, NULL, LOW_PRIORITY, &low_handle);
+    xTaskCreate(middle1_task, "Middle1", TASK_STACK_SIZE, NULL, MIDDLE1_PRIORITY, &middle1_handle);
+    xTaskCreate(middle2_task, "Middle2", TASK_STACK_SIZE, NULL, MIDDLE2_PRIORITY, &middle2_handle);
+    xTaskCreate(spinner_task, "Spinner", TASK_STACK_SIZE, NULL, SPINNER_PRIORITY, NULL);
+    xTaskCreate(high_task, "High", TASK_STACK_SIZE, NULL, HIGH_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    return (failures == 0) ? 0 : 1;
+}
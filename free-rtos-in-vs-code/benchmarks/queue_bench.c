@@ -0,0 +1,199 @@
+// File: benchmarks/queue_bench.c
+// Description:
+// Compares moving items through a queue one at a time with moving them in
+// batches through xQueueSendMultiple() and xQueueReceiveMultiple().  A
+// producer task posts ITEMS samples to a queue of QUEUE_LENGTH items and a
+// consumer task at a lower priority takes them off, as an ADC pipeline
+// does.  Each item costs the single item loop a critical section, a
+// timeout setup and, once the queue is full, a wake of the producer and two
+// context switches.  A batch pays each of those once.
+//
+// The run is repeated for batches of 1 (xQueueSend() and xQueueReceive()),
+// then BATCH_MIN to BATCH_MAX items, and the items per second of each are
+// printed against the single item loop.  Build and run on one core with:
+//
+//     make queue_bench
+//
+// Times are host times, so compare the runs with each other rather than
+// with a target.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#ifndef ITEMS
+#define ITEMS             2000000
+#endif
+
+#ifndef QUEUE_LENGTH
+#define QUEUE_LENGTH      64
+#endif
+
+#ifndef BATCH_MIN
+#define BATCH_MIN         4
+#endif
+
+#ifndef BATCH_MAX
+#define BATCH_MAX         32
+#endif
+
+#define CONTROL_PRIORITY      4
+#define PRODUCER_PRIORITY     3
+#define CONSUMER_PRIORITY     2
+#define TASK_STACK_SIZE       2048
+
+static QueueHandle_t sample_queue;
+static TaskHandle_t control_handle;
+static TaskHandle_t producer_handle;
+static TaskHandle_t consumer_handle;
+
+// Set by the control task before each run.
+static volatile uint32_t batch;
+
+// Written by the consumer during a run, read by the control task after it.
+static volatile uint32_t order_errors;
+
+static void producer_task(void *pvParameters)
+{
+    (void) pvParameters;
+    uint16_t samples[BATCH_MAX];
+    uint32_t sequence;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        sequence = 0;
+        while (sequence < ITEMS)
+        {
+            uint32_t count = batch;
+
+            if (count > ITEMS - sequence)
+            {
+                count = ITEMS - sequence;
+            }
+
+            for (uint32_t i = 0; i < count; i++)
+            {
+                samples[i] = (uint16_t) (sequence + i);
+            }
+
+            if (batch == 1)
+            {
+                xQueueSend(sample_queue, &samples[0], portMAX_DELAY);
+            }
+            else
+            {
+                xQueueSendMultiple(sample_queue, samples, count, portMAX_DELAY);
+            }
+
+            sequence += count;
+        }
+    }
+}
+
+static void consumer_task(void *pvParameters)
+{
+    (void) pvParameters;
+    uint16_t samples[BATCH_MAX];
+    uint32_t sequence;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        sequence = 0;
+        while (sequence < ITEMS)
+        {
+            uint32_t count = batch;
+
+            if (count > ITEMS - sequence)
+            {
+                count = ITEMS - sequence;
+            }
+
+            if (batch == 1)
+            {
+                xQueueReceive(sample_queue, &samples[0], portMAX_DELAY);
+            }
+            else
+            {
+                count = xQueueReceiveMultiple(sample_queue, samples, count, portMAX_DELAY);
+            }
+
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (samples[i] != (uint16_t) (sequence + i))
+                {
+                    order_errors++;
+                }
+            }
+
+            sequence += count;
+        }
+
+        xTaskNotifyGive(control_handle);
+    }
+}
+
+static double seconds_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+}
+
+static double run(uint32_t items_per_call)
+{
+    double start;
+
+    batch = items_per_call;
+    order_errors = 0;
+
+    start = seconds_now();
+    xTaskNotifyGive(consumer_handle);
+    xTaskNotifyGive(producer_handle);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    return (double) ITEMS / (seconds_now() - start);
+}
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+    double single;
+    double rate;
+
+    printf("queue benchmark: %u items of %zu bytes, queue of %u items, %d core(s)\n",
+           (unsigned) ITEMS, sizeof(uint16_t), (unsigned) QUEUE_LENGTH, configNUMBER_OF_CORES);
+    printf("  %5s %14s %8s %6s\n", "batch", "items/s", "speedup", "order");
+
+    single = run(1);
+    printf("  %5u %14.0f %7.2fx %6u\n", 1U, single, 1.0, (unsigned) order_errors);
+
+    for (uint32_t items_per_call = BATCH_MIN; items_per_call <= BATCH_MAX; items_per_call *= 2)
+    {
+        rate = run(items_per_call);
+        printf("  %5u %14.0f %7.2fx %6u\n", (unsigned) items_per_call, rate, rate / single,
+               (unsigned) order_errors);
+    }
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    sample_queue = xQueueCreate(QUEUE_LENGTH, sizeof(uint16_t));
+
+    xTaskCreate(producer_task, "Producer", TASK_STACK_SIZE, NULL, PRODUCER_PRIORITY, &producer_handle);
+    xTaskCreate(consumer_task, "Consumer", TASK_STACK_SIZE, NULL, CONSUMER_PRIORITY, &consumer_handle);
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, CONTROL_PRIORITY, &control_handle);
+
+    vTaskStartScheduler();
+
+    return 0;
+}
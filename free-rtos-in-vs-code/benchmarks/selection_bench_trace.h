@@ -0,0 +1,16 @@
+// File: benchmarks/selection_bench_trace.h
+// Description:
+// Forced into every source file of the selection benchmark with -include, so
+// the kernel calls selection_bench_start() and selection_bench_end() around
+// the selection of the next task in vTaskSwitchContext().
+
+#ifndef SELECTION_BENCH_TRACE_H
+#define SELECTION_BENCH_TRACE_H
+
+void selection_bench_start(void);
+void selection_bench_end(void);
+
+#define traceTASK_SWITCHED_OUT() selection_bench_start()
+#define traceTASK_SWITCHED_IN()  selection_bench_end()
+
+#endif // SELECTION_BENCH_TRACE_H
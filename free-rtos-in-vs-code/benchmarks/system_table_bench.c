@@ -0,0 +1,217 @@
+// File: benchmarks/system_table_bench.c
+// Description:
+// Compares creating the kernel objects a system needs at boot from the heap
+// with creating them from static storage, as SystemTable_Init() in
+// 05_04_Template/Core/Src/system_table.c does.  OBJECTS each of a task of
+// TASK_STACK_WORDS words, a queue of QUEUE_LENGTH 4 byte items, a mutex, an
+// event group and a stream buffer of STREAM_SIZE bytes are created with the
+// dynamic API and then with the static API, ROUNDS times, and deleted again
+// after each round.
+//
+// For each way the heap it took, the static storage it needs, and the
+// median time to create the tasks and the other objects are printed.  The
+// task times include the simulator starting a thread for each task, which
+// both ways pay.  Build and run on one core with:
+//
+//     make system_table_bench
+//
+// Sizes and times are those of the host, so compare the two ways with each
+// other rather than with a target.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+
+#ifndef OBJECTS
+#define OBJECTS           4
+#endif
+
+#ifndef ROUNDS
+#define ROUNDS            200
+#endif
+
+#ifndef TASK_STACK_WORDS
+#define TASK_STACK_WORDS  128
+#endif
+
+#ifndef QUEUE_LENGTH
+#define QUEUE_LENGTH      8
+#endif
+
+#ifndef STREAM_SIZE
+#define STREAM_SIZE       64
+#endif
+
+#define CONTROL_PRIORITY      2
+#define OBJECT_TASK_PRIORITY  1
+#define TASK_STACK_SIZE       2048
+
+// Static storage, as system_table.c lays it out for OBJECTS of each kind.
+static StaticTask_t task_buffers[OBJECTS];
+static StackType_t task_stacks[OBJECTS][TASK_STACK_WORDS];
+static StaticQueue_t queue_buffers[OBJECTS];
+static uint8_t queue_storage[OBJECTS][QUEUE_LENGTH * sizeof(uint32_t)];
+static StaticSemaphore_t mutex_buffers[OBJECTS];
+static StaticEventGroup_t event_group_buffers[OBJECTS];
+static StaticStreamBuffer_t stream_buffers[OBJECTS];
+static uint8_t stream_storage[OBJECTS][STREAM_SIZE + 1];
+
+static TaskHandle_t tasks[OBJECTS];
+static QueueHandle_t queues[OBJECTS];
+static SemaphoreHandle_t mutexes[OBJECTS];
+static EventGroupHandle_t event_groups[OBJECTS];
+static StreamBufferHandle_t streams[OBJECTS];
+
+static uint64_t task_ns[ROUNDS];
+static uint64_t object_ns[ROUNDS];
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    static StaticTask_t idle_buffer;
+    static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+
+    *ppxIdleTaskTCBBuffer = &idle_buffer;
+    *ppxIdleTaskStackBuffer = idle_stack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+// Created below the control task, so never runs before it is deleted.
+static void object_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    for (;;)
+    {
+        vTaskSuspend(NULL);
+    }
+}
+
+static uint64_t ns_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+}
+
+static void create_dynamic(int round)
+{
+    uint64_t start = ns_now();
+
+    for (int i = 0; i < OBJECTS; i++)
+    {
+        xTaskCreate(object_task, "Object", TASK_STACK_WORDS, NULL, OBJECT_TASK_PRIORITY, &tasks[i]);
+    }
+    task_ns[round] = ns_now() - start;
+
+    start = ns_now();
+    for (int i = 0; i < OBJECTS; i++)
+    {
+        queues[i] = xQueueCreate(QUEUE_LENGTH, sizeof(uint32_t));
+        mutexes[i] = xSemaphoreCreateMutex();
+        event_groups[i] = xEventGroupCreate();
+        streams[i] = xStreamBufferCreate(STREAM_SIZE, 1);
+    }
+    object_ns[round] = ns_now() - start;
+}
+
+static void create_static(int round)
+{
+    uint64_t start = ns_now();
+
+    for (int i = 0; i < OBJECTS; i++)
+    {
+        tasks[i] = xTaskCreateStatic(object_task, "Object", TASK_STACK_WORDS, NULL, OBJECT_TASK_PRIORITY,
+                                     task_stacks[i], &task_buffers[i]);
+    }
+    task_ns[round] = ns_now() - start;
+
+    start = ns_now();
+    for (int i = 0; i < OBJECTS; i++)
+    {
+        queues[i] = xQueueCreateStatic(QUEUE_LENGTH, sizeof(uint32_t), queue_storage[i], &queue_buffers[i]);
+        mutexes[i] = xSemaphoreCreateMutexStatic(&mutex_buffers[i]);
+        event_groups[i] = xEventGroupCreateStatic(&event_group_buffers[i]);
+        streams[i] = xStreamBufferCreateStatic(STREAM_SIZE, 1, stream_storage[i], &stream_buffers[i]);
+    }
+    object_ns[round] = ns_now() - start;
+}
+
+static void delete_all(void)
+{
+    for (int i = 0; i < OBJECTS; i++)
+    {
+        vTaskDelete(tasks[i]);
+        vQueueDelete(queues[i]);
+        vSemaphoreDelete(mutexes[i]);
+        vEventGroupDelete(event_groups[i]);
+        vStreamBufferDelete(streams[i]);
+    }
+}
+
+static int compare_ns(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+static uint64_t median(uint64_t *samples)
+{
+    qsort(samples, ROUNDS, sizeof(samples[0]), compare_ns);
+    return samples[ROUNDS / 2];
+}
+
+// Runs ROUNDS rounds of one way and prints its line.
+static void run(const char *name, void (*create)(int), size_t storage)
+{
+    size_t heap_used = 0;
+
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        size_t free_before = xPortGetFreeHeapSize();
+
+        create(round);
+        heap_used = free_before - xPortGetFreeHeapSize();
+        delete_all();
+    }
+
+    printf("  %-8s %10zu %15zu %9llu %14llu\n", name, heap_used, storage,
+           (unsigned long long) median(task_ns), (unsigned long long) median(object_ns));
+}
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+    size_t storage = sizeof(task_buffers) + sizeof(task_stacks) + sizeof(queue_buffers) + sizeof(queue_storage) +
+                     sizeof(mutex_buffers) + sizeof(event_group_buffers) + sizeof(stream_buffers) +
+                     sizeof(stream_storage);
+
+    printf("system table benchmark: %d each of task (%d words), queue (%d x 4 bytes), mutex, event group, "
+           "stream buffer (%d bytes), median of %d rounds\n",
+           OBJECTS, TASK_STACK_WORDS, QUEUE_LENGTH, STREAM_SIZE, ROUNDS);
+    printf("  %-8s %10s %15s %9s %14s\n", "", "heap bytes", "static bytes", "tasks ns", "objects ns");
+
+    run("dynamic", create_dynamic, 0);
+    run("static", create_static, storage);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, CONTROL_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+// File: benchmarks/task_pool_bench.c
+// Description:
+// Measures creating short lived tasks with and without the task pool
+// (configUSE_TASK_POOL).  The control task creates TASKS workers above its
+// own priority, so each one runs as soon as it is created and deletes
+// itself.  Without the pool the memory of a worker that deleted itself is
+// only freed when the idle task runs, so after every BURST workers the
+// control task blocks until the idle task has freed them.  With the pool the
+// slot is back as soon as the worker has been switched out.
+//
+// Printed are the median time per worker over the bursts, from the call to
+// xTaskCreate() to the worker having deleted itself, and the most heap in
+// use at the end of a burst.  With the pool the hit and miss counts of
+// vTaskGetPoolStats() are printed too.  Build and run without and with the
+// pool on one core with:
+//
+//     make task_pool_bench
+//
+// Times include the simulator starting and ending a thread for each task,
+// which both builds pay, so compare the two builds with each other rather
+// than with a target.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef TASKS
+#define TASKS             20000
+#endif
+
+#ifndef BURST
+#define BURST             16
+#endif
+
+#define BURSTS            (TASKS / BURST)
+#define CONTROL_PRIORITY  3
+#define WORKER_PRIORITY   4
+#define TASK_STACK_SIZE   2048
+
+// Small enough to take a pool slot.
+#define WORKER_STACK_SIZE configMINIMAL_STACK_SIZE
+
+static volatile uint32_t worker_runs;
+static uint64_t burst_ns[BURSTS];
+static int failures;
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    static StaticTask_t idle_buffer;
+    static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+
+    *ppxIdleTaskTCBBuffer = &idle_buffer;
+    *ppxIdleTaskStackBuffer = idle_stack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+static void worker_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    worker_runs++;
+    vTaskDelete(NULL);
+}
+
+static uint64_t ns_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+}
+
+static int compare_ns(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+    size_t free_at_start;
+    size_t peak_used = 0;
+    uint64_t start;
+
+    // Let the idle task free anything left from starting up.
+    vTaskDelay(1);
+    free_at_start = xPortGetFreeHeapSize();
+
+    for (int burst = 0; burst < BURSTS; burst++)
+    {
+        start = ns_now();
+        for (int i = 0; i < BURST; i++)
+        {
+            if (xTaskCreate(worker_task, "Worker", WORKER_STACK_SIZE, NULL, WORKER_PRIORITY, NULL) != pdPASS)
+            {
+                failures++;
+            }
+        }
+        burst_ns[burst] = ns_now() - start;
+
+        if (free_at_start - xPortGetFreeHeapSize() > peak_used)
+        {
+            peak_used = free_at_start - xPortGetFreeHeapSize();
+        }
+
+        // Wait for the idle task to free what the workers left behind.
+        do
+        {
+            vTaskDelay(1);
+        } while (xPortGetFreeHeapSize() < free_at_start);
+    }
+
+    qsort(burst_ns, BURSTS, sizeof(burst_ns[0]), compare_ns);
+
+    printf("task pool %d: %d workers in bursts of %d, %llu ns per worker, peak heap used %zu bytes, "
+           "%u ran, %d failed\n",
+           configUSE_TASK_POOL, BURSTS * BURST, BURST, (unsigned long long) (burst_ns[BURSTS / 2] / BURST),
+           peak_used, (unsigned) worker_runs, failures);
+
+#if (configUSE_TASK_POOL == 1)
+    {
+        TaskPoolStats_t stats;
+
+        vTaskGetPoolStats(&stats);
+        printf("  %u slots of %u words, %lu hits, %lu misses, at least %u free\n",
+               (unsigned) stats.uxNumberOfSlots, (unsigned) configTASK_POOL_STACK_DEPTH,
+               (unsigned long) stats.ulHits, (unsigned long) stats.ulMisses,
+               (unsigned) stats.uxMinimumEverFreeSlots);
+    }
+#endif
+
+    if (worker_runs != (uint32_t) (BURSTS * BURST))
+    {
+        failures++;
+    }
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, CONTROL_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+// File: benchmarks/timing_wheel_bench.c
+// Description:
+// Measures the cost of putting a task into the Blocked state with a timeout
+// while many other tasks are blocked.  DELAY_TASKS tasks each call
+// vTaskDelay() in a loop with a pseudo random delay of 1 to DELAY_RANGE
+// ticks, so about DELAY_TASKS tasks are always waiting to time out.  The time
+// from traceTASK_DELAY() to the task being switched out is recorded for
+// RUN_TICKS ticks, and the median, 90th percentile and maximum are printed.
+//
+// With the sorted delayed list, the insert walks past every task that wakes
+// earlier.  With the timing wheel it goes straight into a slot.  The
+// benchmark is built with configUSE_TIMING_WHEEL set to 0 and 1.  Build and
+// run both on one core with:
+//
+//     make timing_wheel_bench
+//
+// The recorded time also includes xTaskResumeAll() and the start of the
+// context switch, which are the same for both builds.  Times are host times,
+// so compare the runs with each other rather than with a target.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef DELAY_TASKS
+#define DELAY_TASKS       60
+#endif
+
+#ifndef DELAY_RANGE
+#define DELAY_RANGE       200
+#endif
+
+#ifndef RUN_TICKS
+#define RUN_TICKS         5000
+#endif
+
+#define MAX_SAMPLES       (RUN_TICKS * 4)
+
+#define CONTROL_PRIORITY  2
+#define DELAY_PRIORITY    1
+#define TASK_STACK_SIZE   2048
+
+static struct timespec delay_start;
+static volatile int timing;
+static volatile int recording;
+
+// Written with the scheduler suspended, read by the control task once the
+// run is over.
+static long delay_ns[MAX_SAMPLES];
+static uint32_t samples;
+
+void timing_wheel_bench_delay(void)
+{
+    if (recording)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &delay_start);
+        timing = 1;
+    }
+}
+
+void timing_wheel_bench_switched_out(void)
+{
+    struct timespec now;
+
+    if (!timing)
+    {
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    timing = 0;
+
+    if (samples < MAX_SAMPLES)
+    {
+        delay_ns[samples++] = (now.tv_sec - delay_start.tv_sec) * 1000000000L + (now.tv_nsec - delay_start.tv_nsec);
+    }
+}
+
+static void delay_task(void *pvParameters)
+{
+    uint32_t seed = (uint32_t) (uintptr_t) pvParameters;
+
+    for (;;)
+    {
+        seed = (seed * 1103515245UL) + 12345UL;
+        vTaskDelay((TickType_t) ((seed >> 16) % DELAY_RANGE) + 1);
+    }
+}
+
+static int compare_ns(const void *a, const void *b)
+{
+    long x = *(const long *) a;
+    long y = *(const long *) b;
+
+    return (x > y) - (x < y);
+}
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    // Let every task block once before recording.
+    vTaskDelay(DELAY_RANGE);
+    recording = 1;
+    vTaskDelay(RUN_TICKS);
+    recording = 0;
+
+    qsort(delay_ns, samples, sizeof(delay_ns[0]), compare_ns);
+
+    printf("%s %d tasks, delays of 1 to %d ticks: block median %5ld p90 %5ld max %6ld ns, %u samples\n",
+           (configUSE_TIMING_WHEEL == 1) ? "timing wheel" : "sorted list ", DELAY_TASKS, DELAY_RANGE,
+           delay_ns[samples / 2], delay_ns[samples * 9 / 10], delay_ns[samples - 1], (unsigned) samples);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    for (int i = 0; i < DELAY_TASKS; i++)
+    {
+        xTaskCreate(delay_task, "Delay", TASK_STACK_SIZE, (void *) (uintptr_t) (i + 1), DELAY_PRIORITY, NULL);
+    }
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, CONTROL_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    return 0;
+}
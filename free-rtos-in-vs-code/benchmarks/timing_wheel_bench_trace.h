@@ -0,0 +1,17 @@
+// File: benchmarks/timing_wheel_bench_trace.h
+// Description:
+// Forced into every source file of the timing wheel benchmark with -include,
+// so the kernel calls timing_wheel_bench_delay() when vTaskDelay() starts to
+// block a task, and timing_wheel_bench_switched_out() when the task is
+// switched out.
+
+#ifndef TIMING_WHEEL_BENCH_TRACE_H
+#define TIMING_WHEEL_BENCH_TRACE_H
+
+void timing_wheel_bench_delay(void);
+void timing_wheel_bench_switched_out(void);
+
+#define traceTASK_DELAY() timing_wheel_bench_delay()
+#define traceTASK_SWITCHED_OUT() timing_wheel_bench_switched_out()
+
+#endif // TIMING_WHEEL_BENCH_TRACE_H
@@ -0,0 +1,153 @@
+// File: benchmarks/wake_bench.c
+// Description:
+// Measures the time the tick interrupt spends on a tick on which many tasks
+// time out together.  WAKE_TASKS tasks share a period of WAKE_PERIOD ticks,
+// so every WAKE_PERIOD ticks they all wake on the same tick.  The time from
+// entry to xTaskIncrementTick() to the tick hook is recorded for RUN_TICKS
+// ticks, and the median, 90th percentile and maximum of the ticks on which
+// the tasks wake are printed, with the average of the other ticks.
+//
+// The benchmark is built with configUSE_BATCHED_WAKEUPS set to 0, then to 1
+// with configBATCHED_WAKEUP_LIMIT set to 4 and to 0.  Build and run all three
+// on one core with:
+//
+//     make wake_bench
+//
+// The wake counts should be the same for all three.  A task counts as late if
+// it runs after the tick it woke on, which on a busy host happens a few dozen
+// times per run whatever the setting.  Times are host times, so compare the
+// runs with each other rather than with a target.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef WAKE_TASKS
+#define WAKE_TASKS        40
+#endif
+
+#ifndef WAKE_PERIOD
+#define WAKE_PERIOD       10
+#endif
+
+#ifndef RUN_TICKS
+#define RUN_TICKS         5000
+#endif
+
+#define CONTROL_PRIORITY      4
+#define WAKE_PRIORITY_BASE    1
+#define TASK_STACK_SIZE       2048
+
+static struct timespec tick_start;
+
+// Written from the tick, read by the control task once the run is over.
+static long wake_tick_ns[RUN_TICKS / WAKE_PERIOD + 1];
+static uint32_t wake_ticks;
+static long long other_tick_ns;
+static uint32_t other_ticks;
+static volatile int recording;
+
+// Written by the wake tasks.
+static volatile uint32_t wakes;
+static volatile uint32_t late_wakes;
+
+void wake_bench_tick_start(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &tick_start);
+}
+
+void vApplicationTickHook(void)
+{
+    struct timespec now;
+    long elapsed;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    elapsed = (now.tv_sec - tick_start.tv_sec) * 1000000000L + (now.tv_nsec - tick_start.tv_nsec);
+
+    if (!recording)
+    {
+        return;
+    }
+
+    if ((xTaskGetTickCountFromISR() % WAKE_PERIOD) == 0)
+    {
+        if (wake_ticks < sizeof(wake_tick_ns) / sizeof(wake_tick_ns[0]))
+        {
+            wake_tick_ns[wake_ticks++] = elapsed;
+        }
+    }
+    else
+    {
+        other_tick_ns += elapsed;
+        other_ticks++;
+    }
+}
+
+static void wake_task(void *pvParameters)
+{
+    (void) pvParameters;
+    TickType_t last_wake = 0;
+
+    for (;;)
+    {
+        vTaskDelayUntil(&last_wake, WAKE_PERIOD);
+
+        if (xTaskGetTickCount() != last_wake)
+        {
+            late_wakes++;
+        }
+        wakes++;
+    }
+}
+
+static int compare_ns(const void *a, const void *b)
+{
+    long x = *(const long *) a;
+    long y = *(const long *) b;
+
+    return (x > y) - (x < y);
+}
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    // Let every wake task block once before recording.
+    vTaskDelay(WAKE_PERIOD);
+    wakes = 0;
+    late_wakes = 0;
+    recording = 1;
+    vTaskDelay(RUN_TICKS);
+    recording = 0;
+
+    qsort(wake_tick_ns, wake_ticks, sizeof(wake_tick_ns[0]), compare_ns);
+
+#if (configUSE_BATCHED_WAKEUPS == 1)
+    printf("batched, limit %-2d", configBATCHED_WAKEUP_LIMIT);
+#else
+    printf("unbatched        ");
+#endif
+    printf(" %d tasks every %d ticks: wake tick median %5ld p90 %5ld max %6ld ns,"
+           " other ticks avg %4lld ns, %u wakes, %u late\n",
+           WAKE_TASKS, WAKE_PERIOD, wake_tick_ns[wake_ticks / 2], wake_tick_ns[wake_ticks * 9 / 10],
+           wake_tick_ns[wake_ticks - 1], other_tick_ns / (other_ticks ? other_ticks : 1),
+           (unsigned) wakes, (unsigned) late_wakes);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    for (int i = 0; i < WAKE_TASKS; i++)
+    {
+        xTaskCreate(wake_task, "Wake", TASK_STACK_SIZE, NULL, WAKE_PRIORITY_BASE + (i % 3), NULL);
+    }
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, CONTROL_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    return 0;
+}
@@ -0,0 +1,13 @@
+// File: benchmarks/wake_bench_trace.h
+// Description:
+// Forced into every source file of the wake benchmark with -include, so the
+// kernel calls wake_bench_tick_start() on entry to xTaskIncrementTick().
+
+#ifndef WAKE_BENCH_TRACE_H
+#define WAKE_BENCH_TRACE_H
+
+void wake_bench_tick_start(void);
+
+#define traceTASK_INCREMENT_TICK(xTickCount) wake_bench_tick_start()
+
+#endif // WAKE_BENCH_TRACE_H
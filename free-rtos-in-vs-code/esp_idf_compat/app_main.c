@@ -0,0 +1,30 @@
+// Starts an ESP-IDF style application on the Linux build: app_main() runs in
+// a task of priority 1 on core 0, as it does on the ESP32.
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define MAIN_TASK_STACK_SIZE 4096
+
+void app_main(void);
+
+static void main_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    app_main();
+
+    vTaskDelete(NULL);
+}
+
+int main(void)
+{
+    printf("Starting FreeRTOS on %d simulated cores...\n", configNUMBER_OF_CORES);
+
+    xTaskCreatePinnedToCore(main_task, "main", MAIN_TASK_STACK_SIZE, NULL, 1, NULL, 0);
+
+    vTaskStartScheduler();
+
+    // Only reached if the scheduler is stopped with vTaskEndScheduler()
+    return 0;
+}
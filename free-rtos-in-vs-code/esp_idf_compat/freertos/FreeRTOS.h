@@ -0,0 +1,7 @@
+// ESP-IDF compatible <freertos/FreeRTOS.h> for the Linux build.
+#ifndef ESP_IDF_COMPAT_FREERTOS_H
+#define ESP_IDF_COMPAT_FREERTOS_H
+
+#include <FreeRTOS.h>
+
+#endif // ESP_IDF_COMPAT_FREERTOS_H
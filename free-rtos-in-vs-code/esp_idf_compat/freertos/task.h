@@ -0,0 +1,34 @@
+// ESP-IDF compatible <freertos/task.h> for the Linux build.
+#ifndef ESP_IDF_COMPAT_TASK_H
+#define ESP_IDF_COMPAT_TASK_H
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+// Create a task that only runs on core xCoreID, or on any core if xCoreID is
+// tskNO_AFFINITY.  As on a single core ESP32, the core is ignored when there
+// is only one.
+static inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode,
+                                                 const char * const pcName,
+                                                 const uint32_t ulStackDepth,
+                                                 void * const pvParameters,
+                                                 UBaseType_t uxPriority,
+                                                 TaskHandle_t * const pxCreatedTask,
+                                                 const BaseType_t xCoreID)
+{
+#if (configNUMBER_OF_CORES > 1)
+    if ((UBaseType_t) xCoreID != tskNO_AFFINITY)
+    {
+        configASSERT((xCoreID >= 0) && (xCoreID < configNUMBER_OF_CORES));
+        return xTaskCreateAffinitySet(pxTaskCode, pcName, (configSTACK_DEPTH_TYPE) ulStackDepth,
+                                      pvParameters, uxPriority, (UBaseType_t) 1U << xCoreID,
+                                      pxCreatedTask);
+    }
+#else
+    (void) xCoreID;
+#endif
+    return xTaskCreate(pxTaskCode, pcName, (configSTACK_DEPTH_TYPE) ulStackDepth,
+                       pvParameters, uxPriority, pxCreatedTask);
+}
+
+#endif // ESP_IDF_COMPAT_TASK_H
@@ -0,0 +1,743 @@
+/*
+ * FreeRTOS Kernel V10.3.1 - Linux multi-core simulator port.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the Linux
+ * multi-core simulator port.  See portmacro.h for an overview.
+ *----------------------------------------------------------*/
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The signal used to interrupt a core. */
+#define portINTERRUPT_SIGNAL		SIGUSR1
+
+/* Pending interrupt flags, one set per core. */
+#define portPENDING_TICK			( 1UL << 0UL )
+#define portPENDING_YIELD			( 1UL << 1UL )
+#define portPENDING_STOP			( 1UL << 2UL )
+#define portPENDING_ALARM			( 1UL << 3UL )
+
+#define portNO_CORE					( ( BaseType_t ) -1 )
+#define portNANOSECONDS_PER_SECOND	( 1000000000L )
+#define portNANOSECONDS_PER_MICROSECOND	( 1000L )
+
+/* The state of a task's thread.  It is held at the top of the task's stack,
+which the thread does not otherwise use. */
+typedef struct THREAD
+{
+	pthread_t xThread;
+	sem_t xWake;					/* Posted to let the thread run. */
+	TaskFunction_t pxCode;
+	void *pvParameters;
+	volatile BaseType_t xCoreID;	/* The core the thread runs on when it is next woken. */
+	volatile BaseType_t xExiting;	/* Set when the task has been deleted. */
+} Thread_t;
+
+/* A spinlock that the core holding it may take again. */
+typedef struct CORE_LOCK
+{
+	BaseType_t xOwner;
+	UBaseType_t uxCount;
+} CoreLock_t;
+
+/*
+ * The thread that raises the tick interrupt on core 0.
+ */
+static void *prvTimerThread( void *pvParameters );
+
+#if ( configUSE_MICROSECOND_DELAYS == 1 )
+
+	/*
+	 * The thread that raises the microsecond alarm interrupt on core 0 when
+	 * the microsecond count reaches the alarm.
+	 */
+	static void *prvAlarmThread( void *pvParameters );
+
+#endif /* configUSE_MICROSECOND_DELAYS */
+
+/*
+ * The function each task thread starts in.
+ */
+static void *prvTaskThread( void *pvParameters );
+
+/*
+ * Wait until a core is handed to the calling thread.
+ */
+static void prvWaitToRun( Thread_t *pxThread );
+
+/*
+ * Select the next task to run on the calling core, and hand the core to its
+ * thread.  Called with interrupts masked.
+ */
+static void prvSwitchThread( void );
+
+/*
+ * Handle the interrupts pending on the calling core.  Called with interrupts
+ * unmasked, from a task or from the signal handler.
+ */
+static void prvServiceInterrupts( void );
+
+/*
+ * The signal handler through which a core is interrupted.
+ */
+static void prvInterruptHandler( int iSignal );
+
+/*
+ * Raise interrupts on a core, and signal the thread it is running.
+ */
+static void prvPendInterrupt( BaseType_t xCoreID, uint32_t ulInterrupts );
+/*-----------------------------------------------------------*/
+
+/* Per thread state.  A thread is only ever on one core, and a core only runs
+one thread, so these are also the state of the core the thread runs on. */
+static __thread BaseType_t xThisCore = portNO_CORE;
+static __thread Thread_t *pxThisThread = NULL;
+static __thread volatile UBaseType_t uxInterruptsMasked = pdTRUE;
+
+/* Set when the task of the calling thread is cleaned up while it is being
+switched out, as a task pool slot is when its task deleted itself.  The
+thread then exits as soon as it has handed over its core. */
+static __thread BaseType_t xThisThreadDeleted = pdFALSE;
+
+/* The thread running on each core.  Updated, and signalled, with
+cCoreThreadsLock held. */
+static Thread_t * volatile xCoreThreads[ configNUMBER_OF_CORES ];
+static volatile char cCoreThreadsLock = 0;
+
+static volatile uint32_t ulPendingInterrupts[ configNUMBER_OF_CORES ];
+
+static CoreLock_t xCoreLocks[ 2 ] = { { portNO_CORE, 0 }, { portNO_CORE, 0 } };
+
+static pthread_t xTimerThread;
+static volatile BaseType_t xTimerRunning = pdFALSE;
+static sem_t xSchedulerEnd;
+
+#if ( configUSE_MICROSECOND_DELAYS == 1 )
+
+	/* The alarm set by vPortSetMicrosecondAlarm(), guarded by xAlarmMutex.
+	xAlarmChanged is signalled whenever it is set, and when the scheduler
+	ends. */
+	static pthread_t xAlarmThread;
+	static pthread_mutex_t xAlarmMutex = PTHREAD_MUTEX_INITIALIZER;
+	static pthread_cond_t xAlarmChanged;
+	static uint32_t ulAlarmCount = 0UL;
+	static BaseType_t xAlarmArmed = pdFALSE;
+
+#endif /* configUSE_MICROSECOND_DELAYS */
+/*-----------------------------------------------------------*/
+
+static Thread_t *prvGetThreadFromTask( TaskHandle_t xTask )
+{
+StackType_t *pxTopOfStack = *( StackType_t ** ) xTask;
+
+	return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvLockCoreThreads( void )
+{
+	while( __atomic_test_and_set( &cCoreThreadsLock, __ATOMIC_ACQUIRE ) )
+	{
+		sched_yield();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnlockCoreThreads( void )
+{
+	__atomic_clear( &cCoreThreadsLock, __ATOMIC_RELEASE );
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+Thread_t *pxThread;
+sigset_t xSignals, xSavedSignals;
+UBaseType_t uxSavedInterruptStatus;
+int iResult;
+
+	pxThread = ( Thread_t * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pxTopOfStack + 1 ) - sizeof( Thread_t ) ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) );
+	pxTopOfStack = ( StackType_t * ) pxThread - 1;
+
+	memset( pxThread, 0, sizeof( Thread_t ) );
+	pxThread->pxCode = pxCode;
+	pxThread->pvParameters = pvParameters;
+	pxThread->xCoreID = portNO_CORE;
+	pxThread->xExiting = pdFALSE;
+	( void ) sem_init( &( pxThread->xWake ), 0, 0 );
+
+	/* The thread starts with the interrupt signal blocked, and unblocks it
+	once it first runs.  Interrupts are masked while the thread is created so
+	the calling task is not switched out while it holds C library locks. */
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portINTERRUPT_SIGNAL );
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+	{
+		( void ) pthread_sigmask( SIG_BLOCK, &xSignals, &xSavedSignals );
+		iResult = pthread_create( &( pxThread->xThread ), NULL, prvTaskThread, pxThread );
+		( void ) pthread_sigmask( SIG_SETMASK, &xSavedSignals, NULL );
+	}
+	portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+
+	configASSERT( iResult == 0 );
+	( void ) iResult;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+struct sigaction xAction;
+sigset_t xSignals;
+BaseType_t xCoreID;
+Thread_t *pxThread;
+
+	( void ) sem_init( &xSchedulerEnd, 0, 0 );
+
+	memset( &xAction, 0, sizeof( xAction ) );
+	xAction.sa_handler = prvInterruptHandler;
+	sigemptyset( &( xAction.sa_mask ) );
+	( void ) sigaction( portINTERRUPT_SIGNAL, &xAction, NULL );
+
+	/* The thread that started the scheduler is not a core, so is never
+	interrupted, and nor is the timer thread it creates. */
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portINTERRUPT_SIGNAL );
+	( void ) pthread_sigmask( SIG_BLOCK, &xSignals, NULL );
+
+	/* vTaskStartScheduler() has already selected a task for every core. */
+	prvLockCoreThreads();
+	{
+		for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+		{
+			#if ( configNUMBER_OF_CORES > 1 )
+				pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+			#else
+				pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+			#endif
+			pxThread->xCoreID = xCoreID;
+			xCoreThreads[ xCoreID ] = pxThread;
+		}
+	}
+	prvUnlockCoreThreads();
+
+	for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+	{
+		( void ) sem_post( &( xCoreThreads[ xCoreID ]->xWake ) );
+	}
+
+	xTimerRunning = pdTRUE;
+	( void ) pthread_create( &xTimerThread, NULL, prvTimerThread, NULL );
+
+	#if ( configUSE_MICROSECOND_DELAYS == 1 )
+	{
+	pthread_condattr_t xAttributes;
+
+		( void ) pthread_condattr_init( &xAttributes );
+		( void ) pthread_condattr_setclock( &xAttributes, CLOCK_MONOTONIC );
+		( void ) pthread_cond_init( &xAlarmChanged, &xAttributes );
+		( void ) pthread_condattr_destroy( &xAttributes );
+
+		( void ) pthread_create( &xAlarmThread, NULL, prvAlarmThread, NULL );
+	}
+	#endif /* configUSE_MICROSECOND_DELAYS */
+
+	/* Wait for vTaskEndScheduler(). */
+	while( sem_wait( &xSchedulerEnd ) != 0 )
+	{
+	}
+
+	xTimerRunning = pdFALSE;
+	( void ) pthread_join( xTimerThread, NULL );
+
+	#if ( configUSE_MICROSECOND_DELAYS == 1 )
+	{
+		( void ) pthread_mutex_lock( &xAlarmMutex );
+		( void ) pthread_cond_signal( &xAlarmChanged );
+		( void ) pthread_mutex_unlock( &xAlarmMutex );
+
+		( void ) pthread_join( xAlarmThread, NULL );
+	}
+	#endif /* configUSE_MICROSECOND_DELAYS */
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+BaseType_t xCoreID;
+
+	( void ) uxPortSetInterruptMask();
+
+	for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+	{
+		if( xCoreID != xThisCore )
+		{
+			prvPendInterrupt( xCoreID, portPENDING_STOP );
+		}
+	}
+
+	( void ) sem_post( &xSchedulerEnd );
+
+	/* This core stops too. */
+	for( ;; )
+	{
+		( void ) pause();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortGetCoreID( void )
+{
+	return xThisCore;
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldCore( BaseType_t xCoreID )
+{
+	if( xCoreID == xThisCore )
+	{
+		__atomic_or_fetch( &( ulPendingInterrupts[ xCoreID ] ), portPENDING_YIELD, __ATOMIC_SEQ_CST );
+
+		if( uxInterruptsMasked == pdFALSE )
+		{
+			prvServiceInterrupts();
+		}
+	}
+	else
+	{
+		prvPendInterrupt( xCoreID, portPENDING_YIELD );
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMask( void )
+{
+UBaseType_t uxSavedInterruptStatus = uxInterruptsMasked;
+
+	uxInterruptsMasked = pdTRUE;
+	__atomic_signal_fence( __ATOMIC_SEQ_CST );
+
+	return uxSavedInterruptStatus;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxSavedInterruptStatus )
+{
+	__atomic_signal_fence( __ATOMIC_SEQ_CST );
+	uxInterruptsMasked = uxSavedInterruptStatus;
+
+	/* Interrupts raised while the mask was set are taken now.  One raised
+	after this check signals the thread again. */
+	if( ( uxSavedInterruptStatus == pdFALSE ) && ( xThisCore != portNO_CORE ) )
+	{
+		if( __atomic_load_n( &( ulPendingInterrupts[ xThisCore ] ), __ATOMIC_SEQ_CST ) != 0UL )
+		{
+			prvServiceInterrupts();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetLock( BaseType_t xLock )
+{
+CoreLock_t *pxLock = &( xCoreLocks[ xLock ] );
+BaseType_t xFree;
+
+	/* Only the owner writes uxCount, and the owner can only change while the
+	lock is free. */
+	if( __atomic_load_n( &( pxLock->xOwner ), __ATOMIC_ACQUIRE ) != xThisCore )
+	{
+		for( ;; )
+		{
+			xFree = portNO_CORE;
+
+			if( __atomic_compare_exchange_n( &( pxLock->xOwner ), &xFree, xThisCore, pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+			{
+				break;
+			}
+
+			sched_yield();
+		}
+	}
+
+	pxLock->uxCount++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortReleaseLock( BaseType_t xLock )
+{
+CoreLock_t *pxLock = &( xCoreLocks[ xLock ] );
+
+	configASSERT( pxLock->xOwner == xThisCore );
+	configASSERT( pxLock->uxCount > 0U );
+
+	pxLock->uxCount--;
+
+	if( pxLock->uxCount == 0U )
+	{
+		__atomic_store_n( &( pxLock->xOwner ), portNO_CORE, __ATOMIC_RELEASE );
+	}
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortMicrosecondCount( void )
+{
+struct timespec xNow;
+
+	( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+	return ( uint32_t ) ( ( ( uint64_t ) xNow.tv_sec * 1000000ULL ) + ( ( uint64_t ) xNow.tv_nsec / ( uint64_t ) portNANOSECONDS_PER_MICROSECOND ) );
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetMicrosecondAlarm( uint32_t ulCount )
+{
+	#if ( configUSE_MICROSECOND_DELAYS == 1 )
+	{
+		/* Called by the kernel with interrupts masked, so the calling task
+		cannot be switched out while it holds the mutex. */
+		( void ) pthread_mutex_lock( &xAlarmMutex );
+		{
+			ulAlarmCount = ulCount;
+			xAlarmArmed = pdTRUE;
+			( void ) pthread_cond_signal( &xAlarmChanged );
+		}
+		( void ) pthread_mutex_unlock( &xAlarmMutex );
+	}
+	#else
+	{
+		( void ) ulCount;
+	}
+	#endif /* configUSE_MICROSECOND_DELAYS */
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTask( void *pxTCB )
+{
+Thread_t *pxThread = prvGetThreadFromTask( ( TaskHandle_t ) pxTCB );
+UBaseType_t uxSavedInterruptStatus;
+
+	/* The task is not running, so its thread is waiting to be woken, or is
+	about to wait.  It exits when it is woken.  As in
+	pxPortInitialiseStack(), interrupts are masked so the calling task is not
+	switched out while pthread_join() holds C library locks that the next
+	pthread_create() needs. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+	{
+		if( pxThread == pxThisThread )
+		{
+			/* vTaskSwitchContext() is returning the task pool slot of the
+			task that deleted itself, on that task's own thread, which cannot
+			join itself.  It exits from prvSwitchThread() instead. */
+			( void ) pthread_detach( pxThread->xThread );
+			xThisThreadDeleted = pdTRUE;
+		}
+		else
+		{
+			pxThread->xExiting = pdTRUE;
+			( void ) sem_post( &( pxThread->xWake ) );
+			( void ) pthread_join( pxThread->xThread, NULL );
+		}
+
+		( void ) sem_destroy( &( pxThread->xWake ) );
+	}
+	portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+/* The idle task waits for an interrupt, unless the application provides an
+idle hook of its own. */
+__attribute__( ( weak ) ) void vApplicationIdleHook( void )
+{
+sigset_t xSignals, xSavedSignals;
+
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portINTERRUPT_SIGNAL );
+	( void ) pthread_sigmask( SIG_BLOCK, &xSignals, &xSavedSignals );
+
+	if( __atomic_load_n( &( ulPendingInterrupts[ xThisCore ] ), __ATOMIC_SEQ_CST ) == 0UL )
+	{
+		sigdelset( &xSavedSignals, portINTERRUPT_SIGNAL );
+		( void ) sigsuspend( &xSavedSignals );
+	}
+	else
+	{
+		sigdelset( &xSavedSignals, portINTERRUPT_SIGNAL );
+	}
+
+	( void ) pthread_sigmask( SIG_SETMASK, &xSavedSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTimerThread( void *pvParameters )
+{
+struct timespec xNext;
+const long lPeriod = portNANOSECONDS_PER_SECOND / ( long ) configTICK_RATE_HZ;
+
+	( void ) pvParameters;
+
+	( void ) clock_gettime( CLOCK_MONOTONIC, &xNext );
+
+	while( xTimerRunning != pdFALSE )
+	{
+		xNext.tv_nsec += lPeriod;
+
+		if( xNext.tv_nsec >= portNANOSECONDS_PER_SECOND )
+		{
+			xNext.tv_nsec -= portNANOSECONDS_PER_SECOND;
+			xNext.tv_sec++;
+		}
+
+		while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xNext, NULL ) == EINTR )
+		{
+		}
+
+		prvPendInterrupt( 0, portPENDING_TICK );
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MICROSECOND_DELAYS == 1 )
+
+	static void *prvAlarmThread( void *pvParameters )
+	{
+	struct timespec xWake;
+	int32_t lRemaining;
+	uint64_t ullNanoseconds;
+
+		( void ) pvParameters;
+
+		( void ) pthread_mutex_lock( &xAlarmMutex );
+
+		while( xTimerRunning != pdFALSE )
+		{
+			if( xAlarmArmed == pdFALSE )
+			{
+				( void ) pthread_cond_wait( &xAlarmChanged, &xAlarmMutex );
+				continue;
+			}
+
+			/* Alarms are compared by their signed distance from the count, as
+			the kernel does. */
+			lRemaining = ( int32_t ) ( ulAlarmCount - ulPortMicrosecondCount() );
+
+			if( lRemaining <= 0 )
+			{
+				xAlarmArmed = pdFALSE;
+
+				( void ) pthread_mutex_unlock( &xAlarmMutex );
+				prvPendInterrupt( 0, portPENDING_ALARM );
+				( void ) pthread_mutex_lock( &xAlarmMutex );
+			}
+			else
+			{
+				/* Wait for the alarm time, or for the alarm to be moved. */
+				( void ) clock_gettime( CLOCK_MONOTONIC, &xWake );
+				ullNanoseconds = ( uint64_t ) xWake.tv_nsec + ( ( uint64_t ) lRemaining * ( uint64_t ) portNANOSECONDS_PER_MICROSECOND );
+				xWake.tv_sec += ( time_t ) ( ullNanoseconds / ( uint64_t ) portNANOSECONDS_PER_SECOND );
+				xWake.tv_nsec = ( long ) ( ullNanoseconds % ( uint64_t ) portNANOSECONDS_PER_SECOND );
+
+				( void ) pthread_cond_timedwait( &xAlarmChanged, &xAlarmMutex, &xWake );
+			}
+		}
+
+		( void ) pthread_mutex_unlock( &xAlarmMutex );
+
+		return NULL;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_MICROSECOND_DELAYS */
+
+static void *prvTaskThread( void *pvParameters )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParameters;
+sigset_t xSignals;
+
+	prvWaitToRun( pxThread );
+
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portINTERRUPT_SIGNAL );
+	( void ) pthread_sigmask( SIG_UNBLOCK, &xSignals, NULL );
+
+	/* Tasks start with interrupts enabled. */
+	vPortClearInterruptMask( pdFALSE );
+
+	pxThread->pxCode( pxThread->pvParameters );
+
+	/* Tasks must not return, but a task that does is deleted. */
+	vTaskDelete( NULL );
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitToRun( Thread_t *pxThread )
+{
+	while( sem_wait( &( pxThread->xWake ) ) != 0 )
+	{
+	}
+
+	if( pxThread->xExiting != pdFALSE )
+	{
+		pthread_exit( NULL );
+	}
+
+	pxThisThread = pxThread;
+	xThisCore = pxThread->xCoreID;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( void )
+{
+Thread_t * const pxThread = pxThisThread;
+const BaseType_t xCoreID = xThisCore;
+Thread_t *pxNextThread;
+
+	vTaskSwitchContext();
+
+	#if ( configNUMBER_OF_CORES > 1 )
+		pxNextThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+	#else
+		pxNextThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+	#endif
+
+	if( pxNextThread != pxThread )
+	{
+		pxNextThread->xCoreID = xCoreID;
+
+		prvLockCoreThreads();
+		{
+			xCoreThreads[ xCoreID ] = pxNextThread;
+		}
+		prvUnlockCoreThreads();
+
+		( void ) sem_post( &( pxNextThread->xWake ) );
+
+		/* The Thread_t of a deleted pool task is in the slot's stack, which
+		the next task may already be reusing, so it is not touched again. */
+		if( xThisThreadDeleted != pdFALSE )
+		{
+			pthread_exit( NULL );
+		}
+
+		/* Wait until this thread's task is selected again, possibly on
+		another core. */
+		prvWaitToRun( pxThread );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvServiceInterrupts( void )
+{
+uint32_t ulPending;
+BaseType_t xSwitchRequired;
+UBaseType_t uxSavedInterruptStatus;
+
+	do
+	{
+		uxInterruptsMasked = pdTRUE;
+		__atomic_signal_fence( __ATOMIC_SEQ_CST );
+
+		ulPending = __atomic_exchange_n( &( ulPendingInterrupts[ xThisCore ] ), 0UL, __ATOMIC_SEQ_CST );
+
+		if( ( ulPending & portPENDING_STOP ) != 0UL )
+		{
+			/* The scheduler has ended. */
+			for( ;; )
+			{
+				( void ) pause();
+			}
+		}
+
+		xSwitchRequired = ( ( ulPending & portPENDING_YIELD ) != 0UL ) ? pdTRUE : pdFALSE;
+
+		if( ( ulPending & portPENDING_TICK ) != 0UL )
+		{
+			uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+			{
+				if( xTaskIncrementTick() != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+			}
+			taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+		}
+
+		#if ( configUSE_MICROSECOND_DELAYS == 1 )
+		{
+			if( ( ulPending & portPENDING_ALARM ) != 0UL )
+			{
+				if( xTaskMicrosecondAlarmFromISR() != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+			}
+		}
+		#endif /* configUSE_MICROSECOND_DELAYS */
+
+		if( xSwitchRequired != pdFALSE )
+		{
+			/* The thread may be on another core when this returns. */
+			prvSwitchThread();
+		}
+
+		__atomic_signal_fence( __ATOMIC_SEQ_CST );
+		uxInterruptsMasked = pdFALSE;
+
+	} while( __atomic_load_n( &( ulPendingInterrupts[ xThisCore ] ), __ATOMIC_SEQ_CST ) != 0UL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInterruptHandler( int iSignal )
+{
+const int iSavedErrno = errno;
+
+	( void ) iSignal;
+
+	/* Masked interrupts are taken when the mask is cleared. */
+	if( ( uxInterruptsMasked == pdFALSE ) && ( pxThisThread != NULL ) && ( xCoreThreads[ xThisCore ] == pxThisThread ) )
+	{
+		prvServiceInterrupts();
+	}
+
+	errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPendInterrupt( BaseType_t xCoreID, uint32_t ulInterrupts )
+{
+	__atomic_or_fetch( &( ulPendingInterrupts[ xCoreID ] ), ulInterrupts, __ATOMIC_SEQ_CST );
+
+	prvLockCoreThreads();
+	{
+		if( xCoreThreads[ xCoreID ] != NULL )
+		{
+			( void ) pthread_kill( xCoreThreads[ xCoreID ]->xThread, portINTERRUPT_SIGNAL );
+		}
+	}
+	prvUnlockCoreThreads();
+}
+/*-----------------------------------------------------------*/
+
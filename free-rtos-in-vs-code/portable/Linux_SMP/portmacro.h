@@ -0,0 +1,158 @@
+/*
+ * FreeRTOS Kernel V10.3.1 - Linux multi-core simulator port.
+ *
+ * Every task runs in a thread of its own, and each of the configNUMBER_OF_CORES
+ * simulated cores lets exactly one of those threads run at a time.  The other
+ * task threads wait on a semaphore until a context switch hands a core to them.
+ * Interrupts are simulated: each core has a set of pending interrupt flags and
+ * a software interrupt mask, and a core is interrupted by sending SIGUSR1 to
+ * the thread it is running.  The tick interrupt is raised on core 0 by a timer
+ * thread.
+ *
+ * A task can be preempted while it is inside the C library, for example in
+ * printf(), so a task that calls into the C library while another task may be
+ * preempted there can be held up until that task runs again.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions.  BaseType_t is an int so that core numbers and the like
+print with %d, as they do on the ESP32. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	unsigned long
+#define portBASE_TYPE	int
+#define portPOINTER_SIZE_TYPE	uint64_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* Aligned 32-bit reads are atomic on the host. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portNOP()
+#define portMEMORY_BARRIER()		__sync_synchronize()
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities.  A yield is an interrupt like any other, so a yield
+requested with interrupts masked happens when they are unmasked. */
+extern BaseType_t xPortGetCoreID( void );
+extern void vPortYieldCore( BaseType_t xCoreID );
+#define portGET_CORE_ID()						xPortGetCoreID()
+#define portYIELD_CORE( xCoreID )				vPortYieldCore( xCoreID )
+#define portYIELD()								vPortYieldCore( xPortGetCoreID() )
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired != pdFALSE ) portYIELD()
+#define portYIELD_FROM_ISR( x )					portEND_SWITCHING_ISR( x )
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  The critical nesting count is held in the
+TCB, and the task and ISR locks are recursive spinlocks. */
+extern UBaseType_t uxPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( UBaseType_t uxSavedInterruptStatus );
+extern void vPortGetLock( BaseType_t xLock );
+extern void vPortReleaseLock( BaseType_t xLock );
+extern void vTaskEnterCritical( void );
+extern void vTaskExitCritical( void );
+
+#define portCRITICAL_NESTING_IN_TCB				1
+#define portSET_INTERRUPT_MASK()				uxPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK( x )			vPortClearInterruptMask( x )
+#define portSET_INTERRUPT_MASK_FROM_ISR()		uxPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )	vPortClearInterruptMask( x )
+#define portDISABLE_INTERRUPTS()				( void ) uxPortSetInterruptMask()
+#define portENABLE_INTERRUPTS()					vPortClearInterruptMask( pdFALSE )
+#define portENTER_CRITICAL()					vTaskEnterCritical()
+#define portEXIT_CRITICAL()						vTaskExitCritical()
+
+#define portTASK_LOCK							0
+#define portISR_LOCK							1
+#define portGET_TASK_LOCK()						vPortGetLock( portTASK_LOCK )
+#define portRELEASE_TASK_LOCK()					vPortReleaseLock( portTASK_LOCK )
+#define portGET_ISR_LOCK()						vPortGetLock( portISR_LOCK )
+#define portRELEASE_ISR_LOCK()					vPortReleaseLock( portISR_LOCK )
+/*-----------------------------------------------------------*/
+
+/* Architecture specific optimisations.  The SMP scheduler does not use the
+ready priority bitmap, so this is only available on one core. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#endif
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Check the configuration.  Above 32 priorities the kernel keeps the ready
+	priorities in a two level bitmap built on the macros below, which covers
+	32 groups of 32 priorities. */
+	#if( configMAX_PRIORITIES > 1024 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31UL - ( uint32_t ) __builtin_clz( ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* The microsecond time is the host's monotonic clock.  An alarm raises an
+interrupt on core 0, which calls xTaskMicrosecondAlarmFromISR() when
+configUSE_MICROSECOND_DELAYS is 1. */
+extern uint32_t ulPortMicrosecondCount( void );
+extern void vPortSetMicrosecondAlarm( uint32_t ulCount );
+/*-----------------------------------------------------------*/
+
+/* The thread of a deleted task is stopped when its TCB is freed. */
+extern void vPortCleanUpTask( void *pxTCB );
+#define portCLEAN_UP_TCB( pxTCB )				vPortCleanUpTask( pxTCB )
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site.  These are
+not necessary for to use this port.  They are defined so the common demo files
+(which build with all the ports) will build. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
+
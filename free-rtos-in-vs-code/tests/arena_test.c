@@ -0,0 +1,245 @@
+// File: tests/arena_test.c
+// Description:
+// Checks the per-task arenas of configUSE_TASK_ARENAS, with the task pool
+// (configUSE_TASK_POOL) on, and times them against pvPortMalloc().
+//
+// - alloc: allocations are aligned to portBYTE_ALIGNMENT, do not overlap,
+//   and only take a chunk from the heap when the current one is full.
+// - reset: after vTaskArenaReset() the arena hands out the same memory
+//   again, without the heap growing or shrinking.
+// - oversize: an allocation larger than configTASK_ARENA_CHUNK_SIZE gets a
+//   chunk of its own.
+// - delete: the chunks of a task are returned to the heap when another task
+//   deletes it, and when a pool task deletes itself, in which case its slot
+//   must also be back in the pool before the idle task has run.
+//
+// Printed are the time per allocation from the arena, including its share
+// of the reset, and from pvPortMalloc() and vPortFree(), for ROUNDS rounds of
+// ALLOCS allocations of ALLOC_SIZE bytes.  The test fails if any check does
+// not hold.  Build and run with:
+//
+//     make test
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_ARENAS != 1) || (configUSE_TASK_POOL != 1)
+#error The test needs configUSE_TASK_ARENAS and configUSE_TASK_POOL set to 1.
+#endif
+
+#ifndef ROUNDS
+#define ROUNDS            20000
+#endif
+
+#ifndef ALLOCS
+#define ALLOCS            16
+#endif
+
+#ifndef ALLOC_SIZE
+#define ALLOC_SIZE        24
+#endif
+
+#define CONTROL_PRIORITY  3
+#define WORKER_PRIORITY   4
+#define TASK_STACK_SIZE   2048
+
+// Small enough to take a pool slot.
+#define WORKER_STACK_SIZE configMINIMAL_STACK_SIZE
+
+// Enough allocations to fill several chunks.
+#define FILL_ALLOCS       (4 * configTASK_ARENA_CHUNK_SIZE / ALLOC_SIZE)
+
+static void *first_allocs[FILL_ALLOCS];
+static void *pointers[ALLOCS];
+static int failures;
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    static StaticTask_t idle_buffer;
+    static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+
+    *ppxIdleTaskTCBBuffer = &idle_buffer;
+    *ppxIdleTaskStackBuffer = idle_stack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+static void check(int condition, const char *what)
+{
+    if (!condition)
+    {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static uint64_t ns_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+}
+
+// Allocates FILL_ALLOCS blocks, fills each with its index, and checks their
+// alignment and that none has been overwritten by another.
+static void fill_arena(void **allocs)
+{
+    for (int i = 0; i < FILL_ALLOCS; i++)
+    {
+        allocs[i] = pvTaskArenaAlloc(ALLOC_SIZE);
+        check(allocs[i] != NULL, "alloc returned NULL");
+        check(((uintptr_t) allocs[i] & portBYTE_ALIGNMENT_MASK) == 0, "alloc is not aligned");
+        memset(allocs[i], i & 0xff, ALLOC_SIZE);
+    }
+
+    for (int i = 0; i < FILL_ALLOCS; i++)
+    {
+        const uint8_t *bytes = allocs[i];
+
+        for (int j = 0; j < ALLOC_SIZE; j++)
+        {
+            if (bytes[j] != (uint8_t) (i & 0xff))
+            {
+                check(0, "allocs overlap");
+                break;
+            }
+        }
+    }
+}
+
+static void arena_worker_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    fill_arena(first_allocs);
+    check(pvTaskArenaAlloc(2 * configTASK_ARENA_CHUNK_SIZE) != NULL, "oversize alloc in worker returned NULL");
+
+    // Deleting itself with chunks held.
+    vTaskDelete(NULL);
+}
+
+static void blocked_worker_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    fill_arena(first_allocs);
+    vTaskSuspend(NULL);
+}
+
+static void test_alloc_and_reset(void)
+{
+    void *allocs[FILL_ALLOCS];
+    size_t free_before, free_filled;
+    void *big;
+
+    free_before = xPortGetFreeHeapSize();
+
+    // alloc
+    pvTaskArenaAlloc(1);
+    check(xPortGetFreeHeapSize() < free_before, "first alloc did not take a chunk");
+    free_filled = xPortGetFreeHeapSize();
+    pvTaskArenaAlloc(1);
+    check(xPortGetFreeHeapSize() == free_filled, "alloc that fits took another chunk");
+    vTaskArenaReset();
+
+    fill_arena(first_allocs);
+    free_filled = xPortGetFreeHeapSize();
+
+    // reset and reuse
+    vTaskArenaReset();
+    check(xPortGetFreeHeapSize() == free_filled, "reset changed the heap");
+    fill_arena(allocs);
+    check(xPortGetFreeHeapSize() == free_filled, "reuse after reset took more heap");
+    check(memcmp(allocs, first_allocs, sizeof(allocs)) == 0, "reuse after reset returned different memory");
+
+    // oversize
+    big = pvTaskArenaAlloc(2 * configTASK_ARENA_CHUNK_SIZE);
+    check(big != NULL, "oversize alloc returned NULL");
+    check(xPortGetFreeHeapSize() + 2 * configTASK_ARENA_CHUNK_SIZE <= free_filled, "oversize alloc did not take its own chunk");
+    if (big != NULL)
+    {
+        memset(big, 0xa5, 2 * configTASK_ARENA_CHUNK_SIZE);
+    }
+    vTaskArenaReset();
+}
+
+static void test_delete(void)
+{
+    TaskHandle_t worker;
+    TaskPoolStats_t stats;
+    size_t free_before;
+
+    // Deleted by another task.
+    free_before = xPortGetFreeHeapSize();
+    xTaskCreate(blocked_worker_task, "Worker", WORKER_STACK_SIZE, NULL, WORKER_PRIORITY, &worker);
+    check(xPortGetFreeHeapSize() < free_before, "worker took no chunks");
+    vTaskDelete(worker);
+    check(xPortGetFreeHeapSize() == free_before, "chunks not freed when the task was deleted");
+
+    // Deleted by itself.  The worker runs above this task, so the idle task
+    // cannot run before the checks.
+    xTaskCreate(arena_worker_task, "Worker", WORKER_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+    check(xPortGetFreeHeapSize() == free_before, "chunks not freed when the task deleted itself");
+    vTaskGetPoolStats(&stats);
+    check(stats.uxNumberOfFreeSlots == stats.uxNumberOfSlots, "slot not returned when the task deleted itself");
+}
+
+static void time_allocs(void)
+{
+    uint64_t start, arena_ns, heap_ns;
+
+    start = ns_now();
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        for (int i = 0; i < ALLOCS; i++)
+        {
+            pointers[i] = pvTaskArenaAlloc(ALLOC_SIZE);
+        }
+        vTaskArenaReset();
+    }
+    arena_ns = ns_now() - start;
+
+    start = ns_now();
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        for (int i = 0; i < ALLOCS; i++)
+        {
+            pointers[i] = pvPortMalloc(ALLOC_SIZE);
+        }
+        for (int i = 0; i < ALLOCS; i++)
+        {
+            vPortFree(pointers[i]);
+        }
+    }
+    heap_ns = ns_now() - start;
+
+    printf("arena_test: %d rounds of %d allocs of %d bytes, arena %.1f ns per alloc, pvPortMalloc %.1f ns per alloc\n",
+           ROUNDS, ALLOCS, ALLOC_SIZE, (double) arena_ns / (ROUNDS * ALLOCS), (double) heap_ns / (ROUNDS * ALLOCS));
+}
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    test_alloc_and_reset();
+    test_delete();
+    time_allocs();
+
+    printf("arena_test: %d failures\n", failures);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, CONTROL_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+// File: tests/edf_test.c
+// Description:
+// Checks earliest deadline first scheduling of the tasks at
+// configEDF_TASK_PRIORITY.
+//
+// The first part checks that a task made ready by a notification preempts
+// the running EDF task if, and only if, its deadline is earlier.  A waker
+// task releases a job of a sporadic task by registering it with a new
+// deadline and notifying it, and checks whether the sporadic task ran before
+// xTaskNotifyGive() returned.
+//
+// The second part runs a periodic task set with a utilisation of 0.9, above
+// the 0.69 bound of rate monotonic scheduling, for TEST_TICKS ticks.  Each
+// job takes a fixed number of ticks of execution, charged by the tick hook to
+// whichever task was running, so the schedule does not depend on the speed
+// of the host.  The set is schedulable by EDF, so every job must finish by
+// its deadline, and the kernel must not switch tasks more than
+// SWITCHES_PER_JOB times per job on average.
+//
+// The test fails if an event does not preempt when it should or preempts
+// when it should not, if a deadline is missed, or if there are too many
+// switches.  Build and run with:
+//
+//     make test
+
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_EDF_SCHEDULING != 1) || (configUSE_TICK_HOOK != 1)
+#error The test needs configUSE_EDF_SCHEDULING and configUSE_TICK_HOOK set to 1.
+#endif
+
+#ifndef WAKE_ROUNDS
+#define WAKE_ROUNDS       100
+#endif
+
+#ifndef TEST_TICKS
+#define TEST_TICKS        4000
+#endif
+
+#ifndef SWITCHES_PER_JOB
+#define SWITCHES_PER_JOB  3
+#endif
+
+#define CONTROL_PRIORITY  (configEDF_TASK_PRIORITY + 1)
+#define TASK_STACK_SIZE   2048
+
+// Each waker round releases the sporadic task with a deadline this many ticks
+// before or after the waker's own.
+#define WAKE_OFFSET       10
+
+#define PERIODIC_TASKS    3
+
+typedef struct
+{
+    TickType_t period;
+    TickType_t execution;
+    TaskHandle_t handle;
+    TickType_t release;
+
+    // Set by the task at the start of each job and counted down by the tick
+    // hook while the task runs.
+    volatile TickType_t remaining;
+    volatile TickType_t finish;
+
+    int jobs;
+    int misses;
+} periodic_t;
+
+// Utilisation 2/5 + 3/10 + 4/20 = 0.9, with deadlines equal to periods.
+static periodic_t periodic[PERIODIC_TASKS] =
+{
+    { .period = 5,  .execution = 2 },
+    { .period = 10, .execution = 3 },
+    { .period = 20, .execution = 4 },
+};
+
+static TaskHandle_t control_handle;
+static TaskHandle_t sporadic_handle;
+static volatile int sporadic_runs;
+
+static volatile int counting;
+static volatile unsigned switches;
+
+static int failures;
+
+void edf_test_switched_in(void)
+{
+    if (counting)
+    {
+        switches++;
+    }
+}
+
+void vApplicationTickHook(void)
+{
+    TaskHandle_t running = xTaskGetCurrentTaskHandle();
+
+    for (int i = 0; i < PERIODIC_TASKS; i++)
+    {
+        if ((periodic[i].handle == running) && (periodic[i].remaining > 0))
+        {
+            if (--periodic[i].remaining == 0)
+            {
+                periodic[i].finish = xTaskGetTickCountFromISR();
+            }
+        }
+    }
+}
+
+static void sporadic_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sporadic_runs++;
+    }
+}
+
+static void waker_task(void *pvParameters)
+{
+    (void) pvParameters;
+    int runs;
+
+    for (int round = 0; round < WAKE_ROUNDS; round++)
+    {
+        vTaskEDFRegister(NULL, 1000, 1000);
+
+        // An earlier deadline runs before the notify returns.
+        vTaskEDFRegister(sporadic_handle, 1000, 1000 - WAKE_OFFSET);
+        runs = sporadic_runs;
+        xTaskNotifyGive(sporadic_handle);
+        if (sporadic_runs == runs)
+        {
+            printf("FAIL round %d: earlier deadline did not preempt\n", round);
+            failures++;
+        }
+
+        // A later deadline waits until the waker blocks.
+        vTaskEDFRegister(sporadic_handle, 1000, 1000 + WAKE_OFFSET);
+        runs = sporadic_runs;
+        xTaskNotifyGive(sporadic_handle);
+        if (sporadic_runs != runs)
+        {
+            printf("FAIL round %d: later deadline preempted\n", round);
+            failures++;
+        }
+
+        vTaskDelay(1);
+    }
+
+    xTaskNotifyGive(control_handle);
+    vTaskDelete(NULL);
+}
+
+static void periodic_task(void *pvParameters)
+{
+    periodic_t *task = pvParameters;
+    TickType_t deadline;
+
+    for (;;)
+    {
+        task->remaining = task->execution;
+        while (task->remaining > 0)
+        {
+        }
+
+        // The tick that completed the job is counted against the deadline of
+        // the job, not the time this task got round to looking at it.
+        deadline = xTaskEDFGetDeadline(NULL);
+        if ((TickType_t) (task->finish - deadline - 1) < (portMAX_DELAY >> 1))
+        {
+            task->misses++;
+        }
+        task->jobs++;
+
+        vTaskEDFWaitForNextPeriod(&task->release);
+    }
+}
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+    int jobs = 0;
+    int misses = 0;
+
+    xTaskCreate(sporadic_task, "Sporadic", TASK_STACK_SIZE, NULL, configEDF_TASK_PRIORITY, &sporadic_handle);
+    xTaskCreate(waker_task, "Waker", TASK_STACK_SIZE, NULL, configEDF_TASK_PRIORITY, NULL);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    vTaskDelete(sporadic_handle);
+
+    // Release the first job of every periodic task on the same tick.
+    vTaskSuspendAll();
+    {
+        for (int i = 0; i < PERIODIC_TASKS; i++)
+        {
+            xTaskCreate(periodic_task, "Periodic", TASK_STACK_SIZE, &periodic[i], configEDF_TASK_PRIORITY, &periodic[i].handle);
+            vTaskEDFRegister(periodic[i].handle, periodic[i].period, periodic[i].period);
+            periodic[i].release = xTaskGetTickCount();
+        }
+        counting = 1;
+    }
+    xTaskResumeAll();
+
+    vTaskDelay(TEST_TICKS);
+    counting = 0;
+
+    for (int i = 0; i < PERIODIC_TASKS; i++)
+    {
+        vTaskSuspend(periodic[i].handle);
+        printf("edf_test: task C=%u P=%u: %d jobs, %d missed deadlines\n",
+               (unsigned) periodic[i].execution, (unsigned) periodic[i].period,
+               periodic[i].jobs, periodic[i].misses);
+        jobs += periodic[i].jobs;
+        misses += periodic[i].misses;
+    }
+
+    if (misses != 0)
+    {
+        printf("FAIL %d missed deadlines\n", misses);
+        failures++;
+    }
+    if (switches > (unsigned) (jobs * SWITCHES_PER_JOB))
+    {
+        printf("FAIL %u switches for %d jobs\n", switches, jobs);
+        failures++;
+    }
+
+    printf("edf_test: %d wake rounds, %d jobs in %d ticks, %u switches, %d failures\n",
+           WAKE_ROUNDS, jobs, TEST_TICKS, switches, failures);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, CONTROL_PRIORITY, &control_handle);
+
+    vTaskStartScheduler();
+
+    return (failures == 0) ? 0 : 1;
+}
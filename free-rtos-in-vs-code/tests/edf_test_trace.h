@@ -0,0 +1,13 @@
+// File: tests/edf_test_trace.h
+// Description:
+// Forced into every source file of the EDF test with -include, so the kernel
+// calls edf_test_switched_in() each time it switches a task in.
+
+#ifndef EDF_TEST_TRACE_H
+#define EDF_TEST_TRACE_H
+
+void edf_test_switched_in(void);
+
+#define traceTASK_SWITCHED_IN() edf_test_switched_in()
+
+#endif // EDF_TEST_TRACE_H
@@ -0,0 +1,215 @@
+// File: tests/heap_realloc_test.c
+// Description:
+// Checks pvPortRealloc() and pvPortCalloc() of heap_4.c, with slabs on and
+// the heap in an application heap region (see heap_realloc_test_region.h),
+// which is how the STM32 template builds newlib's malloc() family.
+//
+// - shrink: shrinking a block in front of a free block gives its end back,
+//   merged with that free block, and keeps the contents.
+// - grow failure: a request larger than the heap returns NULL and leaves the
+//   block, its contents and the free heap as they were.
+// - slab object: shrinking a slab object keeps it in place, and growing it
+//   past its class moves it to a heap block with its contents.
+// - calloc: a count and size whose product overflows a size_t returns NULL
+//   without allocating, and other requests are zeroed.
+//
+// The test fails if any check does not hold.  Build and run with:
+//
+//     make test
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_HEAP_SLABS != 1) || (configUSE_APPLICATION_HEAP_REGION != 1)
+#error The test needs configUSE_HEAP_SLABS and configUSE_APPLICATION_HEAP_REGION set to 1.
+#endif
+
+// Larger than any slab class, so taken from the free list.
+#define BLOCK_SIZE        1024
+#define SHRUNK_SIZE       100
+
+// A slab object that grows past the largest class.
+#define SLAB_SIZE         16
+#define GROWN_SIZE        600
+
+#define TASK_STACK_SIZE   2048
+
+uint8_t heap_test_region[HEAP_TEST_REGION_SIZE] __attribute__((aligned(portBYTE_ALIGNMENT)));
+
+static int failures;
+
+static void check(int condition, const char *what)
+{
+    if (!condition)
+    {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void fill(uint8_t *block, size_t size, uint8_t seed)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        block[i] = (uint8_t) (seed + i);
+    }
+}
+
+static int filled(const uint8_t *block, size_t size, uint8_t seed)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        if (block[i] != (uint8_t) (seed + i))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static size_t free_blocks(void)
+{
+    HeapStats_t stats;
+
+    vPortGetHeapStats(&stats);
+    return stats.xNumberOfFreeBlocks;
+}
+
+static size_t slab_objects_in_use(void)
+{
+    SlabStats_t stats[8];
+    UBaseType_t classes = uxPortGetSlabStats(stats, sizeof(stats) / sizeof(stats[0]));
+    size_t in_use = 0;
+
+    for (UBaseType_t i = 0; i < classes; i++)
+    {
+        in_use += stats[i].xObjectsInUse;
+    }
+    return in_use;
+}
+
+static void test_shrink(void)
+{
+    uint8_t *a, *b, *c, *tail;
+    size_t free_before, blocks_before, header, shrunk_block;
+
+    a = pvPortMalloc(BLOCK_SIZE);
+    b = pvPortMalloc(BLOCK_SIZE);
+    c = pvPortMalloc(BLOCK_SIZE);
+    fill(a, BLOCK_SIZE, 1);
+
+    // BLOCK_SIZE is a multiple of the alignment, so a's block is its header
+    // and BLOCK_SIZE bytes.
+    header = (size_t) (b - a) - BLOCK_SIZE;
+    shrunk_block = (SHRUNK_SIZE + header + portBYTE_ALIGNMENT_MASK) & ~(size_t) portBYTE_ALIGNMENT_MASK;
+
+    // b becomes the free neighbour of a, with c keeping it from the rest of
+    // the heap.
+    vPortFree(b);
+    free_before = xPortGetFreeHeapSize();
+    blocks_before = free_blocks();
+
+    check(pvPortRealloc(a, SHRUNK_SIZE) == a, "shrink moved the block");
+    check(filled(a, SHRUNK_SIZE, 1), "shrink lost the contents");
+    check(xPortGetFreeHeapSize() == free_before + (size_t) (b - a) - shrunk_block, "shrink did not give back the end of the block");
+    check(free_blocks() == blocks_before, "end of the shrunk block not merged with its free neighbour");
+
+    // The merged block is the first that fits everything between a and c.
+    tail = pvPortMalloc((size_t) (c - a) - shrunk_block - header);
+    check(tail == a + shrunk_block, "merged block not reused");
+
+    vPortFree(tail);
+    vPortFree(a);
+    vPortFree(c);
+}
+
+static void test_grow_failure(void)
+{
+    uint8_t *a;
+    size_t free_before;
+
+    a = pvPortMalloc(BLOCK_SIZE);
+    fill(a, BLOCK_SIZE, 2);
+    free_before = xPortGetFreeHeapSize();
+
+    check(pvPortRealloc(a, 2 * HEAP_TEST_REGION_SIZE) == NULL, "grow larger than the heap succeeded");
+    check(filled(a, BLOCK_SIZE, 2), "failed grow changed the contents");
+    check(xPortGetFreeHeapSize() == free_before, "failed grow changed the heap");
+
+    vPortFree(a);
+}
+
+static void test_slab_object(void)
+{
+    uint8_t *a, *grown;
+    size_t in_use_before;
+
+    in_use_before = slab_objects_in_use();
+    a = pvPortMalloc(SLAB_SIZE);
+    check(slab_objects_in_use() == in_use_before + 1, "small block not a slab object");
+    fill(a, SLAB_SIZE, 3);
+
+    check(pvPortRealloc(a, SLAB_SIZE / 2) == a, "shrunk slab object moved");
+    check(pvPortRealloc(a, SLAB_SIZE) == a, "slab object moved within its class");
+
+    grown = pvPortRealloc(a, GROWN_SIZE);
+    check((grown != NULL) && (grown != a), "grown slab object not moved");
+    if (grown != NULL)
+    {
+        check(filled(grown, SLAB_SIZE, 3), "grown slab object lost the contents");
+        check(slab_objects_in_use() == in_use_before, "grown slab object not freed");
+        vPortFree(grown);
+    }
+}
+
+static void test_calloc(void)
+{
+    const size_t half = (size_t) 1 << (sizeof(size_t) * 4);
+    size_t free_before;
+    uint8_t *a;
+
+    free_before = xPortGetFreeHeapSize();
+    check(pvPortCalloc(SIZE_MAX / 2 + 1, 2) == NULL, "calloc of SIZE_MAX / 2 + 1 by 2 did not fail");
+    check(pvPortCalloc(half, half) == NULL, "calloc whose product wraps to 0 did not fail");
+    check(pvPortCalloc(3, SIZE_MAX / 2) == NULL, "calloc of 3 by SIZE_MAX / 2 did not fail");
+    check(xPortGetFreeHeapSize() == free_before, "failed calloc changed the heap");
+
+    a = pvPortMalloc(BLOCK_SIZE);
+    memset(a, 0xff, BLOCK_SIZE);
+    vPortFree(a);
+    a = pvPortCalloc(BLOCK_SIZE / 8, 8);
+    check(a != NULL, "calloc failed");
+    if (a != NULL)
+    {
+        check(filled(a, 1, 0) && (memcmp(a, a + 1, BLOCK_SIZE - 1) == 0), "calloc not zeroed");
+        vPortFree(a);
+    }
+}
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+    size_t free_at_start = xPortGetFreeHeapSize();
+
+    test_shrink();
+    test_grow_failure();
+    test_slab_object();
+    test_calloc();
+
+    printf("heap_realloc_test: %u byte region, %u free at start, %d failures\n",
+           (unsigned) HEAP_TEST_REGION_SIZE, (unsigned) free_at_start, failures);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, 1, NULL);
+
+    vTaskStartScheduler();
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,20 @@
+// File: tests/heap_realloc_test_region.h
+// Description:
+// Forced into every source file of the realloc test with -include, so heap_4.c
+// manages the heap_test_region array of the test as an application heap
+// region, as the STM32 template does with the RAM left after .bss.
+
+#ifndef HEAP_REALLOC_TEST_REGION_H
+#define HEAP_REALLOC_TEST_REGION_H
+
+#include <stdint.h>
+
+#define HEAP_TEST_REGION_SIZE               (64 * 1024)
+
+extern uint8_t heap_test_region[];
+
+#define configUSE_APPLICATION_HEAP_REGION   1
+#define configHEAP_REGION_START()           (heap_test_region)
+#define configHEAP_REGION_END()             (heap_test_region + HEAP_TEST_REGION_SIZE)
+
+#endif // HEAP_REALLOC_TEST_REGION_H
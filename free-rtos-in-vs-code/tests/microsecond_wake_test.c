@@ -0,0 +1,162 @@
+// File: tests/microsecond_wake_test.c
+// Description:
+// Measures how close to their wake time vTaskDelayMicroseconds() and
+// xTaskNotifyWaitMicroseconds() timeouts unblock a task.  DELAY_TASKS tasks
+// sleep for random times of 1 to MAX_DELAY_US microseconds, and as many
+// tasks wait for a notification that never comes with a random timeout in
+// the same range, WAKES_PER_TASK times each.  Every wake is timed against
+// the microsecond clock the delay was set from.
+//
+// The test fails if a task wakes before its time, if a notification wait
+// returns without timing out, or if the 99th percentile lateness reaches a
+// tick, which would mean the tick rather than the microsecond alarm woke
+// the tasks.  Build and run with:
+//
+//     make test
+//
+// Lateness on the simulator is mostly the time the host takes to deliver
+// the alarm signal and switch threads, so it is far larger than on a
+// target, where the TIM5 alarm wakes a task within a few microseconds.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_MICROSECOND_DELAYS != 1)
+#error The test needs configUSE_MICROSECOND_DELAYS set to 1.
+#endif
+
+#ifndef DELAY_TASKS
+#define DELAY_TASKS       6
+#endif
+
+#ifndef WAKES_PER_TASK
+#define WAKES_PER_TASK    2000
+#endif
+
+#ifndef MAX_DELAY_US
+#define MAX_DELAY_US      3000U
+#endif
+
+#define TEST_TASKS        (2 * DELAY_TASKS)
+#define TEST_PRIORITY     2
+#define CONTROL_PRIORITY  3
+#define TASK_STACK_SIZE   2048
+#define TICK_US           (1000000U / configTICK_RATE_HZ)
+
+static TaskHandle_t control_handle;
+
+// Lateness of every wake in microseconds, negative if the task woke early.
+static int32_t lateness[TEST_TASKS][WAKES_PER_TASK];
+static int notify_failures;
+
+static uint32_t next_random(uint32_t *state)
+{
+    // xorshift32
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+
+    return *state;
+}
+
+static void test_task(void *pvParameters)
+{
+    const int task = (int) (intptr_t) pvParameters;
+    uint32_t random_state = 0x2545F491U + (uint32_t) task;
+    uint32_t delay;
+    uint32_t wake;
+
+    for (int i = 0; i < WAKES_PER_TASK; i++)
+    {
+        delay = 1U + (next_random(&random_state) % MAX_DELAY_US);
+        wake = ulPortMicrosecondCount() + delay;
+
+        if (task < DELAY_TASKS)
+        {
+            vTaskDelayMicroseconds(delay);
+        }
+        else if (xTaskNotifyWaitMicroseconds(0, 0, NULL, delay) != pdFALSE)
+        {
+            notify_failures++;
+        }
+
+        lateness[task][i] = (int32_t) (ulPortMicrosecondCount() - wake);
+    }
+
+    xTaskNotifyGive(control_handle);
+    vTaskSuspend(NULL);
+}
+
+static int compare_lateness(const void *a, const void *b)
+{
+    int32_t x = *(const int32_t *) a;
+    int32_t y = *(const int32_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+static int failures;
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+    int32_t *all = &lateness[0][0];
+    const size_t count = (size_t) TEST_TASKS * WAKES_PER_TASK;
+    int64_t total = 0;
+    size_t early = 0;
+    size_t tick_late = 0;
+
+    for (int task = 0; task < TEST_TASKS; task++)
+    {
+        ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        total += all[i];
+
+        if (all[i] < 0)
+        {
+            early++;
+        }
+        else if (all[i] >= (int32_t) TICK_US)
+        {
+            tick_late++;
+        }
+    }
+
+    qsort(all, count, sizeof(all[0]), compare_lateness);
+
+    int32_t p99 = all[(count * 99U) / 100U];
+
+    printf("microsecond_wake_test: %zu wakes of 1 to %u us, lateness us: min %d avg %.1f p50 %d p99 %d max %d\n",
+           count, (unsigned) MAX_DELAY_US, (int) all[0], (double) total / (double) count,
+           (int) all[count / 2U], (int) p99, (int) all[count - 1U]);
+    printf("  %zu early, %zu a tick or more late, %d notification waits did not time out\n",
+           early, tick_late, notify_failures);
+
+    if ((early != 0U) || (notify_failures != 0) || (p99 >= (int32_t) TICK_US))
+    {
+        printf("FAIL\n");
+        failures++;
+    }
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    for (int task = 0; task < TEST_TASKS; task++)
+    {
+        xTaskCreate(test_task, "Test", TASK_STACK_SIZE, (void *) (intptr_t) task, TEST_PRIORITY, NULL);
+    }
+
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, CONTROL_PRIORITY, &control_handle);
+
+    vTaskStartScheduler();
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+// File: tests/notify_timeout_test.c
+// Description:
+// Checks a task whose microsecond notification wait times out while the
+// scheduler is suspended.  The microsecond alarm interrupt can then only
+// hold the task in the pending ready list until xTaskResumeAll(), and a
+// notification that arrives before that must leave it there rather than
+// unblock it a second time.  Every heap_4 allocation suspends the
+// scheduler, so this happens whenever a task notifies another from around
+// a pvPortMalloc() call.
+//
+// A waiter task blocks in xTaskNotifyWaitIndexedMicroseconds().  A lower
+// priority driver task suspends the scheduler, spins until the wait has
+// timed out, notifies the waiter with each of the notify functions in turn
+// and resumes the scheduler.  The waiter then has to report the
+// notification as received, as it does when a notification arrives between
+// a tick timeout and the task running, and nothing may be left pending.
+// Build and run with:
+//
+//     make test
+//
+// A failure is reported on stdout, or by an assertion, and the test exits
+// with a non-zero status.
+
+#include <stdint.h>
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_MICROSECOND_DELAYS != 1) || (configTASK_NOTIFICATION_ARRAY_ENTRIES < 2)
+#error The test needs configUSE_MICROSECOND_DELAYS 1 and two notification indexes.
+#endif
+
+#ifndef ROUNDS
+#define ROUNDS            50
+#endif
+
+// The waiter's timeout, and how long the driver keeps the scheduler
+// suspended.  The host can take milliseconds to deliver the alarm, so the
+// spin is far longer than the timeout.
+#define WAIT_US           200U
+#define SPIN_US           20000U
+
+// Index 0 passes control between the tasks, index 1 is the one tested.
+#define CONTROL_INDEX     0
+#define TEST_INDEX        1
+#define SET_BITS          0x5U
+
+#define WAITER_PRIORITY   3
+#define DRIVER_PRIORITY   2
+#define TASK_STACK_SIZE   2048
+
+typedef enum
+{
+    NOTIFY_GIVE,
+    NOTIFY_FROM_ISR,
+    NOTIFY_GIVE_FROM_ISR,
+    NOTIFY_METHODS
+} notify_method_t;
+
+static const char * const method_names[NOTIFY_METHODS] =
+{
+    "xTaskNotifyGiveIndexed",
+    "xTaskNotifyIndexedFromISR",
+    "vTaskNotifyGiveIndexedFromISR"
+};
+
+static TaskHandle_t waiter_handle;
+static TaskHandle_t driver_handle;
+
+// Set by the waiter for as long as it is in the wait under test.
+static volatile BaseType_t waiter_waiting;
+
+// Written by the waiter, read by the driver once the waiter has notified it.
+static BaseType_t waiter_received;
+static BaseType_t waiter_left_pending;
+static uint32_t waiter_value;
+
+static int failures;
+
+static void waiter_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    for (;;)
+    {
+        ulTaskNotifyTakeIndexed(CONTROL_INDEX, pdTRUE, portMAX_DELAY);
+
+        waiter_value = 0;
+        waiter_waiting = pdTRUE;
+        waiter_received = xTaskNotifyWaitIndexedMicroseconds(TEST_INDEX, 0, UINT32_MAX, &waiter_value, WAIT_US);
+        waiter_waiting = pdFALSE;
+
+        // Does not block, only reports a notification left behind.
+        waiter_left_pending = xTaskNotifyWaitIndexedMicroseconds(TEST_INDEX, 0, UINT32_MAX, NULL, 0);
+
+        xTaskNotifyGiveIndexed(driver_handle, CONTROL_INDEX);
+    }
+}
+
+static void notify_waiter(notify_method_t method)
+{
+    BaseType_t woken = pdFALSE;
+
+    switch (method)
+    {
+        case NOTIFY_GIVE:
+            xTaskNotifyGiveIndexed(waiter_handle, TEST_INDEX);
+            break;
+
+        case NOTIFY_FROM_ISR:
+            xTaskNotifyIndexedFromISR(waiter_handle, TEST_INDEX, SET_BITS, eSetBits, &woken);
+            break;
+
+        default:
+            vTaskNotifyGiveIndexedFromISR(waiter_handle, TEST_INDEX, &woken);
+            break;
+    }
+
+    // The wait has timed out, so there is nothing to unblock.
+    if (woken != pdFALSE)
+    {
+        printf("FAIL %s: asked for a yield for a task that was already unblocked\n", method_names[method]);
+        failures++;
+    }
+}
+
+static void driver_task(void *pvParameters)
+{
+    (void) pvParameters;
+    uint32_t start;
+
+    for (int method = 0; method < NOTIFY_METHODS; method++)
+    {
+        for (int round = 0; round < ROUNDS; round++)
+        {
+            // The waiter runs at once and blocks.
+            xTaskNotifyGiveIndexed(waiter_handle, CONTROL_INDEX);
+
+            vTaskSuspendAll();
+
+            // The host may have held the driver up for longer than the wait,
+            // in which case the waiter has already timed out in the usual
+            // way.  Let it finish and run the round again.
+            if ((waiter_waiting == pdFALSE) || (eTaskGetState(waiter_handle) != eBlocked))
+            {
+                xTaskResumeAll();
+                ulTaskNotifyTakeIndexed(CONTROL_INDEX, pdTRUE, portMAX_DELAY);
+                round--;
+                continue;
+            }
+
+            {
+                // The alarm interrupt times the wait out meanwhile.
+                start = ulPortMicrosecondCount();
+                while ((ulPortMicrosecondCount() - start) < SPIN_US)
+                {
+                }
+
+                notify_waiter((notify_method_t) method);
+            }
+            xTaskResumeAll();
+
+            ulTaskNotifyTakeIndexed(CONTROL_INDEX, pdTRUE, portMAX_DELAY);
+
+            uint32_t expected = (method == NOTIFY_FROM_ISR) ? SET_BITS : 1U;
+
+            if ((waiter_received != pdTRUE) || (waiter_value != expected) || (waiter_left_pending != pdFALSE))
+            {
+                printf("FAIL %s round %d: received %d value %u left pending %d\n", method_names[method], round,
+                       (int) waiter_received, (unsigned) waiter_value, (int) waiter_left_pending);
+                failures++;
+            }
+        }
+    }
+
+    printf("notify_timeout_test: %d rounds per notify function, %d failures\n", ROUNDS, failures);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    xTaskCreate(waiter_task, "Waiter", TASK_STACK_SIZE, NULL, WAITER_PRIORITY, &waiter_handle);
+    xTaskCreate(driver_task, "Driver", TASK_STACK_SIZE, NULL, DRIVER_PRIORITY, &driver_handle);
+
+    vTaskStartScheduler();
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+// File: tests/priority_order_test.c
+// Description:
+// Checks that tasks made ready together run in descending priority order
+// when configMAX_PRIORITIES is above 32, which with
+// configUSE_PORT_OPTIMISED_TASK_SELECTION set to 1 puts the ready priorities
+// in the two level bitmap.  Every round the control task gives each of
+// ORDER_TASKS tasks a random priority below its own, notifies them all in a
+// scrambled order with the scheduler suspended, and then blocks so they can
+// run.  Each task records that it ran and waits for the next notification,
+// and the last one to run wakes the control task.
+//
+// The test fails if a task runs after one of lower priority, or if a task
+// does not run in its round.  Build and run with:
+//
+//     make test
+
+#include <stdint.h>
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configMAX_PRIORITIES <= 32)
+#error The test needs configMAX_PRIORITIES above 32.
+#endif
+
+#ifndef ORDER_TASKS
+#define ORDER_TASKS       48
+#endif
+
+#ifndef ROUNDS
+#define ROUNDS            2000
+#endif
+
+#define CONTROL_PRIORITY  (configMAX_PRIORITIES - 1)
+#define TASK_STACK_SIZE   2048
+
+static TaskHandle_t control_handle;
+static TaskHandle_t order_handles[ORDER_TASKS];
+static UBaseType_t priorities[ORDER_TASKS];
+
+// Indices of the tasks in the order they ran this round.
+static int run_order[ORDER_TASKS];
+static int runs;
+
+static int failures;
+
+static uint32_t next_random(uint32_t *state)
+{
+    // xorshift32
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void order_task(void *pvParameters)
+{
+    int index = (int) (intptr_t) pvParameters;
+    int last;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Tasks that drew the same priority share it in time slices, so the
+        // tick may switch between them in the middle of the update.
+        taskENTER_CRITICAL();
+        {
+            run_order[runs++] = index;
+            last = (runs == ORDER_TASKS);
+        }
+        taskEXIT_CRITICAL();
+
+        if (last)
+        {
+            xTaskNotifyGive(control_handle);
+        }
+    }
+}
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+    uint32_t random_state = 12345;
+
+    // Let every task block.
+    vTaskDelay(1);
+
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        for (int i = 0; i < ORDER_TASKS; i++)
+        {
+            priorities[i] = 1 + next_random(&random_state) % (CONTROL_PRIORITY - 1);
+            vTaskPrioritySet(order_handles[i], priorities[i]);
+        }
+
+        runs = 0;
+        vTaskSuspendAll();
+        {
+            for (int i = 0; i < ORDER_TASKS; i++)
+            {
+                xTaskNotifyGive(order_handles[(i * 7 + round) % ORDER_TASKS]);
+            }
+        }
+        xTaskResumeAll();
+
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+
+        if (runs != ORDER_TASKS)
+        {
+            printf("FAIL round %d: %d of %d tasks ran\n", round, runs, ORDER_TASKS);
+            failures++;
+        }
+        for (int i = 1; i < runs; i++)
+        {
+            if (priorities[run_order[i]] > priorities[run_order[i - 1]])
+            {
+                printf("FAIL round %d: priority %u ran after %u\n", round,
+                       (unsigned) priorities[run_order[i]], (unsigned) priorities[run_order[i - 1]]);
+                failures++;
+            }
+        }
+    }
+
+    printf("priority_order_test: %d tasks over %d priorities, %d rounds, %d failures\n",
+           ORDER_TASKS, configMAX_PRIORITIES, ROUNDS, failures);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    for (int i = 0; i < ORDER_TASKS; i++)
+    {
+        xTaskCreate(order_task, "Order", TASK_STACK_SIZE, (void *) (intptr_t) i, 1, &order_handles[i]);
+    }
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, CONTROL_PRIORITY, &control_handle);
+
+    vTaskStartScheduler();
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+// File: tests/smp_affinity_test.c
+// Description:
+// Checks task selection on more than one core.  SPINNER_TASKS CPU bound tasks
+// run at distinct priorities below a checker task.  Every tick the checker
+// wakes and, in a critical section, notes the core it runs on and which of
+// the spinners are running.
+//
+// In the first phase no task has an affinity, so the spinners that are
+// running must be the configNUMBER_OF_CORES - 1 with the highest priorities,
+// the checker taking the remaining core.
+//
+// In the second phase each spinner is pinned to one core, in turn.  On every
+// core but the checker's, the highest priority spinner pinned to that core
+// must be running, and no other spinner.  Each spinner also records the cores
+// it finds itself on, which must all be in its affinity mask.
+//
+// The test fails if the running spinners differ from those expected in any
+// round, or if a spinner ran on a core outside its affinity mask.  It is
+// built for 2 and 4 cores.  Build and run with:
+//
+//     make test
+
+#include <stdint.h>
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configNUMBER_OF_CORES < 2) || (INCLUDE_eTaskGetState != 1)
+#error The test needs configNUMBER_OF_CORES above 1 and INCLUDE_eTaskGetState set to 1.
+#endif
+
+#define SPINNER_TASKS     (configNUMBER_OF_CORES + 2)
+
+#ifndef CHECK_ROUNDS
+#define CHECK_ROUNDS      200
+#endif
+
+// Ticks given to the cores to act on new affinity masks before checking.
+#define SETTLE_TICKS      5
+
+#define CHECKER_PRIORITY  (SPINNER_TASKS + 1)
+#define TASK_STACK_SIZE   2048
+
+// Spinner 0 has the highest priority.
+static TaskHandle_t spinners[SPINNER_TASKS];
+static UBaseType_t masks[SPINNER_TASKS];
+
+// The cores each spinner found itself on, for the phase it read first.  Each
+// phase has its own copy, so a spinner that is switched out part way through
+// an update cannot carry cores from one phase into the next.
+static volatile int phase;
+static volatile UBaseType_t seen_cores[2][SPINNER_TASKS];
+
+static int failures;
+
+static void spinner_task(void *pvParameters)
+{
+    int spinner = (int) (intptr_t) pvParameters;
+    int p;
+
+    for (;;)
+    {
+        p = phase;
+        seen_cores[p][spinner] |= (UBaseType_t) 1 << xPortGetCoreID();
+    }
+}
+
+// Returns non-zero if the spinner should be running while the checker runs on
+// checker_core.  With no affinity that is the highest priority spinners, one
+// per core left.  Otherwise it is the highest priority spinner pinned to each
+// core but the checker's.
+static int expected_running(int spinner, BaseType_t checker_core)
+{
+    if (masks[spinner] == tskNO_AFFINITY)
+    {
+        return spinner < (configNUMBER_OF_CORES - 1);
+    }
+
+    if ((masks[spinner] & ((UBaseType_t) 1 << checker_core)) != 0)
+    {
+        return 0;
+    }
+
+    for (int other = 0; other < spinner; other++)
+    {
+        if (masks[other] == masks[spinner])
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static int check_rounds(const char *phase)
+{
+    int wrong = 0;
+    int running[SPINNER_TASKS];
+    BaseType_t checker_core;
+
+    for (int round = 0; round < CHECK_ROUNDS; round++)
+    {
+        vTaskDelay(1);
+
+        // Nothing can be switched on any core until the critical section is
+        // left, so this is a snapshot of what every core is running.
+        taskENTER_CRITICAL();
+        {
+            checker_core = xPortGetCoreID();
+            for (int i = 0; i < SPINNER_TASKS; i++)
+            {
+                running[i] = (eTaskGetState(spinners[i]) == eRunning);
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        for (int i = 0; i < SPINNER_TASKS; i++)
+        {
+            if (running[i] != expected_running(i, checker_core))
+            {
+                if (wrong < 5)
+                {
+                    printf("FAIL %s round %d: checker on core %d, spinner %d %s\n", phase, round,
+                           (int) checker_core, i, running[i] ? "running" : "not running");
+                }
+                wrong++;
+            }
+        }
+    }
+
+    return wrong;
+}
+
+static void checker_task(void *pvParameters)
+{
+    (void) pvParameters;
+    int wrong;
+    int outside = 0;
+
+    for (int i = 0; i < SPINNER_TASKS; i++)
+    {
+        masks[i] = tskNO_AFFINITY;
+        xTaskCreate(spinner_task, "Spinner", TASK_STACK_SIZE, (void *) (intptr_t) i, SPINNER_TASKS - i, &spinners[i]);
+    }
+
+    vTaskDelay(SETTLE_TICKS);
+    wrong = check_rounds("unpinned");
+    if (wrong != 0)
+    {
+        printf("FAIL %d spinners in the wrong state with no affinity\n", wrong);
+        failures++;
+    }
+
+    for (int i = 0; i < SPINNER_TASKS; i++)
+    {
+        masks[i] = (UBaseType_t) 1 << (i % configNUMBER_OF_CORES);
+        vTaskCoreAffinitySet(spinners[i], masks[i]);
+    }
+
+    vTaskDelay(SETTLE_TICKS);
+    phase = 1;
+
+    wrong = check_rounds("pinned");
+    if (wrong != 0)
+    {
+        printf("FAIL %d spinners in the wrong state when pinned\n", wrong);
+        failures++;
+    }
+
+    for (int i = 0; i < SPINNER_TASKS; i++)
+    {
+        vTaskSuspend(spinners[i]);
+        if ((seen_cores[1][i] & ~masks[i]) != 0)
+        {
+            printf("FAIL spinner %d with affinity 0x%x ran on cores 0x%x\n", i,
+                   (unsigned) masks[i], (unsigned) seen_cores[1][i]);
+            outside++;
+        }
+    }
+    if (outside != 0)
+    {
+        failures++;
+    }
+
+    printf("smp_affinity_test: %d cores, %d spinners, %d rounds unpinned and pinned, %d failures\n",
+           configNUMBER_OF_CORES, SPINNER_TASKS, CHECK_ROUNDS, failures);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    xTaskCreate(checker_task, "Checker", TASK_STACK_SIZE, NULL, CHECKER_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+// File: tests/time_slice_test.c
+// Description:
+// Checks per task time slices with configUSE_PER_TASK_TIME_SLICE set to 1.
+//
+// Two CPU bound tasks share a priority, one with a time slice of SHORT_SLICE
+// ticks and one with a time slice of LONG_SLICE ticks.  A higher priority
+// task wakes every PREEMPT_PERIOD ticks, which is shorter than the long
+// slice, and blocks again at once.  A preempted task must carry on with the
+// rest of its slice, so the two tasks should still take turns once every
+// SHORT_SLICE + LONG_SLICE ticks, and share the processor in the ratio of
+// their slices.  The tick hook counts the ticks each of them runs for, and
+// the switches between the two are counted as they are switched in.
+//
+// The test fails if the number of switches between the two tasks, or the
+// ratio of the ticks they ran for, is more than a quarter away from the
+// expected value.  Build and run with:
+//
+//     make test
+
+#include <stdint.h>
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_PER_TASK_TIME_SLICE != 1) || (configUSE_TICK_HOOK != 1)
+#error The test needs configUSE_PER_TASK_TIME_SLICE and configUSE_TICK_HOOK set to 1.
+#endif
+
+#ifndef SHORT_SLICE
+#define SHORT_SLICE       1
+#endif
+
+#ifndef LONG_SLICE
+#define LONG_SLICE        20
+#endif
+
+#ifndef PREEMPT_PERIOD
+#define PREEMPT_PERIOD    3
+#endif
+
+#ifndef TEST_TICKS
+#define TEST_TICKS        4200
+#endif
+
+#define CONTROL_PRIORITY  3
+#define PREEMPT_PRIORITY  2
+#define SLICE_PRIORITY    1
+#define TASK_STACK_SIZE   2048
+
+static TaskHandle_t short_handle;
+static TaskHandle_t long_handle;
+static TaskHandle_t last_slice_task;
+static volatile int counting;
+
+// Written from the tick and on each switch, read by the control task once
+// counting has stopped.
+static volatile unsigned switches;
+static volatile unsigned short_ticks;
+static volatile unsigned long_ticks;
+
+static int failures;
+
+void time_slice_test_switched_in(void)
+{
+    TaskHandle_t running = xTaskGetCurrentTaskHandle();
+
+    if ((running != short_handle) && (running != long_handle))
+    {
+        return;
+    }
+
+    if (counting && (last_slice_task != NULL) && (running != last_slice_task))
+    {
+        switches++;
+    }
+    last_slice_task = running;
+}
+
+void vApplicationTickHook(void)
+{
+    TaskHandle_t running = xTaskGetCurrentTaskHandle();
+
+    if (!counting)
+    {
+        return;
+    }
+
+    if (running == short_handle)
+    {
+        short_ticks++;
+    }
+    else if (running == long_handle)
+    {
+        long_ticks++;
+    }
+}
+
+static void slice_task(void *pvParameters)
+{
+    vTaskSetTimeSlice(NULL, (UBaseType_t) (uintptr_t) pvParameters);
+
+    for (;;)
+    {
+    }
+}
+
+static void preempt_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    for (;;)
+    {
+        vTaskDelay(PREEMPT_PERIOD);
+    }
+}
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+    unsigned expected = (2 * TEST_TICKS) / (SHORT_SLICE + LONG_SLICE);
+    unsigned ratio_x100;
+
+    xTaskCreate(slice_task, "Short", TASK_STACK_SIZE, (void *) (uintptr_t) SHORT_SLICE, SLICE_PRIORITY, &short_handle);
+    xTaskCreate(slice_task, "Long", TASK_STACK_SIZE, (void *) (uintptr_t) LONG_SLICE, SLICE_PRIORITY, &long_handle);
+    xTaskCreate(preempt_task, "Preempt", TASK_STACK_SIZE, NULL, PREEMPT_PRIORITY, NULL);
+
+    // Let both tasks set their time slice before counting.
+    vTaskDelay(SHORT_SLICE + LONG_SLICE);
+    counting = 1;
+    vTaskDelay(TEST_TICKS);
+    counting = 0;
+
+    vTaskSuspend(short_handle);
+    vTaskSuspend(long_handle);
+
+    ratio_x100 = (100 * long_ticks) / ((short_ticks != 0) ? short_ticks : 1);
+
+    if ((switches * 4 < expected * 3) || (switches * 4 > expected * 5))
+    {
+        printf("FAIL %u switches between the tasks, expected about %u\n", switches, expected);
+        failures++;
+    }
+    if ((ratio_x100 * SHORT_SLICE * 4 < LONG_SLICE * 100 * 3) || (ratio_x100 * SHORT_SLICE * 4 > LONG_SLICE * 100 * 5))
+    {
+        printf("FAIL ran for %u and %u ticks, expected a ratio of about %d:%d\n",
+               short_ticks, long_ticks, SHORT_SLICE, LONG_SLICE);
+        failures++;
+    }
+
+    printf("time_slice_test: slices of %d and %d ticks, preempted every %d ticks: %u switches in %d ticks,"
+           " ran for %u and %u ticks, %d failures\n",
+           SHORT_SLICE, LONG_SLICE, PREEMPT_PERIOD, switches, TEST_TICKS, short_ticks, long_ticks, failures);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, CONTROL_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,13 @@
+// File: tests/time_slice_test_trace.h
+// Description:
+// Forced into every source file of the time slice test with -include, so the
+// kernel calls time_slice_test_switched_in() each time it switches a task in.
+
+#ifndef TIME_SLICE_TEST_TRACE_H
+#define TIME_SLICE_TEST_TRACE_H
+
+void time_slice_test_switched_in(void);
+
+#define traceTASK_SWITCHED_IN() time_slice_test_switched_in()
+
+#endif // TIME_SLICE_TEST_TRACE_H
@@ -0,0 +1,208 @@
+// File: tests/timing_wheel_test.c
+// Description:
+// Checks that delayed tasks wake on the same tick with and without the timing
+// wheel, across a wrap of the tick count.
+//
+// WHEEL_TASKS tasks block in xTaskNotifyWait() again and again, each time
+// with a pseudo random timeout of 1 to MAX_DELAY ticks.  MAX_DELAY is beyond
+// the horizon of a two level wheel, so some timeouts start out in the sorted
+// delayed lists and move into the wheel later.  A kicker task notifies a
+// random task every few ticks, so some tasks leave their slot before it is
+// due.  The Makefile starts the tick count 2500 ticks short of the wrap.
+//
+// The trace hooks record the tick on which each task blocked and the tick on
+// which the kernel made it ready again.  A task that timed out must have been
+// made ready on exactly the tick it blocked on plus its timeout, which is
+// when the sorted delayed list wakes it.  The test is built with
+// configUSE_TIMING_WHEEL set to 0 and 1, and fails if any timeout wakes on
+// another tick or if no task woke after the wrap.  Build and run both with:
+//
+//     make test
+
+#include <stdint.h>
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef WHEEL_TASKS
+#define WHEEL_TASKS       32
+#endif
+
+#ifndef MAX_DELAY
+#define MAX_DELAY         1500
+#endif
+
+#ifndef TEST_TICKS
+#define TEST_TICKS        5000
+#endif
+
+#ifndef KICK_PERIOD
+#define KICK_PERIOD       40
+#endif
+
+#define CONTROL_PRIORITY  3
+#define WHEEL_PRIORITY    2
+#define KICKER_PRIORITY   1
+#define TASK_STACK_SIZE   2048
+
+typedef struct
+{
+    TaskHandle_t handle;
+    uint32_t seed;
+
+    // Written by the trace hooks.
+    volatile uint32_t blocked_tick;
+    volatile uint32_t ready_tick;
+
+    int timeouts;
+    int notified;
+    int wrong;
+    int wrapped;
+} wheel_task_t;
+
+static wheel_task_t tasks[WHEEL_TASKS];
+static volatile int running;
+static int failures;
+
+static uint32_t next_random(uint32_t *seed)
+{
+    *seed = (*seed * 1103515245UL) + 12345UL;
+    return *seed >> 16;
+}
+
+static wheel_task_t *find_task(void *task)
+{
+    for (int i = 0; i < WHEEL_TASKS; i++)
+    {
+        if ((void *) tasks[i].handle == task)
+        {
+            return &tasks[i];
+        }
+    }
+
+    return NULL;
+}
+
+void timing_wheel_test_blocked(void *task, uint32_t tick)
+{
+    wheel_task_t *t = find_task(task);
+
+    if (t != NULL)
+    {
+        t->blocked_tick = tick;
+    }
+}
+
+void timing_wheel_test_ready(void *task, uint32_t tick)
+{
+    wheel_task_t *t = find_task(task);
+
+    if (t != NULL)
+    {
+        t->ready_tick = tick;
+    }
+}
+
+static void wheel_task(void *pvParameters)
+{
+    wheel_task_t *t = pvParameters;
+    TickType_t timeout;
+    uint32_t expected;
+
+    while (running)
+    {
+        timeout = (TickType_t) (next_random(&t->seed) % MAX_DELAY) + 1;
+
+        if (xTaskNotifyWait(0, 0xFFFFFFFFUL, NULL, timeout) == pdTRUE)
+        {
+            t->notified++;
+            continue;
+        }
+
+        expected = t->blocked_tick + (uint32_t) timeout;
+        if (t->ready_tick != expected)
+        {
+            printf("FAIL task %d: blocked on tick %lu for %lu ticks, woke on tick %lu\n",
+                   (int) (t - tasks), (unsigned long) t->blocked_tick, (unsigned long) timeout,
+                   (unsigned long) t->ready_tick);
+            t->wrong++;
+        }
+        if (t->ready_tick < (uint32_t) configINITIAL_TICK_COUNT)
+        {
+            t->wrapped++;
+        }
+        t->timeouts++;
+    }
+
+    vTaskSuspend(NULL);
+}
+
+static void kicker_task(void *pvParameters)
+{
+    (void) pvParameters;
+    uint32_t seed = 1;
+
+    for (;;)
+    {
+        vTaskDelay(KICK_PERIOD);
+        xTaskNotify(tasks[next_random(&seed) % WHEEL_TASKS].handle, 1, eSetBits);
+    }
+}
+
+static void control_task(void *pvParameters)
+{
+    (void) pvParameters;
+    int timeouts = 0;
+    int notified = 0;
+    int wrong = 0;
+    int wrapped = 0;
+
+    vTaskDelay(TEST_TICKS);
+    running = 0;
+
+    vTaskSuspendAll();
+    {
+        for (int i = 0; i < WHEEL_TASKS; i++)
+        {
+            timeouts += tasks[i].timeouts;
+            notified += tasks[i].notified;
+            wrong += tasks[i].wrong;
+            wrapped += tasks[i].wrapped;
+        }
+    }
+    xTaskResumeAll();
+
+    if (wrong != 0)
+    {
+        printf("FAIL %d timeouts woke on the wrong tick\n", wrong);
+        failures++;
+    }
+    if (wrapped == 0)
+    {
+        printf("FAIL no timeout woke after the tick count wrapped\n");
+        failures++;
+    }
+
+    printf("timing_wheel_test: %s, %d timeouts (%d after the wrap), %d notified early, %d failures\n",
+           (configUSE_TIMING_WHEEL == 1) ? "wheel" : "list", timeouts, wrapped, notified, failures);
+
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    running = 1;
+
+    for (int i = 0; i < WHEEL_TASKS; i++)
+    {
+        tasks[i].seed = (uint32_t) i + 1;
+        xTaskCreate(wheel_task, "Wheel", TASK_STACK_SIZE, &tasks[i], WHEEL_PRIORITY, &tasks[i].handle);
+    }
+
+    xTaskCreate(kicker_task, "Kicker", TASK_STACK_SIZE, NULL, KICKER_PRIORITY, NULL);
+    xTaskCreate(control_task, "Control", TASK_STACK_SIZE, NULL, CONTROL_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    return (failures == 0) ? 0 : 1;
+}
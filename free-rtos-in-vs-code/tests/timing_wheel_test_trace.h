@@ -0,0 +1,20 @@
+// File: tests/timing_wheel_test_trace.h
+// Description:
+// Forced into every source file of the timing wheel test with -include, so
+// the kernel passes the tick count to the test each time a task blocks in
+// xTaskNotifyWait() and each time a task is made ready.  Both are called with
+// the tick count held still, so they record the tick the kernel acted on
+// rather than the tick at which the task got round to running.
+
+#ifndef TIMING_WHEEL_TEST_TRACE_H
+#define TIMING_WHEEL_TEST_TRACE_H
+
+#include <stdint.h>
+
+void timing_wheel_test_blocked(void *task, uint32_t tick);
+void timing_wheel_test_ready(void *task, uint32_t tick);
+
+#define traceTASK_NOTIFY_WAIT_BLOCK() timing_wheel_test_blocked(pxCurrentTCB, xTickCount)
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) timing_wheel_test_ready(pxTCB, xTickCount)
+
+#endif // TIMING_WHEEL_TEST_TRACE_H